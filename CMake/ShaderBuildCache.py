@@ -0,0 +1,281 @@
+#!/usr/bin/env python3
+"""
+Content-addressed cache for shader compilation.
+
+Compiled shaders are keyed by their preprocessed source, the compiler identity and the compilation flags, so editing a
+shared include only recompiles the shaders whose preprocessed source actually changed. Only the standard library is
+used, so the cache works offline.
+
+Commands:
+    report <cache_dir> [--reset]
+        Prints the hits and misses recorded since the last reset.
+    build <ninja_dir>... [-j N] [--ninja PATH]
+        Builds the given shader ninja directories in parallel, sharing the job count between them. Used by the regular
+        shader compilation step.
+    benchmark <shader_build_dir> [-j N] [--ninja PATH]
+        Rebuilds all the shader ninja files of a build directory, in parallel, with a cold then a warm cache. A scratch
+        cache is used, so the actual one is left untouched.
+"""
+
+import argparse
+import concurrent.futures
+import hashlib
+import os
+import re
+import shutil
+import subprocess
+import tempfile
+import time
+from pathlib import Path
+
+STATS_FILE_NAME = "stats.log"
+
+# Both the MSVC and GNU line marker styles, as emitted by the preprocessor
+LINE_MARKER_REGEX = re.compile(r'^#\s*(?:line\s+)?\d+\s+"([^"]+)"', re.MULTILINE)
+
+
+def run_command(args):
+    result = subprocess.run(args, capture_output=True, text=True)
+    if len(result.stdout) > 0:
+        print(result.stdout)
+    if len(result.stderr) > 0:
+        print(result.stderr)
+    if result.returncode != 0:
+        exit(result.returncode)
+
+
+def get_compiler_identity(cache_dir: Path, compiler: str) -> str:
+    """
+    Returns the compiler version string. It is memoized in the cache directory, keyed by the compiler binary path, size
+    and modification time, to avoid running the compiler once more per shader.
+    """
+    stat = os.stat(compiler)
+    stat_key = hashlib.sha256(f"{os.path.abspath(compiler)}|{stat.st_size}|{stat.st_mtime_ns}".encode()).hexdigest()
+    identity_file = cache_dir / "compilers" / f"{stat_key[:32]}.txt"
+
+    if identity_file.exists():
+        return identity_file.read_text()
+
+    result = subprocess.run([compiler, "--version"], capture_output=True, text=True)
+    identity = result.stdout + result.stderr
+    write_atomically(identity_file, identity.encode())
+    return identity
+
+
+def write_atomically(path: Path, data: bytes):
+    # Concurrent compilations may write the same entry, the rename keeps readers from seeing partial files.
+    path.parent.mkdir(parents=True, exist_ok=True)
+    fd, temp_path = tempfile.mkstemp(dir=path.parent, prefix=".tmp_")
+    with os.fdopen(fd, "wb") as f:
+        f.write(data)
+    os.replace(temp_path, path)
+
+
+def escape_depfile_path(path: str) -> str:
+    return path.replace("\\", "/").replace(" ", "\\ ")
+
+
+def write_depfile(depfile: Path, output_file: str, dependencies):
+    line = f"{escape_depfile_path(output_file)}:"
+    for dependency in dependencies:
+        line += f" \\\n  {escape_depfile_path(dependency)}"
+    write_atomically(depfile, (line + "\n").encode())
+
+
+def record_stats(cache_dir: Path, status: str, elapsed: float, output_file: str):
+    # Single small appends are atomic, so concurrent compilations can share the file.
+    with open(cache_dir / STATS_FILE_NAME, "a") as f:
+        f.write(f"{status} {elapsed:.4f} {output_file}\n")
+
+
+# dxc options whose value can be passed as a separate argument
+DXC_VALUE_OPTIONS = {
+    "-T", "-E", "-D", "-I", "-U",
+    "-Fo", "-Fi", "-Fe", "-Fd", "-Fh", "-Fc", "-Fre", "-Frs", "-Fsh", "-MF",
+    "-HV", "-Vn", "-Vd", "-exports", "-external", "-external-fn", "-setrootsignature", "-select-validator",
+}
+
+
+def split_compile_args(args, input_file=None):
+    """
+    Returns the input file and the flags that affect the output. Include directories and the input path are left out,
+    as their effect is already part of the preprocessed source. When the input file isn't given, it is the first
+    argument that is neither an option nor an option value.
+    """
+    flags = []
+    i = 0
+    while i < len(args):
+        arg = args[i]
+        if arg in ("-I", "/I"):
+            i += 2
+            continue
+        if arg.startswith("-I") or arg.startswith("/I"):
+            i += 1
+            continue
+        if arg in DXC_VALUE_OPTIONS:
+            flags += args[i:i + 2]
+            i += 2
+            continue
+        if arg == input_file:
+            i += 1
+            continue
+        if not arg.startswith("-") and input_file is None:
+            input_file = arg
+        else:
+            flags.append(arg)
+        i += 1
+    return input_file, flags
+
+
+def compile_shader(cache_dir: Path, output_file: str, compile_args, input_file=None):
+    start = time.perf_counter()
+    compiler = compile_args[0]
+    input_file, flags = split_compile_args(compile_args[1:], input_file)
+    depfile = Path(f"{output_file}.d")
+
+    cache_dir.mkdir(parents=True, exist_ok=True)
+    Path(output_file).parent.mkdir(parents=True, exist_ok=True)
+
+    with tempfile.TemporaryDirectory(dir=cache_dir, prefix=".pp_") as temp_dir:
+        preprocessed_file = Path(temp_dir) / "source.hlsl"
+        run_command(compile_args + ["-P", "-Fi", str(preprocessed_file)])
+        preprocessed_source = preprocessed_file.read_bytes()
+
+    # Dependencies are recovered from the line markers, saving a dedicated dependency scan.
+    dependencies = [
+        dependency
+        for dependency in dict.fromkeys(LINE_MARKER_REGEX.findall(preprocessed_source.decode(errors="replace")))
+        if not dependency.startswith("<")
+    ]
+    if len(dependencies) == 0:
+        run_command(compile_args + ["-MD", "-MF", str(depfile)])
+    else:
+        write_depfile(depfile, output_file, [input_file] + [d for d in dependencies if d != input_file])
+
+    key_hash = hashlib.sha256()
+    key_hash.update(get_compiler_identity(cache_dir, compiler).encode())
+    key_hash.update(b"\0")
+    key_hash.update("\0".join(flags).encode())
+    key_hash.update(b"\0")
+    key_hash.update(preprocessed_source)
+    key = key_hash.hexdigest()
+
+    cache_entry = cache_dir / "objects" / key[:2] / key[2:]
+    if cache_entry.exists():
+        shutil.copyfile(cache_entry, output_file)
+        record_stats(cache_dir, "hit", time.perf_counter() - start, output_file)
+        return
+
+    run_command(compile_args + ["-Fo", output_file])
+    write_atomically(cache_entry, Path(output_file).read_bytes())
+    record_stats(cache_dir, "miss", time.perf_counter() - start, output_file)
+
+
+def read_stats(cache_dir: Path):
+    hits, misses = [], []
+    stats_file = cache_dir / STATS_FILE_NAME
+    if stats_file.exists():
+        for line in stats_file.read_text().splitlines():
+            status, elapsed, _ = line.split(" ", 2)
+            (hits if status == "hit" else misses).append(float(elapsed))
+    return hits, misses
+
+
+def reset_stats(cache_dir: Path):
+    (cache_dir / STATS_FILE_NAME).unlink(missing_ok=True)
+
+
+def print_report(cache_dir: Path):
+    hits, misses = read_stats(cache_dir)
+    total = len(hits) + len(misses)
+    print(f"Shader cache '{cache_dir}': {total} compilations, {len(hits)} hits, {len(misses)} misses"
+          + (f" ({100.0 * len(hits) / total:.1f}% hit rate)" if total > 0 else ""))
+    if len(hits) > 0:
+        print(f" - Hits: {sum(hits):.2f}s total, {1000.0 * sum(hits) / len(hits):.1f}ms average")
+    if len(misses) > 0:
+        print(f" - Misses: {sum(misses):.2f}s total, {1000.0 * sum(misses) / len(misses):.1f}ms average")
+
+
+def build_all(ninja: str, ninja_dirs, jobs: int, cache_dir, clean: bool):
+    """
+    Builds all the shader ninja files concurrently, sharing the job count between them rather than serialising them
+    per target. The cache directory of the ninja files is used when none is given.
+    """
+    environment = dict(os.environ)
+    if cache_dir is not None:
+        environment["KE_SHADER_CACHE_DIR"] = str(cache_dir)
+    jobs_per_dir = max(1, jobs // max(1, len(ninja_dirs)))
+
+    def build(directory: Path):
+        if clean:
+            subprocess.run([ninja, "-C", str(directory), "-t", "clean"], capture_output=True, env=environment)
+        result = subprocess.run([ninja, "-C", str(directory), "-j", str(jobs_per_dir)],
+                                capture_output=True, text=True, env=environment)
+        if result.returncode != 0:
+            print(result.stdout + result.stderr)
+        return result.returncode
+
+    start = time.perf_counter()
+    with concurrent.futures.ThreadPoolExecutor(max_workers=len(ninja_dirs)) as executor:
+        return_codes = list(executor.map(build, ninja_dirs))
+    return time.perf_counter() - start, all(code == 0 for code in return_codes)
+
+
+def run_benchmark(ninja: str, shader_build_dir: Path, jobs: int):
+    ninja_dirs = sorted(path.parent for path in shader_build_dir.glob("*/build.ninja"))
+    if len(ninja_dirs) == 0:
+        print(f"No shader ninja files found in '{shader_build_dir}'")
+        exit(1)
+
+    print(f"Benchmarking {len(ninja_dirs)} shader targets with {jobs} jobs")
+
+    with tempfile.TemporaryDirectory(prefix="ke_shader_cache_") as scratch_cache:
+        cold_time, success = build_all(ninja, ninja_dirs, jobs, Path(scratch_cache), clean=True)
+        print(f"Cold build: {cold_time:.2f}s")
+        print_report(Path(scratch_cache))
+        if not success:
+            exit(1)
+
+        reset_stats(Path(scratch_cache))
+        warm_time, success = build_all(ninja, ninja_dirs, jobs, Path(scratch_cache), clean=True)
+        print(f"Warm build: {warm_time:.2f}s ({cold_time / max(warm_time, 1e-6):.1f}x faster)")
+        print_report(Path(scratch_cache))
+        if not success:
+            exit(1)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Shader build cache tools")
+    subparsers = parser.add_subparsers(dest="command", required=True)
+
+    report_parser = subparsers.add_parser("report")
+    report_parser.add_argument("cache_dir", type=Path)
+    report_parser.add_argument("--reset", action="store_true")
+
+    build_parser = subparsers.add_parser("build")
+    build_parser.add_argument("ninja_dirs", type=Path, nargs="*")
+    build_parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count())
+    build_parser.add_argument("--ninja", default="ninja")
+
+    benchmark_parser = subparsers.add_parser("benchmark")
+    benchmark_parser.add_argument("shader_build_dir", type=Path)
+    benchmark_parser.add_argument("-j", "--jobs", type=int, default=os.cpu_count())
+    benchmark_parser.add_argument("--ninja", default="ninja")
+
+    args = parser.parse_args()
+    if args.command == "report":
+        print_report(args.cache_dir)
+        if args.reset:
+            reset_stats(args.cache_dir)
+    elif args.command == "build":
+        if len(args.ninja_dirs) == 0:
+            return
+        _, success = build_all(args.ninja, args.ninja_dirs, args.jobs, None, clean=False)
+        if not success:
+            exit(1)
+    elif args.command == "benchmark":
+        run_benchmark(args.ninja, args.shader_build_dir, args.jobs)
+
+
+if __name__ == "__main__":
+    main()
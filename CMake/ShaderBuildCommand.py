@@ -1,24 +1,37 @@
 #!/usr/bin/env python3
 
+import os
 import sys
-import subprocess
+from pathlib import Path
+
+import ShaderBuildCache
 
 
 def main():
-    output_file = sys.argv[1]
-    common_args = sys.argv[2:]
-
-    def run_command(args):
-        result = subprocess.run(args, capture_output=True, text=True)
-        if len(result.stdout) > 0:
-            print(result.stdout)
-        if len(result.stderr) > 0:
-            print(result.stderr)
-        if result.returncode != 0:
-            exit(result.returncode)
-
-    run_command(common_args + ["-MD", "-MF", f"{output_file}.d"])
-    run_command(common_args + ["-Fo", output_file])
+    args = sys.argv[1:]
+
+    # Optional cache directory, which can be overridden through the environment
+    cache_dir = None
+    if args[0] == "--cache-dir":
+        cache_dir = args[1] if args[1] != "None" else None
+        args = args[2:]
+    cache_dir = os.environ.get("KE_SHADER_CACHE_DIR", cache_dir)
+
+    # Input file, passed explicitly so the cache doesn't have to guess it from the compiler arguments
+    input_file = None
+    if args[0] == "--input":
+        input_file = args[1]
+        args = args[2:]
+
+    output_file = args[0]
+    common_args = args[1:]
+
+    if cache_dir is not None:
+        ShaderBuildCache.compile_shader(Path(cache_dir), output_file, common_args, input_file)
+        return
+
+    ShaderBuildCache.run_command(common_args + ["-MD", "-MF", f"{output_file}.d"])
+    ShaderBuildCache.run_command(common_args + ["-Fo", output_file])
 
 
 if __name__ == "__main__":
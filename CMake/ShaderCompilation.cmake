@@ -52,12 +52,47 @@ if (NeedSpirVCross)
     set(ShaderTools "${ShaderTools}%%spirv-cross=${SpirVCross}")
 endif ()
 
+# Content-addressed shader cache, shared by all the shader targets. Set to "None" to disable it.
+set(KE_SHADER_CACHE_DIR "${CMAKE_BINARY_DIR}/ShaderCache" CACHE STRING "Shader compilation cache directory")
+message(STATUS "Shader cache directory: ${KE_SHADER_CACHE_DIR}")
+
 # Global variables set
 set_property(GLOBAL PROPERTY KE_SHADER_TOOLS "${ShaderTools}")
 set_property(GLOBAL PROPERTY KE_SHADER_GENERATE_SCRIPT "${CMAKE_CURRENT_SOURCE_DIR}/CMake/ShaderListParser.py")
 set_property(GLOBAL PROPERTY KE_SHADER_BUILD_COMMAND_SCRIPT "${CMAKE_CURRENT_SOURCE_DIR}/CMake/ShaderBuildCommand.py")
 find_package(Python3 REQUIRED)
 
+# Shader cache tools. The benchmark rebuilds all shader targets in parallel, from a cold then a warm scratch cache.
+if (NOT KE_SHADER_CACHE_DIR STREQUAL "None")
+    add_custom_target(ShaderCacheReport
+            COMMAND ${Python3_EXECUTABLE} "${CMAKE_CURRENT_SOURCE_DIR}/CMake/ShaderBuildCache.py" report "${KE_SHADER_CACHE_DIR}" --reset
+            COMMENT "Shader cache report"
+            USES_TERMINAL
+    )
+    set_target_properties(ShaderCacheReport PROPERTIES FOLDER "EngineTools")
+endif ()
+
+# Shared shader compilation step. Every shader target adds its ninja directory, and they are all built in parallel, with
+# a single job pool, rather than one nested ninja per target serialised by CMake.
+add_custom_target(ShaderCompilation
+        COMMAND ${Python3_EXECUTABLE} "${CMAKE_CURRENT_SOURCE_DIR}/CMake/ShaderBuildCache.py" build
+            "$<TARGET_PROPERTY:ShaderCompilation,KE_SHADER_BUILD_DIRS>"
+            --ninja "${CMAKE_MAKE_PROGRAM}"
+        COMMAND_EXPAND_LISTS
+        COMMENT "Shader Compilation"
+        USES_TERMINAL
+)
+set_target_properties(ShaderCompilation PROPERTIES FOLDER "EngineTools")
+
+add_custom_target(ShaderBuildBenchmark
+        COMMAND ${Python3_EXECUTABLE} "${CMAKE_CURRENT_SOURCE_DIR}/CMake/ShaderBuildCache.py" benchmark
+            "${CMAKE_BINARY_DIR}/ShaderBuild"
+            --ninja "${CMAKE_MAKE_PROGRAM}"
+        COMMENT "Shader build benchmark"
+        USES_TERMINAL
+)
+set_target_properties(ShaderBuildBenchmark PROPERTIES FOLDER "EngineTools")
+
 # target_compile_shaders implementation
 function(target_compile_shaders TARGET_NAME LOCAL_SHADERS_DIR OUTPUT_DIR_NAME)
     set(SHADER_OUTPUT_DIR "${CMAKE_BINARY_DIR}/Shaders")
@@ -111,18 +146,19 @@ function(target_compile_shaders TARGET_NAME LOCAL_SHADERS_DIR OUTPUT_DIR_NAME)
                 ${SHADER_INPUT_DIR}
                 ${BUILD_COMMAND_SCRIPT}
                 "${SHADER_INCLUDE_LIST}"
+                "${KE_SHADER_CACHE_DIR}"
                 ${ShaderListFiles}
             DEPENDS ${GENERATE_SCRIPT} ${ShaderListFiles}
             COMMENT "Parsing shader list"
     )
 
-    message(STATUS "${CMAKE_MAKE_PROGRAM}")
+    # Only generates the ninja file, the compilation itself is done by the shared `ShaderCompilation` target.
     add_custom_target(${TARGET_NAME}_ShaderCommands
-            COMMAND ${CMAKE_MAKE_PROGRAM}
-            WORKING_DIRECTORY ${WORKING_DIR}
             DEPENDS ${COMMANDS_FILE}
-            COMMENT "Shader Compilation [${TARGET_NAME}]"
+            COMMENT "Shader Commands [${TARGET_NAME}]"
     )
+    set_property(TARGET ShaderCompilation APPEND PROPERTY KE_SHADER_BUILD_DIRS "${WORKING_DIR}")
+    add_dependencies(ShaderCompilation ${TARGET_NAME}_ShaderCommands)
 
     get_target_property(folder ${TARGET_NAME} FOLDER)
     if (NOT folder STREQUAL "folder-NOTFOUND")
@@ -131,7 +167,7 @@ function(target_compile_shaders TARGET_NAME LOCAL_SHADERS_DIR OUTPUT_DIR_NAME)
 
     set_target_properties(${TARGET_NAME} PROPERTIES SET_UP_COMPILE_COMMANDS ON)
 
-    add_dependencies(${TARGET_NAME} ${TARGET_NAME}_ShaderCommands)
+    add_dependencies(${TARGET_NAME} ShaderCompilation)
 endfunction()
 
 # target_declare_shader_library implementation
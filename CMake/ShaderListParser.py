@@ -19,7 +19,8 @@ def main():
     shaders_dir = Path(sys.argv[6])
     python_script = Path(sys.argv[7])
     include_list = sys.argv[8]
-    shader_list_files = sys.argv[9:]
+    cache_dir = sys.argv[9]
+    shader_list_files = sys.argv[10:]
 
     working_dir = output_file.parent
 
@@ -60,6 +61,9 @@ def main():
         if "spirv-cross" in shader_tools:
             writer.variable(spirv_cross_path_name, os.path.relpath(shader_tools["spirv-cross"], working_dir))
 
+        cache_dir_name = "cache_dir"
+        writer.variable(cache_dir_name, cache_dir if cache_dir == "None" else os.path.relpath(cache_dir, working_dir))
+
         shader_input_dir_name = "input_dir"
         writer.variable(shader_input_dir_name, os.path.relpath(shaders_dir, working_dir))
 
@@ -81,7 +85,7 @@ def main():
         # base_command += "-Zi "
         # base_command += "-Qembed_debug "
 
-        command = f"${python_name} ${build_shader_script_name} $out {base_command}"
+        command = f"${python_name} ${build_shader_script_name} --cache-dir ${cache_dir_name} --input $in $out {base_command}"
 
         format_extension = ".cso"
         if compile_dxc_to_spirv:
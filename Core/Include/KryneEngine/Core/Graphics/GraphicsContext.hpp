@@ -38,6 +38,7 @@ namespace KryneEngine
     struct TextureMemoryBarrier;
     struct Viewport;
 
+    class FrameStatistics;
     class TracyGpuProfilerContext;
     class Window;
 
@@ -76,6 +77,12 @@ namespace KryneEngine
 
         [[nodiscard]] TracyGpuProfilerContext* GetProfilerContext() const { return m_profilerContext; }
 
+        /**
+         * @brief Sets the statistics to report frame timings to. The context doesn't take ownership.
+         */
+        void SetFrameStatistics(FrameStatistics* _frameStatistics) { m_frameStatistics = _frameStatistics; }
+        [[nodiscard]] FrameStatistics* GetFrameStatistics() const { return m_frameStatistics; }
+
     protected:
 
         GraphicsContext(
@@ -91,6 +98,7 @@ namespace KryneEngine
         u64 m_frameId;
 
         TracyGpuProfilerContext* m_profilerContext = nullptr;
+        FrameStatistics* m_frameStatistics = nullptr;
 
         virtual void InternalEndFrame() = 0;
         virtual void WaitForFrame(u64 _frameId) const = 0;
@@ -169,6 +177,20 @@ namespace KryneEngine
             const uint3& _regionOffset,
             const uint3& _regionSize) = 0;
 
+        /**
+         * @brief Copies multiple regions from a single buffer into a texture sub-resource.
+         *
+         * @details
+         * The regions are submitted as a single copy command on APIs supporting it (Vulkan), or as a tight sequence
+         * of copies within the same encoder otherwise.
+         */
+        virtual void SetTextureRegionsData(
+            CommandListHandle _commandList,
+            BufferHandle _srcBuffer,
+            TextureHandle _dstTexture,
+            const SubResourceIndexing& _subresourceIndex,
+            eastl::span<const TextureRegionCopy> _regions) = 0;
+
         virtual void MapBuffer(BufferMapping& _mapping) = 0;
         virtual void UnmapBuffer(BufferMapping& _mapping) = 0;
 
@@ -75,6 +75,21 @@ namespace KryneEngine
         SubResourceIndexing(): SubResourceIndexing({}, 0) {}
     };
 
+    /**
+     * @brief Describes a single region of a multi-region buffer to texture copy.
+     *
+     * @details
+     * The footprint describes the buffer layout of the region data, its `m_offset` field is ignored in favor of
+     * `m_bufferOffset`.
+     */
+    struct TextureRegionCopy
+    {
+        u64 m_bufferOffset;
+        TextureMemoryFootprint m_footprint;
+        uint3 m_regionOffset;
+        uint3 m_regionSize;
+    };
+
     struct SamplerDesc
     {
         enum class Filter: u8
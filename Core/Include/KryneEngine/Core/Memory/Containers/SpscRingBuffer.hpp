@@ -0,0 +1,118 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <EASTL/algorithm.h>
+#include <type_traits>
+
+#include "KryneEngine/Core/Common/Types.hpp"
+#include "KryneEngine/Core/Common/Utils/Alignment.hpp"
+#include "KryneEngine/Core/Memory/Allocators/Allocator.hpp"
+#include "KryneEngine/Core/Threads/HelperFunctions.hpp"
+
+namespace KryneEngine
+{
+    /**
+     * @brief A bounded, lock-free, single-producer single-consumer ring buffer.
+     *
+     * @details
+     * `TryPush()` must only be called from one producer thread, and `PopBatch()` from one consumer thread. Each side
+     * keeps a cached copy of the other side's index, so the shared indices are only read when the cached one says the
+     * buffer is full or empty.
+     */
+    template <class T>
+    class SpscRingBuffer
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Ring buffer elements are copied bitwise");
+
+    public:
+        /**
+         * @param _capacity The minimum element capacity, rounded up to the next power of two.
+         */
+        SpscRingBuffer(AllocatorInstance _allocator, u32 _capacity)
+            : m_allocator(_allocator)
+            , m_mask(static_cast<u32>(Alignment::NextPowerOfTwo(eastl::max(_capacity, 2u))) - 1)
+        {
+            m_data = m_allocator.Allocate<T>(GetCapacity());
+        }
+
+        ~SpscRingBuffer()
+        {
+            m_allocator.deallocate(m_data, GetCapacity() * sizeof(T));
+        }
+
+        SpscRingBuffer(const SpscRingBuffer&) = delete;
+        SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+        /**
+         * @brief Producer side. Returns false, without blocking, if the buffer is full.
+         */
+        [[nodiscard]] bool TryPush(const T& _value)
+        {
+            const u32 writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+            if (writeIndex - m_cachedReadIndex > m_mask)
+            {
+                m_cachedReadIndex = m_readIndex.load(std::memory_order_acquire);
+                if (writeIndex - m_cachedReadIndex > m_mask)
+                    return false;
+            }
+
+            m_data[writeIndex & m_mask] = _value;
+            m_writeIndex.store(writeIndex + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief Consumer side. Pops up to `_maxCount` elements in push order.
+         *
+         * @return The number of elements written to `_output`.
+         */
+        u32 PopBatch(T* _output, u32 _maxCount)
+        {
+            const u32 readIndex = m_readIndex.load(std::memory_order_relaxed);
+            if (m_cachedWriteIndex - readIndex < _maxCount)
+                m_cachedWriteIndex = m_writeIndex.load(std::memory_order_acquire);
+
+            const u32 count = eastl::min(m_cachedWriteIndex - readIndex, _maxCount);
+            if (count == 0)
+                return 0;
+
+            // At most two contiguous segments, as the batch may wrap around the end of the buffer.
+            const u32 start = readIndex & m_mask;
+            const u32 firstCount = eastl::min(count, GetCapacity() - start);
+            memcpy(_output, m_data + start, firstCount * sizeof(T));
+            memcpy(_output + firstCount, m_data, (count - firstCount) * sizeof(T));
+
+            m_readIndex.store(readIndex + count, std::memory_order_release);
+            return count;
+        }
+
+        [[nodiscard]] u32 GetCapacity() const { return m_mask + 1; }
+
+        /**
+         * @brief Number of elements in the buffer. Only exact when neither side is running.
+         */
+        [[nodiscard]] u32 GetApproximateSize() const
+        {
+            return m_writeIndex.load(std::memory_order_acquire) - m_readIndex.load(std::memory_order_acquire);
+        }
+
+    private:
+        AllocatorInstance m_allocator;
+        T* m_data = nullptr;
+        u32 m_mask;
+
+        // Producer cache line
+        alignas(Threads::kCacheLineSize) std::atomic<u32> m_writeIndex = 0;
+        u32 m_cachedReadIndex = 0;
+
+        // Consumer cache line
+        alignas(Threads::kCacheLineSize) std::atomic<u32> m_readIndex = 0;
+        u32 m_cachedWriteIndex = 0;
+    };
+} // KryneEngine
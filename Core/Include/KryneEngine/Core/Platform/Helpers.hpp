@@ -24,6 +24,7 @@ namespace KryneEngine::Platform
             AccessDenied,
             PathTooLong,
             SystemLimit,
+            Unsupported,
         };
 
         void* m_handle = nullptr;
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <EASTL/span.h>
+#include <EASTL/string.h>
 
 #include "KryneEngine/Core/Common/Types.hpp"
 #include "KryneEngine/Core/Math/Vector.hpp"
@@ -129,6 +130,126 @@ namespace KryneEngine::Platform
      */
     void CloseLocalIpcClient(LocalIpcClient _connection, AllocatorInstance _allocator);
 
+    /**
+     * @brief Opaque handle that represents a shared memory channel, set up over a local IPC connection.
+     *
+     * @details
+     * A channel is a pair of lock-free single-producer single-consumer byte rings in memory shared by both processes,
+     * one per direction. Data doesn't go through the kernel, and waiting sides are woken through futexes, so streaming
+     * large payloads costs no syscall as long as neither side has to wait.
+     * The socket connection is only used to pass the shared memory, and to detect the peer process exiting.
+     *
+     * Only a single thread per process may send, and a single one receive, on a channel at a given time.
+     * Channels are opt-in and only supported on Linux, other platforms return `OpaqueHandle::Error::Unsupported`.
+     */
+    struct LocalIpcChannel: OpaqueHandle {};
+
+    constexpr u32 kDefaultLocalIpcChannelCapacity = 4 * 1024 * 1024;
+
+    /**
+     * @brief Creates a shared memory channel with a connected client, and sends it over the connection.
+     *
+     * @param _capacity The byte capacity of each direction, rounded up to the next power of two.
+     */
+    LocalIpcChannel CreateLocalIpcChannel(
+        LocalIpcHost _connection,
+        AllocatorInstance _allocator,
+        u32 _capacity = kDefaultLocalIpcChannelCapacity,
+        u32 _clientIdx = 0);
+
+    /**
+     * @brief A blocking call to receive the shared memory channel created by the host with `CreateLocalIpcChannel()`.
+     */
+    LocalIpcChannel OpenLocalIpcChannel(LocalIpcClient _connection, AllocatorInstance _allocator);
+
+    /**
+     * @brief Receives data from a shared memory channel, blocking until some data is available.
+     *
+     * @return The number of bytes received. If value is 0, the channel was closed.
+     */
+    size_t ReceiveLocalIpc(LocalIpcChannel _channel, eastl::span<char> _buffer);
+
+    /**
+     * @brief Sends data through a shared memory channel, blocking until all of it was written.
+     *
+     * @return The number of bytes sent, which is only lower than the buffer size if the channel was closed.
+     */
+    size_t SendLocalIpc(LocalIpcChannel _channel, eastl::span<char> _buffer);
+
+    /**
+     * @brief Closes a shared memory channel, waking up the peer. The underlying connection is left open.
+     */
+    void CloseLocalIpcChannel(LocalIpcChannel _channel, AllocatorInstance _allocator);
+
+    /**
+     * @}
+     */
+
+    /**
+     * @defgroup Thread sampling methods
+     * @{
+     */
+
+    /**
+     * @brief Opaque handle to a thread registered for stack sampling.
+     */
+    struct ThreadSamplingTarget: OpaqueHandle {};
+
+    /**
+     * @brief Called while the sampled thread is interrupted, from a signal handler on POSIX platforms.
+     *
+     * @details
+     * It must be async-signal-safe: no allocation, no lock, only reads of atomics or plain data.
+     */
+    using ThreadSampleCallback = void (*)(void* _userData);
+
+    /**
+     * @brief Registers the calling thread as a target for `SampleThreadStack()`.
+     *
+     * @details
+     * On POSIX platforms, this unblocks `SIGPROF` for the calling thread, which is how it gets interrupted.
+     */
+    [[nodiscard]] ThreadSamplingTarget RegisterThreadForSampling(AllocatorInstance _allocator);
+
+    /**
+     * @brief Unregisters a thread. No sampling of this target may be in progress.
+     */
+    void UnregisterThreadForSampling(ThreadSamplingTarget _target, AllocatorInstance _allocator);
+
+    /**
+     * @brief Prepares the process for sampling, must be called before `SampleThreadStack()`.
+     *
+     * @details
+     * Calls are reference counted. On POSIX platforms, the first call installs the `SIGPROF` handler, and the matching
+     * `EndThreadSampling()` call restores the previous one.
+     */
+    bool BeginThreadSampling();
+    void EndThreadSampling();
+
+    /**
+     * @brief Interrupts a registered thread to capture its call stack.
+     *
+     * @details
+     * Only one sample is taken at a time process-wide, concurrent calls are serialized.
+     *
+     * @param _target The thread to sample, must not be the calling thread.
+     * @param _frames Receives the return addresses, innermost first.
+     * @param _callback If not null, called while the thread is interrupted, to capture state consistent with the stack.
+     * @return The number of captured frames, 0 if the thread couldn't be sampled.
+     */
+    u32 SampleThreadStack(
+        ThreadSamplingTarget _target,
+        eastl::span<uintptr_t> _frames,
+        ThreadSampleCallback _callback = nullptr,
+        void* _userData = nullptr);
+
+    /**
+     * @brief Resolves a code address to a demangled symbol name, or to `module+offset` when no symbol is found.
+     *
+     * @return `false` if the address couldn't be resolved at all.
+     */
+    bool ResolveSymbolName(uintptr_t _address, eastl::string& _name);
+
     /**
      * @}
      */
@@ -0,0 +1,243 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <EASTL/array.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+#include "KryneEngine/Core/Memory/Allocators/Allocator.hpp"
+#include "KryneEngine/Core/Profiling/MetricsRegistry.hpp"
+#include "KryneEngine/Core/Profiling/TracyHeader.hpp"
+#include "KryneEngine/Core/Threads/HelperFunctions.hpp"
+
+namespace KryneEngine
+{
+    /**
+     * @brief Tracks frame timings, their rolling distribution, and detects frame time spikes.
+     *
+     * @details
+     * Each frame is split in exclusive timings: `Cpu` holds all the time spent outside of an explicit phase, and
+     * nested phases pause their parent, so `Frame` is always the sum of the other timings. The graphics context marks
+     * the `Submit` phase around the end of the frame, and backends mark `PresentWait` while waiting on previous frames.
+     *
+     * A frame is a spike when it takes `m_spikeMedianRatio` times the rolling median frame time, and at least
+     * `m_spikeMinExcess` longer. Spikes are attributed to the frame zones (see `KE_FrameZoneScoped`) overlapping them,
+     * ranked by their overlapping duration.
+     *
+     * Phases and `EndFrame()` must be called from the thread ending frames, zones can be recorded from any thread.
+     */
+    class FrameStatistics
+    {
+    public:
+        enum class Timing: u8
+        {
+            Frame,
+            Cpu,
+            Submit,
+            PresentWait,
+            Count,
+        };
+        static constexpr u8 kTimingCount = static_cast<u8>(Timing::Count);
+
+        struct Settings
+        {
+            /// Number of frames kept for `GetFrame()` and `WriteHistoryJson()`.
+            u32 m_historySize = 512;
+
+            /// Number of frames used for the rolling statistics and spike detection, at most `m_historySize`.
+            u32 m_rollingWindow = 120;
+
+            /// Maximum number of zones recorded between two `EndFrame()` calls.
+            u32 m_zoneCapacity = 4096;
+
+            double m_spikeMedianRatio = 2.0;
+            u64 m_spikeMinExcess = 4'000'000;
+
+            /// If set, frame timings are also recorded in `frame/*` metrics.
+            MetricsRegistry* m_metrics = nullptr;
+
+            /// Returns the current time in nanoseconds. Uses a steady clock if null.
+            u64 (*m_clock)(void* _userData) = nullptr;
+            void* m_clockUserData = nullptr;
+        };
+
+        static constexpr u32 kMaxAttributedZones = 4;
+
+        struct ZoneAttribution
+        {
+            const char* m_name;
+            u32 m_count;
+            u64 m_duration;
+        };
+
+        struct FrameRecord
+        {
+            u64 m_frameId;
+            u64 m_endTime;
+            eastl::array<u64, kTimingCount> m_timings;
+            bool m_spike;
+            u8 m_attributedZoneCount;
+            eastl::array<ZoneAttribution, kMaxAttributedZones> m_attributedZones;
+
+            [[nodiscard]] u64 GetTiming(Timing _timing) const { return m_timings[static_cast<u8>(_timing)]; }
+        };
+
+        struct RollingStatistics
+        {
+            u64 m_p50;
+            u64 m_p95;
+            u64 m_p99;
+            u64 m_max;
+            u32 m_frameCount;
+        };
+
+        explicit FrameStatistics(AllocatorInstance _allocator, const Settings& _settings = {});
+        ~FrameStatistics();
+
+        FrameStatistics(const FrameStatistics&) = delete;
+        FrameStatistics& operator=(const FrameStatistics&) = delete;
+
+        [[nodiscard]] static FrameStatistics* GetInstance();
+        static void SetInstance(FrameStatistics* _instance);
+
+        [[nodiscard]] u64 GetTime() const;
+
+        void BeginPhase(Timing _phase);
+        void EndPhase(Timing _phase);
+
+        class ScopedPhase
+        {
+        public:
+            ScopedPhase(FrameStatistics* _statistics, const Timing _phase)
+                : m_statistics(_statistics)
+                , m_phase(_phase)
+            {
+                if (m_statistics != nullptr)
+                    m_statistics->BeginPhase(m_phase);
+            }
+
+            ~ScopedPhase()
+            {
+                if (m_statistics != nullptr)
+                    m_statistics->EndPhase(m_phase);
+            }
+
+            ScopedPhase(const ScopedPhase&) = delete;
+            ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+        private:
+            FrameStatistics* m_statistics;
+            Timing m_phase;
+        };
+
+        /**
+         * @brief Records a zone for spike attribution. Thread safe and lock-free.
+         *
+         * @param _name Zones are grouped by name pointer, so it should be a string literal.
+         */
+        void RecordZone(const char* _name, u64 _start, u64 _end);
+
+        /**
+         * @brief Records a zone on the statistics instance, if any.
+         */
+        class ScopedZone
+        {
+        public:
+            explicit ScopedZone(const char* _name)
+                : m_statistics(GetInstance())
+                , m_name(_name)
+                , m_start(m_statistics != nullptr ? m_statistics->GetTime() : 0)
+            {}
+
+            ~ScopedZone()
+            {
+                if (m_statistics != nullptr)
+                    m_statistics->RecordZone(m_name, m_start, m_statistics->GetTime());
+            }
+
+            ScopedZone(const ScopedZone&) = delete;
+            ScopedZone& operator=(const ScopedZone&) = delete;
+
+        private:
+            FrameStatistics* m_statistics;
+            const char* m_name;
+            u64 m_start;
+        };
+
+        /**
+         * @brief Closes the current frame, updates the rolling statistics and checks for a spike.
+         */
+        const FrameRecord& EndFrame(u64 _frameId);
+
+        [[nodiscard]] u32 GetFrameCount() const;
+
+        /**
+         * @param _age 0 for the last ended frame, up to `GetFrameCount() - 1`.
+         */
+        [[nodiscard]] const FrameRecord& GetFrame(u32 _age) const;
+
+        [[nodiscard]] RollingStatistics GetRollingStatistics(Timing _timing) const;
+
+        [[nodiscard]] u64 GetSpikeCount() const { return m_spikeCount; }
+        [[nodiscard]] u64 GetDroppedZoneCount() const { return m_droppedZoneCount; }
+
+        /**
+         * @brief Appends the frame history, oldest first, and the rolling statistics to a string, as a JSON object.
+         */
+        void WriteHistoryJson(eastl::string& _json) const;
+
+    private:
+        struct ZoneRecord
+        {
+            std::atomic<u64> m_sequence;
+            std::atomic<const char*> m_name;
+            std::atomic<u64> m_start;
+            std::atomic<u64> m_end;
+        };
+
+        AllocatorInstance m_allocator;
+        Settings m_settings;
+
+        eastl::vector<FrameRecord> m_history;
+        u64 m_frameCount = 0;
+        u64 m_spikeCount = 0;
+
+        eastl::array<Timing, kTimingCount> m_phaseStack;
+        u8 m_phaseDepth = 1;
+        u64 m_phaseStart;
+        u64 m_frameStart;
+        eastl::array<u64, kTimingCount> m_currentTimings {};
+
+        ZoneRecord* m_zones = nullptr;
+        alignas(Threads::kCacheLineSize) std::atomic<u64> m_zoneWriteIndex = 0;
+        alignas(Threads::kCacheLineSize) u64 m_zoneReadIndex = 0;
+        u64 m_droppedZoneCount = 0;
+
+        // Scratch storage, kept to avoid reallocating each frame
+        mutable eastl::vector<u64> m_sortedTimings;
+        eastl::vector<ZoneAttribution> m_frameZones;
+
+        eastl::array<MetricsHistogramId, kTimingCount> m_timingHistograms {};
+        MetricsCounterId m_spikeCounter {};
+
+        void AccumulatePhase(u64 _now);
+        void AttributeZones(FrameRecord& _record, u64 _frameStart, u64 _frameEnd);
+        void GatherRollingTimings(Timing _timing, u32 _skippedFrames) const;
+    };
+}
+
+#define KE_FRAME_ZONE_CONCAT_IMPL(a, b) a##b
+#define KE_FRAME_ZONE_CONCAT(a, b) KE_FRAME_ZONE_CONCAT_IMPL(a, b)
+
+/**
+ * @brief Opens a Tracy zone, and records it for frame spike attribution.
+ */
+#define KE_FrameZoneScoped(name) \
+    KE_ZoneScoped(name); \
+    const KryneEngine::FrameStatistics::ScopedZone KE_FRAME_ZONE_CONCAT(keFrameZone, __LINE__)(name)
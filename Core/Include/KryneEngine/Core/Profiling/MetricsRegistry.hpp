@@ -0,0 +1,238 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <EASTL/algorithm.h>
+#include <EASTL/span.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+#include "KryneEngine/Core/Common/BitUtils.hpp"
+#include "KryneEngine/Core/Memory/Allocators/Allocator.hpp"
+#include "KryneEngine/Core/Platform/Platform.hpp"
+#include "KryneEngine/Core/Threads/SpinLock.hpp"
+
+namespace KryneEngine
+{
+    struct MetricsCounterId { u32 m_slot = 0; };
+    struct MetricsGaugeId { u32 m_slot = 0; };
+    struct MetricsHistogramId { u32 m_slot = 0; };
+
+    /**
+     * @brief Aggregated metric values, as captured at the end of a frame.
+     *
+     * @details
+     * Entries are listed in registration order, and are only ever appended to, so indices are stable from one frame to
+     * the next.
+     */
+    struct MetricsSnapshot
+    {
+        struct Counter
+        {
+            eastl::string m_name;
+            u64 m_total;
+            u64 m_frameDelta;
+        };
+
+        struct Gauge
+        {
+            eastl::string m_name;
+            s64 m_value;
+        };
+
+        struct Histogram
+        {
+            eastl::string m_name;
+            u64 m_count;
+            u64 m_sum;
+            u64 m_frameCount;
+            u64 m_frameSum;
+            eastl::vector<u64> m_buckets;
+            eastl::vector<u64> m_frameBuckets;
+        };
+
+        u64 m_frameIndex = 0;
+        eastl::vector<Counter> m_counters;
+        eastl::vector<Gauge> m_gauges;
+        eastl::vector<Histogram> m_histograms;
+    };
+
+    /**
+     * @brief Named counters, gauges and latency histograms, cheap enough to be kept in final builds.
+     *
+     * @details
+     * Counters and histograms are sharded per thread: each shard is a cache line aligned block holding one slot per
+     * metric value, and each thread is assigned a shard on first use. Updates are single relaxed atomic additions, so
+     * they are wait-free, and only contend when more threads than shards update the same metric.
+     * Gauges hold a single value, and are not sharded.
+     *
+     * The slot capacity is fixed at construction, so updates never race with a reallocation. Registering past the
+     * capacity reports an error and returns an id writing to a discarded slot, so callers never need to check ids.
+     *
+     * Histograms are log-linear: values below `kHistogramSubBucketCount` get their own bucket, then each power of two
+     * is split in `kHistogramSubBucketCount` linear buckets, which bounds the relative error to 1/8th. Values are
+     * clamped to `kHistogramMaxValue`.
+     *
+     * Registration and `CaptureFrame()` are serialized with a lock, metric updates never take it.
+     */
+    class MetricsRegistry
+    {
+    public:
+        static constexpr u32 kDefaultSlotCapacity = 16 * 1024;
+        static constexpr u32 kMaxShardCount = 64;
+
+        static constexpr u32 kHistogramSubBucketBits = 3;
+        static constexpr u32 kHistogramSubBucketCount = 1u << kHistogramSubBucketBits;
+        static constexpr u32 kHistogramMaxValueBits = 48;
+        static constexpr u64 kHistogramMaxValue = (1ull << kHistogramMaxValueBits) - 1;
+        static constexpr u32 kHistogramBucketCount =
+            (kHistogramMaxValueBits - kHistogramSubBucketBits + 1) * kHistogramSubBucketCount;
+
+        /**
+         * @param _shardCount Rounded up to a power of two. 0 uses the hardware thread count.
+         */
+        explicit MetricsRegistry(
+            AllocatorInstance _allocator,
+            u32 _shardCount = 0,
+            u32 _slotCapacity = kDefaultSlotCapacity);
+        ~MetricsRegistry();
+
+        MetricsRegistry(const MetricsRegistry&) = delete;
+        MetricsRegistry& operator=(const MetricsRegistry&) = delete;
+
+        [[nodiscard]] static MetricsRegistry* GetInstance();
+        static void SetInstance(MetricsRegistry* _instance);
+
+        /**
+         * @brief Registers a metric, or returns the existing one with the same name.
+         */
+        [[nodiscard]] MetricsCounterId RegisterCounter(eastl::string_view _name);
+        [[nodiscard]] MetricsGaugeId RegisterGauge(eastl::string_view _name);
+        [[nodiscard]] MetricsHistogramId RegisterHistogram(eastl::string_view _name);
+
+        void Increment(MetricsCounterId _counter, u64 _value = 1)
+        {
+            GetSlot(GetCurrentShard(), _counter.m_slot).fetch_add(_value, std::memory_order_relaxed);
+        }
+
+        void SetGauge(MetricsGaugeId _gauge, s64 _value)
+        {
+            GetSlot(0, _gauge.m_slot).store(static_cast<u64>(_value), std::memory_order_relaxed);
+        }
+
+        void AddGauge(MetricsGaugeId _gauge, s64 _value)
+        {
+            GetSlot(0, _gauge.m_slot).fetch_add(static_cast<u64>(_value), std::memory_order_relaxed);
+        }
+
+        void Record(MetricsHistogramId _histogram, u64 _value)
+        {
+            const u32 shard = GetCurrentShard();
+            GetSlot(shard, _histogram.m_slot + GetHistogramBucket(_value)).fetch_add(1, std::memory_order_relaxed);
+            GetSlot(shard, _histogram.m_slot + kHistogramBucketCount).fetch_add(_value, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Aggregates all the shards, and computes the deltas since the previous capture.
+         *
+         * @details
+         * Concurrent updates land either in this frame or in the next one, none are lost.
+         * The returned snapshot is owned by the registry, and stays valid until the next capture.
+         */
+        const MetricsSnapshot& CaptureFrame(u64 _frameIndex);
+
+        [[nodiscard]] const MetricsSnapshot& GetLastSnapshot() const { return m_snapshot; }
+
+        [[nodiscard]] u32 GetShardCount() const { return m_shardMask + 1; }
+
+        [[nodiscard]] static u32 GetHistogramBucket(u64 _value)
+        {
+            if (_value < kHistogramSubBucketCount)
+                return static_cast<u32>(_value);
+
+            _value = eastl::min(_value, kHistogramMaxValue);
+            const u32 msb = BitUtils::GetMostSignificantBit(_value);
+            const u32 shift = msb - kHistogramSubBucketBits;
+            return (shift + 1) * kHistogramSubBucketCount
+                + static_cast<u32>((_value >> shift) & (kHistogramSubBucketCount - 1));
+        }
+
+        /**
+         * @return The smallest value falling in the bucket.
+         */
+        [[nodiscard]] static u64 GetHistogramBucketLowerBound(u32 _bucket);
+
+        /**
+         * @brief Estimates a percentile from histogram buckets.
+         *
+         * @param _percentile In [0, 1].
+         * @return The middle of the bucket holding the percentile, or 0 for an empty histogram.
+         */
+        [[nodiscard]] static u64 EstimatePercentile(eastl::span<const u64> _buckets, double _percentile);
+
+        /**
+         * @brief Appends the snapshot to a string, as a JSON object.
+         *
+         * @details
+         * Histograms are written with their count, sum and main percentiles, for both the whole run and the last frame,
+         * followed by their non-empty buckets as `[lowerBound, count]` pairs.
+         */
+        static void WriteJson(const MetricsSnapshot& _snapshot, eastl::string& _json);
+
+        /**
+         * @brief Sends the snapshot as JSON, prefixed by its size as a little endian u32.
+         *
+         * @return True if the whole message was sent.
+         */
+        static bool SendSnapshot(Platform::LocalIpcChannel _channel, const MetricsSnapshot& _snapshot);
+        static bool SendSnapshot(Platform::LocalIpcHost _connection, const MetricsSnapshot& _snapshot, u32 _clientIdx = 0);
+
+    private:
+        enum class MetricType: u8
+        {
+            Counter,
+            Gauge,
+            Histogram,
+        };
+
+        struct MetricInfo
+        {
+            eastl::string m_name;
+            MetricType m_type;
+            u32 m_slot;
+            u32 m_snapshotIndex;
+        };
+
+        AllocatorInstance m_allocator;
+        std::atomic<u64>* m_slots = nullptr;
+        u32 m_shardStride = 0;
+        u32 m_shardMask = 0;
+        u32 m_slotCapacity = 0;
+        u32 m_usedSlots = 0;
+
+        SpinLock m_lock {};
+        eastl::vector<MetricInfo> m_metrics;
+        MetricsSnapshot m_snapshot;
+
+        [[nodiscard]] std::atomic<u64>& GetSlot(u32 _shard, u32 _slot)
+        {
+            return m_slots[_shard * m_shardStride + _slot];
+        }
+
+        [[nodiscard]] u32 GetCurrentShard() const
+        {
+            static thread_local const u32 threadIndex = AssignThreadIndex();
+            return threadIndex & m_shardMask;
+        }
+
+        [[nodiscard]] static u32 AssignThreadIndex();
+
+        u32 RegisterMetric(eastl::string_view _name, MetricType _type);
+        [[nodiscard]] u64 SumShards(u32 _slot) const;
+    };
+}
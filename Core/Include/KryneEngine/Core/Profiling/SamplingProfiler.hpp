@@ -0,0 +1,107 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include <thread>
+
+#include "KryneEngine/Core/Memory/Allocators/Allocator.hpp"
+#include "KryneEngine/Core/Threads/SpinLock.hpp"
+
+namespace KryneEngine
+{
+    class FibersManager;
+
+    /**
+     * @brief Built-in sampling profiler for the fiber threads, which doesn't need Tracy nor any attached tool.
+     *
+     * @details
+     * A sampling thread periodically interrupts each fiber thread to capture its call stack, along with the job and
+     * fiber it was running. External profilers only see the worker threads, so their stacks mix all the jobs switched
+     * on them. Here each sample is attributed to the function of its `FiberJob` instead.
+     *
+     * Samples can be exported as folded stacks (one `frame;frame;... count` line per unique stack), which flame graph
+     * tools (flamegraph.pl, inferno, speedscope) read directly.
+     *
+     * The profiler must be stopped before the fibers manager is destroyed.
+     */
+    class SamplingProfiler
+    {
+    public:
+        struct Settings
+        {
+            u32 m_samplingIntervalUs = 1000;
+
+            /// Maximum depth of a captured stack.
+            u32 m_maxFrames = 64;
+
+            /// Total number of samples kept. Samples past this capacity are dropped.
+            u32 m_sampleCapacity = 64 * 1024;
+
+            /// Total number of frames kept, shared by all samples.
+            u32 m_frameCapacity = 2 * 1024 * 1024;
+        };
+
+        struct Sample
+        {
+            u64 m_time;
+            void (*m_jobFunction)(void*);
+            s32 m_fiberId;
+            u16 m_fiberThreadIndex;
+            u16 m_frameCount;
+            u32 m_firstFrame;
+        };
+
+        SamplingProfiler(AllocatorInstance _allocator, FibersManager* _fibersManager, const Settings& _settings = {});
+        ~SamplingProfiler();
+
+        SamplingProfiler(const SamplingProfiler&) = delete;
+        SamplingProfiler& operator=(const SamplingProfiler&) = delete;
+
+        bool Start();
+        void Stop();
+
+        [[nodiscard]] bool IsRunning() const { return m_running.load(std::memory_order_acquire); }
+
+        [[nodiscard]] u64 GetSampleCount() const;
+        [[nodiscard]] u64 GetDroppedSampleCount() const { return m_droppedSampleCount.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Copies the samples captured so far. Frames are stored innermost first, starting at `m_firstFrame`.
+         */
+        void CopySamples(eastl::vector<Sample>& _samples, eastl::vector<uintptr_t>& _frames) const;
+
+        void Clear();
+
+        /**
+         * @brief Appends the samples as folded stacks, rooted at the job function, or `[idle]` outside of jobs.
+         *
+         * @param _perFiberThread If true, stacks are rooted at their fiber thread instead.
+         */
+        void WriteFoldedStacks(eastl::string& _output, bool _perFiberThread = false) const;
+
+        bool SaveFoldedStacks(const char* _path, bool _perFiberThread = false) const;
+
+    private:
+        AllocatorInstance m_allocator;
+        FibersManager* m_fibersManager;
+        Settings m_settings;
+
+        std::thread m_thread;
+        std::atomic<bool> m_running = false;
+
+        mutable SpinLock m_samplesLock;
+        eastl::vector<Sample> m_samples;
+        eastl::vector<uintptr_t> m_frames;
+        std::atomic<u64> m_droppedSampleCount = 0;
+
+        void SamplingLoop();
+        void SampleFiberThread(u16 _index, eastl::vector<uintptr_t>& _scratch);
+    };
+}
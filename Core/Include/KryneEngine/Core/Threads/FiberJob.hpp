@@ -74,6 +74,7 @@ namespace KryneEngine
         friend class FiberThread;
         friend class FiberContext;
         friend class SyncCounterPool;
+        friend class SchedulerTelemetry;
 
     public:
         typedef void (JobFunc)(void*);
@@ -113,5 +114,9 @@ namespace KryneEngine
         FiberContext *m_context = nullptr;
 
         SyncCounterId m_associatedCounterId = kInvalidSyncCounterId;
+
+        // Scheduler telemetry, only written while it is enabled
+        u64 m_queueTime = 0;
+        std::atomic<u64> m_runTime = 0;
     };
 } // KryneEngine
\ No newline at end of file
@@ -6,9 +6,11 @@
 
 #pragma once
 
+#include <atomic>
 #include <condition_variable>
 #include <thread>
 #include "KryneEngine/Core/Common/Types.hpp"
+#include "KryneEngine/Core/Platform/Platform.hpp"
 
 namespace KryneEngine
 {
@@ -17,6 +19,8 @@ namespace KryneEngine
 
     class FiberThread
     {
+        friend class FibersManager;
+
     public:
         explicit FiberThread(FibersManager *_fiberManager, u16 _threadIndex);
 
@@ -30,11 +34,40 @@ namespace KryneEngine
 
         void Stop(std::condition_variable& _waitVariable);
 
+        /**
+         * @brief What the thread is running, updated on each context switch so samplers can attribute their samples.
+         *
+         * @details
+         * Fields are published separately, right after the switch. A sample taken during a switch may mix the previous
+         * and next jobs.
+         */
+        struct Activity
+        {
+            std::atomic<void (*)(void*)> m_jobFunction = nullptr;
+
+            /// Id of the fiber context running the job, -1 when running the base fiber.
+            std::atomic<s32> m_fiberId = -1;
+        };
+
+        [[nodiscard]] const Activity& GetActivity() const { return m_activity; }
+
+        /**
+         * @brief Returns the handle to sample this thread's stack, invalid until the thread started.
+         */
+        [[nodiscard]] Platform::ThreadSamplingTarget GetSamplingTarget() const;
+
+    protected:
+        void _PublishActivity(const FiberJob* _job);
+
     private:
         bool m_shouldStop = false;
         std::thread m_thread;
         eastl::string m_name;
 
+        Activity m_activity {};
+        Platform::ThreadSamplingTarget m_samplingTarget { Platform::OpaqueHandle { Platform::OpaqueHandle::Error::Unknown } };
+        std::atomic<bool> m_samplingTargetReady = false;
+
         static constexpr u32 kRetrieveSpinCountBeforeThreadWait = 50;
 
         static thread_local ThreadIndex sThreadIndex;
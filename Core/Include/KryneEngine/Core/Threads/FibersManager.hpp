@@ -11,6 +11,7 @@
 #include <KryneEngine/Core/Threads/FiberJob.hpp>
 #include <KryneEngine/Core/Threads/FiberThread.hpp>
 #include <KryneEngine/Core/Threads/FiberTls.hpp>
+#include <KryneEngine/Core/Threads/SchedulerTelemetry.hpp>
 #include <KryneEngine/Core/Threads/SyncCounterPool.hpp>
 
 #include "EASTL/span.h"
@@ -48,6 +49,7 @@ namespace KryneEngine
         }
 
         [[nodiscard]] u16 GetFiberThreadCount() const { return m_fiberThreads.Size(); }
+        [[nodiscard]] const FiberThread& GetFiberThread(u16 _index) const { return m_fiberThreads[_index]; }
 
         [[nodiscard]] FiberJob* GetCurrentJob();
 
@@ -129,6 +131,16 @@ namespace KryneEngine
 
         [[nodiscard]] IoQueryManager* GetIoQueryManager() const { return m_ioManager; }
 
+        /**
+         * @brief Scheduler statistics and tracing, disabled by default.
+         */
+        [[nodiscard]] SchedulerTelemetry& GetTelemetry() { return m_telemetry; }
+
+        /**
+         * @brief Captures the current queue depths and the per-worker telemetry.
+         */
+        void CaptureTelemetry(SchedulerTelemetry::Snapshot& _snapshot) const;
+
     protected:
 
         bool _RetrieveNextJob(Job&job_, u16 _fiberIndex);
@@ -158,6 +170,8 @@ namespace KryneEngine
 
         SyncCounterPool m_syncCounterPool {};
 
+        SchedulerTelemetry m_telemetry;
+
         std::mutex m_waitMutex;
         std::condition_variable m_waitVariable;
 
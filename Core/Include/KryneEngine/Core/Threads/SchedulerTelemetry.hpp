@@ -0,0 +1,203 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <EASTL/array.h>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+
+#include "KryneEngine/Core/Memory/DynamicArray.hpp"
+#include "KryneEngine/Core/Profiling/MetricsRegistry.hpp"
+#include "KryneEngine/Core/Threads/FiberJob.hpp"
+#include "KryneEngine/Core/Threads/HelperFunctions.hpp"
+
+namespace KryneEngine
+{
+    /**
+     * @brief Statistics and optional event trace of the fibers manager scheduling.
+     *
+     * @details
+     * Telemetry is disabled by default, and can be toggled at runtime. When disabled, each scheduling operation only pays
+     * for a relaxed load. When enabled, each fiber thread updates its own counters and histograms, without contention.
+     *
+     * Histograms share the `MetricsRegistry` bucket layout, so `MetricsRegistry::EstimatePercentile()` applies to them:
+     * - latency: from the first queueing of a job to its start, in nanoseconds.
+     * - duration: time spent running a job, excluding the time it spent paused, in nanoseconds.
+     * Only jobs queued while telemetry was enabled are recorded in the histograms.
+     *
+     * Tracing additionally records, per fiber thread, each time a job begins, yields, resumes or ends. The trace can be
+     * exported in the Chrome trace event format, to be opened in Perfetto or `chrome://tracing`.
+     */
+    class SchedulerTelemetry
+    {
+        friend class FibersManager;
+
+    public:
+        static constexpr u32 kDefaultTraceCapacity = 64 * 1024;
+        static constexpr u8 kQueueCount = FiberJob::PriorityType::kJobPriorityTypes;
+
+        struct WorkerCounters
+        {
+            u64 m_startedJobs;
+            u64 m_resumedJobs;
+            u64 m_finishedJobs;
+
+            /// Jobs switched out before finishing, either explicitly yielding or blocked on a sync counter.
+            u64 m_yields;
+
+            u64 m_fiberSwitches;
+            u64 m_counterWaits;
+
+            /// Counter waits which paused the job, as the counter wasn't reached yet.
+            u64 m_blockingCounterWaits;
+
+            /// Time spent running jobs, in nanoseconds.
+            u64 m_busyTime;
+
+            /// Time spent on the base fiber, looking or waiting for jobs, in nanoseconds.
+            u64 m_idleTime;
+        };
+
+        struct WorkerSnapshot
+        {
+            WorkerCounters m_counters;
+            eastl::vector<u64> m_latencyBuckets;
+            eastl::vector<u64> m_durationBuckets;
+        };
+
+        struct Snapshot
+        {
+            /// Approximate job count of each queue, indexed by `u8(FiberJob::PriorityType)`.
+            eastl::array<u64, kQueueCount> m_queueDepths;
+
+            /// Jobs queued for the first time, from any thread.
+            u64 m_queuedJobs;
+
+            /// Counter waits from threads other than the fiber threads.
+            u64 m_externalCounterWaits;
+
+            eastl::vector<WorkerSnapshot> m_workers;
+
+            [[nodiscard]] WorkerCounters GetTotalCounters() const;
+        };
+
+        explicit SchedulerTelemetry(AllocatorInstance _allocator);
+        ~SchedulerTelemetry();
+
+        SchedulerTelemetry(const SchedulerTelemetry&) = delete;
+        SchedulerTelemetry& operator=(const SchedulerTelemetry&) = delete;
+
+        void SetEnabled(bool _enabled);
+        [[nodiscard]] bool IsEnabled() const { return m_enabled.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Toggles event tracing, which only records while telemetry is also enabled.
+         *
+         * @param _eventCapacity Number of events kept per fiber thread, only used when first enabling tracing. Events
+         *                       past this capacity are dropped.
+         */
+        void SetTracingEnabled(bool _enabled, u32 _eventCapacity = kDefaultTraceCapacity);
+        [[nodiscard]] bool IsTracingEnabled() const { return m_tracingEnabled.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Clears all statistics and trace events. Must not be called while telemetry is enabled.
+         */
+        void Reset();
+
+        void CaptureWorkers(Snapshot& _snapshot) const;
+
+        [[nodiscard]] u64 GetDroppedTraceEventCount() const;
+
+        /**
+         * @brief Appends the trace events to a string, in the Chrome trace event JSON format.
+         *
+         * @details
+         * Should be called with tracing disabled, to get a consistent trace. Job functions are named from their symbols.
+         */
+        void WriteChromeTrace(eastl::string& _json) const;
+
+    protected:
+        void _Init(u16 _fiberThreadCount);
+
+        void _OnJobQueued(FiberJob* _job)
+        {
+            if (IsEnabled()) [[unlikely]]
+            {
+                _RecordJobQueued(_job);
+            }
+        }
+
+        void _OnContextSwitched(u16 _fiberIndex, FiberJob* _oldJob, FiberJob* _newJob)
+        {
+            if (IsEnabled()) [[unlikely]]
+            {
+                _RecordContextSwitch(_fiberIndex, _oldJob, _newJob);
+            }
+        }
+
+        void _OnCounterWait(bool _isFiberThread, u16 _fiberIndex, bool _blocking);
+
+    private:
+        enum class TraceEventType: u8
+        {
+            Begin,
+            Resume,
+            Yield,
+            End,
+        };
+
+        struct TraceEvent
+        {
+            u64 m_time;
+            FiberJob::JobFunc* m_function;
+            s32 m_fiberId;
+            TraceEventType m_type;
+        };
+
+        using Histogram = eastl::array<std::atomic<u64>, MetricsRegistry::kHistogramBucketCount>;
+
+        // Only written by its fiber thread, so updates are plain relaxed load and stores.
+        struct alignas(Threads::kCacheLineSize) Worker
+        {
+            std::atomic<u64> m_startedJobs = 0;
+            std::atomic<u64> m_resumedJobs = 0;
+            std::atomic<u64> m_finishedJobs = 0;
+            std::atomic<u64> m_yields = 0;
+            std::atomic<u64> m_fiberSwitches = 0;
+            std::atomic<u64> m_counterWaits = 0;
+            std::atomic<u64> m_blockingCounterWaits = 0;
+            std::atomic<u64> m_busyTime = 0;
+            std::atomic<u64> m_idleTime = 0;
+
+            Histogram m_latency {};
+            Histogram m_duration {};
+
+            u64 m_segmentStart = 0;
+
+            TraceEvent* m_traceEvents = nullptr;
+            std::atomic<u32> m_traceEventCount = 0;
+            std::atomic<u64> m_droppedTraceEvents = 0;
+        };
+
+        DynamicArray<Worker> m_workers;
+        u32 m_traceCapacity = 0;
+
+        std::atomic<bool> m_enabled = false;
+        std::atomic<bool> m_tracingEnabled = false;
+        std::atomic<u64> m_enableTime = 0;
+
+        alignas(Threads::kCacheLineSize) std::atomic<u64> m_queuedJobs = 0;
+        std::atomic<u64> m_externalCounterWaits = 0;
+
+        [[nodiscard]] static u64 GetTime();
+
+        void _RecordJobQueued(FiberJob* _job);
+        void _RecordContextSwitch(u16 _fiberIndex, FiberJob* _oldJob, FiberJob* _newJob);
+        void PushTraceEvent(Worker& _worker, const TraceEvent& _event) const;
+    };
+}
@@ -0,0 +1,44 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include "KryneEngine/Core/Window/Input/KeyInputEvent.hpp"
+#include "KryneEngine/Core/Window/Input/MouseInputEvent.hpp"
+
+namespace KryneEngine
+{
+    /**
+     * @brief A buffered input event, as stored in the InputManager event queue.
+     */
+    struct InputEvent
+    {
+        enum class Type: u8
+        {
+            Key,
+            Text,
+            CursorPos,
+            MouseButton,
+            Scroll,
+        };
+
+        struct Axes
+        {
+            float m_x;
+            float m_y;
+        };
+
+        Type m_type;
+        union
+        {
+            KeyInputEvent m_key;
+            u32 m_char;
+            Axes m_cursorPos;
+            MouseInputEvent m_mouseButton;
+            Axes m_scroll;
+        };
+    };
+}
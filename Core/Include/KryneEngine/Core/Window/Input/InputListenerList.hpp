@@ -0,0 +1,137 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <EASTL/algorithm.h>
+#include <EASTL/functional.h>
+#include <EASTL/vector.h>
+
+#include "KryneEngine/Core/Memory/Allocators/Allocator.hpp"
+#include "KryneEngine/Core/Threads/LightweightMutex.hpp"
+
+namespace KryneEngine
+{
+    /**
+     * @brief A copy-on-write list of input callbacks.
+     *
+     * @details
+     * Registration copies the current listener list and publishes the new one atomically, serialized with a mutex.
+     * `Dispatch()` only loads the current list and never locks, so callbacks are free to register or unregister
+     * listeners, including themselves.
+     *
+     * Replaced lists are retired rather than freed, as a dispatch may still be iterating over them. They are released by
+     * `ReclaimRetired()`, which must be called from the dispatching thread, outside of any dispatch.
+     */
+    template <class... Args>
+    class InputListenerList
+    {
+    public:
+        using Callback = eastl::function<void(Args...)>;
+
+        explicit InputListenerList(AllocatorInstance _allocator)
+            : m_allocator(_allocator)
+        {
+            m_current.store(m_allocator.New<Snapshot>(_allocator), std::memory_order_relaxed);
+        }
+
+        ~InputListenerList()
+        {
+            ReclaimRetired();
+            m_allocator.Delete(m_current.load(std::memory_order_relaxed));
+        }
+
+        InputListenerList(const InputListenerList&) = delete;
+        InputListenerList& operator=(const InputListenerList&) = delete;
+
+        [[nodiscard]] u32 Register(Callback&& _callback)
+        {
+            const auto lock = m_writeMutex.AutoLock();
+
+            const u32 id = m_counter++;
+            Snapshot* snapshot = m_allocator.New<Snapshot>(*m_current.load(std::memory_order_relaxed));
+            snapshot->m_listeners.push_back({ id, eastl::move(_callback) });
+            Publish(snapshot);
+            return id;
+        }
+
+        void Unregister(u32 _id)
+        {
+            const auto lock = m_writeMutex.AutoLock();
+
+            const Snapshot* current = m_current.load(std::memory_order_relaxed);
+            const auto it = eastl::find_if(
+                current->m_listeners.begin(),
+                current->m_listeners.end(),
+                [_id](const Listener& _listener) { return _listener.m_id == _id; });
+            if (it == current->m_listeners.end())
+                return;
+
+            Snapshot* snapshot = m_allocator.New<Snapshot>(*current);
+            snapshot->m_listeners.erase(snapshot->m_listeners.begin() + (it - current->m_listeners.begin()));
+            Publish(snapshot);
+        }
+
+        void Dispatch(Args... _args) const
+        {
+            const Snapshot* snapshot = m_current.load(std::memory_order_acquire);
+            for (const Listener& listener: snapshot->m_listeners)
+                listener.m_callback(_args...);
+        }
+
+        [[nodiscard]] bool IsEmpty() const
+        {
+            return m_current.load(std::memory_order_acquire)->m_listeners.empty();
+        }
+
+        void ReclaimRetired()
+        {
+            Snapshot* snapshot = m_retired.exchange(nullptr, std::memory_order_acquire);
+            while (snapshot != nullptr)
+            {
+                Snapshot* next = snapshot->m_nextRetired;
+                m_allocator.Delete(snapshot);
+                snapshot = next;
+            }
+        }
+
+    private:
+        struct Listener
+        {
+            u32 m_id;
+            Callback m_callback;
+        };
+
+        struct Snapshot
+        {
+            explicit Snapshot(AllocatorInstance _allocator): m_listeners(_allocator) {}
+            Snapshot(const Snapshot& _other): m_listeners(_other.m_listeners) {}
+
+            eastl::vector<Listener> m_listeners;
+            Snapshot* m_nextRetired = nullptr;
+        };
+
+        AllocatorInstance m_allocator;
+        std::atomic<Snapshot*> m_current;
+        std::atomic<Snapshot*> m_retired = nullptr;
+        LightweightMutex m_writeMutex;
+        u32 m_counter = 0;
+
+        void Publish(Snapshot* _snapshot)
+        {
+            Snapshot* previous = m_current.exchange(_snapshot, std::memory_order_acq_rel);
+
+            previous->m_nextRetired = m_retired.load(std::memory_order_relaxed);
+            while (!m_retired.compare_exchange_weak(
+                previous->m_nextRetired,
+                previous,
+                std::memory_order_release,
+                std::memory_order_relaxed))
+            {}
+        }
+    };
+} // KryneEngine
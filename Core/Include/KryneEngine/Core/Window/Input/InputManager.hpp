@@ -6,12 +6,12 @@
 
 #pragma once
 
-#include <EASTL/vector_map.h>
+#include <atomic>
 
 #include "KryneEngine/Core/Math/Vector.hpp"
-#include "KryneEngine/Core/Threads/LightweightMutex.hpp"
-#include "KryneEngine/Core/Window/Input/KeyInputEvent.hpp"
-#include "KryneEngine/Core/Window/Input/MouseInputEvent.hpp"
+#include "KryneEngine/Core/Memory/Containers/SpscRingBuffer.hpp"
+#include "KryneEngine/Core/Window/Input/InputEvent.hpp"
+#include "KryneEngine/Core/Window/Input/InputListenerList.hpp"
 
 struct GLFWwindow;
 
@@ -19,10 +19,26 @@ namespace KryneEngine
 {
     class Window;
 
+    /**
+     * @brief Buffers the window input events and dispatches them to the registered callbacks.
+     *
+     * @details
+     * Platform callbacks only push the events to a lock-free single-producer ring. The events are then dispatched in
+     * batches by `DispatchEvents()`, which the window calls once per frame after polling. Callback lists are
+     * copy-on-write, so dispatching never locks, even while callbacks are being registered from other threads.
+     *
+     * Events are dropped when the ring is full, see `GetDroppedEventCount()`.
+     */
     class InputManager
     {
     public:
-        InputManager(Window* _window, AllocatorInstance _allocator);
+        static constexpr u32 kDefaultEventQueueCapacity = 4096;
+
+        /**
+         * @param _window The window to receive the events from. May be null, in which case the events are only pushed
+         * through `PushEvent()`.
+         */
+        InputManager(Window* _window, AllocatorInstance _allocator, u32 _eventQueueCapacity = kDefaultEventQueueCapacity);
 
         [[nodiscard]] u32 RegisterKeyInputEventCallback(eastl::function<void(const KeyInputEvent&)>&& _callback);
         void UnregisterKeyInputEventCallback(u32 _id);
@@ -32,6 +48,9 @@ namespace KryneEngine
 
         [[nodiscard]] u32 RegisterCursorPosEventCallback(eastl::function<void(float, float)>&& _callback);
         void UnregisterCursorPosEventCallback(u32 _id);
+        /**
+         * @brief Cursor position as of the last dispatched cursor event. Must be read from the dispatching thread.
+         */
         [[nodiscard]] const float2& GetCursorPos() const { return m_cursorPos; }
 
         [[nodiscard]] u32 RegisterMouseInputEventCallback(eastl::function<void(const MouseInputEvent&)>&& _callback);
@@ -40,28 +59,52 @@ namespace KryneEngine
         [[nodiscard]] u32 RegisterScrollInputEventCallback(eastl::function<void(float, float)>&& _callback);
         void UnregisterScrollInputEventCallback(u32 _id);
 
+        /**
+         * @brief Queues an event for the next dispatch. Must always be called from the same thread.
+         *
+         * @return False if the queue was full and the event was dropped.
+         */
+        bool PushEvent(const InputEvent& _event);
+
+        /**
+         * @brief Same as `PushEvent()`, but a full queue isn't counted as a dropped event, so the caller can retry.
+         */
+        bool TryPushEvent(const InputEvent& _event);
+
+        /**
+         * @brief Dispatches all the queued events to the registered callbacks, in push order.
+         *
+         * @details
+         * Must always be called from the same thread. Events pushed while dispatching are left for the next call.
+         *
+         * @return The number of dispatched events.
+         */
+        u32 DispatchEvents();
+
+        [[nodiscard]] u64 GetDroppedEventCount() const { return m_droppedEventCount.load(std::memory_order_relaxed); }
+
     protected:
-        LightweightMutex m_mutex;
+        static constexpr u32 kDispatchBatchSize = 256;
+
+        SpscRingBuffer<InputEvent> m_eventQueue;
+        std::atomic<u64> m_droppedEventCount = 0;
 
         static void KeyCallback(GLFWwindow* _window, s32 _key, s32 _scancode, s32 _action, s32 _mods);
-        eastl::vector_map<u32, eastl::function<void(const KeyInputEvent&)>> m_keyInputEventListeners;
-        u32 m_keyInputEventCounter { 0 };
+        InputListenerList<const KeyInputEvent&> m_keyInputEventListeners;
 
         static void TextCallback(GLFWwindow* _window, u32 _char);
-        eastl::vector_map<u32, eastl::function<void(u32)>> m_textInputEventListeners;
-        u32 m_textInputEventCounter { 0 };
+        InputListenerList<u32> m_textInputEventListeners;
 
         static void CursorPosCallback(GLFWwindow* _window, double _posX, double _posY);
-        eastl::vector_map<u32, eastl::function<void(float, float)>> m_cursorPosEventListeners;
-        u32 m_cursorPosEventCounter = 0;
-        float2 m_cursorPos;
+        InputListenerList<float, float> m_cursorPosEventListeners;
+        float2 m_cursorPos { 0.f, 0.f };
 
         static void MouseButtonInputCallback(GLFWwindow* _window, s32 _button, s32 _action, s32 _mods);
-        eastl::vector_map<u32, eastl::function<void(const MouseInputEvent&)>> m_mouseInputEventListeners;
-        u32 m_mouseInputEventCounter = 0;
+        InputListenerList<const MouseInputEvent&> m_mouseInputEventListeners;
 
         static void ScrollCallback(GLFWwindow* _window, double _xScroll, double _yScroll);
-        eastl::vector_map<u32, eastl::function<void(float, float)>> m_scrollInputEventListeners;
-        u32 m_scrollInputEventCounter = 0;
+        InputListenerList<float, float> m_scrollInputEventListeners;
+
+        void Dispatch(const InputEvent& _event);
     };
 } // namespace KryneEngine
\ No newline at end of file
@@ -20,6 +20,7 @@
 #include "KryneEngine/Core/Graphics/Drawing.hpp"
 #include "KryneEngine/Core/Math/Color.hpp"
 #include "KryneEngine/Core/Memory/GenerationalPool.inl"
+#include "KryneEngine/Core/Profiling/FrameStatistics.hpp"
 #include "KryneEngine/Core/Window/Window.hpp"
 
 namespace KryneEngine
@@ -257,7 +258,10 @@ namespace KryneEngine
         const u8 nextFrameIndex = (m_frameId + 1) % m_frameContextCount;
 
         // Wait for the previous frame with this index.
-        WaitForFrame(m_frameContexts[nextFrameIndex].m_frameId);
+        {
+            const FrameStatistics::ScopedPhase waitPhase(m_frameStatistics, FrameStatistics::Timing::PresentWait);
+            WaitForFrame(m_frameContexts[nextFrameIndex].m_frameId);
+        }
 
         m_resources.FlushPools();
 
@@ -984,6 +988,32 @@ namespace KryneEngine
             &box);
     }
 
+    void Dx12GraphicsContext::SetTextureRegionsData(
+        CommandListHandle _commandList,
+        BufferHandle _srcBuffer,
+        TextureHandle _dstTexture,
+        const SubResourceIndexing& _subresourceIndex,
+        const eastl::span<const TextureRegionCopy> _regions)
+    {
+        KE_ZoneScopedFunction("Dx12GraphicsContext::SetTextureRegionsData");
+
+        // D3D12 has no multi-region buffer to texture copy, record the copies back to back.
+        for (const TextureRegionCopy& region : _regions)
+        {
+            const u64 size = static_cast<u64>(region.m_footprint.m_lineByteAlignedSize)
+                * region.m_footprint.m_height
+                * region.m_footprint.m_depth;
+            SetTextureRegionData(
+                _commandList,
+                { .m_size = size, .m_offset = region.m_bufferOffset, .m_buffer = _srcBuffer },
+                _dstTexture,
+                region.m_footprint,
+                _subresourceIndex,
+                region.m_regionOffset,
+                region.m_regionSize);
+        }
+    }
+
     void Dx12GraphicsContext::MapBuffer(BufferMapping& _mapping)
     {
         KE_ZoneScopedFunction("Dx12GraphicsContext::MapBuffer");
@@ -8,6 +8,7 @@
 
 #include "KryneEngine/Core/Graphics/EnumHelpers.hpp"
 #include "KryneEngine/Core/Graphics/ResourceViews/TextureView.hpp"
+#include "KryneEngine/Core/Profiling/FrameStatistics.hpp"
 #include "KryneEngine/Core/Profiling/TracyGpuProfilerContext.hpp"
 #include "KryneEngine/Core/Window/Window.hpp"
 
@@ -56,7 +57,14 @@ namespace KryneEngine
 
     bool GraphicsContext::EndFrame()
     {
-        InternalEndFrame();
+        {
+            const FrameStatistics::ScopedPhase submitPhase(m_frameStatistics, FrameStatistics::Timing::Submit);
+            InternalEndFrame();
+        }
+        if (m_frameStatistics != nullptr)
+        {
+            m_frameStatistics->EndFrame(m_frameId);
+        }
         m_frameId++;
         if (m_window == nullptr)
         {
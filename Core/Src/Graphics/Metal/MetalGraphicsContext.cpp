@@ -12,6 +12,7 @@
 #include "KryneEngine/Core/Graphics/Drawing.hpp"
 #include "KryneEngine/Core/Graphics/GraphicsContext.hpp"
 #include "KryneEngine/Core/Memory/GenerationalPool.inl"
+#include "KryneEngine/Core/Profiling/FrameStatistics.hpp"
 #include "KryneEngine/Core/Profiling/TracyHeader.hpp"
 #include "KryneEngine/Core/Profiling/TracyGpuProfilerContext.hpp"
 
@@ -113,7 +114,10 @@ namespace KryneEngine
             if (nextFrame >= m_frameContextCount + kInitialFrameId)
             {
                 const u64 previousFrameId = nextFrame - m_frameContextCount;
-                m_frameContexts[newFrameIndex].WaitForFrame(previousFrameId);
+                {
+                    const FrameStatistics::ScopedPhase waitPhase(m_frameStatistics, FrameStatistics::Timing::PresentWait);
+                    m_frameContexts[newFrameIndex].WaitForFrame(previousFrameId);
+                }
 
                 m_frameContexts[newFrameIndex].ResolveCounters(m_timestampConversion);
                 m_lastResolvedFrameId = previousFrameId;
@@ -484,6 +488,32 @@ namespace KryneEngine
             { _regionOffset.x, _regionOffset.y, _regionOffset.z });
     }
 
+    void MetalGraphicsContext::SetTextureRegionsData(
+        CommandListHandle _commandList,
+        BufferHandle _srcBuffer,
+        TextureHandle _dstTexture,
+        const SubResourceIndexing& _subresourceIndex,
+        const eastl::span<const TextureRegionCopy> _regions)
+    {
+        KE_ZoneScopedFunction("MetalGraphicsContext::SetTextureRegionsData");
+
+        // Metal has no multi-region buffer to texture copy. All copies are recorded on the same blit encoder.
+        for (const TextureRegionCopy& region : _regions)
+        {
+            const u64 size = static_cast<u64>(region.m_footprint.m_lineByteAlignedSize)
+                * region.m_footprint.m_height
+                * region.m_footprint.m_depth;
+            SetTextureRegionData(
+                _commandList,
+                { .m_size = size, .m_offset = region.m_bufferOffset, .m_buffer = _srcBuffer },
+                _dstTexture,
+                region.m_footprint,
+                _subresourceIndex,
+                region.m_regionOffset,
+                region.m_regionSize);
+        }
+    }
+
     void MetalGraphicsContext::MapBuffer(BufferMapping& _mapping)
     {
         MTL::Buffer* buffer = m_resources.m_buffers.Get(_mapping.m_buffer.m_handle)->m_buffer;
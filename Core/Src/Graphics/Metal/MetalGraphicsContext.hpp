@@ -136,6 +136,12 @@ namespace KryneEngine
             const SubResourceIndexing& _subresourceIndex,
             const uint3& _regionOffset,
             const uint3& _regionSize) override;
+        void SetTextureRegionsData(
+            CommandListHandle _commandList,
+            BufferHandle _srcBuffer,
+            TextureHandle _dstTexture,
+            const SubResourceIndexing& _subresourceIndex,
+            eastl::span<const TextureRegionCopy> _regions) override;
 
         void MapBuffer(BufferMapping& _mapping) override;
         void UnmapBuffer(BufferMapping& _mapping) override;
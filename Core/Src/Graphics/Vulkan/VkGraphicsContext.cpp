@@ -21,6 +21,7 @@
 #include "KryneEngine/Core/Graphics/Drawing.hpp"
 #include "KryneEngine/Core/Math/Color.hpp"
 #include "KryneEngine/Core/Memory/GenerationalPool.inl"
+#include "KryneEngine/Core/Profiling/FrameStatistics.hpp"
 #include "KryneEngine/Core/Profiling/TracyGpuProfilerContext.hpp"
 #include "KryneEngine/Core/Window/Window.hpp"
 #if defined(WIN32)
@@ -398,7 +399,10 @@ namespace KryneEngine
         VkFrameContext& nextFrameContext = m_frameContexts[nextFrameContextIndex];
         if (nextFrameId >= m_frameContextCount)
         {
-            nextFrameContext.WaitForFences(m_device, nextFrameId - m_frameContextCount);
+            {
+                const FrameStatistics::ScopedPhase waitPhase(m_frameStatistics, FrameStatistics::Timing::PresentWait);
+                nextFrameContext.WaitForFences(m_device, nextFrameId - m_frameContextCount);
+            }
             nextFrameContext.m_graphicsCommandPoolSet.Reset();
             nextFrameContext.m_computeCommandPoolSet.Reset();
             nextFrameContext.m_transferCommandPoolSet.Reset();
@@ -1261,6 +1265,57 @@ namespace KryneEngine
             &region);
     }
 
+    void VkGraphicsContext::SetTextureRegionsData(
+        CommandListHandle _commandList,
+        BufferHandle _srcBuffer,
+        TextureHandle _dstTexture,
+        const SubResourceIndexing& _subresourceIndex,
+        const eastl::span<const TextureRegionCopy> _regions)
+    {
+        KE_ZoneScopedFunction("VkGraphicsContext::SetTextureRegionsData");
+
+        if (_regions.empty())
+            return;
+
+        VkBuffer* srcBuffer = m_resources.m_buffers.Get(_srcBuffer.m_handle);
+        VkImage* dstTexture = m_resources.m_textures.Get(_dstTexture.m_handle);
+
+        KE_ASSERT(srcBuffer != nullptr && dstTexture != nullptr);
+
+        eastl::vector<VkBufferImageCopy> vkRegions(m_allocator);
+        vkRegions.reserve(_regions.size());
+        for (const TextureRegionCopy& region : _regions)
+        {
+            const TextureMemoryFootprint& footprint = region.m_footprint;
+            vkRegions.push_back({
+                .bufferOffset = region.m_bufferOffset,
+                // Only mark as tightly packed if the pixel element size is greater or equal to optimal alignment.
+                .bufferRowLength = GetByteSizePerBlock(ToVkFormat(footprint.m_format)) < footprint.m_rowPitchAlignment ? footprint.m_lineByteAlignedSize : 0,
+                .bufferImageHeight = 0, // Set entry to 0 to mark data as tightly packed.
+                .imageSubresource = {
+                    .aspectMask = RetrieveAspectMask(_subresourceIndex.m_planeSlice),
+                    .mipLevel = _subresourceIndex.m_mipIndex,
+                    .baseArrayLayer = _subresourceIndex.m_arraySlice,
+                    .layerCount = 1,
+                },
+                .imageOffset = {
+                    static_cast<s32>(region.m_regionOffset.x),
+                    static_cast<s32>(region.m_regionOffset.y),
+                    static_cast<s32>(region.m_regionOffset.z)
+                },
+                .imageExtent = { region.m_regionSize.x, region.m_regionSize.y, region.m_regionSize.z },
+            });
+        }
+
+        vkCmdCopyBufferToImage(
+            static_cast<CommandList>(_commandList),
+            *srcBuffer,
+            *dstTexture,
+            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+            static_cast<u32>(vkRegions.size()),
+            vkRegions.data());
+    }
+
     void VkGraphicsContext::MapBuffer(BufferMapping& _mapping)
     {
         KE_ZoneScopedFunction("VkGraphicsContext::MapBuffer");
@@ -0,0 +1,257 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Core/Platform/Platform.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <EASTL/algorithm.h>
+#include <execinfo.h>
+#include <mutex>
+#include <pthread.h>
+#include <thread>
+#include <sys/ucontext.h>
+
+#include "KryneEngine/Core/Common/Assert.hpp"
+
+namespace KryneEngine::Platform
+{
+    namespace
+    {
+        enum class SampleState: u32
+        {
+            Idle,
+            Requested,
+            Capturing,
+            Done,
+        };
+
+        struct DarwinThreadSamplingTarget
+        {
+            pthread_t m_thread {};
+            std::atomic<SampleState> m_state = SampleState::Idle;
+
+            // Request parameters, only accessed by the handler between `Requested` and `Done`
+            uintptr_t* m_frames = nullptr;
+            u32 m_maxFrames = 0;
+            u32 m_frameCount = 0;
+            ThreadSampleCallback m_callback = nullptr;
+            void* m_userData = nullptr;
+        };
+
+        static_assert(sizeof(uintptr_t) == sizeof(void*));
+
+        constexpr auto kSampleTimeout = std::chrono::milliseconds(20);
+
+        // The signal frame is usually found right after the handler frame
+        constexpr s32 kMaxHandlerFrames = 4;
+        constexpr s32 kDefaultHandlerFrames = 2;
+
+        std::atomic<DarwinThreadSamplingTarget*> g_pendingSample = nullptr;
+
+        // Serializes samples, and guards the handler installation
+        std::mutex g_samplingMutex;
+        u32 g_samplingUsers = 0;
+        struct sigaction g_previousAction {};
+
+        uintptr_t GetInterruptedAddress(const void* _context)
+        {
+            const auto* context = static_cast<const ucontext_t*>(_context);
+#if defined(__x86_64__)
+            return static_cast<uintptr_t>(context->uc_mcontext->__ss.__rip);
+#elif defined(__arm64__)
+            return static_cast<uintptr_t>(__darwin_arm_thread_state64_get_pc(context->uc_mcontext->__ss));
+#else
+            (void)context;
+            return 0;
+#endif
+        }
+
+        void SampleSignalHandler(int, siginfo_t*, void* _context)
+        {
+            const s32 savedErrno = errno;
+
+            DarwinThreadSamplingTarget* target = g_pendingSample.load(std::memory_order_acquire);
+            SampleState expected = SampleState::Requested;
+
+            // Late signals of cancelled requests, or signals not sent by the sampler, are ignored.
+            if (target != nullptr
+                && pthread_equal(target->m_thread, pthread_self())
+                && target->m_state.compare_exchange_strong(expected, SampleState::Capturing, std::memory_order_acquire))
+            {
+                if (target->m_callback != nullptr)
+                {
+                    target->m_callback(target->m_userData);
+                }
+
+                void** frames = reinterpret_cast<void**>(target->m_frames);
+                const s32 count = backtrace(frames, static_cast<s32>(target->m_maxFrames));
+
+                // Drop the handler and signal trampoline frames, so the stack starts at the interrupted instruction.
+                const uintptr_t interruptedAddress = GetInterruptedAddress(_context);
+                s32 skipped = eastl::min(count, kDefaultHandlerFrames);
+                for (s32 i = 0; i < eastl::min(count, kMaxHandlerFrames); i++)
+                {
+                    if (reinterpret_cast<uintptr_t>(frames[i]) == interruptedAddress)
+                    {
+                        skipped = i;
+                        break;
+                    }
+                }
+                memmove(frames, frames + skipped, (count - skipped) * sizeof(void*));
+
+                target->m_frameCount = count - skipped;
+                target->m_state.store(SampleState::Done, std::memory_order_release);
+            }
+
+            errno = savedErrno;
+        }
+    }
+
+    ThreadSamplingTarget RegisterThreadForSampling(const AllocatorInstance _allocator)
+    {
+        // The unwinder is lazily loaded on first use, which isn't async-signal-safe, so make sure it happens here.
+        void* frame;
+        backtrace(&frame, 1);
+
+        sigset_t mask;
+        sigemptyset(&mask);
+        sigaddset(&mask, SIGPROF);
+        IF_NOT_VERIFY_MSG(pthread_sigmask(SIG_UNBLOCK, &mask, nullptr) == 0, "Unable to unblock SIGPROF")
+        {
+            return { OpaqueHandle { OpaqueHandle::Error::Unknown } };
+        }
+
+        auto* target = _allocator.New<DarwinThreadSamplingTarget>();
+        target->m_thread = pthread_self();
+        return { OpaqueHandle { target } };
+    }
+
+    void UnregisterThreadForSampling(const ThreadSamplingTarget _target, const AllocatorInstance _allocator)
+    {
+        VERIFY_OR_RETURN_VOID(_target.IsValid());
+
+        auto* target = static_cast<DarwinThreadSamplingTarget*>(_target.m_handle);
+        KE_ASSERT(target->m_state.load(std::memory_order_acquire) == SampleState::Idle);
+        _allocator.Delete(target);
+    }
+
+    bool BeginThreadSampling()
+    {
+        const std::lock_guard lock(g_samplingMutex);
+
+        if (g_samplingUsers == 0)
+        {
+            struct sigaction action {};
+            action.sa_sigaction = SampleSignalHandler;
+            action.sa_flags = SA_SIGINFO | SA_RESTART;
+            sigemptyset(&action.sa_mask);
+
+            IF_NOT_VERIFY_MSG(sigaction(SIGPROF, &action, &g_previousAction) == 0, "Unable to install SIGPROF handler")
+            {
+                return false;
+            }
+        }
+        g_samplingUsers++;
+        return true;
+    }
+
+    void EndThreadSampling()
+    {
+        const std::lock_guard lock(g_samplingMutex);
+
+        VERIFY_OR_RETURN_VOID(g_samplingUsers > 0);
+        g_samplingUsers--;
+        if (g_samplingUsers == 0)
+        {
+            sigaction(SIGPROF, &g_previousAction, nullptr);
+        }
+    }
+
+    u32 SampleThreadStack(
+        const ThreadSamplingTarget _target,
+        const eastl::span<uintptr_t> _frames,
+        const ThreadSampleCallback _callback,
+        void* _userData)
+    {
+        VERIFY_OR_RETURN(_target.IsValid() && !_frames.empty(), 0);
+
+        auto* target = static_cast<DarwinThreadSamplingTarget*>(_target.m_handle);
+        VERIFY_OR_RETURN(!pthread_equal(target->m_thread, pthread_self()), 0);
+
+        const std::lock_guard lock(g_samplingMutex);
+        VERIFY_OR_RETURN(g_samplingUsers > 0, 0);
+
+        target->m_frames = _frames.data();
+        target->m_maxFrames = _frames.size();
+        target->m_frameCount = 0;
+        target->m_callback = _callback;
+        target->m_userData = _userData;
+        target->m_state.store(SampleState::Requested, std::memory_order_release);
+        g_pendingSample.store(target, std::memory_order_release);
+
+        u32 frameCount = 0;
+        if (pthread_kill(target->m_thread, SIGPROF) == 0)
+        {
+            const auto deadline = std::chrono::steady_clock::now() + kSampleTimeout;
+
+            SampleState state;
+            while ((state = target->m_state.load(std::memory_order_acquire)) != SampleState::Done)
+            {
+                // Cancel the request if the signal wasn't handled in time, unless the handler just started.
+                if (state == SampleState::Requested
+                    && std::chrono::steady_clock::now() > deadline
+                    && target->m_state.compare_exchange_strong(state, SampleState::Idle, std::memory_order_acq_rel))
+                {
+                    break;
+                }
+                std::this_thread::yield();
+            }
+
+            if (state == SampleState::Done)
+            {
+                frameCount = target->m_frameCount;
+            }
+        }
+
+        target->m_state.store(SampleState::Idle, std::memory_order_release);
+        g_pendingSample.store(nullptr, std::memory_order_release);
+        return frameCount;
+    }
+
+    bool ResolveSymbolName(const uintptr_t _address, eastl::string& _name)
+    {
+        Dl_info info {};
+        if (dladdr(reinterpret_cast<void*>(_address), &info) == 0)
+        {
+            return false;
+        }
+
+        if (info.dli_sname != nullptr)
+        {
+            s32 status = 0;
+            char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            _name = status == 0 ? demangled : info.dli_sname;
+            free(demangled);
+            return true;
+        }
+
+        // Symbol isn't exported, fall back to an address that can be resolved offline
+        const char* module = info.dli_fname != nullptr ? info.dli_fname : "?";
+        if (const char* separator = strrchr(module, '/'); separator != nullptr)
+        {
+            module = separator + 1;
+        }
+        _name.sprintf("%s+0x%zx", module, static_cast<size_t>(_address - reinterpret_cast<uintptr_t>(info.dli_fbase)));
+        return true;
+    }
+}
@@ -6,12 +6,22 @@
 
 #include "KryneEngine/Core/Platform/Platform.hpp"
 
+#include <atomic>
+#include <EASTL/algorithm.h>
 #include <cerrno>
+#include <linux/futex.h>
+#include <poll.h>
+#include <sys/mman.h>
 #include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
 #include <sys/types.h>
 #include <sys/un.h>
 #include <unistd.h>
 
+#include "KryneEngine/Core/Common/Utils/Alignment.hpp"
+#include "KryneEngine/Core/Threads/HelperFunctions.hpp"
+
 namespace KryneEngine::Platform
 {
     KE_FORCEINLINE void SetupName(sockaddr_un& _address, const eastl::string_view _connectionName)
@@ -66,6 +76,10 @@ namespace KryneEngine::Platform
 
         SetupName(ipcConnection->m_address, _connectionName);
 
+        // Make sure the socket directory exists
+        if (mkdir("/tmp/ke", 0700) == -1)
+            KE_ASSERT_MSG(errno == EEXIST, "Failed to create socket directory");
+
         // If there is an existing socket file, assume it is stale and try to remove it
         if (access(ipcConnection->m_address.sun_path, F_OK) == 0)
         {
@@ -86,7 +100,7 @@ namespace KryneEngine::Platform
         KE_VERIFY(bind(
             ipcConnection->m_socketId,
             reinterpret_cast<sockaddr*>(&ipcConnection->m_address),
-            sizeof(ipcConnection->m_address) != -1));
+            sizeof(ipcConnection->m_address)) != -1);
 
         KE_VERIFY(listen(ipcConnection->m_socketId, static_cast<s32>(_maxConnections)) != -1);
 
@@ -132,7 +146,7 @@ namespace KryneEngine::Platform
         return result > 0 ? result : 0;
     }
 
-    void CloseLocalIpc(const LocalIpcHost _connection, const AllocatorInstance _allocator)
+    void CloseLocalIpcHost(const LocalIpcHost _connection, const AllocatorInstance _allocator)
     {
         KE_ASSERT(_connection.m_handle != nullptr);
 
@@ -153,16 +167,21 @@ namespace KryneEngine::Platform
     {
         auto* clientConnection = _allocator.New<LinuxClientIpcConnection>();
 
+        clientConnection->m_socketId = socket(AF_UNIX, SOCK_STREAM, 0);
+        KE_ASSERT_MSG(clientConnection->m_socketId != -1, "Failed to create socket");
+
         sockaddr_un address {};
         SetupName(address, _connectionName);
-        clientConnection->m_serverId = connect(clientConnection->m_socketId, reinterpret_cast<sockaddr*>(&address), sizeof(address));
-
-        if (clientConnection->m_serverId == -1)
+        if (connect(clientConnection->m_socketId, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
         {
+            close(clientConnection->m_socketId);
             _allocator.Delete(clientConnection);
             return { OpaqueHandle { OpaqueHandle::Error::NoHost } };
         }
 
+        // A connected stream socket is used for both directions
+        clientConnection->m_serverId = clientConnection->m_socketId;
+
         return { OpaqueHandle { clientConnection } };
     }
 
@@ -192,4 +211,383 @@ namespace KryneEngine::Platform
         KE_VERIFY(close(clientConnection->m_socketId) != -1);
         _allocator.Delete(clientConnection);
     }
-}
\ No newline at end of file
+
+    namespace
+    {
+        constexpr u32 kChannelMagic = 0x4b454348; // 'KECH'
+
+        // Futex wait timeout, after which the peer process liveness is checked
+        constexpr timespec kChannelWaitTimeout { .tv_sec = 0, .tv_nsec = 50'000'000 };
+
+        // Waking up through a futex costs a few microseconds, so spin for a short while before going to sleep
+        constexpr u32 kChannelSpinCount = 4096;
+
+        static_assert(std::atomic<u64>::is_always_lock_free && std::atomic<u32>::is_always_lock_free,
+            "Shared memory atomics must be lock-free to work across processes");
+
+        struct SharedRing
+        {
+            // Producer cache line
+            alignas(Threads::kCacheLineSize) std::atomic<u64> m_writeIndex;
+            std::atomic<u32> m_dataSequence; // Futex word for the consumer
+            std::atomic<u32> m_consumerWaiting;
+
+            // Consumer cache line
+            alignas(Threads::kCacheLineSize) std::atomic<u64> m_readIndex;
+            std::atomic<u32> m_spaceSequence; // Futex word for the producer
+            std::atomic<u32> m_producerWaiting;
+        };
+
+        struct SharedChannelHeader
+        {
+            u32 m_magic;
+            u32 m_capacity;
+            std::atomic<u32> m_closed;
+
+            // Host to client, then client to host
+            SharedRing m_rings[2];
+        };
+
+        struct ChannelHandshake
+        {
+            u32 m_magic;
+            u32 m_capacity;
+        };
+
+        size_t GetChannelDataOffset()
+        {
+            return Alignment::AlignUp(sizeof(SharedChannelHeader), static_cast<size_t>(sysconf(_SC_PAGESIZE)));
+        }
+
+        size_t GetChannelMappingSize(const u32 _capacity)
+        {
+            return GetChannelDataOffset() + 2 * static_cast<size_t>(_capacity);
+        }
+
+        void FutexWait(std::atomic<u32>* _word, const u32 _expected)
+        {
+            // Not a private futex, as the word is shared with another process
+            syscall(SYS_futex, reinterpret_cast<u32*>(_word), FUTEX_WAIT, _expected, &kChannelWaitTimeout, nullptr, 0);
+        }
+
+        void FutexWakeAll(std::atomic<u32>* _word)
+        {
+            syscall(SYS_futex, reinterpret_cast<u32*>(_word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+        }
+
+        void Signal(std::atomic<u32>& _sequence)
+        {
+            _sequence.fetch_add(1, std::memory_order_release);
+            FutexWakeAll(&_sequence);
+        }
+    }
+
+    struct LinuxLocalIpcChannel
+    {
+        SharedChannelHeader* m_shared = nullptr;
+        size_t m_mappingSize = 0;
+        SharedRing* m_outbound = nullptr;
+        SharedRing* m_inbound = nullptr;
+        char* m_outboundData = nullptr;
+        char* m_inboundData = nullptr;
+        u32 m_capacity = 0;
+        s32 m_socketId = -1;
+
+        [[nodiscard]] bool IsClosed() const
+        {
+            if (m_shared->m_closed.load(std::memory_order_acquire) != 0)
+                return true;
+
+            // The peer may have exited without closing the channel
+            pollfd pollFd { .fd = m_socketId, .events = POLLRDHUP };
+            return poll(&pollFd, 1, 0) > 0 && (pollFd.revents & (POLLRDHUP | POLLHUP | POLLERR)) != 0;
+        }
+
+        /**
+         * @brief Waits until `_isReady()` returns true, or the channel is closed.
+         *
+         * @details
+         * The waiting flag and the condition are checked in the opposite order of the other side's publication and
+         * flag check, with sequentially consistent accesses, so at least one of them sees the other and no wake-up is
+         * lost.
+         */
+        template <class Predicate>
+        bool Wait(std::atomic<u32>& _sequence, std::atomic<u32>& _waiting, Predicate&& _isReady) const
+        {
+            for (u32 i = 0; i < kChannelSpinCount; i++)
+            {
+                if (_isReady())
+                    return true;
+                Threads::CpuYield();
+            }
+
+            while (true)
+            {
+                const u32 sequence = _sequence.load(std::memory_order_acquire);
+                _waiting.store(1, std::memory_order_seq_cst);
+                if (_isReady())
+                {
+                    _waiting.store(0, std::memory_order_relaxed);
+                    return true;
+                }
+                if (IsClosed())
+                {
+                    _waiting.store(0, std::memory_order_relaxed);
+                    return _isReady();
+                }
+
+                FutexWait(&_sequence, sequence);
+                _waiting.store(0, std::memory_order_relaxed);
+            }
+        }
+    };
+
+    namespace
+    {
+        LocalIpcChannel MapChannel(
+            const s32 _memoryFd,
+            const s32 _socketId,
+            const u32 _capacity,
+            const bool _isHost,
+            const AllocatorInstance _allocator)
+        {
+            const size_t mappingSize = GetChannelMappingSize(_capacity);
+            void* mapping = mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, _memoryFd, 0);
+
+            // The mapping keeps the memory alive
+            close(_memoryFd);
+
+            if (mapping == MAP_FAILED)
+                return { OpaqueHandle { OpaqueHandle::Error::SystemLimit } };
+
+            auto* channel = _allocator.New<LinuxLocalIpcChannel>();
+            channel->m_shared = static_cast<SharedChannelHeader*>(mapping);
+            channel->m_mappingSize = mappingSize;
+            channel->m_capacity = _capacity;
+            channel->m_socketId = _socketId;
+
+            char* data = static_cast<char*>(mapping) + GetChannelDataOffset();
+            const u32 outboundIndex = _isHost ? 0 : 1;
+            channel->m_outbound = &channel->m_shared->m_rings[outboundIndex];
+            channel->m_inbound = &channel->m_shared->m_rings[1 - outboundIndex];
+            channel->m_outboundData = data + outboundIndex * static_cast<size_t>(_capacity);
+            channel->m_inboundData = data + (1 - outboundIndex) * static_cast<size_t>(_capacity);
+
+            return { OpaqueHandle { channel } };
+        }
+    }
+
+    LocalIpcChannel CreateLocalIpcChannel(
+        const LocalIpcHost _connection,
+        const AllocatorInstance _allocator,
+        const u32 _capacity,
+        const u32 _clientIdx)
+    {
+        KE_ASSERT(_connection.m_handle != nullptr);
+        auto* ipcConnection = static_cast<LinuxHostLocalIpcConnection*>(_connection.m_handle);
+
+        KE_ASSERT(ipcConnection->m_maxConnections > _clientIdx);
+        const s32 clientSocket = ipcConnection->GetClient(_clientIdx)->m_clientId;
+
+        // Power of two capacity, so ring positions can be masked
+        const u32 capacity = static_cast<u32>(Alignment::NextPowerOfTwo(eastl::max(_capacity, 4096u)));
+
+        const s32 memoryFd = static_cast<s32>(memfd_create("KryneEngineIpcChannel", MFD_CLOEXEC));
+        if (memoryFd == -1)
+            return { OpaqueHandle { OpaqueHandle::Error::SystemLimit } };
+
+        // Zero-filled on allocation
+        if (ftruncate(memoryFd, static_cast<off_t>(GetChannelMappingSize(capacity))) == -1)
+        {
+            close(memoryFd);
+            return { OpaqueHandle { OpaqueHandle::Error::SystemLimit } };
+        }
+
+        // Pass a duplicate, as mapping closes the file descriptor
+        const s32 sentFd = dup(memoryFd);
+        const LocalIpcChannel channel = MapChannel(memoryFd, clientSocket, capacity, true, _allocator);
+        if (!channel.IsValid())
+        {
+            close(sentFd);
+            return channel;
+        }
+
+        auto* shared = static_cast<LinuxLocalIpcChannel*>(channel.m_handle)->m_shared;
+        shared->m_capacity = capacity;
+        shared->m_magic = kChannelMagic;
+
+        ChannelHandshake handshake { kChannelMagic, capacity };
+        iovec payload { .iov_base = &handshake, .iov_len = sizeof(handshake) };
+
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(s32))] = {};
+        msghdr message {
+            .msg_iov = &payload,
+            .msg_iovlen = 1,
+            .msg_control = control,
+            .msg_controllen = sizeof(control),
+        };
+        cmsghdr* controlMessage = CMSG_FIRSTHDR(&message);
+        controlMessage->cmsg_level = SOL_SOCKET;
+        controlMessage->cmsg_type = SCM_RIGHTS;
+        controlMessage->cmsg_len = CMSG_LEN(sizeof(s32));
+        memcpy(CMSG_DATA(controlMessage), &sentFd, sizeof(s32));
+
+        const ssize_t result = sendmsg(clientSocket, &message, MSG_NOSIGNAL);
+        close(sentFd);
+
+        if (result != sizeof(handshake))
+        {
+            CloseLocalIpcChannel(channel, _allocator);
+            return { OpaqueHandle { OpaqueHandle::Error::NoHost } };
+        }
+
+        return channel;
+    }
+
+    LocalIpcChannel OpenLocalIpcChannel(const LocalIpcClient _connection, const AllocatorInstance _allocator)
+    {
+        KE_ASSERT(_connection.m_handle != nullptr);
+        const auto* clientConnection = static_cast<LinuxClientIpcConnection*>(_connection.m_handle);
+
+        ChannelHandshake handshake {};
+        iovec payload { .iov_base = &handshake, .iov_len = sizeof(handshake) };
+
+        alignas(cmsghdr) char control[CMSG_SPACE(sizeof(s32))] = {};
+        msghdr message {
+            .msg_iov = &payload,
+            .msg_iovlen = 1,
+            .msg_control = control,
+            .msg_controllen = sizeof(control),
+        };
+
+        const ssize_t result = recvmsg(clientConnection->m_serverId, &message, MSG_CMSG_CLOEXEC | MSG_WAITALL);
+        const cmsghdr* controlMessage = CMSG_FIRSTHDR(&message);
+        if (result != sizeof(handshake)
+            || controlMessage == nullptr
+            || controlMessage->cmsg_level != SOL_SOCKET
+            || controlMessage->cmsg_type != SCM_RIGHTS)
+        {
+            return { OpaqueHandle { OpaqueHandle::Error::NoHost } };
+        }
+
+        s32 memoryFd;
+        memcpy(&memoryFd, CMSG_DATA(controlMessage), sizeof(s32));
+
+        IF_NOT_VERIFY_MSG(handshake.m_magic == kChannelMagic, "Invalid channel handshake")
+        {
+            close(memoryFd);
+            return { OpaqueHandle { OpaqueHandle::Error::Unknown } };
+        }
+
+        // The capacity is used as a ring mask, and the shared memory must hold both rings.
+        struct stat memoryStat {};
+        IF_NOT_VERIFY_MSG(
+            Alignment::IsPowerOfTwo(handshake.m_capacity)
+                && fstat(memoryFd, &memoryStat) == 0
+                && static_cast<u64>(memoryStat.st_size) >= GetChannelMappingSize(handshake.m_capacity),
+            "Invalid channel capacity")
+        {
+            close(memoryFd);
+            return { OpaqueHandle { OpaqueHandle::Error::Unknown } };
+        }
+
+        const LocalIpcChannel channel = MapChannel(
+            memoryFd,
+            clientConnection->m_serverId,
+            handshake.m_capacity,
+            false,
+            _allocator);
+        KE_ASSERT(!channel.IsValid()
+            || static_cast<LinuxLocalIpcChannel*>(channel.m_handle)->m_shared->m_magic == kChannelMagic);
+        return channel;
+    }
+
+    size_t ReceiveLocalIpc(const LocalIpcChannel _channel, const eastl::span<char> _buffer)
+    {
+        KE_ASSERT(_channel.m_handle != nullptr);
+        const auto* channel = static_cast<LinuxLocalIpcChannel*>(_channel.m_handle);
+        SharedRing& ring = *channel->m_inbound;
+
+        const u64 readIndex = ring.m_readIndex.load(std::memory_order_relaxed);
+        const bool ready = channel->Wait(
+            ring.m_dataSequence,
+            ring.m_consumerWaiting,
+            [&ring, readIndex] { return ring.m_writeIndex.load(std::memory_order_seq_cst) != readIndex; });
+        if (!ready)
+            return 0;
+
+        const u64 available = ring.m_writeIndex.load(std::memory_order_acquire) - readIndex;
+        const u32 count = static_cast<u32>(eastl::min<u64>(available, _buffer.size()));
+
+        // At most two contiguous segments, as the data may wrap around the end of the ring.
+        const u32 start = static_cast<u32>(readIndex & (channel->m_capacity - 1));
+        const u32 firstCount = eastl::min(count, channel->m_capacity - start);
+        memcpy(_buffer.data(), channel->m_inboundData + start, firstCount);
+        memcpy(_buffer.data() + firstCount, channel->m_inboundData, count - firstCount);
+
+        ring.m_readIndex.store(readIndex + count, std::memory_order_seq_cst);
+        if (ring.m_producerWaiting.load(std::memory_order_seq_cst) != 0)
+            Signal(ring.m_spaceSequence);
+
+        return count;
+    }
+
+    size_t SendLocalIpc(const LocalIpcChannel _channel, const eastl::span<char> _buffer)
+    {
+        KE_ASSERT(_channel.m_handle != nullptr);
+        const auto* channel = static_cast<LinuxLocalIpcChannel*>(_channel.m_handle);
+        SharedRing& ring = *channel->m_outbound;
+        const u32 capacity = channel->m_capacity;
+
+        size_t sent = 0;
+        while (sent < _buffer.size())
+        {
+            if (channel->m_shared->m_closed.load(std::memory_order_relaxed) != 0)
+                break;
+
+            const u64 writeIndex = ring.m_writeIndex.load(std::memory_order_relaxed);
+            const bool ready = channel->Wait(
+                ring.m_spaceSequence,
+                ring.m_producerWaiting,
+                [&ring, writeIndex, capacity]
+                {
+                    return writeIndex - ring.m_readIndex.load(std::memory_order_seq_cst) < capacity;
+                });
+            if (!ready)
+                break;
+
+            const u64 freeSpace = capacity - (writeIndex - ring.m_readIndex.load(std::memory_order_acquire));
+            const u32 count = static_cast<u32>(eastl::min<u64>(freeSpace, _buffer.size() - sent));
+
+            const u32 start = static_cast<u32>(writeIndex & (capacity - 1));
+            const u32 firstCount = eastl::min(count, capacity - start);
+            memcpy(channel->m_outboundData + start, _buffer.data() + sent, firstCount);
+            memcpy(channel->m_outboundData, _buffer.data() + sent + firstCount, count - firstCount);
+
+            ring.m_writeIndex.store(writeIndex + count, std::memory_order_seq_cst);
+            if (ring.m_consumerWaiting.load(std::memory_order_seq_cst) != 0)
+                Signal(ring.m_dataSequence);
+
+            sent += count;
+        }
+
+        return sent;
+    }
+
+    void CloseLocalIpcChannel(const LocalIpcChannel _channel, const AllocatorInstance _allocator)
+    {
+        KE_ASSERT(_channel.m_handle != nullptr);
+        auto* channel = static_cast<LinuxLocalIpcChannel*>(_channel.m_handle);
+
+        // Wake up the peer, whatever it is waiting on
+        channel->m_shared->m_closed.store(1, std::memory_order_release);
+        for (SharedRing& ring: channel->m_shared->m_rings)
+        {
+            Signal(ring.m_dataSequence);
+            Signal(ring.m_spaceSequence);
+        }
+
+        KE_VERIFY(munmap(channel->m_shared, channel->m_mappingSize) != -1);
+        _allocator.Delete(channel);
+    }
+}
@@ -0,0 +1,347 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Core/Platform/Platform.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <cxxabi.h>
+#include <dlfcn.h>
+#include <linux/futex.h>
+#include <mutex>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+#include "KryneEngine/Core/Common/Assert.hpp"
+
+namespace KryneEngine::Platform
+{
+    namespace
+    {
+        enum class SampleState: u32
+        {
+            Idle,
+            Requested,
+            Capturing,
+            Done,
+        };
+
+        struct LinuxThreadSamplingTarget
+        {
+            pthread_t m_thread {};
+            std::atomic<SampleState> m_state = SampleState::Idle;
+
+            // Thread stack bounds, empty if unknown
+            uintptr_t m_stackLow = 0;
+            uintptr_t m_stackHigh = 0;
+
+            // Request parameters, only accessed by the handler between `Requested` and `Done`
+            uintptr_t* m_frames = nullptr;
+            u32 m_maxFrames = 0;
+            u32 m_frameCount = 0;
+            ThreadSampleCallback m_callback = nullptr;
+            void* m_userData = nullptr;
+        };
+
+        static_assert(sizeof(uintptr_t) == sizeof(void*));
+        static_assert(sizeof(std::atomic<SampleState>) == sizeof(u32), "Sample state is used as a futex word");
+
+        constexpr auto kSampleTimeout = std::chrono::milliseconds(20);
+
+        // The sampler sleeps in slices, to check for the request timeout
+        constexpr timespec kSampleWaitSlice { .tv_sec = 0, .tv_nsec = 1'000'000 };
+
+        std::atomic<LinuxThreadSamplingTarget*> g_pendingSample = nullptr;
+
+        // Serializes samples, and guards the handler installation
+        std::mutex g_samplingMutex;
+        u32 g_samplingUsers = 0;
+        struct sigaction g_previousAction {};
+
+        void FutexWait(std::atomic<SampleState>* _word, const SampleState _expected)
+        {
+            syscall(
+                SYS_futex,
+                reinterpret_cast<u32*>(_word),
+                FUTEX_WAIT_PRIVATE,
+                static_cast<u32>(_expected),
+                &kSampleWaitSlice,
+                nullptr,
+                0);
+        }
+
+        void FutexWake(std::atomic<SampleState>* _word)
+        {
+            syscall(SYS_futex, reinterpret_cast<u32*>(_word), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+        }
+
+        /// A frame record, as pushed by function prologues: caller frame pointer, then return address.
+        struct FrameRecord
+        {
+            uintptr_t m_callerFramePointer;
+            uintptr_t m_returnAddress;
+        };
+
+        bool ReadFrameRecord(
+            const uintptr_t _address,
+            FrameRecord& _record,
+            const uintptr_t _mappedLow,
+            const uintptr_t _mappedHigh)
+        {
+            if (_address >= _mappedLow && _address + sizeof(FrameRecord) <= _mappedHigh)
+            {
+                memcpy(&_record, reinterpret_cast<const void*>(_address), sizeof(FrameRecord));
+                return true;
+            }
+
+            // Anywhere else, read through the kernel, which fails instead of faulting on an invalid address.
+            iovec local { &_record, sizeof(FrameRecord) };
+            iovec remote { reinterpret_cast<void*>(_address), sizeof(FrameRecord) };
+            return process_vm_readv(getpid(), &local, 1, &remote, 1, 0) == sizeof(FrameRecord);
+        }
+
+        /**
+         * @brief Walks the frame pointer chain from the interrupted context.
+         *
+         * @details
+         * Unlike `backtrace()`, which may take the loader lock through the libgcc unwinder, this only reads memory and
+         * is async-signal-safe. Frames built without a frame pointer end the walk early, or are skipped.
+         */
+        u32 WalkFramePointers(
+            const void* _context,
+            const LinuxThreadSamplingTarget& _target,
+            uintptr_t* _frames,
+            const u32 _maxFrames)
+        {
+            const auto* context = static_cast<const ucontext_t*>(_context);
+#if defined(__x86_64__)
+            const auto pc = static_cast<uintptr_t>(context->uc_mcontext.gregs[REG_RIP]);
+            const auto sp = static_cast<uintptr_t>(context->uc_mcontext.gregs[REG_RSP]);
+            uintptr_t fp = static_cast<uintptr_t>(context->uc_mcontext.gregs[REG_RBP]);
+#elif defined(__aarch64__)
+            const auto pc = static_cast<uintptr_t>(context->uc_mcontext.pc);
+            const auto sp = static_cast<uintptr_t>(context->uc_mcontext.sp);
+            uintptr_t fp = static_cast<uintptr_t>(context->uc_mcontext.regs[29]);
+#else
+            (void)context;
+            (void)_target;
+            (void)_frames;
+            (void)_maxFrames;
+            return 0;
+#endif
+
+#if defined(__x86_64__) || defined(__aarch64__)
+            // Between the interrupted stack pointer and the top of the thread stack, memory is known to be mapped.
+            // It isn't when running on another stack, like a fiber one.
+            const bool onThreadStack = sp >= _target.m_stackLow && sp < _target.m_stackHigh;
+            const uintptr_t mappedLow = onThreadStack ? sp : 0;
+            const uintptr_t mappedHigh = onThreadStack ? _target.m_stackHigh : 0;
+
+            u32 count = 0;
+            _frames[count++] = pc;
+
+            // Records can only be found higher up the stack than the previous one, which also ends cycles.
+            uintptr_t lowest = sp;
+            while (count < _maxFrames && fp >= lowest && fp % alignof(FrameRecord) == 0)
+            {
+                FrameRecord record;
+                if (!ReadFrameRecord(fp, record, mappedLow, mappedHigh) || record.m_returnAddress == 0)
+                    break;
+
+                _frames[count++] = record.m_returnAddress;
+                lowest = fp + sizeof(FrameRecord);
+                fp = record.m_callerFramePointer;
+            }
+            return count;
+#endif
+        }
+
+        void SampleSignalHandler(int, siginfo_t*, void* _context)
+        {
+            const s32 savedErrno = errno;
+
+            LinuxThreadSamplingTarget* target = g_pendingSample.load(std::memory_order_acquire);
+            SampleState expected = SampleState::Requested;
+
+            // Late signals of cancelled requests, or signals not sent by the sampler, are ignored.
+            if (target != nullptr
+                && pthread_equal(target->m_thread, pthread_self())
+                && target->m_state.compare_exchange_strong(expected, SampleState::Capturing, std::memory_order_acquire))
+            {
+                if (target->m_callback != nullptr)
+                {
+                    target->m_callback(target->m_userData);
+                }
+
+                // Starting from the interrupted context leaves the handler and signal trampoline frames out.
+                target->m_frameCount = WalkFramePointers(_context, *target, target->m_frames, target->m_maxFrames);
+                target->m_state.store(SampleState::Done, std::memory_order_release);
+                FutexWake(&target->m_state);
+            }
+
+            errno = savedErrno;
+        }
+    }
+
+    ThreadSamplingTarget RegisterThreadForSampling(const AllocatorInstance _allocator)
+    {
+        sigset_t mask;
+        sigemptyset(&mask);
+        sigaddset(&mask, SIGPROF);
+        IF_NOT_VERIFY_MSG(pthread_sigmask(SIG_UNBLOCK, &mask, nullptr) == 0, "Unable to unblock SIGPROF")
+        {
+            return { OpaqueHandle { OpaqueHandle::Error::Unknown } };
+        }
+
+        auto* target = _allocator.New<LinuxThreadSamplingTarget>();
+        target->m_thread = pthread_self();
+
+        // Not async-signal-safe, so the thread stack bounds are fetched here for the handler.
+        pthread_attr_t attributes;
+        if (pthread_getattr_np(target->m_thread, &attributes) == 0)
+        {
+            void* stackLow = nullptr;
+            size_t stackSize = 0;
+            if (pthread_attr_getstack(&attributes, &stackLow, &stackSize) == 0)
+            {
+                target->m_stackLow = reinterpret_cast<uintptr_t>(stackLow);
+                target->m_stackHigh = target->m_stackLow + stackSize;
+            }
+            pthread_attr_destroy(&attributes);
+        }
+
+        return { OpaqueHandle { target } };
+    }
+
+    void UnregisterThreadForSampling(const ThreadSamplingTarget _target, const AllocatorInstance _allocator)
+    {
+        VERIFY_OR_RETURN_VOID(_target.IsValid());
+
+        // Waits for a sample of this target to complete, the sampler may still hold a copy of the handle.
+        const std::lock_guard lock(g_samplingMutex);
+
+        auto* target = static_cast<LinuxThreadSamplingTarget*>(_target.m_handle);
+        KE_ASSERT(target->m_state.load(std::memory_order_acquire) == SampleState::Idle);
+        _allocator.Delete(target);
+    }
+
+    bool BeginThreadSampling()
+    {
+        const std::lock_guard lock(g_samplingMutex);
+
+        if (g_samplingUsers == 0)
+        {
+            struct sigaction action {};
+            action.sa_sigaction = SampleSignalHandler;
+            action.sa_flags = SA_SIGINFO | SA_RESTART;
+            sigemptyset(&action.sa_mask);
+
+            IF_NOT_VERIFY_MSG(sigaction(SIGPROF, &action, &g_previousAction) == 0, "Unable to install SIGPROF handler")
+            {
+                return false;
+            }
+        }
+        g_samplingUsers++;
+        return true;
+    }
+
+    void EndThreadSampling()
+    {
+        const std::lock_guard lock(g_samplingMutex);
+
+        VERIFY_OR_RETURN_VOID(g_samplingUsers > 0);
+        g_samplingUsers--;
+        if (g_samplingUsers == 0)
+        {
+            sigaction(SIGPROF, &g_previousAction, nullptr);
+        }
+    }
+
+    u32 SampleThreadStack(
+        const ThreadSamplingTarget _target,
+        const eastl::span<uintptr_t> _frames,
+        const ThreadSampleCallback _callback,
+        void* _userData)
+    {
+        VERIFY_OR_RETURN(_target.IsValid() && !_frames.empty(), 0);
+
+        const std::lock_guard lock(g_samplingMutex);
+        VERIFY_OR_RETURN(g_samplingUsers > 0, 0);
+
+        auto* target = static_cast<LinuxThreadSamplingTarget*>(_target.m_handle);
+        VERIFY_OR_RETURN(!pthread_equal(target->m_thread, pthread_self()), 0);
+
+        target->m_frames = _frames.data();
+        target->m_maxFrames = _frames.size();
+        target->m_frameCount = 0;
+        target->m_callback = _callback;
+        target->m_userData = _userData;
+        target->m_state.store(SampleState::Requested, std::memory_order_release);
+        g_pendingSample.store(target, std::memory_order_release);
+
+        u32 frameCount = 0;
+        if (pthread_kill(target->m_thread, SIGPROF) == 0)
+        {
+            const auto deadline = std::chrono::steady_clock::now() + kSampleTimeout;
+
+            SampleState state;
+            while ((state = target->m_state.load(std::memory_order_acquire)) != SampleState::Done)
+            {
+                // Cancel the request if the signal wasn't handled in time, unless the handler just started.
+                if (state == SampleState::Requested
+                    && std::chrono::steady_clock::now() > deadline
+                    && target->m_state.compare_exchange_strong(state, SampleState::Idle, std::memory_order_acq_rel))
+                {
+                    break;
+                }
+                FutexWait(&target->m_state, state);
+            }
+
+            if (state == SampleState::Done)
+            {
+                frameCount = target->m_frameCount;
+            }
+        }
+
+        target->m_state.store(SampleState::Idle, std::memory_order_release);
+        g_pendingSample.store(nullptr, std::memory_order_release);
+        return frameCount;
+    }
+
+    bool ResolveSymbolName(const uintptr_t _address, eastl::string& _name)
+    {
+        Dl_info info {};
+        if (dladdr(reinterpret_cast<void*>(_address), &info) == 0)
+        {
+            return false;
+        }
+
+        if (info.dli_sname != nullptr)
+        {
+            s32 status = 0;
+            char* demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+            _name = status == 0 ? demangled : info.dli_sname;
+            free(demangled);
+            return true;
+        }
+
+        // Symbol isn't exported, fall back to an address that can be resolved offline
+        const char* module = info.dli_fname != nullptr ? info.dli_fname : "?";
+        if (const char* separator = strrchr(module, '/'); separator != nullptr)
+        {
+            module = separator + 1;
+        }
+        _name.sprintf("%s+0x%zx", module, static_cast<size_t>(_address - reinterpret_cast<uintptr_t>(info.dli_fbase)));
+        return true;
+    }
+}
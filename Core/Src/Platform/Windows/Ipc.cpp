@@ -225,4 +225,28 @@ namespace KryneEngine::Platform
         _allocator.Delete(clientConnection);
     }
 
-}
\ No newline at end of file
+
+    LocalIpcChannel CreateLocalIpcChannel(LocalIpcHost, AllocatorInstance, u32, u32)
+    {
+        return { OpaqueHandle { OpaqueHandle::Error::Unsupported } };
+    }
+
+    LocalIpcChannel OpenLocalIpcChannel(LocalIpcClient, AllocatorInstance)
+    {
+        return { OpaqueHandle { OpaqueHandle::Error::Unsupported } };
+    }
+
+    size_t ReceiveLocalIpc(LocalIpcChannel, eastl::span<char>)
+    {
+        KE_ERROR("Shared memory channels are not supported on this platform");
+        return 0;
+    }
+
+    size_t SendLocalIpc(LocalIpcChannel, eastl::span<char>)
+    {
+        KE_ERROR("Shared memory channels are not supported on this platform");
+        return 0;
+    }
+
+    void CloseLocalIpcChannel(LocalIpcChannel, AllocatorInstance) {}
+}
@@ -0,0 +1,166 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Core/Platform/Platform.hpp"
+
+#include <cstring>
+#include <mutex>
+
+#include "KryneEngine/Core/Common/Assert.hpp"
+#include "KryneEngine/Core/Platform/Windows.h"
+
+namespace KryneEngine::Platform
+{
+    namespace
+    {
+        struct WindowsThreadSamplingTarget
+        {
+            HANDLE m_thread = nullptr;
+            DWORD m_threadId = 0;
+        };
+
+        // Serializes samples
+        std::mutex g_samplingMutex;
+        u32 g_samplingUsers = 0;
+    }
+
+    ThreadSamplingTarget RegisterThreadForSampling(const AllocatorInstance _allocator)
+    {
+        HANDLE thread = nullptr;
+        const BOOL result = DuplicateHandle(
+            GetCurrentProcess(),
+            GetCurrentThread(),
+            GetCurrentProcess(),
+            &thread,
+            THREAD_SUSPEND_RESUME | THREAD_GET_CONTEXT | THREAD_QUERY_INFORMATION,
+            FALSE,
+            0);
+        IF_NOT_VERIFY_MSG(result != 0, "Unable to open thread handle: %d", GetLastError())
+        {
+            return { OpaqueHandle { OpaqueHandle::Error::Unknown } };
+        }
+
+        auto* target = _allocator.New<WindowsThreadSamplingTarget>();
+        target->m_thread = thread;
+        target->m_threadId = GetCurrentThreadId();
+        return { OpaqueHandle { target } };
+    }
+
+    void UnregisterThreadForSampling(const ThreadSamplingTarget _target, const AllocatorInstance _allocator)
+    {
+        VERIFY_OR_RETURN_VOID(_target.IsValid());
+
+        auto* target = static_cast<WindowsThreadSamplingTarget*>(_target.m_handle);
+        CloseHandle(target->m_thread);
+        _allocator.Delete(target);
+    }
+
+    bool BeginThreadSampling()
+    {
+        const std::lock_guard lock(g_samplingMutex);
+        g_samplingUsers++;
+        return true;
+    }
+
+    void EndThreadSampling()
+    {
+        const std::lock_guard lock(g_samplingMutex);
+        VERIFY_OR_RETURN_VOID(g_samplingUsers > 0);
+        g_samplingUsers--;
+    }
+
+    u32 SampleThreadStack(
+        const ThreadSamplingTarget _target,
+        const eastl::span<uintptr_t> _frames,
+        const ThreadSampleCallback _callback,
+        void* _userData)
+    {
+        VERIFY_OR_RETURN(_target.IsValid() && !_frames.empty(), 0);
+
+        auto* target = static_cast<WindowsThreadSamplingTarget*>(_target.m_handle);
+        VERIFY_OR_RETURN(target->m_threadId != GetCurrentThreadId(), 0);
+
+        const std::lock_guard lock(g_samplingMutex);
+        VERIFY_OR_RETURN(g_samplingUsers > 0, 0);
+
+        if (SuspendThread(target->m_thread) == static_cast<DWORD>(-1))
+        {
+            return 0;
+        }
+
+        u32 frameCount = 0;
+        CONTEXT context {};
+        context.ContextFlags = CONTEXT_FULL;
+        if (GetThreadContext(target->m_thread, &context))
+        {
+            if (_callback != nullptr)
+            {
+                _callback(_userData);
+            }
+
+            // Unwind using the function tables, as x64 code doesn't keep frame pointers.
+            // As the target is suspended, this must not allocate nor take any lock it could hold.
+#if defined(_M_X64)
+            while (frameCount < _frames.size() && context.Rip != 0)
+            {
+                _frames[frameCount++] = context.Rip;
+
+                DWORD64 imageBase;
+                PRUNTIME_FUNCTION function = RtlLookupFunctionEntry(context.Rip, &imageBase, nullptr);
+                if (function == nullptr)
+                {
+                    // Leaf function, the return address is on top of the stack
+                    context.Rip = *reinterpret_cast<const DWORD64*>(context.Rsp);
+                    context.Rsp += sizeof(DWORD64);
+                }
+                else
+                {
+                    void* handlerData;
+                    DWORD64 establisherFrame;
+                    RtlVirtualUnwind(
+                        UNW_FLAG_NHANDLER,
+                        imageBase,
+                        context.Rip,
+                        function,
+                        &context,
+                        &handlerData,
+                        &establisherFrame,
+                        nullptr);
+                }
+            }
+#elif defined(_M_ARM64)
+            _frames[frameCount++] = context.Pc;
+#endif
+        }
+
+        ResumeThread(target->m_thread);
+        return frameCount;
+    }
+
+    bool ResolveSymbolName(const uintptr_t _address, eastl::string& _name)
+    {
+        HMODULE module = nullptr;
+        const BOOL found = GetModuleHandleExA(
+            GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+            reinterpret_cast<LPCSTR>(_address),
+            &module);
+        if (!found)
+        {
+            return false;
+        }
+
+        // No symbol lookup without dbghelp, provide an address that can be resolved offline instead.
+        char path[MAX_PATH] {};
+        GetModuleFileNameA(module, path, MAX_PATH);
+        const char* moduleName = path;
+        if (const char* separator = strrchr(path, '\\'); separator != nullptr)
+        {
+            moduleName = separator + 1;
+        }
+        _name.sprintf("%s+0x%zx", moduleName, static_cast<size_t>(_address - reinterpret_cast<uintptr_t>(module)));
+        return true;
+    }
+}
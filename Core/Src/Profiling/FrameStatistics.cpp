@@ -0,0 +1,348 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Core/Profiling/FrameStatistics.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
+
+#include "KryneEngine/Core/Common/Assert.hpp"
+
+namespace KryneEngine
+{
+    namespace
+    {
+        constexpr u32 kMinSpikeBaselineFrames = 8;
+
+        constexpr const char* kTimingNames[] = { "frame", "cpu", "submit", "presentWait" };
+        constexpr const char* kTimingMetricNames[] = { "frame/total", "frame/cpu", "frame/submit", "frame/presentWait" };
+        static_assert(sizeof(kTimingNames) / sizeof(kTimingNames[0]) == FrameStatistics::kTimingCount);
+
+        std::atomic<FrameStatistics*> s_instance = nullptr;
+
+        u64 GetSteadyClockTime(void*)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        }
+
+        // Nearest rank percentile, reorders the values
+        u64 GetPercentile(eastl::vector<u64>& _values, const double _percentile)
+        {
+            const double rank = std::ceil(_percentile * static_cast<double>(_values.size()));
+            const size_t index = eastl::clamp<size_t>(static_cast<size_t>(rank), 1, _values.size()) - 1;
+            const auto nth = _values.begin() + index;
+            eastl::nth_element(_values.begin(), nth, _values.end());
+            return *nth;
+        }
+
+        void AppendJsonString(eastl::string& _json, const char* _string)
+        {
+            _json.push_back('"');
+            for (const char* c = _string; *c != 0; c++)
+            {
+                if (*c == '"' || *c == '\\')
+                    _json.push_back('\\');
+                _json.push_back(*c);
+            }
+            _json.push_back('"');
+        }
+    }
+
+    FrameStatistics::FrameStatistics(AllocatorInstance _allocator, const Settings& _settings)
+        : m_allocator(_allocator)
+        , m_settings(_settings)
+        , m_history(_allocator)
+        , m_sortedTimings(_allocator)
+        , m_frameZones(_allocator)
+    {
+        KE_ZoneScopedFunction("FrameStatistics::FrameStatistics");
+
+        if (m_settings.m_clock == nullptr)
+            m_settings.m_clock = GetSteadyClockTime;
+        m_settings.m_historySize = eastl::max(m_settings.m_historySize, 1u);
+        m_settings.m_rollingWindow = eastl::clamp(m_settings.m_rollingWindow, 1u, m_settings.m_historySize);
+        m_settings.m_zoneCapacity = eastl::max(m_settings.m_zoneCapacity, 1u);
+
+        m_history.resize(m_settings.m_historySize);
+        m_sortedTimings.reserve(m_settings.m_rollingWindow);
+
+        m_zones = m_allocator.Allocate<ZoneRecord>(m_settings.m_zoneCapacity);
+        for (u32 i = 0; i < m_settings.m_zoneCapacity; i++)
+            ::new(&m_zones[i]) ZoneRecord {};
+
+        m_phaseStack[0] = Timing::Cpu;
+        m_phaseStart = GetTime();
+        m_frameStart = m_phaseStart;
+
+        if (m_settings.m_metrics != nullptr)
+        {
+            for (u8 i = 0; i < kTimingCount; i++)
+                m_timingHistograms[i] = m_settings.m_metrics->RegisterHistogram(kTimingMetricNames[i]);
+            m_spikeCounter = m_settings.m_metrics->RegisterCounter("frame/spikes");
+        }
+    }
+
+    FrameStatistics::~FrameStatistics()
+    {
+        FrameStatistics* self = this;
+        s_instance.compare_exchange_strong(self, nullptr);
+
+        m_allocator.deallocate(m_zones, sizeof(ZoneRecord) * m_settings.m_zoneCapacity);
+    }
+
+    FrameStatistics* FrameStatistics::GetInstance()
+    {
+        return s_instance.load(std::memory_order_acquire);
+    }
+
+    void FrameStatistics::SetInstance(FrameStatistics* _instance)
+    {
+        s_instance.store(_instance, std::memory_order_release);
+    }
+
+    u64 FrameStatistics::GetTime() const
+    {
+        return m_settings.m_clock(m_settings.m_clockUserData);
+    }
+
+    void FrameStatistics::BeginPhase(const Timing _phase)
+    {
+        VERIFY_OR_RETURN_VOID(_phase != Timing::Frame && _phase != Timing::Count);
+        VERIFY_OR_RETURN_VOID(m_phaseDepth < m_phaseStack.size());
+
+        AccumulatePhase(GetTime());
+        m_phaseStack[m_phaseDepth++] = _phase;
+    }
+
+    void FrameStatistics::EndPhase(const Timing _phase)
+    {
+        IF_NOT_VERIFY_MSG(m_phaseDepth > 1 && m_phaseStack[m_phaseDepth - 1] == _phase, "Mismatching phase end")
+        {
+            return;
+        }
+
+        AccumulatePhase(GetTime());
+        m_phaseDepth--;
+    }
+
+    void FrameStatistics::RecordZone(const char* _name, const u64 _start, const u64 _end)
+    {
+        const u64 index = m_zoneWriteIndex.fetch_add(1, std::memory_order_relaxed);
+        ZoneRecord& zone = m_zones[index % m_settings.m_zoneCapacity];
+
+        // Seqlock style publication, so the reader can detect records overwritten while it reads them.
+        zone.m_sequence.store(0, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        zone.m_name.store(_name, std::memory_order_relaxed);
+        zone.m_start.store(_start, std::memory_order_relaxed);
+        zone.m_end.store(_end, std::memory_order_relaxed);
+        zone.m_sequence.store(index + 1, std::memory_order_release);
+    }
+
+    const FrameStatistics::FrameRecord& FrameStatistics::EndFrame(const u64 _frameId)
+    {
+        KE_ZoneScopedFunction("FrameStatistics::EndFrame");
+
+        const u64 now = GetTime();
+        AccumulatePhase(now);
+        IF_NOT_VERIFY_MSG(m_phaseDepth == 1, "Frame ended with %u phases still open", m_phaseDepth - 1)
+        {
+            m_phaseDepth = 1;
+        }
+
+        FrameRecord& record = m_history[m_frameCount % m_history.size()];
+        record = {};
+        record.m_frameId = _frameId;
+        record.m_endTime = now;
+        record.m_timings = m_currentTimings;
+        record.m_timings[static_cast<u8>(Timing::Frame)] = now - m_frameStart;
+
+        const u64 frameStart = m_frameStart;
+        m_currentTimings = {};
+        m_frameStart = now;
+        m_frameCount++;
+
+        // The baseline excludes the current frame
+        GatherRollingTimings(Timing::Frame, 1);
+        if (m_sortedTimings.size() >= kMinSpikeBaselineFrames)
+        {
+            const u64 median = GetPercentile(m_sortedTimings, 0.5);
+            const u64 frameTime = record.GetTiming(Timing::Frame);
+            record.m_spike = static_cast<double>(frameTime) >= m_settings.m_spikeMedianRatio * static_cast<double>(median)
+                && frameTime >= median + m_settings.m_spikeMinExcess;
+        }
+
+        // Zones are consumed every frame, to keep room in the ring for the next ones
+        AttributeZones(record, frameStart, now);
+
+        if (record.m_spike)
+            m_spikeCount++;
+
+        if (m_settings.m_metrics != nullptr)
+        {
+            for (u8 i = 0; i < kTimingCount; i++)
+                m_settings.m_metrics->Record(m_timingHistograms[i], record.m_timings[i]);
+            if (record.m_spike)
+                m_settings.m_metrics->Increment(m_spikeCounter);
+        }
+
+        return record;
+    }
+
+    u32 FrameStatistics::GetFrameCount() const
+    {
+        return static_cast<u32>(eastl::min<u64>(m_frameCount, m_history.size()));
+    }
+
+    const FrameStatistics::FrameRecord& FrameStatistics::GetFrame(const u32 _age) const
+    {
+        KE_ASSERT(_age < GetFrameCount());
+        return m_history[(m_frameCount - 1 - _age) % m_history.size()];
+    }
+
+    FrameStatistics::RollingStatistics FrameStatistics::GetRollingStatistics(const Timing _timing) const
+    {
+        KE_ZoneScopedFunction("FrameStatistics::GetRollingStatistics");
+
+        RollingStatistics statistics {};
+        VERIFY_OR_RETURN(_timing != Timing::Count, statistics);
+
+        GatherRollingTimings(_timing, 0);
+        if (m_sortedTimings.empty())
+            return statistics;
+
+        statistics.m_frameCount = m_sortedTimings.size();
+        statistics.m_max = *eastl::max_element(m_sortedTimings.begin(), m_sortedTimings.end());
+        statistics.m_p50 = GetPercentile(m_sortedTimings, 0.5);
+        statistics.m_p95 = GetPercentile(m_sortedTimings, 0.95);
+        statistics.m_p99 = GetPercentile(m_sortedTimings, 0.99);
+        return statistics;
+    }
+
+    void FrameStatistics::WriteHistoryJson(eastl::string& _json) const
+    {
+        KE_ZoneScopedFunction("FrameStatistics::WriteHistoryJson");
+
+        _json.append("{\"frames\":[");
+        for (u32 age = GetFrameCount(); age-- > 0;)
+        {
+            const FrameRecord& record = GetFrame(age);
+            _json.append_sprintf("{\"id\":%llu", static_cast<unsigned long long>(record.m_frameId));
+            for (u8 i = 0; i < kTimingCount; i++)
+                _json.append_sprintf(",\"%s\":%llu", kTimingNames[i], static_cast<unsigned long long>(record.m_timings[i]));
+
+            if (record.m_spike)
+            {
+                _json.append(",\"spike\":true,\"zones\":[");
+                for (u8 i = 0; i < record.m_attributedZoneCount; i++)
+                {
+                    const ZoneAttribution& zone = record.m_attributedZones[i];
+                    _json.append(i > 0 ? ",{\"name\":" : "{\"name\":");
+                    AppendJsonString(_json, zone.m_name);
+                    _json.append_sprintf(
+                        ",\"count\":%u,\"duration\":%llu}",
+                        zone.m_count,
+                        static_cast<unsigned long long>(zone.m_duration));
+                }
+                _json.push_back(']');
+            }
+            _json.append(age > 0 ? "}," : "}");
+        }
+
+        _json.append_sprintf("],\"spikes\":%llu,\"rolling\":{", static_cast<unsigned long long>(m_spikeCount));
+        for (u8 i = 0; i < kTimingCount; i++)
+        {
+            const RollingStatistics statistics = GetRollingStatistics(static_cast<Timing>(i));
+            _json.append_sprintf(
+                "%s\"%s\":{\"p50\":%llu,\"p95\":%llu,\"p99\":%llu,\"max\":%llu}",
+                i > 0 ? "," : "",
+                kTimingNames[i],
+                static_cast<unsigned long long>(statistics.m_p50),
+                static_cast<unsigned long long>(statistics.m_p95),
+                static_cast<unsigned long long>(statistics.m_p99),
+                static_cast<unsigned long long>(statistics.m_max));
+        }
+        _json.append("}}");
+    }
+
+    void FrameStatistics::AccumulatePhase(const u64 _now)
+    {
+        m_currentTimings[static_cast<u8>(m_phaseStack[m_phaseDepth - 1])] += _now - m_phaseStart;
+        m_phaseStart = _now;
+    }
+
+    void FrameStatistics::AttributeZones(FrameRecord& _record, const u64 _frameStart, const u64 _frameEnd)
+    {
+        const u64 writeIndex = m_zoneWriteIndex.load(std::memory_order_acquire);
+        if (writeIndex - m_zoneReadIndex > m_settings.m_zoneCapacity)
+        {
+            m_droppedZoneCount += writeIndex - m_zoneReadIndex - m_settings.m_zoneCapacity;
+            m_zoneReadIndex = writeIndex - m_settings.m_zoneCapacity;
+        }
+
+        m_frameZones.clear();
+        for (; m_zoneReadIndex < writeIndex; m_zoneReadIndex++)
+        {
+            const ZoneRecord& zone = m_zones[m_zoneReadIndex % m_settings.m_zoneCapacity];
+            const u64 sequence = zone.m_sequence.load(std::memory_order_acquire);
+            if (sequence < m_zoneReadIndex + 1)
+            {
+                // Still being written, pick it up next frame.
+                break;
+            }
+
+            const char* name = zone.m_name.load(std::memory_order_relaxed);
+            const u64 start = zone.m_start.load(std::memory_order_relaxed);
+            const u64 end = zone.m_end.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (zone.m_sequence.load(std::memory_order_relaxed) != m_zoneReadIndex + 1)
+            {
+                // Overwritten by a writer that lapped the ring
+                m_droppedZoneCount++;
+                continue;
+            }
+
+            const u64 overlapStart = eastl::max(start, _frameStart);
+            const u64 overlapEnd = eastl::min(end, _frameEnd);
+            if (!_record.m_spike || overlapEnd <= overlapStart)
+                continue;
+
+            auto it = eastl::find_if(
+                m_frameZones.begin(),
+                m_frameZones.end(),
+                [name](const ZoneAttribution& _zone) { return _zone.m_name == name; });
+            if (it == m_frameZones.end())
+            {
+                m_frameZones.push_back({ name, 0, 0 });
+                it = m_frameZones.end() - 1;
+            }
+            it->m_count++;
+            it->m_duration += overlapEnd - overlapStart;
+        }
+
+        const size_t count = eastl::min<size_t>(m_frameZones.size(), kMaxAttributedZones);
+        eastl::partial_sort(
+            m_frameZones.begin(),
+            m_frameZones.begin() + count,
+            m_frameZones.end(),
+            [](const ZoneAttribution& _a, const ZoneAttribution& _b) { return _a.m_duration > _b.m_duration; });
+        for (size_t i = 0; i < count; i++)
+            _record.m_attributedZones[i] = m_frameZones[i];
+        _record.m_attributedZoneCount = count;
+    }
+
+    void FrameStatistics::GatherRollingTimings(const Timing _timing, const u32 _skippedFrames) const
+    {
+        m_sortedTimings.clear();
+        const u32 frameCount = GetFrameCount();
+        const u32 end = eastl::min(frameCount, _skippedFrames + m_settings.m_rollingWindow);
+        for (u32 age = _skippedFrames; age < end; age++)
+            m_sortedTimings.push_back(GetFrame(age).GetTiming(_timing));
+    }
+}
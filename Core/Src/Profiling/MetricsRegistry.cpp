@@ -0,0 +1,388 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Core/Profiling/MetricsRegistry.hpp"
+
+#include <thread>
+
+#include "KryneEngine/Core/Common/Assert.hpp"
+#include "KryneEngine/Core/Common/Utils/Alignment.hpp"
+#include "KryneEngine/Core/Profiling/TracyHeader.hpp"
+#include "KryneEngine/Core/Threads/HelperFunctions.hpp"
+
+namespace KryneEngine
+{
+    namespace
+    {
+        // The first slots are written to by the ids of failed registrations, and never read.
+        constexpr u32 kDiscardedSlotCount = MetricsRegistry::kHistogramBucketCount + 1;
+
+        constexpr u32 kSlotsPerCacheLine = Threads::kCacheLineSize / sizeof(std::atomic<u64>);
+
+        std::atomic<MetricsRegistry*> s_instance = nullptr;
+
+        void AppendJsonString(eastl::string& _json, const eastl::string_view _string)
+        {
+            _json.push_back('"');
+            for (const char c: _string)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    _json.push_back('\\');
+                    _json.push_back(c);
+                }
+                else if (static_cast<u8>(c) < 0x20)
+                {
+                    _json.append_sprintf("\\u%04x", c);
+                }
+                else
+                {
+                    _json.push_back(c);
+                }
+            }
+            _json.push_back('"');
+        }
+
+        void AppendPercentiles(
+            eastl::string& _json,
+            const char* _prefix,
+            const eastl::span<const u64> _buckets)
+        {
+            _json.append_sprintf(
+                ",\"%sp50\":%llu,\"%sp90\":%llu,\"%sp99\":%llu",
+                _prefix,
+                static_cast<unsigned long long>(MetricsRegistry::EstimatePercentile(_buckets, 0.5)),
+                _prefix,
+                static_cast<unsigned long long>(MetricsRegistry::EstimatePercentile(_buckets, 0.9)),
+                _prefix,
+                static_cast<unsigned long long>(MetricsRegistry::EstimatePercentile(_buckets, 0.99)));
+        }
+
+        template <class Connection, class... Args>
+        bool SendAll(Connection _connection, const eastl::span<char> _data, Args... _args)
+        {
+            size_t sent = 0;
+            while (sent < _data.size())
+            {
+                const size_t count = Platform::SendLocalIpc(_connection, _data.subspan(sent), _args...);
+                if (count == 0)
+                    return false;
+                sent += count;
+            }
+            return true;
+        }
+
+        template <class Connection, class... Args>
+        bool SendJsonSnapshot(const MetricsSnapshot& _snapshot, Connection _connection, Args... _args)
+        {
+            KE_ZoneScopedFunction("MetricsRegistry::SendSnapshot");
+
+            // Reserve the size prefix, then fill it once the JSON is written
+            eastl::string message(sizeof(u32), '\0');
+            MetricsRegistry::WriteJson(_snapshot, message);
+
+            const u32 size = message.size() - sizeof(u32);
+            for (u32 i = 0; i < sizeof(u32); i++)
+                message[i] = static_cast<char>((size >> (8 * i)) & 0xff);
+
+            return SendAll(_connection, { message.data(), message.size() }, _args...);
+        }
+    }
+
+    MetricsRegistry::MetricsRegistry(AllocatorInstance _allocator, u32 _shardCount, u32 _slotCapacity)
+        : m_allocator(_allocator)
+        , m_metrics(_allocator)
+    {
+        KE_ZoneScopedFunction("MetricsRegistry::MetricsRegistry");
+
+        if (_shardCount == 0)
+            _shardCount = std::thread::hardware_concurrency();
+        _shardCount = static_cast<u32>(Alignment::NextPowerOfTwo(eastl::clamp(_shardCount, 1u, kMaxShardCount)));
+        m_shardMask = _shardCount - 1;
+
+        KE_ASSERT_MSG(
+            _slotCapacity > kDiscardedSlotCount,
+            "Slot capacity must be greater than %u",
+            kDiscardedSlotCount);
+        m_slotCapacity = eastl::max(_slotCapacity, kDiscardedSlotCount);
+        m_usedSlots = kDiscardedSlotCount;
+
+        // Shards start on their own cache line, so threads never share lines
+        m_shardStride = Alignment::AlignUp(m_slotCapacity, kSlotsPerCacheLine);
+
+        const size_t slotCount = static_cast<size_t>(m_shardStride) * _shardCount;
+        m_slots = static_cast<std::atomic<u64>*>(m_allocator.allocate(
+            slotCount * sizeof(std::atomic<u64>),
+            Threads::kCacheLineSize));
+        for (size_t i = 0; i < slotCount; i++)
+            ::new(&m_slots[i]) std::atomic<u64>(0);
+    }
+
+    MetricsRegistry::~MetricsRegistry()
+    {
+        MetricsRegistry* self = this;
+        s_instance.compare_exchange_strong(self, nullptr);
+
+        m_allocator.deallocate(m_slots, static_cast<size_t>(m_shardStride) * GetShardCount() * sizeof(std::atomic<u64>));
+    }
+
+    MetricsRegistry* MetricsRegistry::GetInstance()
+    {
+        return s_instance.load(std::memory_order_acquire);
+    }
+
+    void MetricsRegistry::SetInstance(MetricsRegistry* _instance)
+    {
+        s_instance.store(_instance, std::memory_order_release);
+    }
+
+    MetricsCounterId MetricsRegistry::RegisterCounter(const eastl::string_view _name)
+    {
+        return { RegisterMetric(_name, MetricType::Counter) };
+    }
+
+    MetricsGaugeId MetricsRegistry::RegisterGauge(const eastl::string_view _name)
+    {
+        return { RegisterMetric(_name, MetricType::Gauge) };
+    }
+
+    MetricsHistogramId MetricsRegistry::RegisterHistogram(const eastl::string_view _name)
+    {
+        return { RegisterMetric(_name, MetricType::Histogram) };
+    }
+
+    const MetricsSnapshot& MetricsRegistry::CaptureFrame(const u64 _frameIndex)
+    {
+        KE_ZoneScopedFunction("MetricsRegistry::CaptureFrame");
+
+        const auto lock = m_lock.AutoLock();
+
+        m_snapshot.m_frameIndex = _frameIndex;
+        for (const MetricInfo& metric: m_metrics)
+        {
+            switch (metric.m_type)
+            {
+            case MetricType::Counter:
+            {
+                MetricsSnapshot::Counter& counter = m_snapshot.m_counters[metric.m_snapshotIndex];
+                const u64 total = SumShards(metric.m_slot);
+                counter.m_frameDelta = total - counter.m_total;
+                counter.m_total = total;
+                break;
+            }
+            case MetricType::Gauge:
+                m_snapshot.m_gauges[metric.m_snapshotIndex].m_value = static_cast<s64>(
+                    GetSlot(0, metric.m_slot).load(std::memory_order_relaxed));
+                break;
+            case MetricType::Histogram:
+            {
+                MetricsSnapshot::Histogram& histogram = m_snapshot.m_histograms[metric.m_snapshotIndex];
+                histogram.m_frameCount = 0;
+                for (u32 bucket = 0; bucket < kHistogramBucketCount; bucket++)
+                {
+                    const u64 total = SumShards(metric.m_slot + bucket);
+                    histogram.m_frameBuckets[bucket] = total - histogram.m_buckets[bucket];
+                    histogram.m_buckets[bucket] = total;
+                    histogram.m_frameCount += histogram.m_frameBuckets[bucket];
+                }
+                histogram.m_count += histogram.m_frameCount;
+
+                const u64 sum = SumShards(metric.m_slot + kHistogramBucketCount);
+                histogram.m_frameSum = sum - histogram.m_sum;
+                histogram.m_sum = sum;
+                break;
+            }
+            }
+        }
+
+        return m_snapshot;
+    }
+
+    u64 MetricsRegistry::GetHistogramBucketLowerBound(const u32 _bucket)
+    {
+        if (_bucket < kHistogramSubBucketCount)
+            return _bucket;
+
+        const u32 shift = _bucket / kHistogramSubBucketCount - 1;
+        const u64 subBucket = _bucket % kHistogramSubBucketCount;
+        return (kHistogramSubBucketCount + subBucket) << shift;
+    }
+
+    u64 MetricsRegistry::EstimatePercentile(const eastl::span<const u64> _buckets, const double _percentile)
+    {
+        u64 count = 0;
+        for (const u64 bucketCount: _buckets)
+            count += bucketCount;
+        if (count == 0)
+            return 0;
+
+        const u64 rank = eastl::max<u64>(1, static_cast<u64>(eastl::clamp(_percentile, 0.0, 1.0) * count + 0.5));
+        u64 cumulatedCount = 0;
+        for (u32 bucket = 0; bucket < _buckets.size(); bucket++)
+        {
+            cumulatedCount += _buckets[bucket];
+            if (cumulatedCount >= rank)
+            {
+                const u64 lowerBound = GetHistogramBucketLowerBound(bucket);
+                const u64 upperBound = GetHistogramBucketLowerBound(bucket + 1) - 1;
+                return lowerBound + (upperBound - lowerBound) / 2;
+            }
+        }
+        return kHistogramMaxValue;
+    }
+
+    void MetricsRegistry::WriteJson(const MetricsSnapshot& _snapshot, eastl::string& _json)
+    {
+        KE_ZoneScopedFunction("MetricsRegistry::WriteJson");
+
+        _json.append_sprintf("{\"frame\":%llu,\"counters\":{", static_cast<unsigned long long>(_snapshot.m_frameIndex));
+        for (size_t i = 0; i < _snapshot.m_counters.size(); i++)
+        {
+            const MetricsSnapshot::Counter& counter = _snapshot.m_counters[i];
+            if (i > 0)
+                _json.push_back(',');
+            AppendJsonString(_json, counter.m_name);
+            _json.append_sprintf(
+                ":{\"total\":%llu,\"frame\":%llu}",
+                static_cast<unsigned long long>(counter.m_total),
+                static_cast<unsigned long long>(counter.m_frameDelta));
+        }
+
+        _json.append("},\"gauges\":{");
+        for (size_t i = 0; i < _snapshot.m_gauges.size(); i++)
+        {
+            const MetricsSnapshot::Gauge& gauge = _snapshot.m_gauges[i];
+            if (i > 0)
+                _json.push_back(',');
+            AppendJsonString(_json, gauge.m_name);
+            _json.append_sprintf(":%lld", static_cast<long long>(gauge.m_value));
+        }
+
+        _json.append("},\"histograms\":{");
+        for (size_t i = 0; i < _snapshot.m_histograms.size(); i++)
+        {
+            const MetricsSnapshot::Histogram& histogram = _snapshot.m_histograms[i];
+            if (i > 0)
+                _json.push_back(',');
+            AppendJsonString(_json, histogram.m_name);
+            _json.append_sprintf(
+                ":{\"count\":%llu,\"sum\":%llu",
+                static_cast<unsigned long long>(histogram.m_count),
+                static_cast<unsigned long long>(histogram.m_sum));
+            AppendPercentiles(_json, "", histogram.m_buckets);
+            _json.append_sprintf(
+                ",\"frameCount\":%llu,\"frameSum\":%llu",
+                static_cast<unsigned long long>(histogram.m_frameCount),
+                static_cast<unsigned long long>(histogram.m_frameSum));
+            AppendPercentiles(_json, "frame", histogram.m_frameBuckets);
+
+            _json.append(",\"buckets\":[");
+            bool first = true;
+            for (u32 bucket = 0; bucket < histogram.m_buckets.size(); bucket++)
+            {
+                if (histogram.m_buckets[bucket] == 0)
+                    continue;
+                if (!first)
+                    _json.push_back(',');
+                first = false;
+                _json.append_sprintf(
+                    "[%llu,%llu]",
+                    static_cast<unsigned long long>(GetHistogramBucketLowerBound(bucket)),
+                    static_cast<unsigned long long>(histogram.m_buckets[bucket]));
+            }
+            _json.append("]}");
+        }
+        _json.append("}}");
+    }
+
+    bool MetricsRegistry::SendSnapshot(const Platform::LocalIpcChannel _channel, const MetricsSnapshot& _snapshot)
+    {
+        return SendJsonSnapshot(_snapshot, _channel);
+    }
+
+    bool MetricsRegistry::SendSnapshot(
+        const Platform::LocalIpcHost _connection,
+        const MetricsSnapshot& _snapshot,
+        const u32 _clientIdx)
+    {
+        return SendJsonSnapshot(_snapshot, _connection, _clientIdx);
+    }
+
+    u32 MetricsRegistry::AssignThreadIndex()
+    {
+        static std::atomic<u32> s_nextThreadIndex = 0;
+        return s_nextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    u32 MetricsRegistry::RegisterMetric(const eastl::string_view _name, const MetricType _type)
+    {
+        const auto lock = m_lock.AutoLock();
+
+        for (const MetricInfo& metric: m_metrics)
+        {
+            if (metric.m_name == _name)
+            {
+                IF_NOT_VERIFY_MSG(metric.m_type == _type, "Metric '%s' was registered with another type", metric.m_name.c_str())
+                {
+                    return 0;
+                }
+                return metric.m_slot;
+            }
+        }
+
+        // Histograms hold their buckets, followed by the sum of their values
+        const u32 slotCount = _type == MetricType::Histogram ? kHistogramBucketCount + 1 : 1;
+        IF_NOT_VERIFY_MSG(
+            m_usedSlots + slotCount <= m_slotCapacity,
+            "Metrics registry is full, can't register '%.*s'",
+            static_cast<int>(_name.size()),
+            _name.data())
+        {
+            return 0;
+        }
+
+        MetricInfo& metric = m_metrics.push_back();
+        metric.m_name.assign(_name.data(), _name.size());
+        metric.m_type = _type;
+        metric.m_slot = m_usedSlots;
+        m_usedSlots += slotCount;
+
+        switch (_type)
+        {
+        case MetricType::Counter:
+            metric.m_snapshotIndex = m_snapshot.m_counters.size();
+            m_snapshot.m_counters.push_back({ metric.m_name, 0, 0 });
+            break;
+        case MetricType::Gauge:
+            metric.m_snapshotIndex = m_snapshot.m_gauges.size();
+            m_snapshot.m_gauges.push_back({ metric.m_name, 0 });
+            break;
+        case MetricType::Histogram:
+        {
+            metric.m_snapshotIndex = m_snapshot.m_histograms.size();
+            MetricsSnapshot::Histogram& histogram = m_snapshot.m_histograms.push_back();
+            histogram.m_name = metric.m_name;
+            histogram.m_count = 0;
+            histogram.m_sum = 0;
+            histogram.m_frameCount = 0;
+            histogram.m_frameSum = 0;
+            histogram.m_buckets.resize(kHistogramBucketCount, 0);
+            histogram.m_frameBuckets.resize(kHistogramBucketCount, 0);
+            break;
+        }
+        }
+
+        return metric.m_slot;
+    }
+
+    u64 MetricsRegistry::SumShards(const u32 _slot) const
+    {
+        u64 sum = 0;
+        for (u32 shard = 0; shard <= m_shardMask; shard++)
+            sum += m_slots[shard * m_shardStride + _slot].load(std::memory_order_relaxed);
+        return sum;
+    }
+}
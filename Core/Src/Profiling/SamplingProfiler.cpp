@@ -0,0 +1,261 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Core/Profiling/SamplingProfiler.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <EASTL/algorithm.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/sort.h>
+#include <limits>
+
+#include "KryneEngine/Core/Common/Assert.hpp"
+#include "KryneEngine/Core/Platform/Platform.hpp"
+#include "KryneEngine/Core/Profiling/TracyHeader.hpp"
+#include "KryneEngine/Core/Threads/FibersManager.hpp"
+
+namespace KryneEngine
+{
+    namespace
+    {
+        struct CapturedActivity
+        {
+            const FiberThread::Activity* m_activity;
+            void (*m_jobFunction)(void*);
+            s32 m_fiberId;
+        };
+
+        // Called while the fiber thread is interrupted, so the activity matches the captured stack.
+        void CaptureActivity(void* _userData)
+        {
+            auto* captured = static_cast<CapturedActivity*>(_userData);
+            captured->m_jobFunction = captured->m_activity->m_jobFunction.load(std::memory_order_relaxed);
+            captured->m_fiberId = captured->m_activity->m_fiberId.load(std::memory_order_relaxed);
+        }
+    }
+
+    SamplingProfiler::SamplingProfiler(
+        const AllocatorInstance _allocator,
+        FibersManager* _fibersManager,
+        const Settings& _settings)
+            : m_allocator(_allocator)
+            , m_fibersManager(_fibersManager)
+            , m_settings(_settings)
+            , m_samples(_allocator)
+            , m_frames(_allocator)
+    {
+        KE_ASSERT(m_fibersManager != nullptr);
+        KE_ASSERT(m_settings.m_maxFrames > 0 && m_settings.m_maxFrames <= std::numeric_limits<u16>::max());
+    }
+
+    SamplingProfiler::~SamplingProfiler()
+    {
+        Stop();
+    }
+
+    bool SamplingProfiler::Start()
+    {
+        KE_ZoneScopedFunction("SamplingProfiler::Start");
+
+        VERIFY_OR_RETURN(m_fibersManager != nullptr, false);
+        IF_NOT_VERIFY_MSG(!IsRunning(), "Sampling profiler is already running")
+        {
+            return false;
+        }
+
+        if (!Platform::BeginThreadSampling())
+        {
+            return false;
+        }
+
+        m_running.store(true, std::memory_order_release);
+        m_thread = std::thread([this] { SamplingLoop(); });
+        return true;
+    }
+
+    void SamplingProfiler::Stop()
+    {
+        if (!m_running.exchange(false, std::memory_order_acq_rel))
+        {
+            return;
+        }
+
+        m_thread.join();
+        Platform::EndThreadSampling();
+    }
+
+    u64 SamplingProfiler::GetSampleCount() const
+    {
+        const auto lock = m_samplesLock.AutoLock();
+        return m_samples.size();
+    }
+
+    void SamplingProfiler::CopySamples(eastl::vector<Sample>& _samples, eastl::vector<uintptr_t>& _frames) const
+    {
+        const auto lock = m_samplesLock.AutoLock();
+        _samples.assign(m_samples.begin(), m_samples.end());
+        _frames.assign(m_frames.begin(), m_frames.end());
+    }
+
+    void SamplingProfiler::Clear()
+    {
+        const auto lock = m_samplesLock.AutoLock();
+        m_samples.clear();
+        m_frames.clear();
+        m_droppedSampleCount.store(0, std::memory_order_relaxed);
+    }
+
+    void SamplingProfiler::WriteFoldedStacks(eastl::string& _output, const bool _perFiberThread) const
+    {
+        KE_ZoneScopedFunction("SamplingProfiler::WriteFoldedStacks");
+
+        // Work on a copy, so symbol resolution doesn't block the sampling thread.
+        eastl::vector<Sample> samples(m_allocator);
+        eastl::vector<uintptr_t> frames(m_allocator);
+        CopySamples(samples, frames);
+
+        eastl::hash_map<uintptr_t, eastl::string> symbols(m_allocator);
+        const auto resolve = [&symbols](const uintptr_t _address) -> const eastl::string&
+        {
+            auto it = symbols.find(_address);
+            if (it == symbols.end())
+            {
+                eastl::string name;
+                if (!Platform::ResolveSymbolName(_address, name))
+                {
+                    name.sprintf("0x%zx", static_cast<size_t>(_address));
+                }
+                // ';' is the frame separator
+                eastl::replace(name.begin(), name.end(), ';', ':');
+                it = symbols.emplace(_address, eastl::move(name)).first;
+            }
+            return it->second;
+        };
+
+        eastl::hash_map<eastl::string, u64> stacks(m_allocator);
+        eastl::string stack;
+        for (const Sample& sample: samples)
+        {
+            stack.clear();
+            if (_perFiberThread)
+            {
+                stack.append_sprintf("Fiber thread %u;", sample.m_fiberThreadIndex);
+            }
+            stack += sample.m_jobFunction != nullptr
+                ? resolve(reinterpret_cast<uintptr_t>(sample.m_jobFunction))
+                : "[idle]";
+
+            // Frames are stored innermost first. Apart from the interrupted one, they are return addresses, which
+            // may point past the end of the calling function, hence the offset.
+            for (s32 i = static_cast<s32>(sample.m_frameCount) - 1; i >= 0; i--)
+            {
+                const uintptr_t address = frames[sample.m_firstFrame + i];
+                stack += ';';
+                stack += resolve(i > 0 ? address - 1 : address);
+            }
+
+            stacks[stack]++;
+        }
+
+        // Sort the stacks, for a stable output
+        eastl::vector<const eastl::hash_map<eastl::string, u64>::value_type*> sortedStacks(m_allocator);
+        sortedStacks.reserve(stacks.size());
+        for (const auto& entry: stacks)
+        {
+            sortedStacks.push_back(&entry);
+        }
+        eastl::sort(sortedStacks.begin(), sortedStacks.end(), [](const auto* _a, const auto* _b)
+        {
+            return _a->first < _b->first;
+        });
+
+        for (const auto* entry: sortedStacks)
+        {
+            _output.append(entry->first);
+            _output.append_sprintf(" %llu\n", static_cast<unsigned long long>(entry->second));
+        }
+    }
+
+    bool SamplingProfiler::SaveFoldedStacks(const char* _path, const bool _perFiberThread) const
+    {
+        eastl::string output;
+        WriteFoldedStacks(output, _perFiberThread);
+
+        FILE* file = fopen(_path, "wb");
+        IF_NOT_VERIFY_MSG(file != nullptr, "Unable to open '%s' for writing", _path)
+        {
+            return false;
+        }
+        const bool success = fwrite(output.data(), 1, output.size(), file) == output.size();
+        fclose(file);
+        return success;
+    }
+
+    void SamplingProfiler::SamplingLoop()
+    {
+        tracy::SetThreadName("Sampling profiler");
+
+        eastl::vector<uintptr_t> scratch(m_settings.m_maxFrames, m_allocator);
+
+        const std::chrono::microseconds interval(m_settings.m_samplingIntervalUs);
+        auto nextSampleTime = std::chrono::steady_clock::now();
+        while (m_running.load(std::memory_order_acquire))
+        {
+            for (u16 i = 0; i < m_fibersManager->GetFiberThreadCount(); i++)
+            {
+                SampleFiberThread(i, scratch);
+            }
+
+            // Don't try to catch up if sampling all threads took longer than the interval.
+            nextSampleTime = eastl::max(nextSampleTime + interval, std::chrono::steady_clock::now());
+            std::this_thread::sleep_until(nextSampleTime);
+        }
+    }
+
+    void SamplingProfiler::SampleFiberThread(const u16 _index, eastl::vector<uintptr_t>& _scratch)
+    {
+        const FiberThread& fiberThread = m_fibersManager->GetFiberThread(_index);
+
+        const Platform::ThreadSamplingTarget target = fiberThread.GetSamplingTarget();
+        if (!target.IsValid())
+        {
+            return;
+        }
+
+        CapturedActivity captured { &fiberThread.GetActivity(), nullptr, -1 };
+        const u32 frameCount = Platform::SampleThreadStack(
+            target,
+            { _scratch.data(), _scratch.size() },
+            CaptureActivity,
+            &captured);
+        if (frameCount == 0)
+        {
+            return;
+        }
+
+        const u64 time = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+
+        const auto lock = m_samplesLock.AutoLock();
+        if (m_samples.size() >= m_settings.m_sampleCapacity
+            || m_frames.size() + frameCount > m_settings.m_frameCapacity)
+        {
+            m_droppedSampleCount.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        m_samples.push_back({
+            .m_time = time,
+            .m_jobFunction = captured.m_jobFunction,
+            .m_fiberId = captured.m_fiberId,
+            .m_fiberThreadIndex = _index,
+            .m_frameCount = static_cast<u16>(frameCount),
+            .m_firstFrame = static_cast<u32>(m_frames.size()),
+        });
+        m_frames.insert(m_frames.end(), _scratch.begin(), _scratch.begin() + frameCount);
+    }
+}
@@ -33,6 +33,10 @@ namespace KryneEngine
 
                 KE_ASSERT(Threads::DisableThreadSignals());
 
+                // Must be done after disabling signals, as sampling may rely on one.
+                m_samplingTarget = Platform::RegisterThreadForSampling(_fiberManager->m_fiberThreads.GetAllocator());
+                m_samplingTargetReady.store(m_samplingTarget.IsValid(), std::memory_order_release);
+
                 FibersManager::s_manager = _fiberManager;
                 sThreadIndex = _threadIndex;
                 sIsThread = true;
@@ -43,6 +47,11 @@ namespace KryneEngine
                 SwitchToNextJob(_fiberManager, nullptr);
             }
 
+            if (m_samplingTargetReady.exchange(false, std::memory_order_acq_rel))
+            {
+                Platform::UnregisterThreadForSampling(m_samplingTarget, _fiberManager->m_fiberThreads.GetAllocator());
+            }
+
             TracyFiberLeave;
         });
 
@@ -64,6 +73,22 @@ namespace KryneEngine
         return sIsThread;
     }
 
+    Platform::ThreadSamplingTarget FiberThread::GetSamplingTarget() const
+    {
+        return m_samplingTargetReady.load(std::memory_order_acquire)
+            ? m_samplingTarget
+            : Platform::ThreadSamplingTarget { Platform::OpaqueHandle { Platform::OpaqueHandle::Error::Unknown } };
+    }
+
+    void FiberThread::_PublishActivity(const FiberJob* _job)
+    {
+        // Only read from this thread's signal handler, or while it is suspended, so no ordering is needed.
+        m_activity.m_jobFunction.store(_job != nullptr ? _job->m_functionPtr : nullptr, std::memory_order_relaxed);
+        m_activity.m_fiberId.store(
+            _job != nullptr ? _job->m_contextId : FiberJob::kInvalidContextId,
+            std::memory_order_relaxed);
+    }
+
     void FiberThread::SwitchToNextJob(FibersManager *_manager, FiberJob *_currentJob, FiberJob *_nextJob)
     {
         const auto fiberIndex = GetCurrentFiberThreadIndex();
@@ -24,6 +24,7 @@ namespace KryneEngine
         , m_currentJobs(_allocator)
         , m_nextJob(_allocator)
         , m_baseContexts(_allocator)
+        , m_telemetry(_allocator)
     {
         KE_ZoneScopedFunction("FibersManager::FibersManager()");
 
@@ -72,6 +73,8 @@ namespace KryneEngine
                 }
             });
 
+            m_telemetry._Init(fiberThreadCount);
+
             m_currentJobs.Init(this, nullptr);
             m_nextJob.Init(this, nullptr);
             m_baseContexts.InitFunc(
@@ -98,6 +101,8 @@ namespace KryneEngine
 
         KE_ASSERT(_job->CanRun());
 
+        m_telemetry._OnJobQueued(_job);
+
         const u8 priorityId = (u8)_job->GetPriorityType();
         if (FiberThread::IsFiberThread())
         {
@@ -194,6 +199,9 @@ namespace KryneEngine
         FiberJob* oldJob = m_currentJobs.Load(fiberIndex);
         FiberJob* newJob = m_nextJob.Load(fiberIndex);
 
+        m_fiberThreads[fiberIndex]._PublishActivity(newJob);
+        m_telemetry._OnContextSwitched(fiberIndex, oldJob, newJob);
+
         if (oldJob != nullptr && oldJob->GetStatus() == FiberJob::Status::Finished)
         {
             if (oldJob->m_associatedCounterId != kInvalidSyncCounterId)
@@ -293,7 +301,9 @@ namespace KryneEngine
         if (FiberThread::IsFiberThread())
         {
             auto* currentJob = GetCurrentJob();
-            if (!m_syncCounterPool.AddWaitingJob(_syncCounter, currentJob))
+            const bool blocking = !m_syncCounterPool.AddWaitingJob(_syncCounter, currentJob);
+            m_telemetry._OnCounterWait(true, FiberThread::GetCurrentFiberThreadIndex(), blocking);
+            if (blocking)
             {
                 YieldJob();
             }
@@ -302,6 +312,8 @@ namespace KryneEngine
         {
             KE_ZoneScopedFunction("FibersManager::WaitForCounter");
 
+            m_telemetry._OnCounterWait(false, 0, true);
+
             TracyLockable(std::mutex, waitMutex);
             struct Data {
                 std::condition_variable_any m_waitVariable {};
@@ -325,6 +337,15 @@ namespace KryneEngine
         }
     }
 
+    void FibersManager::CaptureTelemetry(SchedulerTelemetry::Snapshot& _snapshot) const
+    {
+        for (u8 i = 0; i < kJobQueuesCount; i++)
+        {
+            _snapshot.m_queueDepths[i] = m_jobQueues[i].size_approx();
+        }
+        m_telemetry.CaptureWorkers(_snapshot);
+    }
+
     void FibersManager::ResetCounter(SyncCounterId _syncCounter)
     {
         m_syncCounterPool.FreeCounter(_syncCounter);
@@ -0,0 +1,409 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Core/Threads/SchedulerTelemetry.hpp"
+
+#include <chrono>
+#include <EASTL/hash_map.h>
+
+#include "KryneEngine/Core/Common/Assert.hpp"
+#include "KryneEngine/Core/Common/Utils/Macros.hpp"
+#include "KryneEngine/Core/Platform/Platform.hpp"
+#include "KryneEngine/Core/Profiling/TracyHeader.hpp"
+
+namespace KryneEngine
+{
+    namespace
+    {
+        // Values are only written by a single thread, so no read-modify-write is needed.
+        KE_FORCEINLINE void Add(std::atomic<u64>& _value, const u64 _amount)
+        {
+            _value.store(_value.load(std::memory_order_relaxed) + _amount, std::memory_order_relaxed);
+        }
+
+        void AppendJsonString(eastl::string& _json, const eastl::string& _string)
+        {
+            _json += '"';
+            for (const char c: _string)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    _json += '\\';
+                    _json += c;
+                }
+                else if (static_cast<u8>(c) < 0x20)
+                {
+                    _json.append_sprintf("\\u%04x", c);
+                }
+                else
+                {
+                    _json += c;
+                }
+            }
+            _json += '"';
+        }
+    }
+
+    SchedulerTelemetry::WorkerCounters SchedulerTelemetry::Snapshot::GetTotalCounters() const
+    {
+        WorkerCounters total {};
+        for (const WorkerSnapshot& worker: m_workers)
+        {
+            total.m_startedJobs += worker.m_counters.m_startedJobs;
+            total.m_resumedJobs += worker.m_counters.m_resumedJobs;
+            total.m_finishedJobs += worker.m_counters.m_finishedJobs;
+            total.m_yields += worker.m_counters.m_yields;
+            total.m_fiberSwitches += worker.m_counters.m_fiberSwitches;
+            total.m_counterWaits += worker.m_counters.m_counterWaits;
+            total.m_blockingCounterWaits += worker.m_counters.m_blockingCounterWaits;
+            total.m_busyTime += worker.m_counters.m_busyTime;
+            total.m_idleTime += worker.m_counters.m_idleTime;
+        }
+        return total;
+    }
+
+    SchedulerTelemetry::SchedulerTelemetry(const AllocatorInstance _allocator)
+        : m_workers(_allocator)
+    {}
+
+    SchedulerTelemetry::~SchedulerTelemetry()
+    {
+        if (m_traceCapacity > 0)
+        {
+            for (Worker& worker: m_workers)
+            {
+                m_workers.GetAllocator().deallocate(worker.m_traceEvents, sizeof(TraceEvent) * m_traceCapacity);
+            }
+        }
+    }
+
+    void SchedulerTelemetry::_Init(const u16 _fiberThreadCount)
+    {
+        m_workers.Resize(_fiberThreadCount);
+        m_workers.InitAll();
+    }
+
+    void SchedulerTelemetry::SetEnabled(const bool _enabled)
+    {
+        if (_enabled && !IsEnabled())
+        {
+            // Time spent before enabling is not accounted for
+            m_enableTime.store(GetTime(), std::memory_order_relaxed);
+        }
+        m_enabled.store(_enabled, std::memory_order_release);
+    }
+
+    void SchedulerTelemetry::SetTracingEnabled(const bool _enabled, const u32 _eventCapacity)
+    {
+        KE_ZoneScopedFunction("SchedulerTelemetry::SetTracingEnabled");
+
+        if (_enabled && m_traceCapacity == 0)
+        {
+            VERIFY_OR_RETURN_VOID(_eventCapacity > 0);
+
+            // Buffers are published by the tracing flag release below
+            m_traceCapacity = _eventCapacity;
+            for (Worker& worker: m_workers)
+            {
+                worker.m_traceEvents = static_cast<TraceEvent*>(m_workers.GetAllocator().allocate(
+                    sizeof(TraceEvent) * m_traceCapacity,
+                    alignof(TraceEvent)));
+            }
+        }
+        m_tracingEnabled.store(_enabled, std::memory_order_release);
+    }
+
+    void SchedulerTelemetry::Reset()
+    {
+        KE_ASSERT_MSG(!IsEnabled(), "Telemetry should be disabled before being reset");
+
+        for (Worker& worker: m_workers)
+        {
+            for (std::atomic<u64>* counter: {
+                     &worker.m_startedJobs,
+                     &worker.m_resumedJobs,
+                     &worker.m_finishedJobs,
+                     &worker.m_yields,
+                     &worker.m_fiberSwitches,
+                     &worker.m_counterWaits,
+                     &worker.m_blockingCounterWaits,
+                     &worker.m_busyTime,
+                     &worker.m_idleTime,
+                     &worker.m_droppedTraceEvents })
+            {
+                counter->store(0, std::memory_order_relaxed);
+            }
+            for (u32 i = 0; i < MetricsRegistry::kHistogramBucketCount; i++)
+            {
+                worker.m_latency[i].store(0, std::memory_order_relaxed);
+                worker.m_duration[i].store(0, std::memory_order_relaxed);
+            }
+            worker.m_traceEventCount.store(0, std::memory_order_release);
+        }
+        m_queuedJobs.store(0, std::memory_order_relaxed);
+        m_externalCounterWaits.store(0, std::memory_order_relaxed);
+    }
+
+    void SchedulerTelemetry::CaptureWorkers(Snapshot& _snapshot) const
+    {
+        _snapshot.m_queuedJobs = m_queuedJobs.load(std::memory_order_relaxed);
+        _snapshot.m_externalCounterWaits = m_externalCounterWaits.load(std::memory_order_relaxed);
+
+        _snapshot.m_workers.resize(m_workers.Size());
+        for (u32 i = 0; i < m_workers.Size(); i++)
+        {
+            const Worker& worker = m_workers[i];
+            WorkerSnapshot& workerSnapshot = _snapshot.m_workers[i];
+
+            workerSnapshot.m_counters = {
+                .m_startedJobs = worker.m_startedJobs.load(std::memory_order_relaxed),
+                .m_resumedJobs = worker.m_resumedJobs.load(std::memory_order_relaxed),
+                .m_finishedJobs = worker.m_finishedJobs.load(std::memory_order_relaxed),
+                .m_yields = worker.m_yields.load(std::memory_order_relaxed),
+                .m_fiberSwitches = worker.m_fiberSwitches.load(std::memory_order_relaxed),
+                .m_counterWaits = worker.m_counterWaits.load(std::memory_order_relaxed),
+                .m_blockingCounterWaits = worker.m_blockingCounterWaits.load(std::memory_order_relaxed),
+                .m_busyTime = worker.m_busyTime.load(std::memory_order_relaxed),
+                .m_idleTime = worker.m_idleTime.load(std::memory_order_relaxed),
+            };
+
+            workerSnapshot.m_latencyBuckets.resize(MetricsRegistry::kHistogramBucketCount);
+            workerSnapshot.m_durationBuckets.resize(MetricsRegistry::kHistogramBucketCount);
+            for (u32 j = 0; j < MetricsRegistry::kHistogramBucketCount; j++)
+            {
+                workerSnapshot.m_latencyBuckets[j] = worker.m_latency[j].load(std::memory_order_relaxed);
+                workerSnapshot.m_durationBuckets[j] = worker.m_duration[j].load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    u64 SchedulerTelemetry::GetDroppedTraceEventCount() const
+    {
+        u64 count = 0;
+        for (const Worker& worker: m_workers)
+        {
+            count += worker.m_droppedTraceEvents.load(std::memory_order_relaxed);
+        }
+        return count;
+    }
+
+    void SchedulerTelemetry::WriteChromeTrace(eastl::string& _json) const
+    {
+        KE_ZoneScopedFunction("SchedulerTelemetry::WriteChromeTrace");
+
+        eastl::hash_map<uintptr_t, eastl::string> names(m_workers.GetAllocator());
+        const auto getName = [&names](FiberJob::JobFunc* _function) -> const eastl::string&
+        {
+            const auto address = reinterpret_cast<uintptr_t>(_function);
+            auto it = names.find(address);
+            if (it == names.end())
+            {
+                eastl::string name;
+                if (!Platform::ResolveSymbolName(address, name))
+                {
+                    name.sprintf("0x%zx", static_cast<size_t>(address));
+                }
+                it = names.emplace(address, eastl::move(name)).first;
+            }
+            return it->second;
+        };
+
+        // Timestamps are relative to the earliest event
+        u64 origin = ~0ull;
+        for (const Worker& worker: m_workers)
+        {
+            if (worker.m_traceEventCount.load(std::memory_order_acquire) > 0)
+            {
+                origin = eastl::min(origin, worker.m_traceEvents[0].m_time);
+            }
+        }
+
+        _json += "{\"traceEvents\":[";
+        bool first = true;
+        for (u32 i = 0; i < m_workers.Size(); i++)
+        {
+            if (!first)
+            {
+                _json += ',';
+            }
+            first = false;
+            _json.append_sprintf(
+                R"({"name":"thread_name","ph":"M","pid":0,"tid":%u,"args":{"name":"Fiber thread %u"}})",
+                i,
+                i);
+
+            const Worker& worker = m_workers[i];
+            const u32 eventCount = worker.m_traceEventCount.load(std::memory_order_acquire);
+
+            // Only close slices that were opened in the trace, as tracing may have been enabled mid-job.
+            bool sliceOpen = false;
+            for (u32 j = 0; j < eventCount; j++)
+            {
+                const TraceEvent& event = worker.m_traceEvents[j];
+                const double timestamp = static_cast<double>(event.m_time - origin) / 1000.0;
+
+                switch (event.m_type)
+                {
+                case TraceEventType::Begin:
+                case TraceEventType::Resume:
+                    _json += R"(,{"name":)";
+                    AppendJsonString(_json, getName(event.m_function));
+                    _json.append_sprintf(
+                        R"(,"cat":"job","ph":"B","ts":%.3f,"pid":0,"tid":%u,"args":{"fiber":%d,"resumed":%s}})",
+                        timestamp,
+                        i,
+                        event.m_fiberId,
+                        event.m_type == TraceEventType::Resume ? "true" : "false");
+                    sliceOpen = true;
+                    break;
+                case TraceEventType::Yield:
+                case TraceEventType::End:
+                    if (sliceOpen)
+                    {
+                        _json.append_sprintf(
+                            R"(,{"ph":"E","ts":%.3f,"pid":0,"tid":%u,"args":{"finished":%s}})",
+                            timestamp,
+                            i,
+                            event.m_type == TraceEventType::End ? "true" : "false");
+                    }
+                    sliceOpen = false;
+                    break;
+                }
+            }
+        }
+        _json += "],\"displayTimeUnit\":\"ns\"}";
+    }
+
+    void SchedulerTelemetry::_OnCounterWait(const bool _isFiberThread, const u16 _fiberIndex, const bool _blocking)
+    {
+        if (!IsEnabled()) [[likely]]
+        {
+            return;
+        }
+
+        if (_isFiberThread)
+        {
+            Worker& worker = m_workers[_fiberIndex];
+            Add(worker.m_counterWaits, 1);
+            if (_blocking)
+            {
+                Add(worker.m_blockingCounterWaits, 1);
+            }
+        }
+        else
+        {
+            m_externalCounterWaits.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    u64 SchedulerTelemetry::GetTime()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void SchedulerTelemetry::_RecordJobQueued(FiberJob* _job)
+    {
+        // Paused jobs are queued again when resumed, only track the first queueing.
+        if (_job->GetStatus() == FiberJob::Status::PendingStart && _job->m_queueTime == 0)
+        {
+            _job->m_queueTime = GetTime();
+            m_queuedJobs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    void SchedulerTelemetry::_RecordContextSwitch(const u16 _fiberIndex, FiberJob* _oldJob, FiberJob* _newJob)
+    {
+        Worker& worker = m_workers[_fiberIndex];
+
+        const u64 now = GetTime();
+        const u64 enableTime = m_enableTime.load(std::memory_order_relaxed);
+        const u64 segmentDuration = now - eastl::max(worker.m_segmentStart, enableTime);
+        worker.m_segmentStart = now;
+
+        const bool tracing = IsTracingEnabled();
+
+        if (_oldJob == nullptr)
+        {
+            Add(worker.m_idleTime, segmentDuration);
+        }
+        else
+        {
+            const bool finished = _oldJob->GetStatus() == FiberJob::Status::Finished;
+
+            // Trace first, so the event is visible once the job is counted as finished.
+            if (tracing)
+            {
+                PushTraceEvent(worker, {
+                    .m_time = now,
+                    .m_function = _oldJob->m_functionPtr,
+                    .m_fiberId = _oldJob->m_contextId,
+                    .m_type = finished ? TraceEventType::End : TraceEventType::Yield,
+                });
+            }
+
+            Add(worker.m_busyTime, segmentDuration);
+
+            // A paused job may already be resumed on another thread, hence the atomic addition.
+            const u64 runTime = _oldJob->m_runTime.fetch_add(segmentDuration, std::memory_order_relaxed)
+                + segmentDuration;
+
+            if (finished)
+            {
+                Add(worker.m_finishedJobs, 1);
+                if (_oldJob->m_queueTime >= enableTime)
+                {
+                    Add(worker.m_duration[MetricsRegistry::GetHistogramBucket(runTime)], 1);
+                }
+            }
+            else
+            {
+                Add(worker.m_yields, 1);
+            }
+        }
+
+        if (_newJob != nullptr)
+        {
+            const bool starting = _newJob->GetStatus() == FiberJob::Status::PendingStart;
+            if (starting)
+            {
+                Add(worker.m_startedJobs, 1);
+                if (_newJob->m_queueTime >= enableTime)
+                {
+                    Add(worker.m_latency[MetricsRegistry::GetHistogramBucket(now - _newJob->m_queueTime)], 1);
+                }
+            }
+            else
+            {
+                Add(worker.m_resumedJobs, 1);
+            }
+
+            if (tracing)
+            {
+                PushTraceEvent(worker, {
+                    .m_time = now,
+                    .m_function = _newJob->m_functionPtr,
+                    .m_fiberId = _newJob->m_contextId,
+                    .m_type = starting ? TraceEventType::Begin : TraceEventType::Resume,
+                });
+            }
+        }
+
+        Add(worker.m_fiberSwitches, 1);
+    }
+
+    void SchedulerTelemetry::PushTraceEvent(Worker& _worker, const TraceEvent& _event) const
+    {
+        const u32 index = _worker.m_traceEventCount.load(std::memory_order_relaxed);
+        if (index >= m_traceCapacity)
+        {
+            Add(_worker.m_droppedTraceEvents, 1);
+            return;
+        }
+        _worker.m_traceEvents[index] = _event;
+        _worker.m_traceEventCount.store(index + 1, std::memory_order_release);
+    }
+}
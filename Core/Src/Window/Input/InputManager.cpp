@@ -14,13 +14,17 @@
 
 namespace KryneEngine
 {
-    InputManager::InputManager(Window* _window, AllocatorInstance _allocator)
-        : m_keyInputEventListeners(_allocator)
+    InputManager::InputManager(Window* _window, AllocatorInstance _allocator, u32 _eventQueueCapacity)
+        : m_eventQueue(_allocator, _eventQueueCapacity)
+        , m_keyInputEventListeners(_allocator)
         , m_textInputEventListeners(_allocator)
         , m_cursorPosEventListeners(_allocator)
         , m_mouseInputEventListeners(_allocator)
         , m_scrollInputEventListeners(_allocator)
     {
+        if (_window == nullptr)
+            return;
+
         GLFWwindow* glfwWindow = _window->GetGlfwWindow();
 
         glfwSetKeyCallback(glfwWindow, KeyCallback);
@@ -32,77 +36,123 @@ namespace KryneEngine
 
     u32 InputManager::RegisterKeyInputEventCallback(eastl::function<void(const KeyInputEvent&)>&& _callback)
     {
-        const auto lock = m_mutex.AutoLock();
-
-        const u32 id = m_keyInputEventCounter++;
-        m_keyInputEventListeners.emplace(id, _callback);
-        return id;
+        return m_keyInputEventListeners.Register(eastl::move(_callback));
     }
 
     void InputManager::UnregisterKeyInputEventCallback(u32 _id)
     {
-        const auto lock = m_mutex.AutoLock();
-        m_keyInputEventListeners.erase(_id);
+        m_keyInputEventListeners.Unregister(_id);
     }
 
     u32 InputManager::RegisterTextInputEventCallback(eastl::function<void(u32)>&& _callback)
     {
-        const auto lock = m_mutex.AutoLock();
-
-        const u32 id = m_textInputEventCounter++;
-        m_textInputEventListeners.emplace(id, _callback);
-        return id;
+        return m_textInputEventListeners.Register(eastl::move(_callback));
     }
 
     void InputManager::UnregisterTextInputEventCallback(u32 _id)
     {
-        const auto lock = m_mutex.AutoLock();
-        m_textInputEventListeners.erase(_id);
+        m_textInputEventListeners.Unregister(_id);
     }
 
     u32 InputManager::RegisterCursorPosEventCallback(eastl::function<void(float, float)>&& _callback)
     {
-        const auto lock = m_mutex.AutoLock();
-
-        const u32 id = m_cursorPosEventCounter++;
-        m_cursorPosEventListeners.emplace(id, _callback);
-        return id;
+        return m_cursorPosEventListeners.Register(eastl::move(_callback));
     }
 
     void InputManager::UnregisterCursorPosEventCallback(u32 _id)
     {
-        const auto lock = m_mutex.AutoLock();
-        m_cursorPosEventListeners.erase(_id);
+        m_cursorPosEventListeners.Unregister(_id);
     }
 
     u32 InputManager::RegisterMouseInputEventCallback(eastl::function<void(const MouseInputEvent&)>&& _callback)
     {
-        const auto lock = m_mutex.AutoLock();
-
-        const u32 id = m_mouseInputEventCounter++;
-        m_mouseInputEventListeners.emplace(id, _callback);
-        return id;
+        return m_mouseInputEventListeners.Register(eastl::move(_callback));
     }
 
     void InputManager::UnregisterMouseInputEventCallback(u32 _id)
     {
-        const auto lock = m_mutex.AutoLock();
-        m_mouseInputEventListeners.erase(_id);
+        m_mouseInputEventListeners.Unregister(_id);
     }
 
     u32 InputManager::RegisterScrollInputEventCallback(eastl::function<void(float, float)>&& _callback)
     {
-        const auto lock = m_mutex.AutoLock();
-
-        const u32 id = m_scrollInputEventCounter++;
-        m_scrollInputEventListeners.emplace(id, _callback);
-        return id;
+        return m_scrollInputEventListeners.Register(eastl::move(_callback));
     }
 
     void InputManager::UnregisterScrollInputEventCallback(u32 _id)
     {
-        const auto lock = m_mutex.AutoLock();
-        m_scrollInputEventListeners.erase(_id);
+        m_scrollInputEventListeners.Unregister(_id);
+    }
+
+    bool InputManager::PushEvent(const InputEvent& _event)
+    {
+        if (!TryPushEvent(_event))
+        {
+            m_droppedEventCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        return true;
+    }
+
+    bool InputManager::TryPushEvent(const InputEvent& _event)
+    {
+        return m_eventQueue.TryPush(_event);
+    }
+
+    u32 InputManager::DispatchEvents()
+    {
+        KE_ZoneScopedFunction("InputManager::DispatchEvents");
+
+        // No dispatch is running at this point, so lists replaced since the last call can be released.
+        m_keyInputEventListeners.ReclaimRetired();
+        m_textInputEventListeners.ReclaimRetired();
+        m_cursorPosEventListeners.ReclaimRetired();
+        m_mouseInputEventListeners.ReclaimRetired();
+        m_scrollInputEventListeners.ReclaimRetired();
+
+        // Only drain what was queued before this call, so a producer can't keep the consumer busy indefinitely.
+        u32 remaining = m_eventQueue.GetApproximateSize();
+        u32 dispatched = 0;
+
+        InputEvent batch[kDispatchBatchSize];
+        while (remaining > 0)
+        {
+            const u32 count = m_eventQueue.PopBatch(batch, eastl::min(remaining, kDispatchBatchSize));
+            if (count == 0)
+                break;
+
+            for (u32 i = 0; i < count; i++)
+                Dispatch(batch[i]);
+
+            remaining -= count;
+            dispatched += count;
+        }
+
+        return dispatched;
+    }
+
+    void InputManager::Dispatch(const InputEvent& _event)
+    {
+        switch (_event.m_type)
+        {
+        case InputEvent::Type::Key:
+            m_keyInputEventListeners.Dispatch(_event.m_key);
+            break;
+        case InputEvent::Type::Text:
+            m_textInputEventListeners.Dispatch(_event.m_char);
+            break;
+        case InputEvent::Type::CursorPos:
+            // Only updated on the dispatching thread, so the position matches the events seen so far.
+            m_cursorPos = { _event.m_cursorPos.m_x, _event.m_cursorPos.m_y };
+            m_cursorPosEventListeners.Dispatch(_event.m_cursorPos.m_x, _event.m_cursorPos.m_y);
+            break;
+        case InputEvent::Type::MouseButton:
+            m_mouseInputEventListeners.Dispatch(_event.m_mouseButton);
+            break;
+        case InputEvent::Type::Scroll:
+            m_scrollInputEventListeners.Dispatch(_event.m_scroll.m_x, _event.m_scroll.m_y);
+            break;
+        }
     }
 
     void InputManager::KeyCallback(GLFWwindow* _window, s32 _key, s32 _scancode, s32 _action, s32 _mods)
@@ -111,19 +161,14 @@ namespace KryneEngine
 
         InputManager* inputManager = (static_cast<Window*>(glfwGetWindowUserPointer(_window)))->GetInputManager();
 
-        const KeyInputEvent keyInputEvent {
+        InputEvent event { .m_type = InputEvent::Type::Key };
+        event.m_key = {
             .m_physicalKey = GLFW::ToInputPhysicalKeys(_key),
             .m_customCode = _scancode,
             .m_action = GLFW::ToInputEventAction(_action),
             .m_modifiers = GLFW::ToInputEventModifiers(_mods),
         };
-
-        const auto lock = inputManager->m_mutex.AutoLock();
-
-        for (const auto& pair : inputManager->m_keyInputEventListeners)
-        {
-            pair.second(keyInputEvent);
-        }
+        inputManager->PushEvent(event);
     }
 
     void InputManager::TextCallback(GLFWwindow* _window, u32 _char)
@@ -132,12 +177,9 @@ namespace KryneEngine
 
         InputManager* inputManager = (static_cast<Window*>(glfwGetWindowUserPointer(_window)))->GetInputManager();
 
-        const auto lock = inputManager->m_mutex.AutoLock();
-
-        for (const auto& pair: inputManager->m_textInputEventListeners)
-        {
-            pair.second(_char);
-        }
+        InputEvent event { .m_type = InputEvent::Type::Text };
+        event.m_char = _char;
+        inputManager->PushEvent(event);
     }
 
     void InputManager::CursorPosCallback(GLFWwindow* _window, double _posX, double _posY)
@@ -145,17 +187,10 @@ namespace KryneEngine
         KE_ZoneScopedFunction("InputManager::CursorPosCallback");
 
         InputManager* inputManager = (static_cast<Window*>(glfwGetWindowUserPointer(_window)))->GetInputManager();
-        inputManager->m_cursorPos = {
-            _posX,
-            _posY
-        };
-
-        const auto lock = inputManager->m_mutex.AutoLock();
 
-        for (const auto& pair : inputManager->m_cursorPosEventListeners)
-        {
-            pair.second(static_cast<float>(_posX), static_cast<float>(_posY));
-        }
+        InputEvent event { .m_type = InputEvent::Type::CursorPos };
+        event.m_cursorPos = { static_cast<float>(_posX), static_cast<float>(_posY) };
+        inputManager->PushEvent(event);
     }
 
     void InputManager::MouseButtonInputCallback(GLFWwindow* _window, s32 _button, s32 _action, s32 _mods)
@@ -164,18 +199,13 @@ namespace KryneEngine
 
         InputManager* inputManager = (static_cast<Window*>(glfwGetWindowUserPointer(_window)))->GetInputManager();
 
-        const MouseInputEvent mouseInputEvent{
+        InputEvent event { .m_type = InputEvent::Type::MouseButton };
+        event.m_mouseButton = {
             .m_mouseButton = GLFW::ToMouseInputButton(_button),
             .m_action = GLFW::ToInputEventAction(_action),
             .m_modifiers = GLFW::ToInputEventModifiers(_mods),
         };
-
-        const auto lock = inputManager->m_mutex.AutoLock();
-
-        for (const auto& pair : inputManager->m_mouseInputEventListeners)
-        {
-            pair.second(mouseInputEvent);
-        }
+        inputManager->PushEvent(event);
     }
 
     void InputManager::ScrollCallback(GLFWwindow* _window, double _xScroll, double _yScroll)
@@ -184,11 +214,8 @@ namespace KryneEngine
 
         InputManager* inputManager = (static_cast<Window*>(glfwGetWindowUserPointer(_window)))->GetInputManager();
 
-        const auto lock = inputManager->m_mutex.AutoLock();
-
-        for (const auto& pair : inputManager->m_scrollInputEventListeners)
-        {
-            pair.second(static_cast<float>(_xScroll), static_cast<float>(_yScroll));
-        }
+        InputEvent event { .m_type = InputEvent::Type::Scroll };
+        event.m_scroll = { static_cast<float>(_xScroll), static_cast<float>(_yScroll) };
+        inputManager->PushEvent(event);
     }
 } // namespace KryneEngine
\ No newline at end of file
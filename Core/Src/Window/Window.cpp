@@ -73,6 +73,7 @@ namespace KryneEngine
 
         m_resizedThisFrame = false;
         glfwPollEvents();
+        m_inputManager->DispatchEvents();
 
         return !glfwWindowShouldClose(m_glfwWindow);
     }
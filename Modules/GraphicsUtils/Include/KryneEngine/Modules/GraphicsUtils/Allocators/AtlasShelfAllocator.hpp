@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <EASTL/set.h>
+#include <EASTL/span.h>
 #include <EASTL/vector_map.h>
 
 #include <KryneEngine/Core/Math/Vector.hpp>
@@ -14,6 +16,16 @@
 
 namespace KryneEngine::Modules::GraphicsUtils
 {
+    /**
+     * @brief A shelf packing allocator for 2D texture atlases.
+     *
+     * @details
+     * Shelves are bucketed by height category. Each shelf tracks the width of its largest free run, and all shelves are
+     * indexed by (category, largest free run), so finding a shelf that fits a slot is a best-fit lookup in O(log n)
+     * instead of a walk over every shelf of the category.
+     * Free runs inside a shelf are indexed by start and by width, so carving a run and coalescing a freed slot with its
+     * neighbours are also O(log n), whatever the shelf fragmentation.
+     */
     class AtlasShelfAllocator
     {
         friend class AtlasShelfAllocatorExplorator; // For unit tests
@@ -30,10 +42,39 @@ namespace KryneEngine::Modules::GraphicsUtils
         AtlasShelfAllocator(AllocatorInstance _cpuAllocator, const Configuration& _config);
 
         u32 Allocate(uint2 _slotSize);
+
+        /**
+         * @brief Allocates a batch of slots, tallest first for better packing.
+         *
+         * @param _outSlots Receives the slot of each size, in the same order. Failed allocations are set to
+         * `kInvalidSlot`.
+         * @return The number of successful allocations.
+         */
+        u32 AllocateMany(eastl::span<const uint2> _slotSizes, eastl::span<u32> _outSlots);
+
         void Free(u32 _slot);
 
         [[nodiscard]] Rect GetSlotRect(u32 _slot) const;
 
+        struct Metrics
+        {
+            u32 m_slotCount = 0;
+            u32 m_shelfCount = 0;
+            u64 m_atlasArea = 0;
+            u64 m_shelfArea = 0;
+            u64 m_allocatedArea = 0;
+            /// Ratio of the atlas area covered by allocated slots.
+            float m_occupancy = 0.f;
+            /// Ratio of the shelves area covered by allocated slots.
+            float m_shelfOccupancy = 0.f;
+            /// Ratio of the free shelf area that is not part of its shelf largest free run. 0 means no fragmentation.
+            float m_fragmentation = 0.f;
+        };
+
+        [[nodiscard]] Metrics ComputeMetrics() const;
+
+        static constexpr u32 kInvalidSlot = ~0u;
+
     private:
         struct FreeShelfEntry
         {
@@ -46,10 +87,27 @@ namespace KryneEngine::Modules::GraphicsUtils
             u32 m_start = 0;
             u32 m_size = 0;
             u32 m_firstFree = 0;
+            u32 m_largestFree = 0;
             u32 m_next = 0;
             u32 m_previous = 0;
         };
 
+        struct AvailableShelfKey
+        {
+            u32 m_category;
+            u32 m_largestFree;
+            u32 m_shelf;
+
+            bool operator<(const AvailableShelfKey& _other) const
+            {
+                if (m_category != _other.m_category)
+                    return m_category < _other.m_category;
+                if (m_largestFree != _other.m_largestFree)
+                    return m_largestFree < _other.m_largestFree;
+                return m_shelf < _other.m_shelf;
+            }
+        };
+
         struct FreeSlotEntry
         {
             u32 m_start = 0;
@@ -58,6 +116,37 @@ namespace KryneEngine::Modules::GraphicsUtils
             u32 m_previous = 0;
         };
 
+        struct FreeRunStartKey
+        {
+            u32 m_shelf;
+            u32 m_start;
+            u32 m_freeSlot;
+
+            bool operator<(const FreeRunStartKey& _other) const
+            {
+                if (m_shelf != _other.m_shelf)
+                    return m_shelf < _other.m_shelf;
+                return m_start < _other.m_start;
+            }
+        };
+
+        struct FreeRunWidthKey
+        {
+            u32 m_shelf;
+            u32 m_width;
+            u32 m_start;
+            u32 m_freeSlot;
+
+            bool operator<(const FreeRunWidthKey& _other) const
+            {
+                if (m_shelf != _other.m_shelf)
+                    return m_shelf < _other.m_shelf;
+                if (m_width != _other.m_width)
+                    return m_width < _other.m_width;
+                return m_start < _other.m_start;
+            }
+        };
+
         struct SlotEntry
         {
             u32 m_shelf = ~0u;
@@ -66,7 +155,6 @@ namespace KryneEngine::Modules::GraphicsUtils
         };
 
         static constexpr u32 kBlockAlignment = 4;
-        static constexpr u32 kInvalidSlot = ~0u;
 
         AllocatorInstance m_cpuAllocator;
         uint2 m_atlasSize;
@@ -77,15 +165,26 @@ namespace KryneEngine::Modules::GraphicsUtils
         eastl::vector<FreeShelfEntry> m_freeShelves;
         VectorDeLinkedList<ShelfEntry> m_shelves;
         eastl::vector_map<u32, u32> m_shelfCategories;
+        eastl::set<AvailableShelfKey> m_availableShelves;
         VectorDeLinkedList<FreeSlotEntry> m_freeSlots;
+        eastl::set<FreeRunStartKey> m_freeRunsByStart;
+        eastl::set<FreeRunWidthKey> m_freeRunsByWidth;
         eastl::vector<SlotEntry> m_slots;
         u32 m_nextSlotIndex = kInvalidSlot;
 
         void FreeShelf(FreeShelfEntry _freedShelf);
+        void FreeInShelf(const SlotEntry& _slot);
 
-        u32 FindSlot(u32 _width, u32 _shelfIndex, bool _allocateShelfIfNeeded);
+        u32 FindSlot(u32 _width, u32 _category, bool _allocateShelfIfNeeded);
+        u32 AllocateInShelf(u32 _width, u32 _shelfIndex);
         u32 TryAllocateShelf(u32 _height);
         u32 AllocateSlot();
+
+        void IndexFreeRun(u32 _shelfIndex, u32 _freeSlotIndex);
+        void UnindexFreeRun(u32 _shelfIndex, u32 _freeSlotIndex);
+
+        void SetShelfLargestFree(u32 _shelfIndex, u32 _largestFree);
+        [[nodiscard]] u32 ComputeShelfLargestFree(u32 _shelfIndex) const;
     };
 
 }
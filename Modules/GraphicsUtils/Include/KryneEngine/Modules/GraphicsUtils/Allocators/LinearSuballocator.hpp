@@ -0,0 +1,57 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <KryneEngine/Core/Common/Assert.hpp>
+#include <KryneEngine/Core/Common/Types.hpp>
+#include <KryneEngine/Core/Common/Utils/Alignment.hpp>
+
+namespace KryneEngine::Modules::GraphicsUtils
+{
+    /**
+     * @brief Bump allocator over a range of offsets, with per-allocation alignment. Memory is only freed all at once.
+     */
+    class LinearSuballocator
+    {
+    public:
+        static constexpr u64 kInvalidOffset = ~0ull;
+
+        LinearSuballocator() = default;
+        explicit LinearSuballocator(u64 _capacity): m_capacity(_capacity) {}
+
+        /**
+         * @return The offset of the allocation, or `kInvalidOffset` if it doesn't fit.
+         */
+        [[nodiscard]] u64 Allocate(u64 _size, u64 _alignment = 1)
+        {
+            KE_ASSERT(Alignment::IsPowerOfTwo(_alignment));
+
+            const u64 offset = Alignment::AlignUp(m_used, _alignment);
+            if (offset + _size > m_capacity)
+            {
+                return kInvalidOffset;
+            }
+            m_used = offset + _size;
+            return offset;
+        }
+
+        void Reset() { m_used = 0; }
+
+        void Reset(u64 _capacity)
+        {
+            m_capacity = _capacity;
+            m_used = 0;
+        }
+
+        [[nodiscard]] u64 GetUsed() const { return m_used; }
+        [[nodiscard]] u64 GetCapacity() const { return m_capacity; }
+
+    private:
+        u64 m_capacity = 0;
+        u64 m_used = 0;
+    };
+}
@@ -6,10 +6,14 @@
 
 #pragma once
 
+#include <atomic>
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
 #include <KryneEngine/Core/Common/Types.hpp>
 #include <KryneEngine/Core/Graphics/Handles.hpp>
 #include <KryneEngine/Core/Memory/Allocators/Allocator.hpp>
-#include <KryneEngine/Core/Threads/LightweightMutex.hpp>
+#include <KryneEngine/Core/Memory/Containers/ConcurrentQueue.hpp>
+#include <KryneEngine/Core/Memory/DynamicArray.hpp>
 
 namespace KryneEngine
 {
@@ -18,8 +22,24 @@ namespace KryneEngine
 
 namespace KryneEngine::Modules::GraphicsUtils
 {
+    /**
+     * @brief Destroys graphics resources once the GPU is done with the frame they were last used in.
+     *
+     * @details
+     * Entries are pushed to lock-free queues, ring-indexed by destruction frame id modulo the bucket count, so they can
+     * be deferred from any thread. `Flush()` only visits the buckets of the frames elapsed since its previous call, and
+     * destroys their resources in one pass, grouped by resource type.
+     *
+     * Frame ids further ahead than the bucket count still work, but are requeued until their frame comes. Frame ids
+     * that already elapsed are destroyed at the next flush. `Flush()` must only be called from one thread at a time.
+     *
+     * A deferral racing with a `Flush()` may pick its bucket before the flush advances, and land in a bucket that was
+     * just drained. The resource is then only destroyed once that bucket is visited again, up to a bucket count of
+     * frames later. This never destroys anything early, it only delays it.
+     */
     class DeferredGraphicResourcesDestructor
     {
+    public:
         enum class Type: u8
         {
             Buffer,
@@ -35,22 +55,42 @@ namespace KryneEngine::Modules::GraphicsUtils
             PipelineLayout,
             GraphicsPipeline,
             ComputePipeline,
+            COUNT,
         };
 
-    public:
-        explicit DeferredGraphicResourcesDestructor(AllocatorInstance _allocator);
+        /**
+         * @brief Destroys a group of resources of the same type.
+         */
+        using DestroyBatchFunction = void (*)(void* _userData, Type _type, eastl::span<const GenPool::Handle> _handles);
+
+        static constexpr u8 kDefaultBucketCount = 4;
+
+        explicit DeferredGraphicResourcesDestructor(
+            AllocatorInstance _allocator,
+            u8 _bucketCount = kDefaultBucketCount);
         ~DeferredGraphicResourcesDestructor();
 
         void Flush(GraphicsContext* _graphicsContext);
 
-        void DeferDestruction(const BufferHandle _buffer, const u64 _frameId)
+        /**
+         * @brief Destroys all resources due at or before `_currentFrameId` through the given function.
+         */
+        void Flush(u64 _currentFrameId, DestroyBatchFunction _destroyBatch, void* _userData);
+
+        /**
+         * @param _byteSize Optional memory size of the resource, only used for the pending bytes statistic.
+         */
+        void DeferDestruction(const BufferHandle _buffer, const u64 _frameId, const u64 _byteSize = 0)
         {
-            DeferDestruction(Type::Buffer, _buffer.m_handle, _frameId);
+            DeferDestruction(Type::Buffer, _buffer.m_handle, _frameId, _byteSize);
         }
 
-        void DeferDestruction(const TextureHandle _texture, const u64 _frameId)
+        /**
+         * @param _byteSize Optional memory size of the resource, only used for the pending bytes statistic.
+         */
+        void DeferDestruction(const TextureHandle _texture, const u64 _frameId, const u64 _byteSize = 0)
         {
-            DeferDestruction(Type::Texture, _texture.m_handle, _frameId);
+            DeferDestruction(Type::Texture, _texture.m_handle, _frameId, _byteSize);
         }
 
         void DeferDestruction(const SamplerHandle _sampler, const u64 _frameId)
@@ -108,18 +148,29 @@ namespace KryneEngine::Modules::GraphicsUtils
             DeferDestruction(Type::ComputePipeline, _computePipeline.m_handle, _frameId);
         }
 
+        [[nodiscard]] u64 GetPendingCount() const { return m_pendingCount.load(std::memory_order_relaxed); }
+        [[nodiscard]] u64 GetPendingBytes() const { return m_pendingBytes.load(std::memory_order_relaxed); }
+
     private:
         struct DeferredDestruction
         {
             Type m_type;
             GenPool::Handle m_handle;
             u64 m_frameId;
+            u64 m_byteSize;
         };
 
         AllocatorInstance m_allocator;
-        eastl::vector<DeferredDestruction> m_deferredDestructions;
-        LightweightMutex m_mutex;
+        DynamicArray<ConcurrentQueue<DeferredDestruction>> m_buckets;
+        std::atomic<u64> m_nextFrameToFlush = 0;
+        std::atomic<u64> m_pendingCount = 0;
+        std::atomic<u64> m_pendingBytes = 0;
+
+        // Flush scratch memory
+        eastl::vector<DeferredDestruction> m_dueDestructions;
+        eastl::vector<DeferredDestruction> m_notDueYet;
+        eastl::vector<GenPool::Handle> m_sortedHandles;
 
-        void DeferDestruction(Type _type, GenPool::Handle _handle, u64 _frameId);
+        void DeferDestruction(Type _type, GenPool::Handle _handle, u64 _frameId, u64 _byteSize = 0);
     };
 }
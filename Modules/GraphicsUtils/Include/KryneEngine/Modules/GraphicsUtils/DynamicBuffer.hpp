@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <EASTL/span.h>
 #include <KryneEngine/Core/Graphics/Buffer.hpp>
 #include <KryneEngine/Core/Graphics/GraphicsContext.hpp>
 #include <KryneEngine/Core/Graphics/Handles.hpp>
@@ -14,6 +15,12 @@
 
 namespace KryneEngine::Modules::GraphicsUtils
 {
+    struct BufferRange
+    {
+        u64 m_offset;
+        u64 m_size;
+    };
+
     class DynamicBuffer
     {
     public:
@@ -29,6 +36,22 @@ namespace KryneEngine::Modules::GraphicsUtils
             BarrierAccessFlags _accessFlags,
             u8 _frameIndex);
 
+        /**
+         * @brief Same as `PrepareBuffers()`, but only copies the given ranges from the staging buffer to the GPU buffer.
+         *
+         * @details
+         * Only the given ranges need to have been written to the mapped staging buffer, as long as
+         * `IsGpuContentRetained()` returned true after this frame's `Map()`. Otherwise, the whole staging buffer is
+         * copied like with `PrepareBuffers()`, so all the content in use must have been written. Nothing is copied when the buffer
+         * is directly mapped.
+         */
+        void PrepareBufferRanges(
+            GraphicsContext* _graphicsContext,
+            CommandListHandle _commandLine,
+            BarrierAccessFlags _accessFlags,
+            u8 _frameIndex,
+            eastl::span<const BufferRange> _ranges);
+
         /**
          * @brief Informs you whether your destination buffer is GPU memory-only (and thus requires explicit transfer)
          * or CPU-mappable and GPU visible (aka ReBar,...)
@@ -38,6 +61,16 @@ namespace KryneEngine::Modules::GraphicsUtils
          */
         [[nodiscard]] bool IsDirectMapping() const { return m_gpuBuffer == GenPool::kInvalidHandle; }
 
+        /**
+         * @brief Tells whether the GPU buffer still holds the data of the previous upload, in which case only the
+         * modified ranges need to be uploaded.
+         *
+         * @details
+         * Always false for directly mapped buffers, as each frame context has its own buffer. Also false after the GPU
+         * buffer was recreated by a resize.
+         */
+        [[nodiscard]] bool IsGpuContentRetained() const { return !IsDirectMapping() && m_gpuContentRetained; }
+
         [[nodiscard]] u64 GetSize(u8 _frameIndex) const
         {
             return m_sizes[_frameIndex];
@@ -54,6 +87,7 @@ namespace KryneEngine::Modules::GraphicsUtils
         DynamicArray<u64> m_sizes;
         BufferHandle m_gpuBuffer { GenPool::kInvalidHandle };
         BufferMapping m_currentMapping { { GenPool::kInvalidHandle } };
+        bool m_gpuContentRetained = false;
 
         struct BufferToFree
         {
@@ -61,5 +95,12 @@ namespace KryneEngine::Modules::GraphicsUtils
             u8 m_atIndex = 0;
         };
         eastl::vector<BufferToFree> m_gpuBuffersToFree;
+
+        void CopyToGpuBuffer(
+            GraphicsContext* _graphicsContext,
+            CommandListHandle _commandLine,
+            BarrierAccessFlags _accessFlags,
+            u8 _frameIndex,
+            eastl::span<const BufferRange> _ranges);
     };
 }
\ No newline at end of file
@@ -0,0 +1,133 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <EASTL/string_view.h>
+#include <EASTL/vector.h>
+#include <KryneEngine/Core/Graphics/Buffer.hpp>
+#include <KryneEngine/Core/Graphics/Handles.hpp>
+#include <KryneEngine/Core/Graphics/MemoryBarriers.hpp>
+#include <KryneEngine/Core/Memory/DynamicArray.hpp>
+
+#include "KryneEngine/Modules/GraphicsUtils/Allocators/LinearSuballocator.hpp"
+
+namespace KryneEngine
+{
+    class GraphicsContext;
+}
+
+namespace KryneEngine::Modules::GraphicsUtils
+{
+    /**
+     * @brief A per-frame upload arena, shared by several dynamic buffer users.
+     *
+     * @details
+     * Each frame context owns a GPU buffer, plus a staging buffer when the platform requires one. Allocations are
+     * linearly suballocated from the current frame's buffer, and the whole used range is uploaded with a single copy at
+     * the end of the frame.
+     *
+     * When a frame runs out of space, an extra chunk is created for the rest of the frame, so the data already written
+     * is kept. Next time the frame context comes around, its chunks are replaced with a single buffer large enough for
+     * the high-water mark, so the extra chunks and copies only happen during growth.
+     */
+    class FrameUploadArena
+    {
+    public:
+        struct Allocation
+        {
+            std::byte* m_cpuPtr = nullptr;
+            BufferHandle m_buffer { GenPool::kInvalidHandle };
+            u64 m_offset = 0;
+            u64 m_size = 0;
+
+            [[nodiscard]] BufferSpan GetBufferSpan(const u32 _stride = sizeof(u32)) const
+            {
+                return { .m_size = m_size, .m_offset = m_offset, .m_stride = _stride, .m_buffer = m_buffer };
+            }
+        };
+
+        struct Statistics
+        {
+            u64 m_usedBytes;
+            u64 m_capacity;
+            u64 m_highWaterMark;
+            u32 m_allocationCount;
+            u32 m_chunkCount;
+            u32 m_copyCount;
+        };
+
+        explicit FrameUploadArena(AllocatorInstance _allocator);
+
+        /**
+         * @param _usage The buffer usage flags of the allocations, such as `VertexBuffer | IndexBuffer`. The memory usage
+         * type is set by the arena.
+         */
+        void Init(
+            GraphicsContext* _graphicsContext,
+            u64 _initialSize,
+            MemoryUsage _usage,
+            u8 _frameCount,
+            const eastl::string_view& _debugName = "FrameUploadArena");
+
+        /**
+         * @brief Resets and maps the given frame context's memory. Its previous chunks are coalesced if needed.
+         */
+        void BeginFrame(GraphicsContext* _graphicsContext, u8 _frameIndex);
+
+        /**
+         * @brief Suballocates CPU-writable memory for the current frame. Never fails, a new chunk is created if needed.
+         */
+        [[nodiscard]] Allocation Allocate(GraphicsContext* _graphicsContext, u64 _size, u64 _alignment = 16);
+
+        /**
+         * @brief Unmaps the frame memory and records the uploads, with the barriers to make them available for the
+         * given accesses.
+         */
+        void EndFrame(GraphicsContext* _graphicsContext, CommandListHandle _commandList, BarrierAccessFlags _accessFlags);
+
+        void Destroy(GraphicsContext* _graphicsContext);
+
+        /**
+         * @brief Usage of the last ended frame, and the high-water mark over all frames.
+         */
+        [[nodiscard]] const Statistics& GetStatistics() const { return m_statistics; }
+
+        [[nodiscard]] bool NeedsStaging() const { return m_needsStaging; }
+
+    private:
+        struct Chunk
+        {
+            BufferHandle m_gpuBuffer;
+            BufferHandle m_stagingBuffer;
+            BufferMapping m_mapping { { GenPool::kInvalidHandle } };
+            LinearSuballocator m_suballocator;
+        };
+
+        using FrameChunks = eastl::vector<Chunk>;
+
+        DynamicArray<FrameChunks> m_frames;
+        MemoryUsage m_usage = MemoryUsage::Undefined_UsageType;
+        u64 m_targetSize = 0;
+        u8 m_currentFrame = 0;
+        bool m_needsStaging = false;
+        bool m_frameOpen = false;
+        u32 m_allocationCount = 0;
+        Statistics m_statistics {};
+
+#if !defined(KE_FINAL)
+        eastl::string m_debugName;
+#endif
+
+        [[nodiscard]] BufferHandle CreateGpuBuffer(GraphicsContext* _graphicsContext, u64 _size) const;
+        [[nodiscard]] Chunk CreateChunk(
+            GraphicsContext* _graphicsContext,
+            u64 _size,
+            BufferHandle _gpuBuffer = { GenPool::kInvalidHandle }) const;
+        void DestroyChunk(GraphicsContext* _graphicsContext, const Chunk& _chunk) const;
+        void MapChunk(GraphicsContext* _graphicsContext, Chunk& _chunk) const;
+    };
+}
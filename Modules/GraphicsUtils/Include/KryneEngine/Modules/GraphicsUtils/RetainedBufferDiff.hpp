@@ -0,0 +1,71 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
+#include <KryneEngine/Core/Common/Types.hpp>
+#include <KryneEngine/Core/Memory/Allocators/Allocator.hpp>
+
+#include "KryneEngine/Modules/GraphicsUtils/DynamicBuffer.hpp"
+
+namespace KryneEngine::Modules::GraphicsUtils
+{
+    /**
+     * @brief Keeps a CPU copy of the last uploaded buffer content, to only upload the ranges that changed.
+     *
+     * @details
+     * The data is compared block by block against the previous content. Modified blocks are merged into ranges, and
+     * ranges closer than the merge distance are joined, to trade a few redundant bytes for fewer copy commands.
+     * Bytes past the previous size are always dirty, while shrinking uploads nothing.
+     *
+     * Meant to be used with a staged `DynamicBuffer`, as long as `DynamicBuffer::IsGpuContentRetained()` is true. The
+     * diff must be invalidated otherwise, so the next update is a full upload.
+     */
+    class RetainedBufferDiff
+    {
+    public:
+        struct Statistics
+        {
+            u64 m_totalBytes;
+            u64 m_uploadedBytes;
+            u32 m_rangeCount;
+
+            [[nodiscard]] u64 GetSavedBytes() const { return m_totalBytes - m_uploadedBytes; }
+        };
+
+        /**
+         * @param _blockSize The comparison granularity, typically the size of an element of the buffer.
+         * @param _mergeDistance Dirty ranges separated by this many bytes or fewer are merged.
+         */
+        RetainedBufferDiff(AllocatorInstance _allocator, u32 _blockSize, u32 _mergeDistance = 0);
+
+        /**
+         * @brief Compares the new content against the retained one, and retains the new content.
+         *
+         * @return The ranges to upload, valid until the next call.
+         */
+        eastl::span<const BufferRange> Update(const std::byte* _data, u64 _size);
+
+        /**
+         * @brief Forgets the retained content, the next update will cover the whole buffer.
+         */
+        void Invalidate() { m_valid = false; }
+
+        [[nodiscard]] const Statistics& GetStatistics() const { return m_statistics; }
+
+    private:
+        eastl::vector<std::byte> m_retained;
+        eastl::vector<BufferRange> m_ranges;
+        u32 m_blockSize;
+        u32 m_mergeDistance;
+        bool m_valid = false;
+        Statistics m_statistics {};
+
+        void AddRange(u64 _offset, u64 _size);
+    };
+}
@@ -6,6 +6,8 @@
 
 #include "KryneEngine/Modules/GraphicsUtils/Allocators/AtlasShelfAllocator.hpp"
 
+#include <EASTL/sort.h>
+
 namespace KryneEngine::Modules::GraphicsUtils
 {
     AtlasShelfAllocator::AtlasShelfAllocator(
@@ -19,7 +21,10 @@ namespace KryneEngine::Modules::GraphicsUtils
             , m_slWidth(_config.m_slWidth)
             , m_freeShelves(_cpuAllocator)
             , m_shelves(_cpuAllocator)
+            , m_availableShelves(_cpuAllocator)
             , m_freeSlots(_cpuAllocator)
+            , m_freeRunsByStart(_cpuAllocator)
+            , m_freeRunsByWidth(_cpuAllocator)
             , m_slots(_cpuAllocator)
     {
         KE_ASSERT(m_atlasSize.x % m_shelfWidth == 0);
@@ -53,47 +58,34 @@ namespace KryneEngine::Modules::GraphicsUtils
         const u32 allocatedHeight = category;
 
         auto it = m_shelfCategories.lower_bound(category);
-        if (it != m_shelfCategories.end())
+        if (it != m_shelfCategories.end() && it->first == category)
         {
-            if (it->first == category)
+            const u32 slot = FindSlot(slotWidth, category, true);
+            if (slot != kInvalidSlot)
             {
-                const u32 slot = FindSlot(slotWidth, it->second, true);
-                if (slot != kInvalidSlot)
-                {
-                    return slot;
-                }
-            }
-
-            // Try to allocate a new shelf only if there was no entry for this category
-            const u32 newShelf = it->first == category ? invalidIndex : TryAllocateShelf(allocatedHeight);
-
-            if (newShelf != invalidIndex)
-            {
-                m_shelfCategories.insert(it, { category, newShelf });
-                const u32 slot = FindSlot(slotWidth, newShelf, false);
-                KE_ASSERT_MSG(slot != kInvalidSlot, "Shelf is new, why the hell can't you find a free spot ?");
                 return slot;
             }
-
-            // Cannot allocate a new shelf, pack it in a bigger shelf if possible
-            for (; it != m_shelfCategories.end(); ++it)
-            {
-                const u32 slot = FindSlot(slotWidth, it->second, false);
-                if (slot != kInvalidSlot)
-                {
-                    return slot;
-                }
-            }
+            ++it;
         }
         else
         {
-            // No shelf big enough, allocate a new one
+            // No shelf for this category yet, allocate a new one
             const u32 shelfIndex = TryAllocateShelf(allocatedHeight);
             if (shelfIndex != invalidIndex)
             {
-                m_shelfCategories.emplace_back_unsorted(category, shelfIndex);
-                const u32 slot = FindSlot(slotWidth, shelfIndex, false);
-                KE_ASSERT_MSG(slot != invalidIndex, "Shelf is new, why the hell can't you find a free spot ?");
+                m_shelfCategories.insert(it, { category, shelfIndex });
+                const u32 slot = AllocateInShelf(slotWidth, shelfIndex);
+                KE_ASSERT_MSG(slot != kInvalidSlot, "Shelf is new, why the hell can't you find a free spot ?");
+                return slot;
+            }
+        }
+
+        // Cannot allocate a new shelf, pack it in a bigger shelf if possible
+        for (; it != m_shelfCategories.end(); ++it)
+        {
+            const u32 slot = FindSlot(slotWidth, it->first, false);
+            if (slot != kInvalidSlot)
+            {
                 return slot;
             }
         }
@@ -101,6 +93,32 @@ namespace KryneEngine::Modules::GraphicsUtils
         return invalidIndex;
     }
 
+    u32 AtlasShelfAllocator::AllocateMany(const eastl::span<const uint2> _slotSizes, const eastl::span<u32> _outSlots)
+    {
+        KE_ASSERT(_outSlots.size() >= _slotSizes.size());
+
+        // Allocating the tallest slots first lets the smaller ones fill the remaining gaps of the bigger shelves.
+        eastl::vector<u32> order(m_cpuAllocator);
+        order.resize(_slotSizes.size());
+        for (u32 i = 0; i < order.size(); i++)
+            order[i] = i;
+        eastl::sort(order.begin(), order.end(), [&](const u32 _a, const u32 _b)
+        {
+            const uint2 a = _slotSizes[_a];
+            const uint2 b = _slotSizes[_b];
+            return a.y > b.y || (a.y == b.y && a.x > b.x);
+        });
+
+        u32 successCount = 0;
+        for (const u32 index : order)
+        {
+            _outSlots[index] = Allocate(_slotSizes[index]);
+            if (_outSlots[index] != kInvalidSlot)
+                successCount++;
+        }
+        return successCount;
+    }
+
     void AtlasShelfAllocator::Free(u32 _slot)
     {
         const SlotEntry slot = m_slots[_slot];
@@ -117,38 +135,73 @@ namespace KryneEngine::Modules::GraphicsUtils
             m_freeSlots[freeNodeIndex].m_start = slot.m_start;
             m_freeSlots[freeNodeIndex].m_width = slot.m_width;
             shelf.m_firstFree = freeNodeIndex;
-            return;
+            IndexFreeRun(slot.m_shelf, freeNodeIndex);
+            SetShelfLargestFree(slot.m_shelf, slot.m_width);
+        }
+        else
+        {
+            FreeInShelf(slot);
         }
 
-        u32 previousFreeSlotIndex = ~0u;
-        u32 freeSlotIndex = shelf.m_firstFree;
-        for (
-            FreeSlotEntry* freeSlot = &m_freeSlots[freeSlotIndex];
-            freeSlotIndex != VectorDeLinkedList<FreeSlotEntry>::kListLimitId;
-            previousFreeSlotIndex = freeSlotIndex, freeSlotIndex = freeSlot->m_next, freeSlot = &m_freeSlots[freeSlotIndex])
+        if (m_freeSlots[shelf.m_firstFree].m_width >= m_shelfWidth)
         {
-            if (freeSlot->m_start > slot.m_start)
-                break;
+            UnindexFreeRun(slot.m_shelf, shelf.m_firstFree);
+            FreeShelf({ .m_start = shelf.m_start, .m_size = shelf.m_size });
+            m_availableShelves.erase({ shelf.m_size, shelf.m_largestFree, slot.m_shelf });
+            const u32 next = shelf.m_next;
+            m_shelves.FreeNode(slot.m_shelf);
+
+            auto it = m_shelfCategories.find(shelf.m_size);
+            VERIFY_OR_RETURN_VOID(it != m_shelfCategories.end());
+            if (it->second == slot.m_shelf)
+            {
+                if (next == VectorDeLinkedList<ShelfEntry>::kListLimitId)
+                    m_shelfCategories.erase(it);
+                else
+                    it->second = next;
+            }
+        }
+    }
+
+    void AtlasShelfAllocator::FreeInShelf(const SlotEntry& _slot)
+    {
+        constexpr u32 listLimit = VectorDeLinkedList<FreeSlotEntry>::kListLimitId;
+
+        ShelfEntry& shelf = m_shelves[_slot.m_shelf];
+
+        // The runs surrounding the freed slot are its neighbours in the start index.
+        const auto nextIt = m_freeRunsByStart.lower_bound({ _slot.m_shelf, _slot.m_start, 0 });
+        const u32 freeSlotIndex = nextIt != m_freeRunsByStart.end() && nextIt->m_shelf == _slot.m_shelf
+            ? nextIt->m_freeSlot
+            : listLimit;
+        u32 previousFreeSlotIndex = listLimit;
+        if (nextIt != m_freeRunsByStart.begin())
+        {
+            const auto previousIt = eastl::prev(nextIt);
+            if (previousIt->m_shelf == _slot.m_shelf)
+                previousFreeSlotIndex = previousIt->m_freeSlot;
         }
 
         bool backMerge = false;
-        if (freeSlotIndex != VectorDeLinkedList<FreeSlotEntry>::kListLimitId)
+        if (freeSlotIndex != listLimit)
         {
             FreeSlotEntry& freeSlot = m_freeSlots[freeSlotIndex];
-            if (slot.m_start + slot.m_width == freeSlot.m_start)
+            if (_slot.m_start + _slot.m_width == freeSlot.m_start)
             {
-                freeSlot.m_start = slot.m_start;
-                freeSlot.m_width += slot.m_width;
+                UnindexFreeRun(_slot.m_shelf, freeSlotIndex);
+                freeSlot.m_start = _slot.m_start;
+                freeSlot.m_width += _slot.m_width;
                 backMerge = true;
             }
         }
 
         bool frontMerge = false;
-        if (previousFreeSlotIndex != VectorDeLinkedList<FreeSlotEntry>::kListLimitId)
+        if (previousFreeSlotIndex != listLimit)
         {
             FreeSlotEntry& previousFreeSlot = m_freeSlots[previousFreeSlotIndex];
-            if (previousFreeSlot.m_start + previousFreeSlot.m_width == slot.m_start)
+            if (previousFreeSlot.m_start + previousFreeSlot.m_width == _slot.m_start)
             {
+                UnindexFreeRun(_slot.m_shelf, previousFreeSlotIndex);
                 if (backMerge)
                 {
                     previousFreeSlot.m_width += m_freeSlots[freeSlotIndex].m_width;
@@ -156,43 +209,41 @@ namespace KryneEngine::Modules::GraphicsUtils
                 }
                 else
                 {
-                    previousFreeSlot.m_width += slot.m_width;
+                    previousFreeSlot.m_width += _slot.m_width;
                 }
+                IndexFreeRun(_slot.m_shelf, previousFreeSlotIndex);
                 frontMerge = true;
             }
         }
 
-        if (!frontMerge && !backMerge)
+        u32 mergedWidth = _slot.m_width;
+        if (frontMerge)
+        {
+            mergedWidth = m_freeSlots[previousFreeSlotIndex].m_width;
+        }
+        else if (backMerge)
+        {
+            mergedWidth = m_freeSlots[freeSlotIndex].m_width;
+            IndexFreeRun(_slot.m_shelf, freeSlotIndex);
+        }
+        else
         {
             const u32 newFreeSlotIndex = m_freeSlots.AllocateNode();
-            m_freeSlots[newFreeSlotIndex].m_start = slot.m_start;
-            m_freeSlots[newFreeSlotIndex].m_width = slot.m_width;
+            m_freeSlots[newFreeSlotIndex].m_start = _slot.m_start;
+            m_freeSlots[newFreeSlotIndex].m_width = _slot.m_width;
             m_freeSlots[newFreeSlotIndex].m_next = freeSlotIndex;
             m_freeSlots[newFreeSlotIndex].m_previous = previousFreeSlotIndex;
-            if (previousFreeSlotIndex == VectorDeLinkedList<FreeSlotEntry>::kListLimitId)
+            if (previousFreeSlotIndex == listLimit)
                 shelf.m_firstFree = newFreeSlotIndex;
             else
                 m_freeSlots[previousFreeSlotIndex].m_next = newFreeSlotIndex;
-            if (freeSlotIndex != VectorDeLinkedList<FreeSlotEntry>::kListLimitId)
+            if (freeSlotIndex != listLimit)
                 m_freeSlots[freeSlotIndex].m_previous = newFreeSlotIndex;
+            IndexFreeRun(_slot.m_shelf, newFreeSlotIndex);
         }
 
-        if (m_freeSlots[shelf.m_firstFree].m_width >= m_shelfWidth)
-        {
-            FreeShelf({ .m_start = shelf.m_start, .m_size = shelf.m_size });
-            const u32 next = shelf.m_next;
-            m_shelves.FreeNode(slot.m_shelf);
-
-            auto it = m_shelfCategories.find(shelf.m_size);
-            VERIFY_OR_RETURN_VOID(it != m_shelfCategories.end());
-            if (it->second == slot.m_shelf)
-            {
-                if (next == VectorDeLinkedList<ShelfEntry>::kListLimitId)
-                    m_shelfCategories.erase(it);
-                else
-                    it->second = next;
-            }
-        }
+        // Coalescing can only grow runs, so the summary is updated from the merged width.
+        SetShelfLargestFree(_slot.m_shelf, eastl::max(shelf.m_largestFree, mergedWidth));
     }
 
     Rect AtlasShelfAllocator::GetSlotRect(u32 _slot) const
@@ -263,60 +314,68 @@ namespace KryneEngine::Modules::GraphicsUtils
         }
     }
 
-    u32 AtlasShelfAllocator::FindSlot(u32 _width, u32 _shelfIndex, bool _allocateShelfIfNeeded)
+    u32 AtlasShelfAllocator::FindSlot(u32 _width, u32 _category, bool _allocateShelfIfNeeded)
     {
-        u32 shelfIndex = _shelfIndex;
-        for (
-            ShelfEntry* shelf = &m_shelves[_shelfIndex];
-            shelfIndex != VectorDeLinkedList<ShelfEntry>::kListLimitId;
-            shelfIndex = shelf->m_next, shelf = &m_shelves[shelfIndex])
+        // Best fit: the shelf of this category with the smallest largest free run that still fits the slot.
+        const auto it = m_availableShelves.lower_bound({ _category, _width, 0 });
+        if (it != m_availableShelves.end() && it->m_category == _category)
         {
-            u32 freeSlotIndex = shelf->m_firstFree;
-            for (
-                FreeSlotEntry* freeSlot = &m_freeSlots[freeSlotIndex];
-                freeSlotIndex != VectorDeLinkedList<FreeSlotEntry>::kListLimitId;
-                freeSlotIndex = freeSlot->m_next, freeSlot = &m_freeSlots[freeSlotIndex])
-            {
-                if (freeSlot->m_width >= _width)
-                {
-                    const u32 slot = AllocateSlot();
-                    m_slots[slot] = { .m_shelf = shelfIndex, .m_start = freeSlot->m_start, .m_width = _width };
-                    freeSlot->m_start += _width;
-                    freeSlot->m_width -= _width;
-
-                    if (freeSlot->m_width == 0)
-                    {
-                        const u32 next = freeSlot->m_next;
-                        m_freeSlots.FreeNode(freeSlotIndex);
-                        if (freeSlotIndex == shelf->m_firstFree)
-                            shelf->m_firstFree = next;
-                    }
-                    return slot;
-                }
-            }
+            return AllocateInShelf(_width, it->m_shelf);
+        }
 
-            if (_allocateShelfIfNeeded && shelf->m_next == VectorDeLinkedList<ShelfEntry>::kListLimitId)
-            {
-                const u32 newShelf = TryAllocateShelf(shelf->m_size);
-                if (newShelf == VectorDeLinkedList<ShelfEntry>::kListLimitId)
-                    continue;
-
-                m_shelves.SetNext(shelfIndex, newShelf);
-                const u32 slot = AllocateSlot();
-                m_slots[slot] = {
-                    .m_shelf = newShelf,
-                    .m_start = 0,
-                    .m_width = _width,
-                };
-
-                FreeSlotEntry& freeSlot = m_freeSlots[m_shelves[newShelf].m_firstFree];
-                freeSlot.m_width -= _width;
-                freeSlot.m_start += _width;
-                return slot;
-            }
+        if (!_allocateShelfIfNeeded)
+            return kInvalidSlot;
+
+        const auto categoryIt = m_shelfCategories.find(_category);
+        VERIFY_OR_RETURN(categoryIt != m_shelfCategories.end(), kInvalidSlot);
+
+        const u32 newShelf = TryAllocateShelf(_category);
+        if (newShelf == VectorDeLinkedList<ShelfEntry>::kListLimitId)
+            return kInvalidSlot;
+
+        // Link the new shelf right after the category head
+        const u32 head = categoryIt->second;
+        const u32 next = m_shelves[head].m_next;
+        m_shelves.SetNext(head, newShelf);
+        if (next != VectorDeLinkedList<ShelfEntry>::kListLimitId)
+            m_shelves.SetNext(newShelf, next);
+
+        return AllocateInShelf(_width, newShelf);
+    }
+
+    u32 AtlasShelfAllocator::AllocateInShelf(u32 _width, u32 _shelfIndex)
+    {
+        ShelfEntry& shelf = m_shelves[_shelfIndex];
+
+        // Best fit: the narrowest run of the shelf that fits the slot, leftmost on ties.
+        const auto it = m_freeRunsByWidth.lower_bound({ _shelfIndex, _width, 0, 0 });
+        if (it == m_freeRunsByWidth.end() || it->m_shelf != _shelfIndex)
+            return kInvalidSlot;
+
+        const u32 freeSlotIndex = it->m_freeSlot;
+        UnindexFreeRun(_shelfIndex, freeSlotIndex);
+
+        FreeSlotEntry& freeSlot = m_freeSlots[freeSlotIndex];
+        const u32 slot = AllocateSlot();
+        m_slots[slot] = { .m_shelf = _shelfIndex, .m_start = freeSlot.m_start, .m_width = _width };
+
+        freeSlot.m_start += _width;
+        freeSlot.m_width -= _width;
+
+        if (freeSlot.m_width == 0)
+        {
+            const u32 next = freeSlot.m_next;
+            m_freeSlots.FreeNode(freeSlotIndex);
+            if (freeSlotIndex == shelf.m_firstFree)
+                shelf.m_firstFree = next;
+        }
+        else
+        {
+            IndexFreeRun(_shelfIndex, freeSlotIndex);
         }
 
-        return kInvalidSlot;
+        SetShelfLargestFree(_shelfIndex, ComputeShelfLargestFree(_shelfIndex));
+        return slot;
     }
 
     u32 AtlasShelfAllocator::TryAllocateShelf(u32 _height)
@@ -338,8 +397,11 @@ namespace KryneEngine::Modules::GraphicsUtils
                 m_shelves[shelfIndex].m_start = start;
                 m_shelves[shelfIndex].m_size = _height;
                 m_shelves[shelfIndex].m_firstFree = freeSlotIndex;
+                m_shelves[shelfIndex].m_largestFree = 0;
                 m_freeSlots[freeSlotIndex].m_start = 0;
                 m_freeSlots[freeSlotIndex].m_width = m_shelfWidth;
+                IndexFreeRun(shelfIndex, freeSlotIndex);
+                SetShelfLargestFree(shelfIndex, m_shelfWidth);
 
                 return shelfIndex;
             }
@@ -358,4 +420,97 @@ namespace KryneEngine::Modules::GraphicsUtils
         m_nextSlotIndex = m_slots[index].m_shelf; // We use m_shelf to store the next free index
         return index;
     }
+
+    void AtlasShelfAllocator::IndexFreeRun(u32 _shelfIndex, u32 _freeSlotIndex)
+    {
+        const FreeSlotEntry& freeSlot = m_freeSlots[_freeSlotIndex];
+        m_freeRunsByStart.insert({ _shelfIndex, freeSlot.m_start, _freeSlotIndex });
+        m_freeRunsByWidth.insert({ _shelfIndex, freeSlot.m_width, freeSlot.m_start, _freeSlotIndex });
+    }
+
+    void AtlasShelfAllocator::UnindexFreeRun(u32 _shelfIndex, u32 _freeSlotIndex)
+    {
+        const FreeSlotEntry& freeSlot = m_freeSlots[_freeSlotIndex];
+        m_freeRunsByStart.erase({ _shelfIndex, freeSlot.m_start, _freeSlotIndex });
+        m_freeRunsByWidth.erase({ _shelfIndex, freeSlot.m_width, freeSlot.m_start, _freeSlotIndex });
+    }
+
+    void AtlasShelfAllocator::SetShelfLargestFree(u32 _shelfIndex, u32 _largestFree)
+    {
+        ShelfEntry& shelf = m_shelves[_shelfIndex];
+        if (shelf.m_largestFree == _largestFree)
+            return;
+
+        // Full shelves are not indexed, as they can't fit anything.
+        if (shelf.m_largestFree > 0)
+            m_availableShelves.erase({ shelf.m_size, shelf.m_largestFree, _shelfIndex });
+        shelf.m_largestFree = _largestFree;
+        if (_largestFree > 0)
+            m_availableShelves.insert({ shelf.m_size, _largestFree, _shelfIndex });
+    }
+
+    u32 AtlasShelfAllocator::ComputeShelfLargestFree(u32 _shelfIndex) const
+    {
+        // The widest run of a shelf is the last entry of its range in the width index.
+        const auto it = m_freeRunsByWidth.lower_bound({ _shelfIndex + 1, 0, 0, 0 });
+        if (it == m_freeRunsByWidth.begin())
+            return 0;
+        const auto lastIt = eastl::prev(it);
+        return lastIt->m_shelf == _shelfIndex ? lastIt->m_width : 0;
+    }
+
+    AtlasShelfAllocator::Metrics AtlasShelfAllocator::ComputeMetrics() const
+    {
+        Metrics metrics {
+            .m_atlasArea = static_cast<u64>(m_atlasSize.x) * m_atlasSize.y,
+        };
+
+        u32 freeSlotIndexCount = 0;
+        for (u32 slotIndex = m_nextSlotIndex; slotIndex != kInvalidSlot; slotIndex = m_slots[slotIndex].m_shelf)
+            freeSlotIndexCount++;
+        metrics.m_slotCount = m_slots.size() - freeSlotIndexCount;
+
+        u64 freeArea = 0;
+        u64 fragmentedArea = 0;
+        for (const auto [category, firstShelf] : m_shelfCategories)
+        {
+            for (
+                u32 shelfIndex = firstShelf;
+                shelfIndex != VectorDeLinkedList<ShelfEntry>::kListLimitId;
+                shelfIndex = m_shelves[shelfIndex].m_next)
+            {
+                const ShelfEntry& shelf = m_shelves[shelfIndex];
+
+                u32 freeWidth = 0;
+                for (
+                    u32 freeSlotIndex = shelf.m_firstFree;
+                    freeSlotIndex != VectorDeLinkedList<FreeSlotEntry>::kListLimitId;
+                    freeSlotIndex = m_freeSlots[freeSlotIndex].m_next)
+                {
+                    freeWidth += m_freeSlots[freeSlotIndex].m_width;
+                }
+
+                metrics.m_shelfCount++;
+                metrics.m_shelfArea += static_cast<u64>(m_shelfWidth) * shelf.m_size;
+                metrics.m_allocatedArea += static_cast<u64>(m_shelfWidth - freeWidth) * shelf.m_size;
+                freeArea += static_cast<u64>(freeWidth) * shelf.m_size;
+                fragmentedArea += static_cast<u64>(freeWidth - shelf.m_largestFree) * shelf.m_size;
+            }
+        }
+
+        metrics.m_occupancy = static_cast<float>(
+            static_cast<double>(metrics.m_allocatedArea) / static_cast<double>(metrics.m_atlasArea));
+        if (metrics.m_shelfArea > 0)
+        {
+            metrics.m_shelfOccupancy = static_cast<float>(
+                static_cast<double>(metrics.m_allocatedArea) / static_cast<double>(metrics.m_shelfArea));
+        }
+        if (freeArea > 0)
+        {
+            metrics.m_fragmentation = static_cast<float>(
+                static_cast<double>(fragmentedArea) / static_cast<double>(freeArea));
+        }
+
+        return metrics;
+    }
 } // namespace KryneEngine::Modules::GraphicsUtils
\ No newline at end of file
@@ -6,84 +6,201 @@
 
 #include "KryneEngine/Modules/GraphicsUtils/DeferredGraphicResourcesDestructor.hpp"
 
+#include <EASTL/array.h>
 #include <KryneEngine/Core/Graphics/GraphicsContext.hpp>
+#include <KryneEngine/Core/Profiling/TracyHeader.hpp>
 
 namespace KryneEngine::Modules::GraphicsUtils
 {
-    DeferredGraphicResourcesDestructor::DeferredGraphicResourcesDestructor(const AllocatorInstance _allocator)
-        : m_allocator(_allocator)
-        , m_deferredDestructions(_allocator)
-    {}
+    DeferredGraphicResourcesDestructor::DeferredGraphicResourcesDestructor(
+        const AllocatorInstance _allocator,
+        const u8 _bucketCount)
+            : m_allocator(_allocator)
+            , m_buckets(_allocator)
+            , m_dueDestructions(_allocator)
+            , m_notDueYet(_allocator)
+            , m_sortedHandles(_allocator)
+    {
+        KE_ASSERT(_bucketCount > 0);
+        m_buckets.Resize(_bucketCount);
+        m_buckets.InitAll();
+    }
 
     DeferredGraphicResourcesDestructor::~DeferredGraphicResourcesDestructor() = default;
 
     void DeferredGraphicResourcesDestructor::Flush(GraphicsContext* _graphicsContext)
     {
-        const u64 currentFrame = _graphicsContext->GetFrameId();
+        constexpr DestroyBatchFunction destroyBatch = [](
+            void* _userData,
+            const Type _type,
+            const eastl::span<const GenPool::Handle> _handles)
+        {
+            auto* graphicsContext = static_cast<GraphicsContext*>(_userData);
+            switch (_type)
+            {
+            case Type::Buffer:
+                for (const GenPool::Handle handle: _handles)
+                    graphicsContext->DestroyBuffer({ handle });
+                break;
+            case Type::Texture:
+                for (const GenPool::Handle handle: _handles)
+                    graphicsContext->DestroyTexture({ handle });
+                break;
+            case Type::Sampler:
+                for (const GenPool::Handle handle: _handles)
+                    graphicsContext->DestroySampler({ handle });
+                break;
+            case Type::TextureView:
+                for (const GenPool::Handle handle: _handles)
+                    graphicsContext->DestroyTextureView({ handle });
+                break;
+            case Type::BufferView:
+                for (const GenPool::Handle handle: _handles)
+                    graphicsContext->DestroyBufferView({ handle });
+                break;
+            case Type::RenderTargetView:
+                for (const GenPool::Handle handle: _handles)
+                    graphicsContext->DestroyRenderTargetView({ handle });
+                break;
+            case Type::RenderPass:
+                for (const GenPool::Handle handle: _handles)
+                    graphicsContext->DestroyRenderPass({ handle });
+                break;
+            case Type::ShaderModule:
+                for (const GenPool::Handle handle: _handles)
+                    graphicsContext->FreeShaderModule({ handle });
+                break;
+            case Type::DescriptorSetLayout:
+                for (const GenPool::Handle handle: _handles)
+                    graphicsContext->DestroyDescriptorSetLayout({ handle });
+                break;
+            case Type::DescriptorSet:
+                for (const GenPool::Handle handle: _handles)
+                    graphicsContext->DestroyDescriptorSet({ handle });
+                break;
+            case Type::PipelineLayout:
+                for (const GenPool::Handle handle: _handles)
+                    graphicsContext->DestroyPipelineLayout({ handle });
+                break;
+            case Type::GraphicsPipeline:
+                for (const GenPool::Handle handle: _handles)
+                    graphicsContext->DestroyGraphicsPipeline({ handle });
+                break;
+            case Type::ComputePipeline:
+                for (const GenPool::Handle handle: _handles)
+                    graphicsContext->DestroyComputePipeline({ handle });
+                break;
+            case Type::COUNT:
+                KE_ERROR("Invalid resource type");
+                break;
+            }
+        };
 
-        const auto lock = m_mutex.AutoLock();
+        Flush(_graphicsContext->GetFrameId(), destroyBatch, _graphicsContext);
+    }
+
+    void DeferredGraphicResourcesDestructor::Flush(
+        const u64 _currentFrameId,
+        const DestroyBatchFunction _destroyBatch,
+        void* _userData)
+    {
+        KE_ZoneScopedFunction("DeferredGraphicResourcesDestructor::Flush");
 
-        for (auto it = m_deferredDestructions.begin(); it != m_deferredDestructions.end();)
+        const u64 firstFrame = m_nextFrameToFlush.load(std::memory_order_acquire);
+        if (_currentFrameId < firstFrame)
         {
-            if (it->m_frameId <= currentFrame)
+            return;
+        }
+
+        // Resources deferred from now on for elapsed frames go to the next flushed bucket.
+        m_nextFrameToFlush.store(_currentFrameId + 1, std::memory_order_release);
+
+        const u64 bucketCount = m_buckets.Size();
+        const u64 frameCount = eastl::min<u64>(_currentFrameId + 1 - firstFrame, bucketCount);
+
+        m_dueDestructions.clear();
+        m_notDueYet.clear();
+        for (u64 i = 0; i < frameCount; i++)
+        {
+            ConcurrentQueue<DeferredDestruction>& bucket = m_buckets[(firstFrame + i) % bucketCount];
+
+            constexpr size_t kDequeueBatchSize = 64;
+            DeferredDestruction dequeued[kDequeueBatchSize];
+            size_t count;
+            while ((count = bucket.try_dequeue_bulk(dequeued, kDequeueBatchSize)) > 0)
             {
-                switch (it->m_type)
+                for (size_t j = 0; j < count; j++)
                 {
-                case Type::Buffer:
-                    _graphicsContext->DestroyBuffer({ it->m_handle });
-                    break;
-                case Type::Texture:
-                    _graphicsContext->DestroyTexture({ it->m_handle });
-                    break;
-                case Type::Sampler:
-                    _graphicsContext->DestroySampler({ it->m_handle });
-                    break;
-                case Type::TextureView:
-                    _graphicsContext->DestroyTextureView({ it->m_handle });
-                    break;
-                case Type::BufferView:
-                    _graphicsContext->DestroyBufferView({ it->m_handle });
-                    break;
-                case Type::RenderTargetView:
-                    _graphicsContext->DestroyRenderTargetView({ it->m_handle });
-                    break;
-                case Type::RenderPass:
-                    _graphicsContext->DestroyRenderPass({ it->m_handle });
-                    break;
-                case Type::ShaderModule:
-                    _graphicsContext->FreeShaderModule({ it->m_handle });
-                    break;
-                case Type::DescriptorSetLayout:
-                    _graphicsContext->DestroyDescriptorSetLayout({ it->m_handle });
-                    break;
-                case Type::DescriptorSet:
-                    _graphicsContext->DestroyDescriptorSet({ it->m_handle });
-                    break;
-                case Type::PipelineLayout:
-                    _graphicsContext->DestroyPipelineLayout({ it->m_handle });
-                    break;
-                case Type::GraphicsPipeline:
-                    _graphicsContext->DestroyGraphicsPipeline({ it->m_handle });
-                    break;
-                case Type::ComputePipeline:
-                    _graphicsContext->DestroyComputePipeline({ it->m_handle });
-                    break;
+                    if (dequeued[j].m_frameId <= _currentFrameId)
+                        m_dueDestructions.push_back(dequeued[j]);
+                    else
+                        m_notDueYet.push_back(dequeued[j]);
                 }
+            }
+        }
 
-                m_deferredDestructions.erase_unsorted(it);
+        // Deferred more than a bucket count ahead, put back for a later flush.
+        for (const DeferredDestruction& destruction: m_notDueYet)
+        {
+            m_buckets[destruction.m_frameId % bucketCount].enqueue(destruction);
+        }
+
+        if (m_dueDestructions.empty())
+        {
+            return;
+        }
+
+        // Group the handles by type
+        constexpr size_t typeCount = static_cast<size_t>(Type::COUNT);
+        eastl::array<u32, typeCount + 1> typeOffsets {};
+        u64 dueBytes = 0;
+        for (const DeferredDestruction& destruction: m_dueDestructions)
+        {
+            typeOffsets[static_cast<size_t>(destruction.m_type) + 1]++;
+            dueBytes += destruction.m_byteSize;
+        }
+        for (size_t i = 1; i <= typeCount; i++)
+        {
+            typeOffsets[i] += typeOffsets[i - 1];
+        }
+
+        m_sortedHandles.resize(m_dueDestructions.size());
+        {
+            eastl::array<u32, typeCount + 1> writeOffsets = typeOffsets;
+            for (const DeferredDestruction& destruction: m_dueDestructions)
+            {
+                m_sortedHandles[writeOffsets[static_cast<size_t>(destruction.m_type)]++] = destruction.m_handle;
             }
-            else
+        }
+
+        for (size_t i = 0; i < typeCount; i++)
+        {
+            const u32 count = typeOffsets[i + 1] - typeOffsets[i];
+            if (count > 0)
             {
-                ++it;
+                _destroyBatch(
+                    _userData,
+                    static_cast<Type>(i),
+                    { m_sortedHandles.data() + typeOffsets[i], count });
             }
         }
+
+        m_pendingCount.fetch_sub(m_dueDestructions.size(), std::memory_order_relaxed);
+        m_pendingBytes.fetch_sub(dueBytes, std::memory_order_relaxed);
     }
 
-    void DeferredGraphicResourcesDestructor::DeferDestruction(Type _type, GenPool::Handle _handle, u64 _frameId)
+    void DeferredGraphicResourcesDestructor::DeferDestruction(
+        const Type _type,
+        const GenPool::Handle _handle,
+        const u64 _frameId,
+        const u64 _byteSize)
     {
-        const auto lock = m_mutex.AutoLock();
+        // Frames that were already flushed won't be visited again before a full bucket cycle. A concurrent flush may
+        // still drain the selected bucket before the enqueue, delaying the destruction by a bucket cycle.
+        const u64 bucketFrame = eastl::max(_frameId, m_nextFrameToFlush.load(std::memory_order_acquire));
 
-        // Insert without ordering, we'll simply iterate over all entries and check frame id later.
-        m_deferredDestructions.emplace_back(DeferredDestruction{ _type, _handle, _frameId });
+        m_pendingCount.fetch_add(1, std::memory_order_relaxed);
+        m_pendingBytes.fetch_add(_byteSize, std::memory_order_relaxed);
+        m_buckets[bucketFrame % m_buckets.Size()].enqueue({ _type, _handle, _frameId, _byteSize });
     }
-}
\ No newline at end of file
+}
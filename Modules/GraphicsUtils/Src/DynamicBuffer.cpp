@@ -90,6 +90,7 @@ namespace KryneEngine::Modules::GraphicsUtils
                     static_cast<u8>((_frameIndex + frameCount - 1u) % frameCount),
                 });
                 m_gpuBuffer = _graphicsContext->CreateBuffer(m_gpuRecreateDesc);
+                m_gpuContentRetained = false;
             }
 
             m_sizes[_frameIndex] = m_mappableRecreateDesc.m_desc.m_size;
@@ -129,55 +130,105 @@ namespace KryneEngine::Modules::GraphicsUtils
         }
         else
         {
-            const BufferCopyParameters params {
-                .m_copySize = m_sizes[_frameIndex],
-                .m_bufferSrc = m_mappableBuffers[_frameIndex],
-                .m_bufferDst = m_gpuBuffer,
+            const BufferRange range { 0, m_sizes[_frameIndex] };
+            CopyToGpuBuffer(_graphicsContext, _commandLine, _accessFlags, _frameIndex, { &range, 1 });
+        }
+    }
+
+    void DynamicBuffer::PrepareBufferRanges(
+        GraphicsContext* _graphicsContext,
+        CommandListHandle _commandLine,
+        BarrierAccessFlags _accessFlags,
+        u8 _frameIndex,
+        eastl::span<const BufferRange> _ranges)
+    {
+        if (m_gpuBuffer == GenPool::kInvalidHandle)
+        {
+            PrepareBuffers(_graphicsContext, _commandLine, _accessFlags, _frameIndex);
+            return;
+        }
+
+        // GPU buffer was recreated or never filled, its whole content must be uploaded
+        if (!m_gpuContentRetained)
+        {
+            PrepareBuffers(_graphicsContext, _commandLine, _accessFlags, _frameIndex);
+            return;
+        }
+
+        // GPU buffer already holds the data and is in the right state
+        if (_ranges.empty())
+        {
+            return;
+        }
+
+        CopyToGpuBuffer(_graphicsContext, _commandLine, _accessFlags, _frameIndex, _ranges);
+    }
+
+    void DynamicBuffer::CopyToGpuBuffer(
+        GraphicsContext* _graphicsContext,
+        CommandListHandle _commandLine,
+        BarrierAccessFlags _accessFlags,
+        u8 _frameIndex,
+        eastl::span<const BufferRange> _ranges)
+    {
+        const BufferHandle bufferSrc = m_mappableBuffers[_frameIndex];
+
+        {
+            BufferMemoryBarrier memoryBarriers[2] = {
+                {
+                    .m_stagesSrc = BarrierSyncStageFlags::None,
+                    .m_stagesDst = BarrierSyncStageFlags::Transfer,
+                    .m_accessSrc = BarrierAccessFlags::All,
+                    .m_accessDst = BarrierAccessFlags::TransferSrc,
+                    .m_buffer = bufferSrc,
+                },
+                {
+                    .m_stagesSrc = BarrierSyncStageFlags::None,
+                    .m_stagesDst = BarrierSyncStageFlags::Transfer,
+                    .m_accessSrc = BarrierAccessFlags::All,
+                    .m_accessDst = BarrierAccessFlags::TransferDst,
+                    .m_buffer = m_gpuBuffer,
+                }
             };
 
-            {
-                BufferMemoryBarrier memoryBarriers[2] = {
-                    {
-                        .m_stagesSrc = BarrierSyncStageFlags::None,
-                        .m_stagesDst = BarrierSyncStageFlags::Transfer,
-                        .m_accessSrc = BarrierAccessFlags::All,
-                        .m_accessDst = BarrierAccessFlags::TransferSrc,
-                        .m_buffer = params.m_bufferSrc,
-                    },
-                    {
-                        .m_stagesSrc = BarrierSyncStageFlags::None,
-                        .m_stagesDst = BarrierSyncStageFlags::Transfer,
-                        .m_accessSrc = BarrierAccessFlags::All,
-                        .m_accessDst = BarrierAccessFlags::TransferDst,
-                        .m_buffer = params.m_bufferDst,
-                    }
-                };
-
-                _graphicsContext->PlaceMemoryBarriers(
-                    _commandLine,
-                    {},
-                    { memoryBarriers, 2 },
-                    {});
-            }
+            _graphicsContext->PlaceMemoryBarriers(
+                _commandLine,
+                {},
+                { memoryBarriers, 2 },
+                {});
+        }
+
+        for (const BufferRange& range: _ranges)
+        {
+            KE_ASSERT(range.m_offset + range.m_size <= m_sizes[_frameIndex]);
 
+            const BufferCopyParameters params {
+                .m_copySize = range.m_size,
+                .m_bufferSrc = bufferSrc,
+                .m_bufferDst = m_gpuBuffer,
+                .m_offsetSrc = range.m_offset,
+                .m_offsetDst = range.m_offset,
+            };
             _graphicsContext->CopyBuffer(_commandLine, params);
+        }
 
-            {
-                BufferMemoryBarrier memoryBarrier {
-                    .m_stagesSrc = BarrierSyncStageFlags::Transfer,
-                    .m_stagesDst = BarrierSyncStageFlags::All,
-                    .m_accessSrc = BarrierAccessFlags::TransferDst,
-                    .m_accessDst = _accessFlags,
-                    .m_buffer = params.m_bufferDst,
-                };
-
-                _graphicsContext->PlaceMemoryBarriers(
-                    _commandLine,
-                    {},
-                    { &memoryBarrier, 1 },
-                    {});
-            }
+        {
+            BufferMemoryBarrier memoryBarrier {
+                .m_stagesSrc = BarrierSyncStageFlags::Transfer,
+                .m_stagesDst = BarrierSyncStageFlags::All,
+                .m_accessSrc = BarrierAccessFlags::TransferDst,
+                .m_accessDst = _accessFlags,
+                .m_buffer = m_gpuBuffer,
+            };
+
+            _graphicsContext->PlaceMemoryBarriers(
+                _commandLine,
+                {},
+                { &memoryBarrier, 1 },
+                {});
         }
+
+        m_gpuContentRetained = true;
     }
 
     BufferHandle DynamicBuffer::GetBuffer(u8 _frameIndex)
@@ -202,5 +253,10 @@ namespace KryneEngine::Modules::GraphicsUtils
         {
             _graphicsContext->DestroyBuffer(m_gpuBuffer);
         }
+        for (const BufferToFree& bufferToFree: m_gpuBuffersToFree)
+        {
+            _graphicsContext->DestroyBuffer(bufferToFree.m_buffer);
+        }
+        m_gpuBuffersToFree.clear();
     }
 }
\ No newline at end of file
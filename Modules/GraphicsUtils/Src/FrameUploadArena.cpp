@@ -0,0 +1,278 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Modules/GraphicsUtils/FrameUploadArena.hpp"
+
+#include <KryneEngine/Core/Graphics/GraphicsContext.hpp>
+#include <KryneEngine/Core/Profiling/TracyHeader.hpp>
+
+namespace KryneEngine::Modules::GraphicsUtils
+{
+    FrameUploadArena::FrameUploadArena(const AllocatorInstance _allocator)
+        : m_frames(_allocator)
+#if !defined(KE_FINAL)
+        , m_debugName(_allocator)
+#endif
+    {}
+
+    void FrameUploadArena::Init(
+        GraphicsContext* _graphicsContext,
+        const u64 _initialSize,
+        const MemoryUsage _usage,
+        const u8 _frameCount,
+        const eastl::string_view& _debugName)
+    {
+        KE_ASSERT_MSG(
+            (_usage & MemoryUsage::USAGE_TYPE_MASK) == MemoryUsage::Undefined_UsageType,
+            "Memory usage type is set by the arena");
+
+        m_usage = _usage;
+        m_targetSize = Alignment::NextPowerOfTwo(_initialSize);
+#if !defined(KE_FINAL)
+        m_debugName.assign(_debugName.data(), _debugName.size());
+#endif
+
+        m_frames.Resize(_frameCount);
+        m_frames.InitAll(m_frames.GetAllocator());
+
+        // The first GPU buffer tells whether the platform needs staging.
+        const BufferHandle firstBuffer = CreateGpuBuffer(_graphicsContext, m_targetSize);
+        m_needsStaging = _graphicsContext->NeedsStagingBuffer(firstBuffer);
+
+        m_frames[0].push_back(CreateChunk(_graphicsContext, m_targetSize, firstBuffer));
+        for (u8 i = 1; i < _frameCount; i++)
+        {
+            m_frames[i].push_back(CreateChunk(_graphicsContext, m_targetSize));
+        }
+    }
+
+    void FrameUploadArena::BeginFrame(GraphicsContext* _graphicsContext, const u8 _frameIndex)
+    {
+        KE_ZoneScopedFunction("FrameUploadArena::BeginFrame");
+
+        KE_ASSERT_MSG(!m_frameOpen, "Previous frame was not ended");
+
+        m_currentFrame = _frameIndex;
+        FrameChunks& chunks = m_frames[_frameIndex];
+
+        // The GPU is done with this frame context, its memory can be coalesced into a single chunk.
+        if (chunks.size() > 1 || chunks.front().m_suballocator.GetCapacity() < m_targetSize)
+        {
+            for (const Chunk& chunk: chunks)
+            {
+                DestroyChunk(_graphicsContext, chunk);
+            }
+            chunks.clear();
+            chunks.push_back(CreateChunk(_graphicsContext, m_targetSize));
+        }
+
+        chunks.front().m_suballocator.Reset();
+        MapChunk(_graphicsContext, chunks.front());
+
+        m_allocationCount = 0;
+        m_frameOpen = true;
+    }
+
+    FrameUploadArena::Allocation FrameUploadArena::Allocate(
+        GraphicsContext* _graphicsContext,
+        const u64 _size,
+        const u64 _alignment)
+    {
+        KE_ASSERT_MSG(m_frameOpen, "Allocations must happen between BeginFrame() and EndFrame()");
+
+        FrameChunks& chunks = m_frames[m_currentFrame];
+        u64 offset = chunks.back().m_suballocator.Allocate(_size, _alignment);
+
+        if (offset == LinearSuballocator::kInvalidOffset)
+        {
+            // Keep the data already written, continue in a new chunk.
+            const u64 size = eastl::max(
+                Alignment::NextPowerOfTwo(_size),
+                chunks.back().m_suballocator.GetCapacity() * 2);
+            chunks.push_back(CreateChunk(_graphicsContext, size));
+            MapChunk(_graphicsContext, chunks.back());
+            offset = chunks.back().m_suballocator.Allocate(_size, _alignment);
+        }
+
+        const Chunk& chunk = chunks.back();
+        m_allocationCount++;
+        return {
+            .m_cpuPtr = chunk.m_mapping.m_ptr + offset,
+            .m_buffer = chunk.m_gpuBuffer,
+            .m_offset = offset,
+            .m_size = _size,
+        };
+    }
+
+    void FrameUploadArena::EndFrame(
+        GraphicsContext* _graphicsContext,
+        const CommandListHandle _commandList,
+        const BarrierAccessFlags _accessFlags)
+    {
+        KE_ZoneScopedFunction("FrameUploadArena::EndFrame");
+
+        VERIFY_OR_RETURN_VOID(m_frameOpen);
+        m_frameOpen = false;
+
+        FrameChunks& chunks = m_frames[m_currentFrame];
+
+        m_statistics.m_usedBytes = 0;
+        m_statistics.m_capacity = 0;
+        m_statistics.m_copyCount = 0;
+        m_statistics.m_chunkCount = chunks.size();
+        m_statistics.m_allocationCount = m_allocationCount;
+
+        eastl::vector<BufferMemoryBarrier> transferBarriers(m_frames.GetAllocator());
+        eastl::vector<BufferMemoryBarrier> usageBarriers(m_frames.GetAllocator());
+
+        for (Chunk& chunk: chunks)
+        {
+            _graphicsContext->UnmapBuffer(chunk.m_mapping);
+
+            const u64 used = chunk.m_suballocator.GetUsed();
+            m_statistics.m_usedBytes += used;
+            m_statistics.m_capacity += chunk.m_suballocator.GetCapacity();
+            if (used == 0)
+            {
+                continue;
+            }
+
+            if (m_needsStaging)
+            {
+                transferBarriers.push_back({
+                    .m_stagesSrc = BarrierSyncStageFlags::None,
+                    .m_stagesDst = BarrierSyncStageFlags::Transfer,
+                    .m_accessSrc = BarrierAccessFlags::All,
+                    .m_accessDst = BarrierAccessFlags::TransferSrc,
+                    .m_buffer = chunk.m_stagingBuffer,
+                });
+                transferBarriers.push_back({
+                    .m_stagesSrc = BarrierSyncStageFlags::None,
+                    .m_stagesDst = BarrierSyncStageFlags::Transfer,
+                    .m_accessSrc = BarrierAccessFlags::All,
+                    .m_accessDst = BarrierAccessFlags::TransferDst,
+                    .m_buffer = chunk.m_gpuBuffer,
+                });
+                usageBarriers.push_back({
+                    .m_stagesSrc = BarrierSyncStageFlags::Transfer,
+                    .m_stagesDst = BarrierSyncStageFlags::All,
+                    .m_accessSrc = BarrierAccessFlags::TransferDst,
+                    .m_accessDst = _accessFlags,
+                    .m_buffer = chunk.m_gpuBuffer,
+                });
+            }
+            else
+            {
+                usageBarriers.push_back({
+                    .m_stagesSrc = BarrierSyncStageFlags::All,
+                    .m_stagesDst = BarrierSyncStageFlags::All,
+                    .m_accessSrc = BarrierAccessFlags::All,
+                    .m_accessDst = _accessFlags,
+                    .m_buffer = chunk.m_gpuBuffer,
+                });
+            }
+        }
+
+        if (!transferBarriers.empty())
+        {
+            _graphicsContext->PlaceMemoryBarriers(_commandList, {}, transferBarriers, {});
+
+            // A single copy of the used range per chunk
+            for (const Chunk& chunk: chunks)
+            {
+                const u64 used = chunk.m_suballocator.GetUsed();
+                if (used == 0)
+                {
+                    continue;
+                }
+
+                _graphicsContext->CopyBuffer(_commandList, {
+                    .m_copySize = used,
+                    .m_bufferSrc = chunk.m_stagingBuffer,
+                    .m_bufferDst = chunk.m_gpuBuffer,
+                });
+                m_statistics.m_copyCount++;
+            }
+        }
+
+        if (!usageBarriers.empty())
+        {
+            _graphicsContext->PlaceMemoryBarriers(_commandList, {}, usageBarriers, {});
+        }
+
+        m_statistics.m_highWaterMark = eastl::max(m_statistics.m_highWaterMark, m_statistics.m_usedBytes);
+        m_targetSize = eastl::max(m_targetSize, Alignment::NextPowerOfTwo(m_statistics.m_usedBytes));
+    }
+
+    void FrameUploadArena::Destroy(GraphicsContext* _graphicsContext)
+    {
+        for (FrameChunks& chunks: m_frames)
+        {
+            for (const Chunk& chunk: chunks)
+            {
+                DestroyChunk(_graphicsContext, chunk);
+            }
+            chunks.clear();
+        }
+    }
+
+    BufferHandle FrameUploadArena::CreateGpuBuffer(GraphicsContext* _graphicsContext, const u64 _size) const
+    {
+        return _graphicsContext->CreateBuffer({
+            .m_desc = {
+                .m_size = _size,
+#if !defined(KE_FINAL)
+                .m_debugName = m_debugName,
+#endif
+            },
+            .m_usage = MemoryUsage::StageEveryFrame_UsageType | m_usage | MemoryUsage::TransferDstBuffer,
+        });
+    }
+
+    FrameUploadArena::Chunk FrameUploadArena::CreateChunk(
+        GraphicsContext* _graphicsContext,
+        const u64 _size,
+        const BufferHandle _gpuBuffer) const
+    {
+        Chunk chunk {
+            .m_gpuBuffer = _gpuBuffer != GenPool::kInvalidHandle ? _gpuBuffer : CreateGpuBuffer(_graphicsContext, _size),
+            .m_suballocator = LinearSuballocator(_size),
+        };
+
+        if (m_needsStaging)
+        {
+            chunk.m_stagingBuffer = _graphicsContext->CreateBuffer({
+                .m_desc = {
+                    .m_size = _size,
+#if !defined(KE_FINAL)
+                    .m_debugName = m_debugName,
+#endif
+                },
+                .m_usage = MemoryUsage::StageOnce_UsageType | MemoryUsage::TransferSrcBuffer,
+            });
+        }
+        else
+        {
+            chunk.m_stagingBuffer = chunk.m_gpuBuffer;
+        }
+        return chunk;
+    }
+
+    void FrameUploadArena::DestroyChunk(GraphicsContext* _graphicsContext, const Chunk& _chunk) const
+    {
+        if (m_needsStaging)
+        {
+            _graphicsContext->DestroyBuffer(_chunk.m_stagingBuffer);
+        }
+        _graphicsContext->DestroyBuffer(_chunk.m_gpuBuffer);
+    }
+
+    void FrameUploadArena::MapChunk(GraphicsContext* _graphicsContext, Chunk& _chunk) const
+    {
+        _chunk.m_mapping = BufferMapping { _chunk.m_stagingBuffer, _chunk.m_suballocator.GetCapacity() };
+        _graphicsContext->MapBuffer(_chunk.m_mapping);
+    }
+}
@@ -0,0 +1,84 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Modules/GraphicsUtils/RetainedBufferDiff.hpp"
+
+#include <KryneEngine/Core/Common/Assert.hpp>
+#include <KryneEngine/Core/Profiling/TracyHeader.hpp>
+
+namespace KryneEngine::Modules::GraphicsUtils
+{
+    RetainedBufferDiff::RetainedBufferDiff(
+        const AllocatorInstance _allocator,
+        const u32 _blockSize,
+        const u32 _mergeDistance)
+            : m_retained(_allocator)
+            , m_ranges(_allocator)
+            , m_blockSize(_blockSize)
+            , m_mergeDistance(_mergeDistance)
+    {
+        KE_ASSERT(_blockSize > 0);
+    }
+
+    eastl::span<const BufferRange> RetainedBufferDiff::Update(const std::byte* _data, const u64 _size)
+    {
+        KE_ZoneScopedFunction("RetainedBufferDiff::Update");
+
+        m_ranges.clear();
+
+        if (!m_valid)
+        {
+            AddRange(0, _size);
+        }
+        else
+        {
+            const u64 comparedSize = eastl::min<u64>(_size, m_retained.size());
+            for (u64 offset = 0; offset < comparedSize; offset += m_blockSize)
+            {
+                const u64 size = eastl::min<u64>(m_blockSize, comparedSize - offset);
+                if (memcmp(_data + offset, m_retained.data() + offset, size) != 0)
+                {
+                    AddRange(offset, size);
+                }
+            }
+            if (_size > comparedSize)
+            {
+                AddRange(comparedSize, _size - comparedSize);
+            }
+        }
+
+        m_retained.resize(_size);
+        m_statistics = { .m_totalBytes = _size };
+        for (const BufferRange& range: m_ranges)
+        {
+            memcpy(m_retained.data() + range.m_offset, _data + range.m_offset, range.m_size);
+            m_statistics.m_uploadedBytes += range.m_size;
+        }
+        m_statistics.m_rangeCount = m_ranges.size();
+        m_valid = true;
+
+        return m_ranges;
+    }
+
+    void RetainedBufferDiff::AddRange(const u64 _offset, const u64 _size)
+    {
+        if (_size == 0)
+        {
+            return;
+        }
+
+        if (!m_ranges.empty())
+        {
+            BufferRange& last = m_ranges.back();
+            if (_offset <= last.m_offset + last.m_size + m_mergeDistance)
+            {
+                last.m_size = _offset + _size - last.m_offset;
+                return;
+            }
+        }
+        m_ranges.push_back({ _offset, _size });
+    }
+}
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <clay.h>
+#include <KryneEngine/Core/Common/Types.hpp>
 #include <KryneEngine/Core/Common/Utils/Macros.hpp>
 
 namespace KryneEngine
@@ -21,3 +22,11 @@ namespace KryneEngine
         };
     }
 }
+
+namespace KryneEngine::Modules::GuiLib
+{
+    /**
+     * @brief Returns the number of layout elements declared so far in the current Clay layout, text elements included.
+     */
+    [[nodiscard]] s32 GetClayLayoutElementCount();
+}
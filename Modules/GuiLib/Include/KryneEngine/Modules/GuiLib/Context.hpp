@@ -15,6 +15,8 @@
 #include <KryneEngine/Core/Memory/Containers/StableVector.hpp>
 #include <clay.h>
 
+#include "KryneEngine/Modules/GuiLib/GuiLayoutCache.hpp"
+#include "KryneEngine/Modules/GuiLib/GuiRenderCommandOptimizer.hpp"
 #include "KryneEngine/Modules/GuiLib/TextureRegion.hpp"
 
 namespace KryneEngine::Modules::TextRendering
@@ -52,6 +54,44 @@ namespace KryneEngine::Modules::GuiLib
 
         void* RegisterTextureRegion(TextureRegion&& _region);
 
+        /**
+         * @brief Enables the reuse of unchanged cached subtrees from one frame to the next. See `GuiLayoutCache`.
+         */
+        void SetIncrementalLayout(bool _enabled);
+        [[nodiscard]] bool IsIncrementalLayoutEnabled() const { return m_incrementalLayout; }
+
+        /**
+         * @brief Opens a subtree that can be reused by the incremental layout.
+         *
+         * @details
+         * Must be closed with `EndCachedSubtree()`. With incremental layout disabled, this simply opens an element with
+         * the given id and declaration.
+         *
+         * @return True if the children need to be declared.
+         */
+        [[nodiscard]] bool BeginCachedSubtree(
+            Clay_ElementId _id,
+            u64 _contentHash,
+            const Clay_ElementDeclaration& _declaration);
+        void EndCachedSubtree();
+
+        [[nodiscard]] const GuiLayoutCache::Statistics& GetLayoutStatistics() const
+        {
+            return m_layoutCache.GetStatistics();
+        }
+
+        /**
+         * @brief Enables the render commands post-pass, culling, dropping and reordering commands before they reach the
+         * renderer. See `GuiRenderCommandOptimizer`. Enabled by default.
+         */
+        void SetRenderCommandOptimization(bool _enabled) { m_optimizeRenderCommands = _enabled; }
+        [[nodiscard]] bool IsRenderCommandOptimizationEnabled() const { return m_optimizeRenderCommands; }
+
+        [[nodiscard]] const GuiRenderCommandOptimizer::Statistics& GetRenderCommandStatistics() const
+        {
+            return m_renderCommandOptimizer.GetStatistics();
+        }
+
         ~Context();
 
         [[nodiscard]] AllocatorInstance GetAllocator() const { return m_allocator; }
@@ -62,6 +102,11 @@ namespace KryneEngine::Modules::GuiLib
         char* m_arenaMemory = nullptr;
         Clay_Context* m_clayContext = nullptr;
         IGuiRenderer* m_renderer = nullptr;
+        GuiLayoutCache m_layoutCache;
+        bool m_incrementalLayout = false;
+        GuiRenderCommandOptimizer m_renderCommandOptimizer;
+        bool m_optimizeRenderCommands = true;
+        float2 m_viewportSize {};
 
         /// A temporary array for storing texture regions for this Gui context
         StableVector<TextureRegion> m_registeredRegions;
@@ -0,0 +1,140 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <EASTL/hash_map.h>
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
+#include <KryneEngine/Core/Common/Types.hpp>
+#include <KryneEngine/Core/Math/Vector.hpp>
+#include <KryneEngine/Core/Memory/Allocators/Allocator.hpp>
+#include <clay.h>
+
+namespace KryneEngine::Modules::GuiLib
+{
+    /**
+     * @brief Reuses the layout and render commands of unchanged GUI subtrees from one frame to the next.
+     *
+     * @details
+     * A cached subtree is identified by its element id and a content hash provided by the caller, which must cover
+     * everything its contents and size depend on. When both match the previous frame, `BeginSubtree()` returns false
+     * and the caller skips declaring the children: Clay only lays out a fixed size placeholder, and the previous render
+     * commands are moved to the placeholder position in `EndFrame()`. Text of clean subtrees is neither measured nor
+     * wrapped again.
+     *
+     * Dirty subtrees are declared as usual, within an extra outer element carrying the sizing and floating config. The
+     * subtree root keeps its id and the rest of the declaration, so the emitted render commands are the same as without
+     * the cache. Marker render commands are emitted around the contents, so they can be recorded for the next frames.
+     *
+     * Clay culling is disabled while the cache is in use, so subtrees are recorded whole. Culling is applied to the
+     * resolved commands instead.
+     *
+     * Limitations:
+     * - Elements of clean subtrees are not declared, so they don't receive pointer or scroll state. Interactive widgets
+     * should be part of dirty subtrees, or include their hover state in the content hash.
+     * - Floating elements are emitted out of their parent's order, and must not be declared inside a cached subtree.
+     * - Data referenced by render commands other than text (`userData`, image and custom data) must stay valid as long
+     * as the content hash doesn't change.
+     * - A viewport size change invalidates all the subtrees.
+     */
+    class GuiLayoutCache
+    {
+    public:
+        struct Statistics
+        {
+            u32 m_subtrees;
+            u32 m_reusedSubtrees;
+            u32 m_elements;
+            u32 m_reusedElements;
+            u32 m_renderCommands;
+            u32 m_reusedRenderCommands;
+
+            /**
+             * @brief Fraction of the frame's layout elements that were reused from a previous frame.
+             */
+            [[nodiscard]] float GetReuseRatio() const
+            {
+                return m_elements > 0 ? static_cast<float>(m_reusedElements) / static_cast<float>(m_elements) : 0.f;
+            }
+        };
+
+        explicit GuiLayoutCache(AllocatorInstance _allocator);
+
+        /**
+         * @brief Starts a new frame. Must be called after `Clay_BeginLayout()`.
+         */
+        void BeginFrame(const float2& _viewportSize);
+
+        /**
+         * @brief Opens a cached subtree.
+         *
+         * @param _id The element id of the subtree, which must be unique within the frame.
+         * @param _contentHash A hash of everything the subtree contents and size depend on.
+         * @param _declaration The declaration of the subtree root element. Its id is ignored.
+         *
+         * @return True if the children need to be declared, false if the subtree is reused. `EndSubtree()` must be
+         * called in both cases.
+         */
+        [[nodiscard]] bool BeginSubtree(Clay_ElementId _id, u64 _contentHash, const Clay_ElementDeclaration& _declaration);
+
+        void EndSubtree();
+
+        /**
+         * @brief Expands the reused subtrees, records the dirty ones and culls the final render commands.
+         *
+         * @param _renderCommands The render commands returned by `Clay_EndLayout()`.
+         * @return The render commands to submit to the renderer, valid until the next frame.
+         */
+        [[nodiscard]] eastl::span<const Clay_RenderCommand> EndFrame(const Clay_RenderCommandArray& _renderCommands);
+
+        void Clear();
+
+        [[nodiscard]] const Statistics& GetStatistics() const { return m_statistics; }
+
+    private:
+        struct Entry
+        {
+            u64 m_contentHash = 0;
+            u64 m_lastUsedFrame = 0;
+            Clay_BoundingBox m_boundingBox {};
+            u32 m_elementCount = 0;
+            bool m_recorded = false;
+            bool m_reused = false;
+            eastl::vector<Clay_RenderCommand> m_commands;
+            eastl::vector<char> m_strings;
+        };
+
+        struct OpenSubtree
+        {
+            Entry* m_entry;
+            s32 m_firstElement;
+            u32 m_wrapperElements;
+            u32 m_reusedElements;
+        };
+
+        struct Recording
+        {
+            Entry* m_entry;
+            Clay_BoundingBox m_boundingBox;
+            u32 m_firstCommand;
+        };
+
+        AllocatorInstance m_allocator;
+        eastl::hash_map<u32, Entry> m_entries;
+        eastl::vector<OpenSubtree> m_openSubtrees;
+        eastl::vector<Recording> m_recordings;
+        eastl::vector<Clay_RenderCommand> m_resolvedCommands;
+        u64 m_frameId = 0;
+        u32 m_wrapperElements = 0;
+        float2 m_viewportSize {};
+        Statistics m_statistics {};
+
+        void Record(const Recording& _recording);
+        void Expand(const Entry& _entry, const Clay_BoundingBox& _boundingBox);
+        [[nodiscard]] bool IsOffscreen(const Clay_RenderCommand& _command) const;
+    };
+}
@@ -0,0 +1,83 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
+#include <KryneEngine/Core/Common/Types.hpp>
+#include <KryneEngine/Core/Math/Vector.hpp>
+#include <KryneEngine/Core/Memory/Allocators/Allocator.hpp>
+#include <clay.h>
+
+namespace KryneEngine::Modules::GuiLib
+{
+    /**
+     * @brief Post-pass over the Clay render commands, removing what won't be visible and grouping commands per pipeline.
+     *
+     * @details
+     * The pass runs in three steps:
+     * - Commands entirely outside the active scissor rect (or the viewport) are culled, and scissor pairs left empty are
+     * removed.
+     * - Invisible commands are dropped: fully transparent colors, zero-sized rects and borders without width.
+     * - Within a scissor segment, commands are moved earlier to join the last command group of the same pipeline, as long
+     * as they don't overlap any command they are moved past. The painter's order of overlapping commands is kept.
+     *
+     * Images share a pipeline and are batched across textures by the renderer, so they are grouped regardless of their
+     * texture. Scissor and custom commands are never moved, and no command is moved across them.
+     */
+    class GuiRenderCommandOptimizer
+    {
+    public:
+        struct Statistics
+        {
+            u32 m_inputCommands;
+            u32 m_outputCommands;
+            u32 m_culledCommands;
+            u32 m_invisibleCommands;
+            u32 m_removedScissors;
+            u32 m_reorderedCommands;
+        };
+
+        /// How many command groups a command can be moved past.
+        static constexpr u32 kMaxLookbackGroups = 16;
+
+        explicit GuiRenderCommandOptimizer(AllocatorInstance _allocator);
+
+        /**
+         * @return The optimized render commands, valid until the next call.
+         */
+        [[nodiscard]] eastl::span<const Clay_RenderCommand> Process(
+            eastl::span<const Clay_RenderCommand> _renderCommands,
+            const float2& _viewportSize);
+
+        [[nodiscard]] const Statistics& GetStatistics() const { return m_statistics; }
+
+    private:
+        struct Group
+        {
+            u32 m_key;
+            Clay_BoundingBox m_bounds;
+            u32 m_first;
+            u32 m_last;
+        };
+
+        static constexpr u32 kEndOfGroup = ~0u;
+
+        eastl::vector<Clay_RenderCommand> m_output;
+        eastl::vector<Group> m_groups;
+        eastl::vector<u32> m_nextInGroup;
+        eastl::vector<const Clay_RenderCommand*> m_segmentCommands;
+        eastl::vector<Clay_BoundingBox> m_clipStack;
+        eastl::vector<u32> m_openScissors;
+        Statistics m_statistics {};
+
+        void AddToSegment(const Clay_RenderCommand& _command);
+        void FlushSegment();
+
+        [[nodiscard]] static bool IsInvisible(const Clay_RenderCommand& _command);
+    };
+}
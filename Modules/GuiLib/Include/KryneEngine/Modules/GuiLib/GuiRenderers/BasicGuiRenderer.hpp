@@ -7,8 +7,12 @@
 #pragma once
 
 #include <KryneEngine/Modules/GraphicsUtils/DynamicBuffer.hpp>
+#include <KryneEngine/Modules/GraphicsUtils/RetainedBufferDiff.hpp>
 #include "KryneEngine/Core/Math/Matrix.hpp"
 #include "KryneEngine/Modules/GuiLib/IGuiRenderer.hpp"
+#include "KryneEngine/Modules/GuiLib/GuiRenderers/GuiDrawBatcher.hpp"
+#include "KryneEngine/Modules/GuiLib/GuiRenderers/GuiTextTierSelector.hpp"
+#include "KryneEngine/Modules/GuiLib/GuiRenderers/GuiTextureBindingCache.hpp"
 
 namespace KryneEngine::Modules::TextRendering
 {
@@ -18,7 +22,18 @@ namespace KryneEngine::Modules::TextRendering
 namespace KryneEngine::Modules::GuiLib
 {
     /**
-     * @brief A basic renderer for the GUI that does 1 draw call per UI element
+     * @brief A basic renderer for the GUI, with one instanced quad per UI element or glyph.
+     *
+     * @details
+     * By default, consecutive instances sharing the same pipeline, textures descriptor set and scissor rect are merged
+     * into a single instanced draw. Batching can be disabled to get back one draw call per instance.
+     *
+     * In retained instance buffer mode, the instance stream is compared against the previous frame, and only the
+     * changed ranges are uploaded to the GPU buffer. This only pays off when the instance buffer goes through staging,
+     * directly mapped buffers are fully written every frame.
+     *
+     * Text is rendered in tiers: small font sizes use coverage bitmaps pre-rasterized by the atlas manager, larger ones
+     * evaluate the glyph MSDF. A per-frame glyph instance budget can be set, see `GuiTextTierSelector`.
      */
     class BasicGuiRenderer final: public IGuiRenderer
     {
@@ -35,13 +50,66 @@ namespace KryneEngine::Modules::GuiLib
         void EndLayoutAndRender(
             GraphicsContext& _graphicsContext,
             CommandListHandle _transferCommandList,
-            CommandListHandle _renderCommandList) override;
+            CommandListHandle _renderCommandList,
+            eastl::span<const Clay_RenderCommand> _renderCommands) override;
 
-        static constexpr u32 kMaxTextureSlots = 32;
-        static constexpr u32 kMaxSamplerSlots = 8;
+        static constexpr u32 kMaxTextureSlots = GuiTextureBindingCache::kTextureSlotCount;
+        static constexpr u32 kMaxSamplerSlots = GuiTextureBindingCache::kSamplerSlotCount;
 
         [[nodiscard]] AllocatorInstance GetAllocator() const { return m_commonConstantBufferViews.GetAllocator(); }
 
+        void SetBatchingEnabled(bool _enabled) { m_batching = _enabled; }
+        [[nodiscard]] bool IsBatchingEnabled() const { return m_batching; }
+
+        /**
+         * @brief Returns the render commands consumed and draw calls issued during the last `EndLayoutAndRender()`.
+         */
+        [[nodiscard]] const GuiDrawBatcher::Statistics& GetLastRenderStatistics() const
+        {
+            return m_drawBatcher.GetStatistics();
+        }
+
+        /**
+         * @brief Returns the texture descriptor set creations and writes done during the last `EndLayoutAndRender()`.
+         */
+        [[nodiscard]] const GuiTextureBindingCache::Statistics& GetLastTextureBindingStatistics() const
+        {
+            return m_textureBindingCache.GetStatistics();
+        }
+
+        void SetRetainedInstanceBuffer(bool _enabled)
+        {
+            m_retainedInstanceBuffer = _enabled;
+            m_instanceDiff.Invalidate();
+        }
+        [[nodiscard]] bool IsRetainedInstanceBufferEnabled() const { return m_retainedInstanceBuffer; }
+
+        /**
+         * @brief Returns the instance bytes uploaded and saved during the last `EndLayoutAndRender()`, in retained
+         * instance buffer mode.
+         */
+        [[nodiscard]] const GraphicsUtils::RetainedBufferDiff::Statistics& GetLastInstanceUploadStatistics() const
+        {
+            return m_instanceDiff.GetStatistics();
+        }
+
+        void SetTextTierSettings(const GuiTextTierSelector::Settings& _settings) { m_textTierSelector.SetSettings(_settings); }
+        [[nodiscard]] const GuiTextTierSelector::Settings& GetTextTierSettings() const { return m_textTierSelector.GetSettings(); }
+
+        /**
+         * @brief Returns the glyph instances drawn per text tier, and skipped by the budget, during the last
+         * `EndLayoutAndRender()`.
+         */
+        [[nodiscard]] const GuiTextTierSelector::Statistics& GetLastTextStatistics() const
+        {
+            return m_textTierSelector.GetStatistics();
+        }
+
+        /**
+         * @brief Must be called before destroying a texture view that was displayed by the GUI.
+         */
+        void InvalidateTextureView(TextureViewHandle _textureView) { m_textureBindingCache.Invalidate(_textureView); }
+
     private:
         TextRendering::MsdfAtlasManager* m_atlasManager = nullptr;
 
@@ -64,6 +132,7 @@ namespace KryneEngine::Modules::GuiLib
         GraphicsPipelineHandle m_borderPipeline;
         GraphicsPipelineHandle m_imagePipeline;
         GraphicsPipelineHandle m_textPipeline;
+        GraphicsPipelineHandle m_textCoveragePipeline;
 
         SamplerHandle m_defaultSampler;
         SamplerHandle m_textSampler;
@@ -71,8 +140,23 @@ namespace KryneEngine::Modules::GuiLib
         eastl::array<u32, 1> m_commonDescriptorSetIndices {};
         eastl::array<u32, 2> m_texturesDescriptorSetIndices {};
 
-        eastl::vector<DescriptorSetHandle> m_texturesDescriptorSets;
         DescriptorSetHandle m_textDescriptorSet;
+
+        // Draw batches index the text descriptor set first, then the texture binding cache sets.
+        static constexpr u32 kTextDescriptorSetIndex = 0;
+        static constexpr u32 kFirstTexturesDescriptorSetIndex = 1;
+
+        GuiDrawBatcher m_drawBatcher;
+        GuiTextureBindingCache m_textureBindingCache;
+        GuiTextTierSelector m_textTierSelector;
+        bool m_batching = true;
+
+        // Dirty instance ranges this close are uploaded as one, in instance count.
+        static constexpr u32 kInstanceRangeMergeDistance = 4;
+
+        eastl::vector<std::byte> m_instanceStream;
+        GraphicsUtils::RetainedBufferDiff m_instanceDiff;
+        bool m_retainedInstanceBuffer = false;
     };
 
 } // namespace KryneEngine
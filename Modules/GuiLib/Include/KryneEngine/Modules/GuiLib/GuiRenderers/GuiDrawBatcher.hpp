@@ -0,0 +1,112 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
+#include <KryneEngine/Core/Common/Types.hpp>
+#include <KryneEngine/Core/Graphics/Handles.hpp>
+#include <KryneEngine/Core/Memory/Allocators/Allocator.hpp>
+
+namespace KryneEngine
+{
+    class GraphicsContext;
+}
+
+namespace KryneEngine::Modules::GuiLib
+{
+    /**
+     * @brief Merges consecutive GUI instances sharing the same draw state into instanced draw batches.
+     *
+     * @details
+     * Instances are pushed in render command order, with contiguous instance indices. A new batch is started whenever
+     * the pipeline, the textures descriptor set or the scissor rect changes, so the painter's order of the commands is
+     * preserved. Instances that don't sample any texture use `kAnyDescriptorSet` and never break a batch on descriptor
+     * set changes.
+     *
+     * The recorded batches are replayed onto a command list with `Submit()`, which only emits the state changes that
+     * actually differ from the previous batch.
+     */
+    class GuiDrawBatcher
+    {
+    public:
+        static constexpr u32 kAnyDescriptorSet = ~0u;
+
+        struct DrawState
+        {
+            GraphicsPipelineHandle m_pipeline { GenPool::kInvalidHandle };
+            u32 m_descriptorSetIndex = kAnyDescriptorSet;
+        };
+
+        struct Batch
+        {
+            DrawState m_state;
+            u32 m_scissorIndex;
+            u32 m_firstInstance;
+            u32 m_instanceCount;
+        };
+
+        struct Statistics
+        {
+            u32 m_renderCommands;
+            u32 m_instances;
+            u32 m_drawCalls;
+            u32 m_pipelineChanges;
+            u32 m_descriptorSetChanges;
+            u32 m_scissorChanges;
+        };
+
+        explicit GuiDrawBatcher(AllocatorInstance _allocator);
+
+        /**
+         * @param _batching When disabled, every instance gets its own draw, matching the non-batched renderer behavior.
+         */
+        void Reset(bool _batching);
+
+        void PushInstance(const DrawState& _state, u32 _instanceIndex);
+
+        /**
+         * @brief Sets the scissor rect of the following instances. Setting the same rect again doesn't break the
+         * current batch.
+         */
+        void SetScissor(const Rect& _scissor);
+
+        void CountRenderCommand() { m_statistics.m_renderCommands++; }
+
+        /**
+         * @brief Emits the recorded batches onto the command list.
+         *
+         * @param _descriptorSets The textures descriptor sets, indexed by `DrawState::m_descriptorSetIndex`.
+         * @param _descriptorSetOffset The descriptor set slot the textures descriptor sets are bound to.
+         */
+        void Submit(
+            GraphicsContext& _graphicsContext,
+            CommandListHandle _commandList,
+            PipelineLayoutHandle _pipelineLayout,
+            eastl::span<const DescriptorSetHandle> _descriptorSets,
+            u32 _descriptorSetOffset,
+            u32 _vertexCount);
+
+        [[nodiscard]] eastl::span<const Batch> GetBatches() const { return m_batches; }
+        [[nodiscard]] eastl::span<const Rect> GetScissors() const { return m_scissors; }
+
+        /**
+         * @brief Returns the statistics of the recorded batches. Draw call and state change counts are only
+         * known after `Submit()`.
+         */
+        [[nodiscard]] const Statistics& GetStatistics() const { return m_statistics; }
+
+        static constexpr u32 kNoScissor = ~0u;
+
+    private:
+        eastl::vector<Batch> m_batches;
+        eastl::vector<Rect> m_scissors;
+        u32 m_currentScissor = kNoScissor;
+        bool m_batching = true;
+        Statistics m_statistics {};
+    };
+}
@@ -0,0 +1,78 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <KryneEngine/Core/Common/Types.hpp>
+
+namespace KryneEngine::Modules::GuiLib
+{
+    /**
+     * @brief Picks the text rendering path of GUI glyphs, and enforces a per-frame glyph instance budget.
+     *
+     * @details
+     * Small font sizes use coverage bitmaps pre-rasterized at their pixel size, which skip the MSDF evaluation but only
+     * look right when sampled 1:1. They are only selected when the GUI is drawn in screen space. Larger sizes, and any
+     * text drawn with a custom viewport transform, keep the MSDF path.
+     *
+     * Once the instance budget of the frame is spent, the remaining glyphs are skipped.
+     */
+    class GuiTextTierSelector
+    {
+    public:
+        enum class Tier: u8
+        {
+            Coverage,
+            Msdf,
+        };
+
+        struct Settings
+        {
+            /// Font sizes up to this value use the coverage tier. 0 disables it.
+            float m_coverageMaxFontSize = 18.f;
+            /// Maximum glyph instances per frame. 0 means unlimited.
+            u32 m_instanceBudget = 0;
+        };
+
+        struct Statistics
+        {
+            u32 m_coverageInstances;
+            u32 m_msdfInstances;
+            u32 m_overBudgetInstances;
+
+            [[nodiscard]] u32 GetInstanceCount() const { return m_coverageInstances + m_msdfInstances; }
+        };
+
+        void SetSettings(const Settings& _settings) { m_settings = _settings; }
+        [[nodiscard]] const Settings& GetSettings() const { return m_settings; }
+
+        /**
+         * @param _screenSpace Whether GUI pixels map 1:1 to render target pixels this frame.
+         */
+        void BeginFrame(bool _screenSpace);
+
+        [[nodiscard]] Tier SelectTier(float _fontSize) const;
+
+        /**
+         * @brief Counts a glyph instance of the given tier against the budget.
+         *
+         * @return False if the budget is spent and the glyph must be skipped.
+         */
+        [[nodiscard]] bool AcquireInstance(Tier _tier);
+
+        /**
+         * @brief The pixel size coverage bitmaps are rasterized at for a given font size.
+         */
+        [[nodiscard]] static u32 GetCoveragePixelSize(float _fontSize);
+
+        [[nodiscard]] const Statistics& GetStatistics() const { return m_statistics; }
+
+    private:
+        Settings m_settings {};
+        Statistics m_statistics {};
+        bool m_screenSpace = true;
+    };
+}
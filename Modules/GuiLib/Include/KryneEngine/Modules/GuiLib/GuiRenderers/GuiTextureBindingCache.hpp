@@ -0,0 +1,167 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <EASTL/array.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
+#include <KryneEngine/Core/Graphics/Handles.hpp>
+#include <KryneEngine/Core/Memory/Allocators/Allocator.hpp>
+#include <KryneEngine/Modules/GraphicsUtils/DeferredGraphicResourcesDestructor.hpp>
+
+namespace KryneEngine
+{
+    class GraphicsContext;
+}
+
+namespace KryneEngine::Modules::GuiLib
+{
+    /**
+     * @brief Persistent texture descriptor sets for GUI images, keyed by (texture view, sampler).
+     *
+     * @details
+     * Each descriptor set holds up to `kTextureSlotCount` textures and `kSamplerSlotCount` samplers. Bindings stay in
+     * their slots across frames, so a static UI doesn't create nor write any descriptor set.
+     *
+     * When a slot is assigned, its descriptor set is written once per frame context over the next frames, as each frame
+     * context has its own copy of the set. Slots unused for more than the eviction frame count are released, and
+     * descriptor sets with no more textures are destroyed through deferred destruction.
+     *
+     * A frame goes through `BeginFrame()`, `Acquire()` for each image, `EndFrame()` to run eviction and record the
+     * descriptor set operations, then `Synchronize()` to apply these operations to the graphics context. Texture views
+     * that are destroyed while still cached must be removed with `Invalidate()` beforehand.
+     */
+    class GuiTextureBindingCache
+    {
+    public:
+        static constexpr u32 kTextureSlotCount = 32;
+        static constexpr u32 kSamplerSlotCount = 8;
+        static constexpr u32 kDefaultEvictionFrameCount = 120;
+
+        struct Binding
+        {
+            u16 m_descriptorSetIndex;
+            u8 m_textureSlot;
+            u8 m_samplerSlot;
+        };
+
+        struct Statistics
+        {
+            u32 m_hits;
+            u32 m_misses;
+            u32 m_setCreations;
+            u32 m_setWrites;
+            u32 m_descriptorWrites;
+            u32 m_slotEvictions;
+            u32 m_setEvictions;
+        };
+
+        GuiTextureBindingCache(
+            AllocatorInstance _allocator,
+            u8 _frameContextCount,
+            u32 _evictionFrameCount = kDefaultEvictionFrameCount);
+
+        void BeginFrame(u64 _frameId);
+
+        [[nodiscard]] Binding Acquire(TextureViewHandle _textureView, SamplerHandle _sampler);
+
+        /**
+         * @brief Releases every slot referencing the texture view.
+         */
+        void Invalidate(TextureViewHandle _textureView);
+
+        void EndFrame();
+
+        /**
+         * @brief Creates, writes and destroys descriptor sets as decided during the frame.
+         *
+         * @param _bindingIndices The texture and sampler binding indices in the descriptor set layout.
+         */
+        void Synchronize(
+            GraphicsContext& _graphicsContext,
+            DescriptorSetLayoutHandle _layout,
+            const u32* _bindingIndices);
+
+        /**
+         * @brief Destroys all descriptor sets immediately.
+         */
+        void Destroy(GraphicsContext& _graphicsContext);
+
+        /**
+         * @brief The descriptor sets, indexed by `Binding::m_descriptorSetIndex`.
+         */
+        [[nodiscard]] eastl::span<const DescriptorSetHandle> GetDescriptorSets() const { return m_descriptorSets; }
+
+        /**
+         * @brief The texture views used during the current frame, each one listed once.
+         */
+        [[nodiscard]] eastl::span<const TextureViewHandle> GetFrameTextureViews() const { return m_frameTextureViews; }
+
+        [[nodiscard]] const Statistics& GetStatistics() const { return m_statistics; }
+
+    private:
+        struct TextureSlot
+        {
+            TextureViewHandle m_textureView { GenPool::kInvalidHandle };
+            u64 m_lastUsedFrame = 0;
+        };
+
+        struct SamplerSlot
+        {
+            SamplerHandle m_sampler { GenPool::kInvalidHandle };
+            u64 m_lastUsedFrame = 0;
+        };
+
+        struct SetEntry
+        {
+            eastl::array<TextureSlot, kTextureSlotCount> m_textures {};
+            eastl::array<SamplerSlot, kSamplerSlotCount> m_samplers {};
+            u64 m_lastUsedFrame = 0;
+            u32 m_textureCount = 0;
+            u8 m_pendingWrites = 0;
+            bool m_alive = false;
+            bool m_isNew = false;
+        };
+
+        struct Operation
+        {
+            enum class Type: u8
+            {
+                Create,
+                Write,
+                Destroy,
+            };
+
+            Type m_type;
+            u16 m_setIndex;
+        };
+
+        static constexpr u8 kInvalidSlot = 0xff;
+
+        u8 m_frameContextCount;
+        u32 m_evictionFrameCount;
+        u64 m_frameId = 0;
+
+        eastl::vector<SetEntry> m_sets;
+        eastl::vector<DescriptorSetHandle> m_descriptorSets;
+        eastl::hash_map<u64, Binding> m_bindings;
+        eastl::vector<TextureViewHandle> m_frameTextureViews;
+        eastl::vector<Operation> m_operations;
+        GraphicsUtils::DeferredGraphicResourcesDestructor m_destructor;
+
+        Statistics m_statistics {};
+
+        static u64 MakeKey(TextureViewHandle _textureView, SamplerHandle _sampler);
+
+        [[nodiscard]] u8 FindOrAddSampler(SetEntry& _set, SamplerHandle _sampler);
+        [[nodiscard]] u16 AllocateSet();
+        void Touch(u16 _setIndex, u8 _textureSlot, u8 _samplerSlot);
+        void EvictTextureSlot(SetEntry& _set, u8 _textureSlot);
+        void EvictSamplerSlot(SetEntry& _set, u8 _samplerSlot);
+    };
+}
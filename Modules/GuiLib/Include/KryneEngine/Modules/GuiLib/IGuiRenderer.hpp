@@ -5,6 +5,8 @@
  */
 
 #pragma once
+#include <EASTL/span.h>
+#include <clay.h>
 #include "KryneEngine/Core/Graphics/GraphicsContext.hpp"
 #include "KryneEngine/Core/Math/Matrix.hpp"
 
@@ -25,6 +27,7 @@ namespace KryneEngine::Modules::GuiLib
         virtual void EndLayoutAndRender(
             GraphicsContext& _graphicsContext,
             CommandListHandle _transferCommandList,
-            CommandListHandle _renderCommandList) = 0;
+            CommandListHandle _renderCommandList,
+            eastl::span<const Clay_RenderCommand> _renderCommands) = 0;
     };
 } // namespace KryneEngine
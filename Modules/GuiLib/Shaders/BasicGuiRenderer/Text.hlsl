@@ -70,4 +70,18 @@ float4 TextFs(FsInput _input): SV_TARGET0
     const float4 tintColor = SrgbToLinear(unpackUnorm4x8ToFloat(_input.backgroundColor));
 
     return lerp(float4(tintColor.rgb, 0.f), tintColor, saturate(d + 0.5));
+}
+
+[shader("pixel")]
+float4 TextCoverageFs(FsInput _input): SV_TARGET0
+{
+    // Pre-rasterized coverage, sampled 1:1 in screen space. No distance field evaluation needed.
+    uint w, h;
+    textures[0].GetDimensions(w, h);
+    const float2 uv = _input.samplePixelCoords / float2(w, h);
+    const float coverage = textures[0].Sample(samplers[0], uv).a;
+
+    const float4 tintColor = SrgbToLinear(unpackUnorm4x8ToFloat(_input.backgroundColor));
+
+    return float4(tintColor.rgb, tintColor.a * coverage);
 }
\ No newline at end of file
@@ -10,6 +10,11 @@
       "ShaderType": "ps_6_0",
       "EntryPoint": "TextFs",
       "Defines": []
+    },
+    {
+      "ShaderType": "ps_6_0",
+      "EntryPoint": "TextCoverageFs",
+      "Defines": []
     }
   ]
 }
\ No newline at end of file
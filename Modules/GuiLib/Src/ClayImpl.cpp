@@ -5,4 +5,15 @@
  */
 
 #define CLAY_IMPLEMENTATION
-#include <clay.h>
\ No newline at end of file
+#include <clay.h>
+
+#include "KryneEngine/Modules/GuiLib/ClayHelper.hpp"
+
+namespace KryneEngine::Modules::GuiLib
+{
+    s32 GetClayLayoutElementCount()
+    {
+        const Clay_Context* context = Clay_GetCurrentContext();
+        return context != nullptr ? context->layoutElements.length : 0;
+    }
+}
@@ -18,6 +18,8 @@ namespace KryneEngine::Modules::GuiLib
     Context::Context(const AllocatorInstance _allocator, TextRendering::FontManager* _fontManager)
         : m_allocator(_allocator)
         , m_fontManager(_fontManager)
+        , m_layoutCache(_allocator)
+        , m_renderCommandOptimizer(_allocator)
         , m_registeredRegions(_allocator)
     {}
 
@@ -74,6 +76,14 @@ namespace KryneEngine::Modules::GuiLib
         });
         Clay_SetPointerState({ _cursorPosition.x, _cursorPosition.y }, _isClicking);
         Clay_UpdateScrollContainers(_allowDragging, { _deltaScroll.x, _deltaScroll.y }, _deltaTime);
+        Clay_BeginLayout();
+
+        m_viewportSize = float2(_viewportSize);
+        if (m_incrementalLayout)
+            m_layoutCache.BeginFrame(m_viewportSize);
+        else
+            Clay_SetCullingEnabled(true);
+
         m_renderer->BeginLayout(_projectionMatrix, _viewportSize);
     }
 
@@ -82,7 +92,19 @@ namespace KryneEngine::Modules::GuiLib
         CommandListHandle _transferCommandList,
         CommandListHandle _renderCommandList)
     {
-        m_renderer->EndLayoutAndRender(_graphicsContext, _transferCommandList, _renderCommandList);
+        const Clay_RenderCommandArray renderCommands = Clay_EndLayout();
+
+        eastl::span<const Clay_RenderCommand> commands = m_incrementalLayout
+            ? m_layoutCache.EndFrame(renderCommands)
+            : eastl::span<const Clay_RenderCommand>(renderCommands.internalArray, renderCommands.length);
+        if (m_optimizeRenderCommands)
+            commands = m_renderCommandOptimizer.Process(commands, m_viewportSize);
+
+        m_renderer->EndLayoutAndRender(
+            _graphicsContext,
+            _transferCommandList,
+            _renderCommandList,
+            commands);
         Clay_SetCurrentContext(nullptr);
     }
 
@@ -91,6 +113,36 @@ namespace KryneEngine::Modules::GuiLib
         return &m_registeredRegions.PushBack(std::move(_region));
     }
 
+    void Context::SetIncrementalLayout(const bool _enabled)
+    {
+        if (!_enabled)
+            m_layoutCache.Clear();
+        m_incrementalLayout = _enabled;
+    }
+
+    bool Context::BeginCachedSubtree(
+        const Clay_ElementId _id,
+        const u64 _contentHash,
+        const Clay_ElementDeclaration& _declaration)
+    {
+        if (m_incrementalLayout)
+            return m_layoutCache.BeginSubtree(_id, _contentHash, _declaration);
+
+        Clay_ElementDeclaration declaration = _declaration;
+        declaration.id = _id;
+        Clay__OpenElement();
+        Clay__ConfigureOpenElement(declaration);
+        return true;
+    }
+
+    void Context::EndCachedSubtree()
+    {
+        if (m_incrementalLayout)
+            m_layoutCache.EndSubtree();
+        else
+            Clay__CloseElement();
+    }
+
     void Context::ErrorHandler(Clay_ErrorData _errorData)
     {
         KE_ERROR(_errorData.errorText.chars);
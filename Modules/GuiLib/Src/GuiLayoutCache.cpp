@@ -0,0 +1,300 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Modules/GuiLib/GuiLayoutCache.hpp"
+
+#include <KryneEngine/Core/Common/Assert.hpp>
+#include <KryneEngine/Core/Profiling/TracyHeader.hpp>
+
+#include "KryneEngine/Modules/GuiLib/ClayHelper.hpp"
+
+namespace KryneEngine::Modules::GuiLib
+{
+    namespace
+    {
+        // Only their addresses matter, they tag the marker render commands through their user data.
+        u8 g_beginMarker;
+        u8 g_endMarker;
+    }
+
+    GuiLayoutCache::GuiLayoutCache(const AllocatorInstance _allocator)
+        : m_allocator(_allocator)
+        , m_entries(_allocator)
+        , m_openSubtrees(_allocator)
+        , m_recordings(_allocator)
+        , m_resolvedCommands(_allocator)
+    {}
+
+    void GuiLayoutCache::BeginFrame(const float2& _viewportSize)
+    {
+        KE_ASSERT_MSG(m_openSubtrees.empty(), "Previous frame has unclosed subtrees");
+
+        // Subtrees may depend on the viewport size without it being part of their content hash.
+        if (_viewportSize.x != m_viewportSize.x || _viewportSize.y != m_viewportSize.y)
+        {
+            Clear();
+            m_viewportSize = _viewportSize;
+        }
+
+        m_frameId++;
+        m_wrapperElements = 0;
+        m_statistics = {};
+
+        Clay_SetCullingEnabled(false);
+    }
+
+    bool GuiLayoutCache::BeginSubtree(
+        const Clay_ElementId _id,
+        const u64 _contentHash,
+        const Clay_ElementDeclaration& _declaration)
+    {
+        auto it = m_entries.find(_id.id);
+        if (it == m_entries.end())
+        {
+            Entry newEntry;
+            newEntry.m_commands.set_allocator(m_allocator);
+            newEntry.m_strings.set_allocator(m_allocator);
+            it = m_entries.emplace(_id.id, eastl::move(newEntry)).first;
+        }
+
+        Entry& entry = it->second;
+        KE_ASSERT_MSG(entry.m_lastUsedFrame != m_frameId, "Cached subtree ids must be unique within a frame");
+
+        const bool reused = entry.m_recorded && entry.m_contentHash == _contentHash;
+        if (!reused)
+        {
+            entry.m_contentHash = _contentHash;
+            entry.m_recorded = false;
+        }
+        entry.m_reused = reused;
+        entry.m_lastUsedFrame = m_frameId;
+        m_statistics.m_subtrees++;
+
+        if (reused)
+        {
+            // A fixed size placeholder, carrying the root id so the subtree can still be looked up.
+            Clay__OpenElement();
+            Clay__ConfigureOpenElement({
+                .id = _id,
+                .layout = {
+                    .sizing = {
+                        .width = CLAY_SIZING_FIXED(entry.m_boundingBox.width),
+                        .height = CLAY_SIZING_FIXED(entry.m_boundingBox.height),
+                    },
+                },
+                .floating = _declaration.floating,
+                .custom = { .customData = &entry },
+                .userData = &g_beginMarker,
+            });
+
+            m_wrapperElements++;
+            m_statistics.m_reusedSubtrees++;
+            m_statistics.m_reusedElements += entry.m_elementCount;
+            m_openSubtrees.push_back({ .m_entry = &entry, .m_firstElement = -1 });
+            return false;
+        }
+
+        Clay__OpenElement();
+        Clay__ConfigureOpenElement({
+            .layout = {
+                .sizing = _declaration.layout.sizing,
+                .layoutDirection = CLAY_TOP_TO_BOTTOM,
+            },
+            .floating = _declaration.floating,
+            .custom = { .customData = &entry },
+            .userData = &g_beginMarker,
+        });
+
+        Clay_ElementDeclaration rootDeclaration = _declaration;
+        rootDeclaration.id = _id;
+        rootDeclaration.floating = {};
+        rootDeclaration.layout.sizing = { .width = CLAY_SIZING_GROW(0), .height = CLAY_SIZING_GROW(0) };
+        Clay__OpenElement();
+        Clay__ConfigureOpenElement(rootDeclaration);
+
+        // Outer element and end marker
+        m_wrapperElements += 2;
+        m_openSubtrees.push_back({
+            .m_entry = &entry,
+            .m_firstElement = GetClayLayoutElementCount(),
+            .m_wrapperElements = m_wrapperElements,
+            .m_reusedElements = m_statistics.m_reusedElements,
+        });
+        return true;
+    }
+
+    void GuiLayoutCache::EndSubtree()
+    {
+        VERIFY_OR_RETURN_VOID(!m_openSubtrees.empty());
+
+        const OpenSubtree subtree = m_openSubtrees.back();
+        m_openSubtrees.pop_back();
+
+        if (!subtree.m_entry->m_reused)
+        {
+            // Elements of nested reused subtrees are part of this one, nested wrappers are not. Root is included.
+            subtree.m_entry->m_elementCount = GetClayLayoutElementCount() - subtree.m_firstElement
+                - (m_wrapperElements - subtree.m_wrapperElements)
+                + (m_statistics.m_reusedElements - subtree.m_reusedElements)
+                + 1;
+
+            // Close root element
+            Clay__CloseElement();
+
+            Clay__OpenElement();
+            Clay__ConfigureOpenElement({
+                .custom = { .customData = subtree.m_entry },
+                .userData = &g_endMarker,
+            });
+            Clay__CloseElement();
+        }
+
+        // Close outer element or placeholder
+        Clay__CloseElement();
+    }
+
+    eastl::span<const Clay_RenderCommand> GuiLayoutCache::EndFrame(const Clay_RenderCommandArray& _renderCommands)
+    {
+        KE_ZoneScopedFunction("GuiLayoutCache::EndFrame");
+
+        KE_ASSERT_MSG(m_openSubtrees.empty(), "All cached subtrees must be closed before ending the frame");
+        m_openSubtrees.clear();
+
+        m_resolvedCommands.clear();
+        m_recordings.clear();
+
+        for (s32 i = 0; i < _renderCommands.length; i++)
+        {
+            const Clay_RenderCommand& command = _renderCommands.internalArray[i];
+
+            if (command.commandType == CLAY_RENDER_COMMAND_TYPE_CUSTOM && command.userData == &g_beginMarker)
+            {
+                Entry* entry = static_cast<Entry*>(command.renderData.custom.customData);
+                if (entry->m_reused)
+                {
+                    Expand(*entry, command.boundingBox);
+                }
+                else
+                {
+                    m_recordings.push_back({
+                        .m_entry = entry,
+                        .m_boundingBox = command.boundingBox,
+                        .m_firstCommand = static_cast<u32>(m_resolvedCommands.size()),
+                    });
+                }
+            }
+            else if (command.commandType == CLAY_RENDER_COMMAND_TYPE_CUSTOM && command.userData == &g_endMarker)
+            {
+                IF_NOT_VERIFY_MSG(!m_recordings.empty()
+                    && m_recordings.back().m_entry == command.renderData.custom.customData,
+                    "Mismatching cached subtree markers, make sure no floating element is declared in a cached subtree")
+                {
+                    continue;
+                }
+                Record(m_recordings.back());
+                m_recordings.pop_back();
+            }
+            else
+            {
+                m_resolvedCommands.push_back(command);
+            }
+        }
+
+        m_statistics.m_renderCommands = m_resolvedCommands.size();
+
+        // Root element is not counted
+        m_statistics.m_elements = GetClayLayoutElementCount() - 1 - m_wrapperElements + m_statistics.m_reusedElements;
+
+        // Drop the subtrees that were not declared this frame
+        for (auto it = m_entries.begin(); it != m_entries.end();)
+        {
+            if (it->second.m_lastUsedFrame != m_frameId)
+                it = m_entries.erase(it);
+            else
+                ++it;
+        }
+
+        // Clay culling was disabled to record whole subtrees, cull the final commands instead.
+        {
+            auto end = eastl::remove_if(
+                m_resolvedCommands.begin(),
+                m_resolvedCommands.end(),
+                [this](const Clay_RenderCommand& _command) { return IsOffscreen(_command); });
+            m_resolvedCommands.erase(end, m_resolvedCommands.end());
+        }
+
+        return m_resolvedCommands;
+    }
+
+    void GuiLayoutCache::Clear()
+    {
+        m_entries.clear();
+    }
+
+    void GuiLayoutCache::Record(const Recording& _recording)
+    {
+        Entry& entry = *_recording.m_entry;
+        entry.m_boundingBox = _recording.m_boundingBox;
+        entry.m_commands.assign(
+            m_resolvedCommands.begin() + _recording.m_firstCommand,
+            m_resolvedCommands.end());
+
+        // Text contents may not outlive the frame, keep a copy
+        size_t stringsSize = 0;
+        for (const Clay_RenderCommand& command: entry.m_commands)
+        {
+            if (command.commandType == CLAY_RENDER_COMMAND_TYPE_TEXT)
+                stringsSize += command.renderData.text.stringContents.length;
+        }
+
+        entry.m_strings.resize(stringsSize);
+        size_t offset = 0;
+        for (Clay_RenderCommand& command: entry.m_commands)
+        {
+            if (command.commandType != CLAY_RENDER_COMMAND_TYPE_TEXT)
+                continue;
+
+            Clay_StringSlice& slice = command.renderData.text.stringContents;
+            char* chars = entry.m_strings.data() + offset;
+            memcpy(chars, slice.chars, slice.length);
+            slice.chars = chars;
+            slice.baseChars = chars;
+            offset += slice.length;
+        }
+
+        entry.m_recorded = true;
+    }
+
+    void GuiLayoutCache::Expand(const Entry& _entry, const Clay_BoundingBox& _boundingBox)
+    {
+        const float offsetX = _boundingBox.x - _entry.m_boundingBox.x;
+        const float offsetY = _boundingBox.y - _entry.m_boundingBox.y;
+
+        for (Clay_RenderCommand command: _entry.m_commands)
+        {
+            command.boundingBox.x += offsetX;
+            command.boundingBox.y += offsetY;
+            m_resolvedCommands.push_back(command);
+        }
+        m_statistics.m_reusedRenderCommands += _entry.m_commands.size();
+    }
+
+    bool GuiLayoutCache::IsOffscreen(const Clay_RenderCommand& _command) const
+    {
+        // Scissors are always kept, so they stay balanced.
+        if (_command.commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_START
+            || _command.commandType == CLAY_RENDER_COMMAND_TYPE_SCISSOR_END)
+        {
+            return false;
+        }
+
+        const Clay_BoundingBox& box = _command.boundingBox;
+        return box.x > m_viewportSize.x
+            || box.y > m_viewportSize.y
+            || box.x + box.width < 0
+            || box.y + box.height < 0;
+    }
+}
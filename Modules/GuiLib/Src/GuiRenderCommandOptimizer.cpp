@@ -0,0 +1,211 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Modules/GuiLib/GuiRenderCommandOptimizer.hpp"
+
+#include <KryneEngine/Core/Common/Assert.hpp>
+#include <KryneEngine/Core/Profiling/TracyHeader.hpp>
+
+namespace KryneEngine::Modules::GuiLib
+{
+    namespace
+    {
+        bool Overlaps(const Clay_BoundingBox& _a, const Clay_BoundingBox& _b)
+        {
+            return _a.x < _b.x + _b.width
+                && _b.x < _a.x + _a.width
+                && _a.y < _b.y + _b.height
+                && _b.y < _a.y + _a.height;
+        }
+
+        Clay_BoundingBox Intersection(const Clay_BoundingBox& _a, const Clay_BoundingBox& _b)
+        {
+            const float left = eastl::max(_a.x, _b.x);
+            const float top = eastl::max(_a.y, _b.y);
+            const float right = eastl::min(_a.x + _a.width, _b.x + _b.width);
+            const float bottom = eastl::min(_a.y + _a.height, _b.y + _b.height);
+            return { left, top, eastl::max(right - left, 0.f), eastl::max(bottom - top, 0.f) };
+        }
+
+        Clay_BoundingBox Union(const Clay_BoundingBox& _a, const Clay_BoundingBox& _b)
+        {
+            const float left = eastl::min(_a.x, _b.x);
+            const float top = eastl::min(_a.y, _b.y);
+            const float right = eastl::max(_a.x + _a.width, _b.x + _b.width);
+            const float bottom = eastl::max(_a.y + _a.height, _b.y + _b.height);
+            return { left, top, right - left, bottom - top };
+        }
+    }
+
+    GuiRenderCommandOptimizer::GuiRenderCommandOptimizer(const AllocatorInstance _allocator)
+        : m_output(_allocator)
+        , m_groups(_allocator)
+        , m_nextInGroup(_allocator)
+        , m_segmentCommands(_allocator)
+        , m_clipStack(_allocator)
+        , m_openScissors(_allocator)
+    {}
+
+    eastl::span<const Clay_RenderCommand> GuiRenderCommandOptimizer::Process(
+        const eastl::span<const Clay_RenderCommand> _renderCommands,
+        const float2& _viewportSize)
+    {
+        KE_ZoneScopedFunction("GuiRenderCommandOptimizer::Process");
+
+        m_statistics = { .m_inputCommands = static_cast<u32>(_renderCommands.size()) };
+        m_output.clear();
+        m_openScissors.clear();
+        m_clipStack.clear();
+
+        const Clay_BoundingBox viewport { 0, 0, _viewportSize.x, _viewportSize.y };
+        m_clipStack.push_back(viewport);
+
+        for (const Clay_RenderCommand& command: _renderCommands)
+        {
+            switch (command.commandType)
+            {
+            case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START:
+                FlushSegment();
+                // Same clip as the renderer, which doesn't intersect nested scissors.
+                m_clipStack.push_back(Intersection(command.boundingBox, viewport));
+                m_openScissors.push_back(static_cast<u32>(m_output.size()));
+                m_output.push_back(command);
+                break;
+            case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END:
+                FlushSegment();
+                if (!KE_VERIFY(m_clipStack.size() > 1 && !m_openScissors.empty()))
+                {
+                    m_output.push_back(command);
+                    break;
+                }
+                m_clipStack.pop_back();
+
+                // Nothing left between the scissor start and end
+                if (m_openScissors.back() == m_output.size() - 1)
+                {
+                    m_output.pop_back();
+                    m_statistics.m_removedScissors++;
+                }
+                else
+                {
+                    m_output.push_back(command);
+                }
+                m_openScissors.pop_back();
+                break;
+            case CLAY_RENDER_COMMAND_TYPE_CUSTOM:
+                FlushSegment();
+                m_output.push_back(command);
+                break;
+            case CLAY_RENDER_COMMAND_TYPE_NONE:
+                m_statistics.m_invisibleCommands++;
+                break;
+            default:
+                if (!Overlaps(command.boundingBox, m_clipStack.back()))
+                {
+                    m_statistics.m_culledCommands++;
+                }
+                else if (IsInvisible(command))
+                {
+                    m_statistics.m_invisibleCommands++;
+                }
+                else
+                {
+                    AddToSegment(command);
+                }
+                break;
+            }
+        }
+        FlushSegment();
+
+        m_statistics.m_outputCommands = m_output.size();
+        return m_output;
+    }
+
+    void GuiRenderCommandOptimizer::AddToSegment(const Clay_RenderCommand& _command)
+    {
+        // Each command type maps to a pipeline of its own
+        const u32 key = _command.commandType;
+        const u32 index = static_cast<u32>(m_segmentCommands.size());
+        m_segmentCommands.push_back(&_command);
+        m_nextInGroup.push_back(kEndOfGroup);
+
+        const u32 groupCount = static_cast<u32>(m_groups.size());
+        const u32 lookbackEnd = groupCount > kMaxLookbackGroups ? groupCount - kMaxLookbackGroups : 0;
+        for (u32 i = groupCount; i > lookbackEnd; i--)
+        {
+            Group& group = m_groups[i - 1];
+            if (group.m_key == key)
+            {
+                m_nextInGroup[group.m_last] = index;
+                group.m_last = index;
+                group.m_bounds = Union(group.m_bounds, _command.boundingBox);
+                if (i != groupCount)
+                {
+                    m_statistics.m_reorderedCommands++;
+                }
+                return;
+            }
+
+            // Can't be drawn before a command it overlaps.
+            if (Overlaps(group.m_bounds, _command.boundingBox))
+            {
+                break;
+            }
+        }
+
+        m_groups.push_back({
+            .m_key = key,
+            .m_bounds = _command.boundingBox,
+            .m_first = index,
+            .m_last = index,
+        });
+    }
+
+    void GuiRenderCommandOptimizer::FlushSegment()
+    {
+        for (const Group& group: m_groups)
+        {
+            for (u32 index = group.m_first; index != kEndOfGroup; index = m_nextInGroup[index])
+            {
+                m_output.push_back(*m_segmentCommands[index]);
+            }
+        }
+
+        m_groups.clear();
+        m_nextInGroup.clear();
+        m_segmentCommands.clear();
+    }
+
+    bool GuiRenderCommandOptimizer::IsInvisible(const Clay_RenderCommand& _command)
+    {
+        if (_command.boundingBox.width <= 0.f || _command.boundingBox.height <= 0.f)
+        {
+            return true;
+        }
+
+        switch (_command.commandType)
+        {
+        case CLAY_RENDER_COMMAND_TYPE_RECTANGLE:
+            return _command.renderData.rectangle.backgroundColor.a <= 0.f;
+        case CLAY_RENDER_COMMAND_TYPE_BORDER:
+        {
+            const Clay_BorderWidth& width = _command.renderData.border.width;
+            return _command.renderData.border.color.a <= 0.f
+                || (width.left == 0 && width.right == 0 && width.top == 0 && width.bottom == 0);
+        }
+        case CLAY_RENDER_COMMAND_TYPE_TEXT:
+            return _command.renderData.text.textColor.a <= 0.f || _command.renderData.text.stringContents.length == 0;
+        case CLAY_RENDER_COMMAND_TYPE_IMAGE:
+        {
+            // A zero tint is displayed untinted
+            const Clay_Color& tint = _command.renderData.image.backgroundColor;
+            return tint.a <= 0.f && (tint.r > 0.f || tint.g > 0.f || tint.b > 0.f);
+        }
+        default:
+            return false;
+        }
+    }
+}
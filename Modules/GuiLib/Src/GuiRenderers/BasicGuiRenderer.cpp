@@ -16,7 +16,7 @@
 #include <KryneEngine/Core/Profiling/TracyHeader.hpp>
 #include <KryneEngine/Modules/TextRendering/MsdfAtlasManager.hpp>
 
-#include <EASTL/hash_map.h>
+#include <EASTL/fixed_vector.h>
 #include <EASTL/vector_set.h>
 #include <clay.h>
 #include <cmath>
@@ -34,124 +34,6 @@ namespace KryneEngine
         uint m_packedColor;
         uint4 m_packedData;
     };
-
-    struct SlotData
-    {
-        u16 m_index;
-        u16 m_descriptorSetIndex;
-    };
-
-    using TextureDataMap = eastl::hash_map<u32, SlotData>;
-    using SamplerArray = eastl::fixed_vector<SamplerHandle, Modules::GuiLib::BasicGuiRenderer::kMaxSamplerSlots, false>;
-    using SamplerDataMap = eastl::vector<SamplerArray>;
-
-    static eastl::pair<TextureDataMap, SamplerDataMap> HandleTextureSets(
-        const AllocatorInstance _allocator,
-        GraphicsContext& _graphicsContext,
-        const Clay_RenderCommandArray& _renderCommandArray,
-        eastl::vector<DescriptorSetHandle>& _texturesDescriptorSets,
-        DescriptorSetLayoutHandle _texturesDescriptorSetLayout,
-        SamplerHandle _defaultSampler,
-        const u32* _descriptorSetIndices)
-    {
-        KE_ZoneScopedFunction("Handle texture sets");
-
-        TextureDataMap textureData(_allocator);
-        SamplerDataMap samplerData(_allocator);
-
-        eastl::vector<eastl::array<DescriptorSetWriteInfo::DescriptorData, Modules::GuiLib::BasicGuiRenderer::kMaxTextureSlots>> textureSetWrites(_allocator);
-        eastl::vector<eastl::array<DescriptorSetWriteInfo::DescriptorData, Modules::GuiLib::BasicGuiRenderer::kMaxSamplerSlots>> samplerSetWrites(_allocator);
-
-        u16 descriptorSetIndex = 0;
-
-        for (u32 i = 0; i < _renderCommandArray.length; i++)
-        {
-            const Clay_RenderCommand& renderCommand = _renderCommandArray.internalArray[i];
-
-            if (renderCommand.commandType != CLAY_RENDER_COMMAND_TYPE_IMAGE) continue;
-
-            const auto* textureRegion = static_cast<const Modules::GuiLib::TextureRegion*>(renderCommand.renderData.image.imageData);
-
-            if (!KE_VERIFY_MSG(textureRegion->m_textureType == TextureTypes::Single2D, "Unsupported texture type")) continue;
-
-            const SamplerHandle sampler = textureRegion->m_customSampler != GenPool::kInvalidHandle
-                ? textureRegion->m_customSampler
-                : _defaultSampler;
-
-            const TextureViewHandle textureView = textureRegion->m_textureView;
-            const auto it = textureData.find(static_cast<u32>(textureView.m_handle));
-
-            // Texture is already in a set, add sampler to it if not already done
-            if (it != textureData.end())
-            {
-                SamplerArray& array = samplerData[it->second.m_descriptorSetIndex];
-                if (eastl::find(array.begin(), array.end(), sampler) == array.end() && KE_VERIFY(array.size() < array.max_size()))
-                {
-                    KE_ASSERT(samplerSetWrites.size() > it->second.m_descriptorSetIndex);
-                    samplerSetWrites[it->second.m_descriptorSetIndex][array.size()] = {
-                        .m_handle = sampler.m_handle,
-                    };
-                    array.push_back(sampler);
-                }
-                continue;
-            }
-
-            // Push texture to set
-
-            if (descriptorSetIndex >= Modules::GuiLib::BasicGuiRenderer::kMaxTextureSlots || samplerData.empty())
-            {
-                samplerData.push_back();
-                textureSetWrites.push_back();
-                samplerSetWrites.push_back();
-
-                if (_texturesDescriptorSets.size() < samplerData.size())
-                {
-                    _texturesDescriptorSets.push_back(_graphicsContext.CreateDescriptorSet(_texturesDescriptorSetLayout));
-                }
-
-                descriptorSetIndex %= Modules::GuiLib::BasicGuiRenderer::kMaxTextureSlots;
-            }
-
-            textureData.emplace(static_cast<u32>(textureView.m_handle), SlotData {
-                .m_index = descriptorSetIndex,
-                .m_descriptorSetIndex = static_cast<u16>(samplerData.size() - 1u),
-            });
-            textureSetWrites.back()[descriptorSetIndex] = {
-                .m_textureLayout = TextureLayout::ShaderResource,
-                .m_handle = textureView.m_handle,
-            };
-
-            SamplerArray& samplerArray = samplerData.back();
-            const auto samplerIt = eastl::find(samplerArray.begin(), samplerArray.end(), sampler);
-            if (samplerIt == samplerArray.end() && KE_VERIFY(samplerArray.size() < samplerArray.max_size()))
-            {
-                samplerSetWrites.back()[samplerArray.size()] = {
-                    .m_handle = sampler.m_handle,
-                };
-                samplerArray.push_back(sampler);
-            }
-
-            descriptorSetIndex++;
-        }
-
-        for (auto i = 0u; i < textureSetWrites.size(); i++)
-        {
-            const size_t spanSize = i + 1 == textureSetWrites.size() ? descriptorSetIndex : Modules::GuiLib::BasicGuiRenderer::kMaxTextureSlots;
-            const DescriptorSetWriteInfo info[] = {
-                {
-                    .m_index = _descriptorSetIndices[0],
-                    .m_descriptorData = { textureSetWrites[i].begin(), spanSize },
-                },
-                {
-                    .m_index = _descriptorSetIndices[1],
-                    .m_descriptorData = { samplerSetWrites[i].begin(), samplerData[i].size() },
-                }
-            };
-            _graphicsContext.UpdateDescriptorSet(_texturesDescriptorSets[i], info, true);
-        }
-
-        return { eastl::move(textureData), eastl::move(samplerData) };
-    }
 }
 
 namespace KryneEngine::Modules::GuiLib
@@ -164,8 +46,11 @@ namespace KryneEngine::Modules::GuiLib
         : m_instanceDataBuffer(_allocator)
         , m_commonConstantBuffer(_allocator)
         , m_commonConstantBufferViews(_allocator)
-        , m_texturesDescriptorSets(_allocator)
         , m_defaultSampler(_defaultSampler)
+        , m_drawBatcher(_allocator)
+        , m_textureBindingCache(_allocator, _graphicsContext->GetFrameContextCount())
+        , m_instanceStream(_allocator)
+        , m_instanceDiff(_allocator, sizeof(PackedInstanceData), kInstanceRangeMergeDistance * sizeof(PackedInstanceData))
     {
         KE_ZoneScoped("BasicGuiRenderer initialization");
 
@@ -258,7 +143,6 @@ namespace KryneEngine::Modules::GuiLib
             });
 
             m_commonDescriptorSet = _graphicsContext->CreateDescriptorSet(commonDescriptorSetLayout);
-            m_texturesDescriptorSets.push_back(_graphicsContext->CreateDescriptorSet(m_texturesDescriptorSetLayout));
         }
 
         constexpr VertexLayoutElement commonVertexElements[] = {
@@ -453,6 +337,28 @@ namespace KryneEngine::Modules::GuiLib
             pipelineDesc.m_stages = stages;
             m_textPipeline = _graphicsContext->CreateGraphicsPipeline(pipelineDesc);
 
+            // Coverage text PSO, sharing the vertex stage
+            {
+                const eastl::span<char> coverageShaderSource = readShaderFile(
+                    eastl::string("Shaders/BasicGuiRenderer/Text_TextCoverageFs.", _allocator) + GraphicsContext::GetShaderFileExtension());
+                const ShaderModuleHandle coverageShaderModule = _graphicsContext->RegisterShaderModule(coverageShaderSource.data(), coverageShaderSource.size());
+
+                const ShaderStage coverageStages[] = {
+                    stages[0],
+                    {
+                        .m_shaderModule = coverageShaderModule,
+                        .m_stage = ShaderStage::Stage::Fragment,
+                        .m_entryPoint = "TextCoverageFs",
+                    },
+                };
+
+                pipelineDesc.m_stages = coverageStages;
+                m_textCoveragePipeline = _graphicsContext->CreateGraphicsPipeline(pipelineDesc);
+
+                _graphicsContext->FreeShaderModule(coverageShaderModule);
+                _allocator.deallocate(coverageShaderSource.data(), coverageShaderSource.size());
+            }
+
             _graphicsContext->FreeShaderModule(fragmentShaderModule);
             _graphicsContext->FreeShaderModule(vertexShaderModule);
             _allocator.deallocate(fragmentShaderSource.data(), fragmentShaderSource.size());
@@ -464,8 +370,6 @@ namespace KryneEngine::Modules::GuiLib
 
     void BasicGuiRenderer::BeginLayout(const float4x4& _viewportTransform, const uint2& _viewportSize)
     {
-        Clay_BeginLayout();
-
         m_viewportConstants.ndcProjectionMatrix = _viewportTransform;
         m_viewportConstants.viewportSize = float2(_viewportSize);
     }
@@ -473,12 +377,11 @@ namespace KryneEngine::Modules::GuiLib
     void BasicGuiRenderer::EndLayoutAndRender(
         GraphicsContext& _graphicsContext,
         CommandListHandle _transferCommandList,
-        CommandListHandle _renderCommandList)
+        CommandListHandle _renderCommandList,
+        const eastl::span<const Clay_RenderCommand> _renderCommands)
     {
         KE_ZoneScopedFunction("BasicGuiRenderer::EndLayoutAndRender");
 
-        const Clay_RenderCommandArray renderCommandArray = Clay_EndLayout();
-
         const u8 frameIndex = _graphicsContext.GetCurrentFrameContextIndex();
 
         {
@@ -519,26 +422,7 @@ namespace KryneEngine::Modules::GuiLib
             _graphicsContext.UpdateDescriptorSet(m_textDescriptorSet, writes, false);
         }
 
-        TextureDataMap textureDataMap;
-        SamplerDataMap samplerDataMap;
-        {
-            const auto pair = HandleTextureSets(
-                m_texturesDescriptorSets.get_allocator(),
-                _graphicsContext,
-                renderCommandArray,
-                m_texturesDescriptorSets,
-                m_texturesDescriptorSetLayout,
-                m_defaultSampler,
-                m_texturesDescriptorSetIndices.data());
-            textureDataMap = eastl::move(pair.first);
-            samplerDataMap = eastl::move(pair.second);
-
-            for (const auto [textureViewRawHandle, _]: textureDataMap)
-            {
-                TextureViewHandle handle { GenPool::Handle(textureViewRawHandle) };
-                _graphicsContext.DeclarePassTextureViewUsage(_renderCommandList, { &handle, 1 }, TextureViewAccessType::Read);
-            }
-        }
+        m_textureBindingCache.BeginFrame(_graphicsContext.GetFrameId());
 
         if (m_atlasManager != nullptr)
         {
@@ -547,10 +431,8 @@ namespace KryneEngine::Modules::GuiLib
         }
 
         size_t sizeEstimation = 0;
-        for (u32 i = 0; i < renderCommandArray.length; i++)
+        for (const Clay_RenderCommand& renderCommand: _renderCommands)
         {
-            const Clay_RenderCommand& renderCommand = renderCommandArray.internalArray[i];
-
             switch (renderCommand.commandType)
             {
                 case CLAY_RENDER_COMMAND_TYPE_RECTANGLE:
@@ -570,7 +452,14 @@ namespace KryneEngine::Modules::GuiLib
         {
             m_instanceDataBuffer.RequestResize(sizeRequirement);
         }
-        auto* buffer = static_cast<std::byte*>(m_instanceDataBuffer.Map(&_graphicsContext, frameIndex));
+        auto* mappedBuffer = static_cast<std::byte*>(m_instanceDataBuffer.Map(&_graphicsContext, frameIndex));
+        std::byte* buffer = mappedBuffer;
+        if (m_retainedInstanceBuffer)
+        {
+            // Instances are packed on the CPU side first, to be compared against the previous frame.
+            m_instanceStream.resize(sizeEstimation);
+            buffer = m_instanceStream.data();
+        }
         size_t offset = 0;
 
         constexpr auto packCornerRadii = [](const Clay_CornerRadius& _cornerRadius)
@@ -582,8 +471,6 @@ namespace KryneEngine::Modules::GuiLib
             return packedRadii;
         };
 
-        Clay_RenderCommandType previous = CLAY_RENDER_COMMAND_TYPE_NONE;
-
         const BufferSpan bufferView {
             .m_size = sizeEstimation,
             .m_stride = sizeof(PackedInstanceData),
@@ -591,9 +478,10 @@ namespace KryneEngine::Modules::GuiLib
         };
         _graphicsContext.SetVertexBuffers(_renderCommandList, { &bufferView, 1 });
 
-        size_t texturesDescriptorSetIndex = 0;
-        const DescriptorSetHandle descriptorSets[] = { m_commonDescriptorSet, m_texturesDescriptorSets[0] };
-        _graphicsContext.SetGraphicsDescriptorSets(_renderCommandList, m_commonPipelineLayout, descriptorSets);
+        _graphicsContext.SetGraphicsDescriptorSets(_renderCommandList, m_commonPipelineLayout, { &m_commonDescriptorSet, 1 });
+
+        m_drawBatcher.Reset(m_batching);
+        m_textTierSelector.BeginFrame(m_viewportConstants.ndcProjectionMatrix == float4x4());
 
         eastl::fixed_vector<Rect, 16, false> scissors;
         if (m_viewportConstants.ndcProjectionMatrix == float4x4())
@@ -609,14 +497,14 @@ namespace KryneEngine::Modules::GuiLib
                 .m_right = static_cast<u32>(m_viewportConstants.viewportSize.x),
                 .m_bottom = static_cast<u32>(m_viewportConstants.viewportSize.y)
             });
-            _graphicsContext.SetScissorsRect(_renderCommandList, scissors.back());
+            m_drawBatcher.SetScissor(scissors.back());
         }
 
         {
-            KE_ZoneScoped("Fill instance data and dispatch render commands");
-            for (u32 i = 0; i < renderCommandArray.length; i++)
+            KE_ZoneScoped("Fill instance data and batch render commands");
+            for (const Clay_RenderCommand& renderCommand: _renderCommands)
             {
-                const Clay_RenderCommand& renderCommand = renderCommandArray.internalArray[i];
+                m_drawBatcher.CountRenderCommand();
 
                 const float2 halfSize { 0.5f * renderCommand.boundingBox.width, 0.5f * renderCommand.boundingBox.height };
                 const float2 center = float2(renderCommand.boundingBox.x, renderCommand.boundingBox.y) + halfSize;
@@ -640,17 +528,10 @@ namespace KryneEngine::Modules::GuiLib
                     packedInstanceData->m_packedData.x = packedRadii.x;
                     packedInstanceData->m_packedData.y = packedRadii.y;
 
-                    if (previous != CLAY_RENDER_COMMAND_TYPE_RECTANGLE)
-                    {
-                        _graphicsContext.SetGraphicsPipeline(_renderCommandList, m_rectanglePipeline);
-                    }
-                    _graphicsContext.DrawInstanced(_renderCommandList, DrawInstancedDesc {
-                        .m_vertexCount = 6,
-                        .m_instanceOffset = static_cast<u32>(offset / sizeof(PackedInstanceData)),
-                    });
+                    m_drawBatcher.PushInstance(
+                        { .m_pipeline = m_rectanglePipeline },
+                        static_cast<u32>(offset / sizeof(PackedInstanceData)));
                     offset += sizeof(PackedInstanceData);
-
-                    previous = CLAY_RENDER_COMMAND_TYPE_RECTANGLE;
                     break;
                 }
                 case CLAY_RENDER_COMMAND_TYPE_BORDER:
@@ -670,17 +551,10 @@ namespace KryneEngine::Modules::GuiLib
                     packedInstanceData->m_packedData.w = Math::Float16::PackFloat16x2(
                         renderCommand.renderData.border.width.left, renderCommand.renderData.border.width.right);
 
-                    if (previous != CLAY_RENDER_COMMAND_TYPE_BORDER)
-                    {
-                        _graphicsContext.SetGraphicsPipeline(_renderCommandList, m_borderPipeline);
-                    }
-                    _graphicsContext.DrawInstanced(_renderCommandList, DrawInstancedDesc {
-                        .m_vertexCount = 6,
-                        .m_instanceOffset = static_cast<u32>(offset / sizeof(PackedInstanceData)),
-                    });
+                    m_drawBatcher.PushInstance(
+                        { .m_pipeline = m_borderPipeline },
+                        static_cast<u32>(offset / sizeof(PackedInstanceData)));
                     offset += sizeof(PackedInstanceData);
-
-                    previous = CLAY_RENDER_COMMAND_TYPE_BORDER;
                     break;
                 }
                 case CLAY_RENDER_COMMAND_TYPE_TEXT:
@@ -696,6 +570,22 @@ namespace KryneEngine::Modules::GuiLib
                     TextRendering::Font* font = m_atlasManager->GetFontManager()->GetFont(renderCommand.renderData.text.fontId);
                     const float fontSize = renderCommand.renderData.text.fontSize;
 
+                    const GuiTextTierSelector::Tier tier = m_textTierSelector.SelectTier(fontSize);
+                    const bool coverageTier = tier == GuiTextTierSelector::Tier::Coverage;
+                    const u32 coveragePixelSize = GuiTextTierSelector::GetCoveragePixelSize(fontSize);
+
+                    Color tintColor {
+                        renderCommand.renderData.text.textColor.r / 255.f,
+                        renderCommand.renderData.text.textColor.g / 255.f,
+                        renderCommand.renderData.text.textColor.b / 255.f,
+                        renderCommand.renderData.text.textColor.a / 255.f,
+                    };
+                    if (tintColor.m_value == float4(0))
+                    {
+                        tintColor = Color(float4(1));
+                    }
+                    const u32 packedTintColor = tintColor.ToSrgb().ToRgba8();
+
                     float2 writePoint {
                         renderCommand.boundingBox.x,
                         renderCommand.boundingBox.y + font->GetAscender(fontSize)
@@ -705,28 +595,49 @@ namespace KryneEngine::Modules::GuiLib
                         const TextRendering::GlyphLayoutMetrics glyphLayoutMetrics = font->GetGlyphLayoutMetrics(*utf8Iterator, fontSize);
 
                         constexpr float msdfFontSize = 32;
-                        const TextRendering::MsdfAtlasManager::GlyphRegion glyphRegion =
-                            m_atlasManager->GetGlyphRegion(font, *utf8Iterator, msdfFontSize);
+                        const TextRendering::MsdfAtlasManager::GlyphRegion glyphRegion = coverageTier
+                            ? m_atlasManager->GetCoverageGlyphRegion(font, *utf8Iterator, coveragePixelSize, msdfFontSize)
+                            : m_atlasManager->GetGlyphRegion(font, *utf8Iterator, msdfFontSize);
 
-                        // If the glyph has no visuals (special chars like space or tab), simply advance write point and
-                        // don't render anything.
-                        if (!glyphRegion.IsValid())
+                        // If the glyph has no visuals (special chars like space or tab), or doesn't fit in the frame
+                        // budget, simply advance write point and don't render anything.
+                        if (!glyphRegion.IsValid() || !m_textTierSelector.AcquireInstance(tier))
                         {
                             writePoint.x += glyphLayoutMetrics.m_advanceX;
                             continue;
                         }
 
-                        const float scale = fontSize / msdfFontSize;
-
-                        const float2 glyphHalfSize {
-                            static_cast<float>(glyphRegion.m_width) * 0.5f * scale,
-                            static_cast<float>(glyphRegion.m_height) * 0.5f * scale,
-                        };
-                        const float2 glyphOffset {
-                            -static_cast<float>(glyphRegion.m_pxRange) * 0.5f * scale + glyphLayoutMetrics.m_bearingX,
-                            -static_cast<float>(glyphRegion.m_baseline) * scale,
-                        };
-                        const float2 glyphCenter = writePoint + glyphOffset + glyphHalfSize;
+                        float2 glyphHalfSize;
+                        float2 glyphCenter;
+                        if (coverageTier)
+                        {
+                            // Coverage bitmaps are already at their final size, snap them to the pixel grid.
+                            const float msdfScale = static_cast<float>(coveragePixelSize) / msdfFontSize;
+                            const float msdfPxRange = TextRendering::MsdfAtlasManager::GetPxRange(static_cast<u32>(msdfFontSize));
+                            glyphHalfSize = {
+                                static_cast<float>(glyphRegion.m_width) * 0.5f,
+                                static_cast<float>(glyphRegion.m_height) * 0.5f,
+                            };
+                            const float2 glyphTopLeft {
+                                std::round(writePoint.x + glyphLayoutMetrics.m_bearingX - msdfPxRange * 0.5f * msdfScale),
+                                std::round(writePoint.y) - static_cast<float>(glyphRegion.m_baseline),
+                            };
+                            glyphCenter = glyphTopLeft + glyphHalfSize;
+                        }
+                        else
+                        {
+                            const float scale = fontSize / msdfFontSize;
+
+                            glyphHalfSize = {
+                                static_cast<float>(glyphRegion.m_width) * 0.5f * scale,
+                                static_cast<float>(glyphRegion.m_height) * 0.5f * scale,
+                            };
+                            const float2 glyphOffset {
+                                -static_cast<float>(glyphRegion.m_pxRange) * 0.5f * scale + glyphLayoutMetrics.m_bearingX,
+                                -static_cast<float>(glyphRegion.m_baseline) * scale,
+                            };
+                            glyphCenter = writePoint + glyphOffset + glyphHalfSize;
+                        }
 
                         const uint2 glyphPackedRect = {
                             Math::Float16::PackFloat16x2(glyphCenter.x, glyphCenter.y),
@@ -736,44 +647,20 @@ namespace KryneEngine::Modules::GuiLib
                         auto* packedInstanceData = reinterpret_cast<PackedInstanceData*>(buffer + offset);
 
                         packedInstanceData->m_packedRect = glyphPackedRect;
-
-                        Color tintColor {
-                            renderCommand.renderData.text.textColor.r / 255.f,
-                            renderCommand.renderData.text.textColor.g / 255.f,
-                            renderCommand.renderData.text.textColor.b / 255.f,
-                            renderCommand.renderData.text.textColor.a / 255.f,
-                        };
-                        if (tintColor.m_value == float4(0))
-                        {
-                            tintColor = Color(float4(1));
-                        }
-                        packedInstanceData->m_packedColor = tintColor.ToSrgb().ToRgba8();
+                        packedInstanceData->m_packedColor = packedTintColor;
 
                         packedInstanceData->m_packedData.x = BitUtils::BitfieldInsert<u32>(glyphRegion.m_x, glyphRegion.m_y, 16, 16);
                         packedInstanceData->m_packedData.y = BitUtils::BitfieldInsert<u32>(glyphRegion.m_width + glyphRegion.m_x, glyphRegion.m_height + glyphRegion.m_y, 16, 16);
                         packedInstanceData->m_packedData.z = glyphRegion.m_pxRange;
 
-                        if (previous != CLAY_RENDER_COMMAND_TYPE_TEXT)
-                        {
-                            _graphicsContext.SetGraphicsPipeline(_renderCommandList, m_textPipeline);
-                            previous = CLAY_RENDER_COMMAND_TYPE_TEXT;
-                        }
-
-                        // We use the textures descriptor sets size as the index for the text descriptor set
-                        if (texturesDescriptorSetIndex != m_texturesDescriptorSets.size())
-                        {
-                            _graphicsContext.SetGraphicsDescriptorSetsWithOffset(
-                                _renderCommandList,
-                                m_commonPipelineLayout,
-                                { &m_textDescriptorSet, 1 },
-                                1);
-                            texturesDescriptorSetIndex = m_texturesDescriptorSets.size();
-                        }
-
-                        _graphicsContext.DrawInstanced(_renderCommandList, DrawInstancedDesc {
-                            .m_vertexCount = 6,
-                            .m_instanceOffset = static_cast<u32>(offset / sizeof(PackedInstanceData)),
-                        });
+                        // All glyphs share the text descriptor set, so glyphs of consecutive text elements of the same
+                        // tier all end up in the same batch.
+                        m_drawBatcher.PushInstance(
+                            {
+                                .m_pipeline = coverageTier ? m_textCoveragePipeline : m_textPipeline,
+                                .m_descriptorSetIndex = kTextDescriptorSetIndex,
+                            },
+                            static_cast<u32>(offset / sizeof(PackedInstanceData)));
                         offset += sizeof(PackedInstanceData);
 
                         writePoint.x += glyphLayoutMetrics.m_advanceX;
@@ -785,6 +672,9 @@ namespace KryneEngine::Modules::GuiLib
                     auto* packedInstanceData = reinterpret_cast<PackedInstanceData*>(buffer + offset);
                     const auto* textureRegion = static_cast<const TextureRegion*>(renderCommand.renderData.image.imageData);
 
+                    if (!KE_VERIFY_MSG(textureRegion->m_textureType == TextureTypes::Single2D, "Unsupported texture type"))
+                        break;
+
                     packedInstanceData->m_packedRect = packedRect;
 
                     Color tintColor {
@@ -800,29 +690,17 @@ namespace KryneEngine::Modules::GuiLib
                     packedInstanceData->m_packedColor = tintColor.ToSrgb().ToRgba8();
 
                     // Pack texture and sampler indices
-                    {
-                        const auto it = textureDataMap.find(static_cast<u32>(textureRegion->m_textureView.m_handle));
-                        if (!KE_VERIFY(it != textureDataMap.end())) break;
-                        if (texturesDescriptorSetIndex != it->second.m_descriptorSetIndex)
-                        {
-                            texturesDescriptorSetIndex = it->second.m_descriptorSetIndex;
-                            _graphicsContext.SetGraphicsDescriptorSetsWithOffset(
-                                _renderCommandList,
-                                m_commonPipelineLayout,
-                                { m_texturesDescriptorSets.begin() + texturesDescriptorSetIndex, 1 },
-                                1);
-                        }
-
-                        const SamplerArray& array = samplerDataMap[it->second.m_descriptorSetIndex];
-                        const SamplerHandle samplerHandle = textureRegion->m_customSampler != GenPool::kInvalidHandle ? textureRegion->m_customSampler : m_defaultSampler;
-                        const auto samplerIt = eastl::find(array.begin(), array.end(), samplerHandle);
-                        if (!KE_VERIFY(samplerIt != array.end())) break;
-                        packedInstanceData->m_packedData.x = BitUtils::BitfieldInsert<u32>(
-                            it->second.m_index,
-                            eastl::distance(array.begin(), samplerIt),
-                            3,
-                            5);
-                    }
+                    const SamplerHandle samplerHandle = textureRegion->m_customSampler != GenPool::kInvalidHandle
+                        ? textureRegion->m_customSampler
+                        : m_defaultSampler;
+                    const GuiTextureBindingCache::Binding binding = m_textureBindingCache.Acquire(
+                        textureRegion->m_textureView,
+                        samplerHandle);
+                    packedInstanceData->m_packedData.x = BitUtils::BitfieldInsert<u32>(
+                        binding.m_textureSlot,
+                        binding.m_samplerSlot,
+                        3,
+                        5);
 
                     // Pack corner radii
                     {
@@ -859,16 +737,13 @@ namespace KryneEngine::Modules::GuiLib
                         packedInstanceData->m_packedData.w = Math::Float16::PackFloat16x2(regionHalfSize.x, regionHalfSize.y);
                     }
 
-                    if (previous != CLAY_RENDER_COMMAND_TYPE_IMAGE)
-                        _graphicsContext.SetGraphicsPipeline(_renderCommandList, m_imagePipeline);
-
-                    _graphicsContext.DrawInstanced(_renderCommandList, DrawInstancedDesc {
-                        .m_vertexCount = 6,
-                        .m_instanceOffset = static_cast<u32>(offset / sizeof(PackedInstanceData)),
-                    });
+                    m_drawBatcher.PushInstance(
+                        {
+                            .m_pipeline = m_imagePipeline,
+                            .m_descriptorSetIndex = kFirstTexturesDescriptorSetIndex + binding.m_descriptorSetIndex,
+                        },
+                        static_cast<u32>(offset / sizeof(PackedInstanceData)));
                     offset += sizeof(PackedInstanceData);
-
-                    previous = CLAY_RENDER_COMMAND_TYPE_IMAGE;
                     break;
                 }
                 case CLAY_RENDER_COMMAND_TYPE_SCISSOR_START:
@@ -880,34 +755,86 @@ namespace KryneEngine::Modules::GuiLib
                             .m_right = static_cast<u32>(eastl::clamp(renderCommand.boundingBox.x + renderCommand.boundingBox.width, 0.f, m_viewportConstants.viewportSize.x)),
                             .m_bottom = static_cast<u32>(eastl::clamp(renderCommand.boundingBox.y + renderCommand.boundingBox.height, 0.f, m_viewportConstants.viewportSize.y)),
                         });
-                        _graphicsContext.SetScissorsRect(_renderCommandList, scissors.back());
+                        m_drawBatcher.SetScissor(scissors.back());
                     }
-                    previous = CLAY_RENDER_COMMAND_TYPE_SCISSOR_START;
                     break;
                 case CLAY_RENDER_COMMAND_TYPE_SCISSOR_END:
                     if (KE_VERIFY(scissors.size() > 1)) [[likely]]
                     {
                         scissors.pop_back();
-                        _graphicsContext.SetScissorsRect(_renderCommandList, scissors.back());
+                        m_drawBatcher.SetScissor(scissors.back());
                     }
-                    previous = CLAY_RENDER_COMMAND_TYPE_SCISSOR_END;
                     break;
                 case CLAY_RENDER_COMMAND_TYPE_NONE:
-                    previous = CLAY_RENDER_COMMAND_TYPE_NONE;
-                    break;
                 case CLAY_RENDER_COMMAND_TYPE_CUSTOM:
-                    previous = CLAY_RENDER_COMMAND_TYPE_CUSTOM;
                     break;
                 }
             }
         }
 
+        {
+            KE_ZoneScoped("Synchronize texture descriptor sets");
+
+            m_textureBindingCache.EndFrame();
+            m_textureBindingCache.Synchronize(
+                _graphicsContext,
+                m_texturesDescriptorSetLayout,
+                m_texturesDescriptorSetIndices.data());
+
+            const eastl::span<const TextureViewHandle> textureViews = m_textureBindingCache.GetFrameTextureViews();
+            if (!textureViews.empty())
+            {
+                _graphicsContext.DeclarePassTextureViewUsage(_renderCommandList, textureViews, TextureViewAccessType::Read);
+            }
+        }
+
+        {
+            KE_ZoneScoped("Submit draw batches");
+
+            const eastl::span<const DescriptorSetHandle> textureSets = m_textureBindingCache.GetDescriptorSets();
+            eastl::fixed_vector<DescriptorSetHandle, 8> batchDescriptorSets;
+            batchDescriptorSets.push_back(m_textDescriptorSet);
+            batchDescriptorSets.insert(batchDescriptorSets.end(), textureSets.begin(), textureSets.end());
+
+            m_drawBatcher.Submit(
+                _graphicsContext,
+                _renderCommandList,
+                m_commonPipelineLayout,
+                batchDescriptorSets,
+                1,
+                6);
+        }
+
         KE_ASSERT(scissors.size() == 1 || m_viewportConstants.ndcProjectionMatrix != float4x4());
 
         {
             KE_ZoneScoped("Upload instance data");
-            m_instanceDataBuffer.Unmap(&_graphicsContext);
-            m_instanceDataBuffer.PrepareBuffers(&_graphicsContext, _transferCommandList, BarrierAccessFlags::VertexBuffer, frameIndex);
+            if (m_retainedInstanceBuffer)
+            {
+                if (!m_instanceDataBuffer.IsGpuContentRetained())
+                {
+                    m_instanceDiff.Invalidate();
+                }
+
+                const eastl::span<const GraphicsUtils::BufferRange> ranges = m_instanceDiff.Update(buffer, offset);
+                for (const GraphicsUtils::BufferRange& range: ranges)
+                {
+                    memcpy(mappedBuffer + range.m_offset, buffer + range.m_offset, range.m_size);
+                }
+
+                m_instanceDataBuffer.Unmap(&_graphicsContext);
+                m_instanceDataBuffer.PrepareBufferRanges(
+                    &_graphicsContext,
+                    _transferCommandList,
+                    BarrierAccessFlags::VertexBuffer,
+                    frameIndex,
+                    ranges);
+            }
+            else
+            {
+                m_instanceDataBuffer.Unmap(&_graphicsContext);
+                m_instanceDataBuffer.PrepareBuffers(&_graphicsContext, _transferCommandList, BarrierAccessFlags::VertexBuffer, frameIndex);
+            }
         }
     }
 
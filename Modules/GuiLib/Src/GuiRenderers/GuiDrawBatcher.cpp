@@ -0,0 +1,135 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Modules/GuiLib/GuiRenderers/GuiDrawBatcher.hpp"
+
+#include <KryneEngine/Core/Common/Assert.hpp>
+#include <KryneEngine/Core/Graphics/Drawing.hpp>
+#include <KryneEngine/Core/Graphics/GraphicsContext.hpp>
+#include <KryneEngine/Core/Profiling/TracyHeader.hpp>
+
+namespace KryneEngine::Modules::GuiLib
+{
+    static bool IsSameRect(const Rect& _a, const Rect& _b)
+    {
+        return _a.m_left == _b.m_left
+            && _a.m_top == _b.m_top
+            && _a.m_right == _b.m_right
+            && _a.m_bottom == _b.m_bottom;
+    }
+
+    GuiDrawBatcher::GuiDrawBatcher(const AllocatorInstance _allocator)
+        : m_batches(_allocator)
+        , m_scissors(_allocator)
+    {}
+
+    void GuiDrawBatcher::Reset(const bool _batching)
+    {
+        m_batches.clear();
+        m_scissors.clear();
+        m_currentScissor = kNoScissor;
+        m_batching = _batching;
+        m_statistics = {};
+    }
+
+    void GuiDrawBatcher::PushInstance(const DrawState& _state, const u32 _instanceIndex)
+    {
+        m_statistics.m_instances++;
+
+        if (m_batching && !m_batches.empty())
+        {
+            Batch& batch = m_batches.back();
+
+            const bool compatibleDescriptorSet = batch.m_state.m_descriptorSetIndex == _state.m_descriptorSetIndex
+                || batch.m_state.m_descriptorSetIndex == kAnyDescriptorSet
+                || _state.m_descriptorSetIndex == kAnyDescriptorSet;
+
+            if (batch.m_state.m_pipeline == _state.m_pipeline
+                && batch.m_scissorIndex == m_currentScissor
+                && batch.m_firstInstance + batch.m_instanceCount == _instanceIndex
+                && compatibleDescriptorSet)
+            {
+                if (batch.m_state.m_descriptorSetIndex == kAnyDescriptorSet)
+                    batch.m_state.m_descriptorSetIndex = _state.m_descriptorSetIndex;
+                batch.m_instanceCount++;
+                return;
+            }
+        }
+
+        m_batches.push_back(Batch {
+            .m_state = _state,
+            .m_scissorIndex = m_currentScissor,
+            .m_firstInstance = _instanceIndex,
+            .m_instanceCount = 1,
+        });
+    }
+
+    void GuiDrawBatcher::SetScissor(const Rect& _scissor)
+    {
+        if (m_currentScissor != kNoScissor && IsSameRect(m_scissors[m_currentScissor], _scissor))
+            return;
+
+        m_currentScissor = m_scissors.size();
+        m_scissors.push_back(_scissor);
+    }
+
+    void GuiDrawBatcher::Submit(
+        GraphicsContext& _graphicsContext,
+        const CommandListHandle _commandList,
+        const PipelineLayoutHandle _pipelineLayout,
+        const eastl::span<const DescriptorSetHandle> _descriptorSets,
+        const u32 _descriptorSetOffset,
+        const u32 _vertexCount)
+    {
+        KE_ZoneScopedFunction("GuiDrawBatcher::Submit");
+
+        GraphicsPipelineHandle boundPipeline { GenPool::kInvalidHandle };
+        u32 boundDescriptorSet = kAnyDescriptorSet;
+        u32 boundScissor = kNoScissor;
+
+        for (const Batch& batch: m_batches)
+        {
+            if (batch.m_scissorIndex != boundScissor && batch.m_scissorIndex != kNoScissor)
+            {
+                if (boundScissor == kNoScissor || !IsSameRect(m_scissors[boundScissor], m_scissors[batch.m_scissorIndex]))
+                {
+                    _graphicsContext.SetScissorsRect(_commandList, m_scissors[batch.m_scissorIndex]);
+                    m_statistics.m_scissorChanges++;
+                }
+                boundScissor = batch.m_scissorIndex;
+            }
+
+            if (batch.m_state.m_pipeline != boundPipeline)
+            {
+                _graphicsContext.SetGraphicsPipeline(_commandList, batch.m_state.m_pipeline);
+                boundPipeline = batch.m_state.m_pipeline;
+                m_statistics.m_pipelineChanges++;
+            }
+
+            if (batch.m_state.m_descriptorSetIndex != kAnyDescriptorSet
+                && batch.m_state.m_descriptorSetIndex != boundDescriptorSet)
+            {
+                if (KE_VERIFY(batch.m_state.m_descriptorSetIndex < _descriptorSets.size()))
+                {
+                    _graphicsContext.SetGraphicsDescriptorSetsWithOffset(
+                        _commandList,
+                        _pipelineLayout,
+                        { _descriptorSets.begin() + batch.m_state.m_descriptorSetIndex, 1 },
+                        _descriptorSetOffset);
+                    boundDescriptorSet = batch.m_state.m_descriptorSetIndex;
+                    m_statistics.m_descriptorSetChanges++;
+                }
+            }
+
+            _graphicsContext.DrawInstanced(_commandList, DrawInstancedDesc {
+                .m_vertexCount = _vertexCount,
+                .m_instanceCount = batch.m_instanceCount,
+                .m_instanceOffset = batch.m_firstInstance,
+            });
+            m_statistics.m_drawCalls++;
+        }
+    }
+}
@@ -0,0 +1,50 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Modules/GuiLib/GuiRenderers/GuiTextTierSelector.hpp"
+
+#include <cmath>
+
+namespace KryneEngine::Modules::GuiLib
+{
+    void GuiTextTierSelector::BeginFrame(const bool _screenSpace)
+    {
+        m_screenSpace = _screenSpace;
+        m_statistics = {};
+    }
+
+    GuiTextTierSelector::Tier GuiTextTierSelector::SelectTier(const float _fontSize) const
+    {
+        if (m_screenSpace && GetCoveragePixelSize(_fontSize) > 0 && _fontSize <= m_settings.m_coverageMaxFontSize)
+            return Tier::Coverage;
+        return Tier::Msdf;
+    }
+
+    bool GuiTextTierSelector::AcquireInstance(const Tier _tier)
+    {
+        if (m_settings.m_instanceBudget > 0 && m_statistics.GetInstanceCount() >= m_settings.m_instanceBudget)
+        {
+            m_statistics.m_overBudgetInstances++;
+            return false;
+        }
+
+        switch (_tier)
+        {
+        case Tier::Coverage:
+            m_statistics.m_coverageInstances++;
+            break;
+        case Tier::Msdf:
+            m_statistics.m_msdfInstances++;
+            break;
+        }
+        return true;
+    }
+
+    u32 GuiTextTierSelector::GetCoveragePixelSize(const float _fontSize)
+    {
+        return static_cast<u32>(std::lround(std::fmax(_fontSize, 0.f)));
+    }
+}
@@ -0,0 +1,388 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Modules/GuiLib/GuiRenderers/GuiTextureBindingCache.hpp"
+
+#include <EASTL/fixed_vector.h>
+#include <KryneEngine/Core/Graphics/GraphicsContext.hpp>
+#include <KryneEngine/Core/Graphics/ShaderPipeline.hpp>
+#include <KryneEngine/Core/Profiling/TracyHeader.hpp>
+
+namespace KryneEngine::Modules::GuiLib
+{
+    GuiTextureBindingCache::GuiTextureBindingCache(
+        const AllocatorInstance _allocator,
+        const u8 _frameContextCount,
+        const u32 _evictionFrameCount)
+        : m_frameContextCount(_frameContextCount)
+        , m_evictionFrameCount(_evictionFrameCount)
+        , m_sets(_allocator)
+        , m_descriptorSets(_allocator)
+        , m_bindings(_allocator)
+        , m_frameTextureViews(_allocator)
+        , m_operations(_allocator)
+        , m_destructor(_allocator)
+    {}
+
+    void GuiTextureBindingCache::BeginFrame(const u64 _frameId)
+    {
+        m_frameId = _frameId;
+        m_frameTextureViews.clear();
+        m_statistics = {};
+    }
+
+    GuiTextureBindingCache::Binding GuiTextureBindingCache::Acquire(
+        const TextureViewHandle _textureView,
+        const SamplerHandle _sampler)
+    {
+        const u64 key = MakeKey(_textureView, _sampler);
+
+        if (const auto it = m_bindings.find(key); it != m_bindings.end())
+        {
+            m_statistics.m_hits++;
+            Touch(it->second.m_descriptorSetIndex, it->second.m_textureSlot, it->second.m_samplerSlot);
+            return it->second;
+        }
+
+        m_statistics.m_misses++;
+
+        Binding binding { .m_descriptorSetIndex = 0, .m_textureSlot = kInvalidSlot, .m_samplerSlot = kInvalidSlot };
+
+        // First try to reuse a set already holding the texture.
+        for (u16 setIndex = 0; setIndex < m_sets.size() && binding.m_textureSlot == kInvalidSlot; setIndex++)
+        {
+            SetEntry& set = m_sets[setIndex];
+            if (!set.m_alive)
+                continue;
+
+            for (u8 slot = 0; slot < kTextureSlotCount; slot++)
+            {
+                if (set.m_textures[slot].m_textureView != _textureView)
+                    continue;
+
+                const u8 samplerSlot = FindOrAddSampler(set, _sampler);
+                if (samplerSlot != kInvalidSlot)
+                {
+                    binding = { setIndex, slot, samplerSlot };
+                }
+                break;
+            }
+        }
+
+        // Then look for a free texture slot in a set that can also hold the sampler.
+        for (u16 setIndex = 0; setIndex < m_sets.size() && binding.m_textureSlot == kInvalidSlot; setIndex++)
+        {
+            SetEntry& set = m_sets[setIndex];
+            if (!set.m_alive || set.m_textureCount == kTextureSlotCount)
+                continue;
+
+            const u8 samplerSlot = FindOrAddSampler(set, _sampler);
+            if (samplerSlot == kInvalidSlot)
+                continue;
+
+            for (u8 slot = 0; slot < kTextureSlotCount; slot++)
+            {
+                if (set.m_textures[slot].m_textureView == GenPool::kInvalidHandle)
+                {
+                    set.m_textures[slot] = { _textureView, ~0ull };
+                    set.m_textureCount++;
+                    set.m_pendingWrites = m_frameContextCount;
+                    binding = { setIndex, slot, samplerSlot };
+                    break;
+                }
+            }
+        }
+
+        if (binding.m_textureSlot == kInvalidSlot)
+        {
+            const u16 setIndex = AllocateSet();
+            SetEntry& set = m_sets[setIndex];
+            set.m_textures[0] = { _textureView, ~0ull };
+            set.m_textureCount = 1;
+            binding = { setIndex, 0, FindOrAddSampler(set, _sampler) };
+        }
+
+        m_bindings.emplace(key, binding);
+        Touch(binding.m_descriptorSetIndex, binding.m_textureSlot, binding.m_samplerSlot);
+        return binding;
+    }
+
+    void GuiTextureBindingCache::Invalidate(const TextureViewHandle _textureView)
+    {
+        for (SetEntry& set: m_sets)
+        {
+            if (!set.m_alive)
+                continue;
+
+            for (u8 slot = 0; slot < kTextureSlotCount; slot++)
+            {
+                if (set.m_textures[slot].m_textureView == _textureView)
+                    EvictTextureSlot(set, slot);
+            }
+        }
+
+        const auto it = eastl::find(m_frameTextureViews.begin(), m_frameTextureViews.end(), _textureView);
+        if (it != m_frameTextureViews.end())
+            m_frameTextureViews.erase_unsorted(it);
+    }
+
+    void GuiTextureBindingCache::EndFrame()
+    {
+        KE_ZoneScopedFunction("GuiTextureBindingCache::EndFrame");
+
+        const auto isExpired = [this](const u64 _lastUsedFrame)
+        {
+            return _lastUsedFrame + m_evictionFrameCount < m_frameId;
+        };
+
+        for (u16 setIndex = 0; setIndex < m_sets.size(); setIndex++)
+        {
+            SetEntry& set = m_sets[setIndex];
+            if (!set.m_alive)
+                continue;
+
+            for (u8 slot = 0; slot < kTextureSlotCount; slot++)
+            {
+                const TextureSlot& textureSlot = set.m_textures[slot];
+                if (textureSlot.m_textureView != GenPool::kInvalidHandle && isExpired(textureSlot.m_lastUsedFrame))
+                    EvictTextureSlot(set, slot);
+            }
+
+            for (u8 slot = 0; slot < kSamplerSlotCount; slot++)
+            {
+                const SamplerSlot& samplerSlot = set.m_samplers[slot];
+                if (samplerSlot.m_sampler != GenPool::kInvalidHandle && isExpired(samplerSlot.m_lastUsedFrame))
+                    EvictSamplerSlot(set, slot);
+            }
+
+            if (set.m_textureCount == 0 && isExpired(set.m_lastUsedFrame))
+            {
+                if (!set.m_isNew)
+                    m_operations.push_back({ Operation::Type::Destroy, setIndex });
+                set = {};
+                m_statistics.m_setEvictions++;
+                continue;
+            }
+
+            if (set.m_isNew)
+            {
+                m_operations.push_back({ Operation::Type::Create, setIndex });
+                set.m_isNew = false;
+                m_statistics.m_setCreations++;
+            }
+
+            if (set.m_pendingWrites > 0)
+            {
+                m_operations.push_back({ Operation::Type::Write, setIndex });
+                set.m_pendingWrites--;
+                m_statistics.m_setWrites++;
+                m_statistics.m_descriptorWrites += set.m_textureCount;
+                for (const SamplerSlot& samplerSlot: set.m_samplers)
+                {
+                    if (samplerSlot.m_sampler != GenPool::kInvalidHandle)
+                        m_statistics.m_descriptorWrites++;
+                }
+            }
+        }
+    }
+
+    void GuiTextureBindingCache::Synchronize(
+        GraphicsContext& _graphicsContext,
+        const DescriptorSetLayoutHandle _layout,
+        const u32* _bindingIndices)
+    {
+        KE_ZoneScopedFunction("GuiTextureBindingCache::Synchronize");
+
+        for (const Operation& operation: m_operations)
+        {
+            const u16 setIndex = operation.m_setIndex;
+
+            if (operation.m_type == Operation::Type::Destroy)
+            {
+                m_destructor.DeferDestruction(m_descriptorSets[setIndex], m_frameId + m_frameContextCount);
+                m_descriptorSets[setIndex] = GenPool::kInvalidHandle;
+                continue;
+            }
+
+            if (operation.m_type == Operation::Type::Create)
+            {
+                m_descriptorSets[setIndex] = _graphicsContext.CreateDescriptorSet(_layout);
+                continue;
+            }
+
+            const SetEntry& set = m_sets[setIndex];
+
+            // Only occupied slots are written, as one write per contiguous range of slots.
+            constexpr size_t maxWrites = kTextureSlotCount + kSamplerSlotCount;
+            eastl::fixed_vector<DescriptorSetWriteInfo::DescriptorData, maxWrites, false> data;
+            eastl::fixed_vector<DescriptorSetWriteInfo, maxWrites, false> writes;
+
+            const auto appendRanges = [&](
+                const u32 _bindingIndex,
+                const u32 _slotCount,
+                const TextureLayout _textureLayout,
+                const auto& _getHandle)
+            {
+                for (u32 slot = 0; slot < _slotCount;)
+                {
+                    if (_getHandle(slot) == GenPool::kInvalidHandle)
+                    {
+                        slot++;
+                        continue;
+                    }
+
+                    const size_t rangeStart = data.size();
+                    const u32 firstSlot = slot;
+                    for (; slot < _slotCount && _getHandle(slot) != GenPool::kInvalidHandle; slot++)
+                    {
+                        data.push_back({ .m_textureLayout = _textureLayout, .m_handle = _getHandle(slot) });
+                    }
+                    writes.push_back({
+                        .m_index = _bindingIndex,
+                        .m_arrayOffset = static_cast<u16>(firstSlot),
+                        .m_descriptorData = { data.begin() + rangeStart, data.size() - rangeStart },
+                    });
+                }
+            };
+
+            appendRanges(_bindingIndices[0], kTextureSlotCount, TextureLayout::ShaderResource, [&](const u32 _slot)
+            {
+                return set.m_textures[_slot].m_textureView.m_handle;
+            });
+            appendRanges(_bindingIndices[1], kSamplerSlotCount, TextureLayout::Unknown, [&](const u32 _slot)
+            {
+                return set.m_samplers[_slot].m_sampler.m_handle;
+            });
+
+            _graphicsContext.UpdateDescriptorSet(m_descriptorSets[setIndex], writes, true);
+        }
+        m_operations.clear();
+
+        m_destructor.Flush(&_graphicsContext);
+    }
+
+    void GuiTextureBindingCache::Destroy(GraphicsContext& _graphicsContext)
+    {
+        for (u32 setIndex = 0; setIndex < m_sets.size(); setIndex++)
+        {
+            if (m_descriptorSets[setIndex] != GenPool::kInvalidHandle)
+                _graphicsContext.DestroyDescriptorSet(m_descriptorSets[setIndex]);
+        }
+        m_destructor.Flush(&_graphicsContext);
+
+        m_sets.clear();
+        m_descriptorSets.clear();
+        m_bindings.clear();
+        m_frameTextureViews.clear();
+        m_operations.clear();
+    }
+
+    u64 GuiTextureBindingCache::MakeKey(const TextureViewHandle _textureView, const SamplerHandle _sampler)
+    {
+        return static_cast<u64>(static_cast<u32>(_textureView.m_handle)) << 32
+            | static_cast<u64>(static_cast<u32>(_sampler.m_handle));
+    }
+
+    u8 GuiTextureBindingCache::FindOrAddSampler(SetEntry& _set, const SamplerHandle _sampler)
+    {
+        u8 freeSlot = kInvalidSlot;
+        for (u8 slot = 0; slot < kSamplerSlotCount; slot++)
+        {
+            if (_set.m_samplers[slot].m_sampler == _sampler)
+                return slot;
+            if (freeSlot == kInvalidSlot && _set.m_samplers[slot].m_sampler == GenPool::kInvalidHandle)
+                freeSlot = slot;
+        }
+
+        if (freeSlot != kInvalidSlot)
+        {
+            _set.m_samplers[freeSlot] = { _sampler, ~0ull };
+            _set.m_pendingWrites = m_frameContextCount;
+        }
+        return freeSlot;
+    }
+
+    u16 GuiTextureBindingCache::AllocateSet()
+    {
+        u16 setIndex = 0;
+        for (; setIndex < m_sets.size(); setIndex++)
+        {
+            if (!m_sets[setIndex].m_alive)
+                break;
+        }
+
+        if (setIndex == m_sets.size())
+        {
+            m_sets.push_back();
+            m_descriptorSets.push_back({ GenPool::kInvalidHandle });
+        }
+        else
+        {
+            m_sets[setIndex] = {};
+        }
+
+        SetEntry& set = m_sets[setIndex];
+        set.m_alive = true;
+        set.m_isNew = true;
+        set.m_pendingWrites = m_frameContextCount;
+        return setIndex;
+    }
+
+    void GuiTextureBindingCache::Touch(const u16 _setIndex, const u8 _textureSlot, const u8 _samplerSlot)
+    {
+        SetEntry& set = m_sets[_setIndex];
+        set.m_lastUsedFrame = m_frameId;
+
+        TextureSlot& textureSlot = set.m_textures[_textureSlot];
+        if (textureSlot.m_lastUsedFrame != m_frameId)
+        {
+            // The same view can live in several sets, only declare it once per frame.
+            if (eastl::find(m_frameTextureViews.begin(), m_frameTextureViews.end(), textureSlot.m_textureView) == m_frameTextureViews.end())
+                m_frameTextureViews.push_back(textureSlot.m_textureView);
+            textureSlot.m_lastUsedFrame = m_frameId;
+        }
+        set.m_samplers[_samplerSlot].m_lastUsedFrame = m_frameId;
+    }
+
+    void GuiTextureBindingCache::EvictTextureSlot(SetEntry& _set, const u8 _textureSlot)
+    {
+        const u16 setIndex = static_cast<u16>(&_set - m_sets.data());
+        const TextureViewHandle textureView = _set.m_textures[_textureSlot].m_textureView;
+
+        for (const SamplerSlot& samplerSlot: _set.m_samplers)
+        {
+            if (samplerSlot.m_sampler == GenPool::kInvalidHandle)
+                continue;
+
+            const auto it = m_bindings.find(MakeKey(textureView, samplerSlot.m_sampler));
+            if (it != m_bindings.end() && it->second.m_descriptorSetIndex == setIndex)
+                m_bindings.erase(it);
+        }
+
+        _set.m_textures[_textureSlot] = {};
+        _set.m_textureCount--;
+        m_statistics.m_slotEvictions++;
+    }
+
+    void GuiTextureBindingCache::EvictSamplerSlot(SetEntry& _set, const u8 _samplerSlot)
+    {
+        const u16 setIndex = static_cast<u16>(&_set - m_sets.data());
+        const SamplerHandle sampler = _set.m_samplers[_samplerSlot].m_sampler;
+
+        for (const TextureSlot& textureSlot: _set.m_textures)
+        {
+            if (textureSlot.m_textureView == GenPool::kInvalidHandle)
+                continue;
+
+            const auto it = m_bindings.find(MakeKey(textureSlot.m_textureView, sampler));
+            if (it != m_bindings.end() && it->second.m_descriptorSetIndex == setIndex)
+                m_bindings.erase(it);
+        }
+
+        _set.m_samplers[_samplerSlot] = {};
+        m_statistics.m_slotEvictions++;
+    }
+}
@@ -9,11 +9,12 @@
 #include <EASTL/chrono.h>
 #include <EASTL/vector_map.h>
 #include <KryneEngine/Core/Graphics/GraphicsContext.hpp>
-#include <KryneEngine/Modules/GraphicsUtils/DynamicBuffer.hpp>
+#include <KryneEngine/Modules/GraphicsUtils/FrameUploadArena.hpp>
 #include <imgui.h>
 
 namespace KryneEngine
 {
+    class FibersManager;
     class Window;
 }
 
@@ -102,6 +103,31 @@ namespace KryneEngine::Modules::ImGui
          */
         static eastl::pair<TextureViewHandle, SamplerHandle> FromImTextureID(ImTextureID _textureId);
 
+        /**
+         * @brief Sets the fibers manager used to copy the draw lists in parallel. Copies are done serially if null.
+         */
+        void SetFibersManager(FibersManager* _fibersManager) { m_fibersManager = _fibersManager; }
+
+        /**
+         * @brief Copies the vertices and indices of all the draw lists into contiguous buffers.
+         *
+         * @details
+         * The GPU vertex layout and index format match `ImDrawVert` and `ImDrawIdx`, so each draw list is copied with a
+         * single `memcpy` per buffer. When a fibers manager is provided and the draw data holds at least
+         * `kParallelCopyMinVertexCount` vertices, the draw lists are split into contiguous ranges copied in parallel.
+         *
+         * @param _vertices Destination buffer, holding at least `TotalVtxCount` vertices.
+         * @param _indices Destination buffer, holding at least `TotalIdxCount` indices.
+         */
+        static void CopyDrawData(
+            const ImDrawData* _drawData,
+            ImDrawVert* _vertices,
+            ImDrawIdx* _indices,
+            FibersManager* _fibersManager = nullptr);
+
+        static constexpr u32 kParallelCopyMinVertexCount = 1 << 16;
+        static constexpr u32 kMaxParallelCopyJobs = 16;
+
     private:
         struct SystemTexture
         {
@@ -129,12 +155,14 @@ namespace KryneEngine::Modules::ImGui
         GraphicsPipelineHandle m_pso { GenPool::kInvalidHandle };
 
         static constexpr u64 kInitialSize = 1024;
-        GraphicsUtils::DynamicBuffer m_dynamicVertexBuffer;
-        GraphicsUtils::DynamicBuffer m_dynamicIndexBuffer;
+        GraphicsUtils::FrameUploadArena m_uploadArena;
+        GraphicsUtils::FrameUploadArena::Allocation m_vertexAllocation {};
+        GraphicsUtils::FrameUploadArena::Allocation m_indexAllocation {};
 
         eastl::chrono::time_point<eastl::chrono::steady_clock> m_timePoint;
 
         Input* m_input;
+        FibersManager* m_fibersManager = nullptr;
 
         void InitPso(
             GraphicsContext* _graphicsContext,
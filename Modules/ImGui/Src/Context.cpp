@@ -6,12 +6,14 @@
 
 #include "KryneEngine/Modules/ImGui/Context.hpp"
 
+#include <EASTL/array.h>
 #include <fstream>
 #include <imgui_internal.h>
 #include <GLFW/glfw3.h>
 #include <KryneEngine/Core/Common/Utils/Alignment.hpp>
 #include <KryneEngine/Core/Graphics/ResourceViews/TextureView.hpp>
 #include <KryneEngine/Core/Profiling/TracyHeader.hpp>
+#include <KryneEngine/Core/Threads/FibersManager.hpp>
 #include <KryneEngine/Core/Window/Window.hpp>
 #include "KryneEngine/Core/Graphics/Drawing.hpp"
 #include "KryneEngine/Core/Graphics/ShaderPipeline.hpp"
@@ -22,12 +24,9 @@
 
 namespace KryneEngine::Modules::ImGui
 {
-    struct VertexEntry
-    {
-        float2 m_position;
-        float2 m_uv;
-        u32 m_color;
-    };
+    // Vertices are uploaded as is, make sure the vertex layout matches ImGui's.
+    static_assert(sizeof(ImDrawVert) == sizeof(float2) * 2 + sizeof(u32), "Unsupported ImDrawVert layout");
+    static_assert(sizeof(ImDrawIdx) == sizeof(u16) || sizeof(ImDrawIdx) == sizeof(u32), "Unsupported ImDrawIdx size");
 
     struct PushConstants
     {
@@ -44,8 +43,7 @@ namespace KryneEngine::Modules::ImGui
             : m_systemsTexturesStagingBuffers(_allocator)
             , m_systemTextures(_allocator)
             , m_setIndices(_allocator)
-            , m_dynamicVertexBuffer(_allocator)
-            , m_dynamicIndexBuffer(_allocator)
+            , m_uploadArena(_allocator)
     {
         KE_ZoneScopedFunction("Modules::ImGui::ContextContext");
 
@@ -61,41 +59,13 @@ namespace KryneEngine::Modules::ImGui
         const float2 dpiScale = _window->GetDpiScale();
         io.DisplayFramebufferScale = { dpiScale.x, dpiScale.y };
 
-        {
-            const BufferCreateDesc bufferCreateDesc{
-                .m_desc = {
-                    .m_size = kInitialSize * sizeof(VertexEntry),
-#if !defined(KE_FINAL)
-                    .m_debugName { "ImGuiContext/DynamicVertexBuffer", _allocator }
-#endif
-                },
-                .m_usage = MemoryUsage::StageEveryFrame_UsageType
-                           | MemoryUsage::VertexBuffer
-                           | MemoryUsage::TransferDstBuffer,
-            };
-            m_dynamicVertexBuffer.Init(
-                graphicsContext,
-                bufferCreateDesc,
-                graphicsContext->GetFrameContextCount());
-        }
-
-        {
-            const BufferCreateDesc bufferCreateDesc{
-                .m_desc = {
-                    .m_size = kInitialSize * sizeof(u32),
-#if !defined(KE_FINAL)
-                    .m_debugName { "ImGuiContext/DynamicIndexBuffer", _allocator }
-#endif
-                },
-                .m_usage = MemoryUsage::StageEveryFrame_UsageType
-                           | MemoryUsage::IndexBuffer
-                           | MemoryUsage::TransferDstBuffer,
-            };
-            m_dynamicIndexBuffer.Init(
-                graphicsContext,
-                bufferCreateDesc,
-                graphicsContext->GetFrameContextCount());
-        }
+        // Vertices and indices share the same per-frame memory
+        m_uploadArena.Init(
+            graphicsContext,
+            kInitialSize * (sizeof(ImDrawVert) + sizeof(ImDrawIdx)),
+            MemoryUsage::VertexBuffer | MemoryUsage::IndexBuffer,
+            graphicsContext->GetFrameContextCount(),
+            "ImGuiContext/UploadArena");
 
         m_input = _allocator.New<Input>(_window);
 
@@ -132,8 +102,7 @@ namespace KryneEngine::Modules::ImGui
             }
         }
 
-        m_dynamicIndexBuffer.Destroy(graphicsContext);
-        m_dynamicVertexBuffer.Destroy(graphicsContext);
+        m_uploadArena.Destroy(graphicsContext);
 
         if (m_defaultSampler != GenPool::kInvalidHandle)
         {
@@ -457,66 +426,115 @@ namespace KryneEngine::Modules::ImGui
         const u8 frameIndex = _graphicsContext->GetCurrentFrameContextIndex();
 
         {
-            const u64 vertexCount = drawData->TotalVtxCount;
-
-            const u64 desiredSize = sizeof(VertexEntry) * Alignment::NextPowerOfTwo(vertexCount);
-            if (m_dynamicVertexBuffer.GetSize(frameIndex) < desiredSize)
-            {
-                m_dynamicVertexBuffer.RequestResize(desiredSize);
-            }
+            m_uploadArena.BeginFrame(_graphicsContext, frameIndex);
 
-            auto* vertexEntries = static_cast<VertexEntry*>(m_dynamicVertexBuffer.Map(_graphicsContext, frameIndex));
-            u64 vertexIndex = 0;
-            for (auto i = 0u; i < drawData->CmdListsCount; i++)
-            {
-                const ImDrawList* drawList = drawData->CmdLists[i];
-                for (auto j = 0; j < drawList->VtxBuffer.Size; j++)
-                {
-                    VertexEntry& entry = vertexEntries[vertexIndex];
-                    const ImDrawVert& vert = drawList->VtxBuffer[j];
+            m_vertexAllocation = m_uploadArena.Allocate(
+                _graphicsContext,
+                sizeof(ImDrawVert) * drawData->TotalVtxCount,
+                alignof(ImDrawVert));
+            m_indexAllocation = m_uploadArena.Allocate(
+                _graphicsContext,
+                sizeof(ImDrawIdx) * drawData->TotalIdxCount,
+                sizeof(u32));
 
-                    entry.m_position = { vert.pos.x, vert.pos.y };
-                    entry.m_uv = { vert.uv.x, vert.uv.y };
-                    entry.m_color = vert.col;
+            CopyDrawData(
+                drawData,
+                reinterpret_cast<ImDrawVert*>(m_vertexAllocation.m_cpuPtr),
+                reinterpret_cast<ImDrawIdx*>(m_indexAllocation.m_cpuPtr),
+                m_fibersManager);
 
-                    vertexIndex++;
-                }
-            }
-            m_dynamicVertexBuffer.Unmap(_graphicsContext);
-
-            m_dynamicVertexBuffer.PrepareBuffers(
+            m_uploadArena.EndFrame(
                 _graphicsContext,
                 _commandList,
-                BarrierAccessFlags::VertexBuffer,
-                frameIndex);
+                BarrierAccessFlags::VertexBuffer | BarrierAccessFlags::IndexBuffer);
         }
+    }
+
+    void Context::CopyDrawData(
+        const ImDrawData* _drawData,
+        ImDrawVert* _vertices,
+        ImDrawIdx* _indices,
+        FibersManager* _fibersManager)
+    {
+        KE_ZoneScopedFunction("Modules::ImGui::Context::CopyDrawData");
 
+        struct CopyJob
         {
-            const u64 indexCount = drawData->TotalIdxCount;
+            const ImDrawData* m_drawData;
+            ImDrawVert* m_vertices;
+            ImDrawIdx* m_indices;
+            s32 m_firstList;
+            s32 m_endList;
+        };
 
-            const u64 desiredSize = sizeof(u32) * Alignment::NextPowerOfTwo(indexCount);
-            if (m_dynamicIndexBuffer.GetSize(frameIndex) < desiredSize)
+        constexpr auto executeCopyJob = [](void* _userData)
+        {
+            const auto* job = static_cast<const CopyJob*>(_userData);
+            ImDrawVert* vertices = job->m_vertices;
+            ImDrawIdx* indices = job->m_indices;
+            for (s32 i = job->m_firstList; i < job->m_endList; i++)
             {
-                m_dynamicIndexBuffer.RequestResize(desiredSize);
+                const ImDrawList* drawList = job->m_drawData->CmdLists[i];
+                memcpy(vertices, drawList->VtxBuffer.Data, drawList->VtxBuffer.Size * sizeof(ImDrawVert));
+                memcpy(indices, drawList->IdxBuffer.Data, drawList->IdxBuffer.Size * sizeof(ImDrawIdx));
+                vertices += drawList->VtxBuffer.Size;
+                indices += drawList->IdxBuffer.Size;
             }
+        };
+
+        const s32 listCount = _drawData->CmdListsCount;
+        const bool parallel = _fibersManager != nullptr
+            && listCount > 1
+            && _drawData->TotalVtxCount >= kParallelCopyMinVertexCount;
+
+        if (!parallel)
+        {
+            CopyJob job { _drawData, _vertices, _indices, 0, listCount };
+            executeCopyJob(&job);
+            return;
+        }
+
+        // Split the draw lists in contiguous ranges of similar vertex counts, one job each.
+        eastl::array<CopyJob, kMaxParallelCopyJobs> jobs;
+        const u32 jobCount = eastl::min<u32>(
+            listCount,
+            eastl::min<u32>(kMaxParallelCopyJobs, _fibersManager->GetFiberThreadCount() + 1));
+        const u64 verticesPerJob = (_drawData->TotalVtxCount + jobCount - 1) / jobCount;
 
-            u32* indexBuffer = static_cast<u32*>(m_dynamicIndexBuffer.Map(_graphicsContext, frameIndex));
-            for (auto i = 0u; i < drawData->CmdListsCount; i++)
+        u32 createdJobs = 0;
+        {
+            CopyJob* job = &jobs[0];
+            *job = { _drawData, _vertices, _indices, 0, 0 };
+            u64 jobVertexCount = 0;
+            for (s32 i = 0; i < listCount; i++)
             {
-                const ImDrawList* drawList = drawData->CmdLists[i];
-                for (auto j = 0; j < drawList->IdxBuffer.Size; j++)
+                const ImDrawList* drawList = _drawData->CmdLists[i];
+                jobVertexCount += drawList->VtxBuffer.Size;
+                _vertices += drawList->VtxBuffer.Size;
+                _indices += drawList->IdxBuffer.Size;
+                job->m_endList = i + 1;
+
+                if (jobVertexCount >= verticesPerJob && createdJobs + 1 < jobCount && i + 1 < listCount)
                 {
-                    indexBuffer[j] = drawList->IdxBuffer[j];
+                    createdJobs++;
+                    job = &jobs[createdJobs];
+                    *job = { _drawData, _vertices, _indices, i + 1, i + 1 };
+                    jobVertexCount = 0;
                 }
-                indexBuffer += drawList->IdxBuffer.Size;
             }
-            m_dynamicIndexBuffer.Unmap(_graphicsContext);
+            createdJobs++;
+        }
 
-            m_dynamicIndexBuffer.PrepareBuffers(
-                _graphicsContext,
-                _commandList,
-                BarrierAccessFlags::IndexBuffer,
-                frameIndex);
+        // Execute the last job in this thread/fiber, schedule the other ones for dispatch.
+        if (createdJobs > 1)
+        {
+            const SyncCounterId counter = _fibersManager->InitAndBatchJobs(createdJobs - 1, executeCopyJob, jobs.data());
+            executeCopyJob(&jobs[createdJobs - 1]);
+            _fibersManager->WaitForCounterAndReset(counter);
+        }
+        else
+        {
+            executeCopyJob(&jobs[0]);
         }
     }
 
@@ -542,24 +560,15 @@ namespace KryneEngine::Modules::ImGui
             _graphicsContext->SetViewport(_commandList, viewport);
         }
 
-        const u8 frameIndex = _graphicsContext->GetCurrentFrameContextIndex();
-
         // Set index buffer
         {
-            const BufferSpan bufferView {
-                .m_size = m_dynamicIndexBuffer.GetSize(frameIndex),
-                .m_buffer = m_dynamicIndexBuffer.GetBuffer(frameIndex),
-            };
-            _graphicsContext->SetIndexBuffer(_commandList, bufferView, false);
+            const BufferSpan bufferView = m_indexAllocation.GetBufferSpan(sizeof(ImDrawIdx));
+            _graphicsContext->SetIndexBuffer(_commandList, bufferView, sizeof(ImDrawIdx) == sizeof(u16));
         }
 
         // Set vertex buffer
         {
-            BufferSpan bufferView {
-                .m_size = m_dynamicVertexBuffer.GetSize(frameIndex),
-                .m_stride = sizeof(VertexEntry),
-                .m_buffer = m_dynamicVertexBuffer.GetBuffer(frameIndex),
-            };
+            const BufferSpan bufferView = m_vertexAllocation.GetBufferSpan(sizeof(ImDrawVert));
             _graphicsContext->SetVertexBuffers(_commandList, {&bufferView,1});
         }
 
@@ -831,7 +840,7 @@ namespace KryneEngine::Modules::ImGui
                     .m_semanticIndex = 0,
                     .m_bindingIndex = 0,
                     .m_format = TextureFormat::RG32_Float,
-                    .m_offset = offsetof(VertexEntry, m_position),
+                    .m_offset = offsetof(ImDrawVert, pos),
                     .m_location = 0,
                 },
                 {
@@ -839,7 +848,7 @@ namespace KryneEngine::Modules::ImGui
                     .m_semanticIndex = 0,
                     .m_bindingIndex = 0,
                     .m_format = TextureFormat::RG32_Float,
-                    .m_offset = offsetof(VertexEntry, m_uv),
+                    .m_offset = offsetof(ImDrawVert, uv),
                     .m_location = 1,
                 },
                 {
@@ -847,13 +856,13 @@ namespace KryneEngine::Modules::ImGui
                     .m_semanticIndex = 0,
                     .m_bindingIndex = 0,
                     .m_format = TextureFormat::RGBA8_UNorm,
-                    .m_offset = offsetof(VertexEntry, m_color),
+                    .m_offset = offsetof(ImDrawVert, col),
                     .m_location = 2,
                 },
             };
             const VertexBindingDesc vertexBindings[] {
                 {
-                    .m_stride = sizeof(VertexEntry),
+                    .m_stride = sizeof(ImDrawVert),
                     .m_binding = 0,
                 }
             };
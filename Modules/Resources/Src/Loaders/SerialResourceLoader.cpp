@@ -7,6 +7,7 @@
 #include "KryneEngine/Modules/Resources/Loaders/SerialResourceLoader.hpp"
 
 #include <KryneEngine/Core/Common/Assert.hpp>
+#include <KryneEngine/Core/Profiling/FrameStatistics.hpp>
 #include <KryneEngine/Modules/FileSystem/VirtualFileSystem.hpp>
 
 #include "KryneEngine/Modules/Resources/IResourceManager.hpp"
@@ -50,6 +51,7 @@ namespace KryneEngine::Modules::Resources
             }
             else
             {
+                KE_FrameZoneScoped("Resource finalization");
                 _resourceManager->FinalizeResourceLoading(_entry, loadedResourceData, _path.m_string);
             }
         }
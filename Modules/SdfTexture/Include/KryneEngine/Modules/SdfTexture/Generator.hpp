@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <EASTL/functional.h>
 #include <EASTL/span.h>
+#include <EASTL/vector.h>
 
 #include "KryneEngine/Core/Math/BoundingBox.hpp"
 #include "KryneEngine/Core/Math/Float16.hpp"
@@ -23,6 +25,65 @@ namespace KryneEngine::Modules::SdfTexture
     class Generator
     {
     public:
+        enum class Algorithm: u8
+        {
+            /// Exact distance to every triangle for every texel. Cost grows with texel count times triangle count.
+            BruteForce,
+
+            /**
+             * Exact distances only in a narrow band around the triangles, then propagated to the rest of the volume by
+             * fast sweeping the closest triangle of each texel. Inside and outside are determined by ray parity, so the
+             * mesh must be closed.
+             */
+            NarrowBandSweeping,
+        };
+
+        /**
+         * @brief A cubic block of the volume, produced by `GenerateTiled()`.
+         */
+        struct Brick
+        {
+            /// Position of the brick in the brick grid.
+            uint3 m_coordinates;
+
+            /// Position of the first texel of the brick in the volume.
+            uint3 m_texelOffset;
+
+            /// Texel dimensions of the brick, clamped to the volume on its upper borders.
+            uint3 m_dimensions;
+
+            /// Signed distance at the center of the brick.
+            float m_centerDistance;
+
+            /**
+             * Texels of the brick, X-major, only valid during the writer call.
+             * Empty for sparse bricks, whose texels are all further than the sparse distance from the surface, on the
+             * same side as the brick center.
+             */
+            eastl::span<const Math::Float16> m_texels;
+
+            [[nodiscard]] bool IsSparse() const { return m_texels.empty(); }
+        };
+
+        using BrickWriter = eastl::function<void(const Brick&)>;
+
+        struct TiledStats
+        {
+            u64 m_brickCount = 0;
+            u64 m_sparseBrickCount = 0;
+
+            /// Size of the full volume, if it was stored densely.
+            u64 m_denseBytes = 0;
+
+            /// Size of the texels of the non-sparse bricks.
+            u64 m_storedBytes = 0;
+
+            /// Largest amount of memory used at once by the generation, excluding the source mesh.
+            u64 m_peakWorkingBytes = 0;
+
+            [[nodiscard]] u64 GetSavedBytes() const { return m_denseBytes - m_storedBytes; }
+        };
+
         explicit Generator(AllocatorInstance _allocator);
         ~Generator();
 
@@ -34,6 +95,16 @@ namespace KryneEngine::Modules::SdfTexture
 
         [[nodiscard]] const uint3& GetDimensions() const { return m_dimensions; }
 
+        void SetAlgorithm(Algorithm _algorithm) { m_algorithm = _algorithm; }
+        [[nodiscard]] Algorithm GetAlgorithm() const { return m_algorithm; }
+
+        /**
+         * @brief Sets the half width of the band in which distances are exact, in texels.
+         * Only used by `Algorithm::NarrowBandSweeping`.
+         */
+        void SetNarrowBandWidth(u32 _texelCount);
+        [[nodiscard]] u32 GetNarrowBandWidth() const { return m_narrowBandWidth; }
+
         void Generate(
             eastl::span<const std::byte> _indexBuffer,
             eastl::span<const std::byte> _vertexBuffer,
@@ -43,7 +114,38 @@ namespace KryneEngine::Modules::SdfTexture
 
         const std::byte* GetOutputBuffer() { return reinterpret_cast<const std::byte*>(m_outputBuffer); }
 
+        /**
+         * @brief Sets the edge length of the bricks produced by `GenerateTiled()`, in texels.
+         */
+        void SetBrickSize(u32 _texelCount);
+        [[nodiscard]] u32 GetBrickSize() const { return m_brickSize; }
+
+        /**
+         * @brief Sets the distance to the surface past which bricks are sparse, in texels.
+         */
+        void SetSparseDistance(float _texelDistance);
+        [[nodiscard]] float GetSparseDistance() const { return m_sparseDistance; }
+
+        /**
+         * @brief Generates the volume brick by brick, without ever storing it whole.
+         *
+         * @details
+         * Bricks are passed to the writer in X, then Y, then Z order. Dense bricks hold the same values as the brute
+         * force algorithm. Memory use only depends on the brick size and on the mesh triangle count, so the output
+         * buffer isn't touched, and the resolution is only bound by the time it takes.
+         */
+        TiledStats GenerateTiled(
+            eastl::span<const std::byte> _indexBuffer,
+            eastl::span<const std::byte> _vertexBuffer,
+            bool _16BitsIndex,
+            u64 _vertexStride,
+            u64 _vertexPositionOffset,
+            const BrickWriter& _writer);
+
         static constexpr u32 kMinDimension = 8;
+        static constexpr u32 kDefaultNarrowBandWidth = 2;
+        static constexpr u32 kDefaultBrickSize = 8;
+        static constexpr float kDefaultSparseDistance = 4.f;
 
     private:
         AllocatorInstance m_allocator;
@@ -51,6 +153,22 @@ namespace KryneEngine::Modules::SdfTexture
         float m_texelSize {};
         Math::BoundingBox m_boundingBox {};
         Math::Float16* m_outputBuffer = nullptr;
+        Algorithm m_algorithm = Algorithm::BruteForce;
+        u32 m_narrowBandWidth = kDefaultNarrowBandWidth;
+        u32 m_brickSize = kDefaultBrickSize;
+        float m_sparseDistance = kDefaultSparseDistance;
+
+        [[nodiscard]] float3 GetPositionStart() const;
+
+        static void GatherTriangles(
+            eastl::span<const std::byte> _indexBuffer,
+            eastl::span<const std::byte> _vertexBuffer,
+            bool _16BitsIndex,
+            u64 _vertexStride,
+            u64 _vertexPositionOffset,
+            eastl::vector<float3>& _triangles);
+
+        void GenerateNarrowBand(eastl::span<const float3> _triangles, const float3& _positionStart);
 
         static float TriangleSdf(const float3& _p, const float3& _a, const float3& _b, const float3& _c);
     };
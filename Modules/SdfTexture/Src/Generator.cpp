@@ -7,9 +7,78 @@
 #include "KryneEngine/Modules/SdfTexture/Generator.hpp"
 
 #include <cmath>
+#include <EASTL/algorithm.h>
+#include <EASTL/vector.h>
 
 namespace KryneEngine::Modules::SdfTexture
 {
+    namespace
+    {
+        // Number of times the 8 sweep directions are run. A second pass fixes most texels whose closest triangle
+        // could only be reached through a path with turns.
+        constexpr u32 kSweepPassCount = 2;
+
+        constexpr u32 kNoTriangle = ~0u;
+
+        /**
+         * Orientation of the (0, 0), (x0, y0), (x1, y1) triangle, with consistent tie-breaking on degenerate cases, so
+         * a point lying exactly on an edge shared by two triangles is only inside one of them.
+         */
+        s32 Orientation(const double _x0, const double _y0, const double _x1, const double _y1, double& _twiceArea)
+        {
+            _twiceArea = _y0 * _x1 - _x0 * _y1;
+            if (_twiceArea != 0.0)
+            {
+                return _twiceArea > 0.0 ? 1 : -1;
+            }
+            if (_y1 != _y0)
+            {
+                return _y1 > _y0 ? 1 : -1;
+            }
+            if (_x0 != _x1)
+            {
+                return _x0 > _x1 ? 1 : -1;
+            }
+            return 0;
+        }
+
+        bool PointInTriangle2d(
+            const double _x,
+            const double _y,
+            double _x0, double _y0,
+            double _x1, double _y1,
+            double _x2, double _y2,
+            double (&_barycentrics)[3])
+        {
+            _x0 -= _x; _x1 -= _x; _x2 -= _x;
+            _y0 -= _y; _y1 -= _y; _y2 -= _y;
+
+            const s32 sign0 = Orientation(_x1, _y1, _x2, _y2, _barycentrics[0]);
+            if (sign0 == 0)
+            {
+                return false;
+            }
+            if (Orientation(_x2, _y2, _x0, _y0, _barycentrics[1]) != sign0)
+            {
+                return false;
+            }
+            if (Orientation(_x0, _y0, _x1, _y1, _barycentrics[2]) != sign0)
+            {
+                return false;
+            }
+
+            const double sum = _barycentrics[0] + _barycentrics[1] + _barycentrics[2];
+            if (sum == 0.0)
+            {
+                return false;
+            }
+            _barycentrics[0] /= sum;
+            _barycentrics[1] /= sum;
+            _barycentrics[2] /= sum;
+            return true;
+        }
+    }
+
     Generator::Generator(AllocatorInstance _allocator)
         : m_allocator(_allocator)
     {}
@@ -22,6 +91,24 @@ namespace KryneEngine::Modules::SdfTexture
         }
     }
 
+    void Generator::SetNarrowBandWidth(const u32 _texelCount)
+    {
+        KE_ASSERT(_texelCount > 0);
+        m_narrowBandWidth = _texelCount;
+    }
+
+    void Generator::SetBrickSize(const u32 _texelCount)
+    {
+        KE_ASSERT(_texelCount > 0);
+        m_brickSize = _texelCount;
+    }
+
+    void Generator::SetSparseDistance(const float _texelDistance)
+    {
+        KE_ASSERT(_texelDistance >= 0.f);
+        m_sparseDistance = _texelDistance;
+    }
+
     void Generator::ForceDimensions(const uint3& _dimensions)
     {
         KE_ASSERT(_dimensions.x > kMinDimension && _dimensions.y > kMinDimension && _dimensions.z > kMinDimension);
@@ -113,13 +200,22 @@ namespace KryneEngine::Modules::SdfTexture
             return float3 { position };
         };
 
-        const float3 positionStart {
-            m_boundingBox.GetCenter()
-            - float3 { m_dimensions } * m_texelSize * 0.5f
-        };
+        const float3 positionStart = GetPositionStart();
 
+        if (m_outputBuffer != nullptr)
+        {
+            m_allocator.deallocate(m_outputBuffer);
+        }
         m_outputBuffer = m_allocator.Allocate<Math::Float16>(m_dimensions.x * m_dimensions.y * m_dimensions.z);
 
+        if (m_algorithm == Algorithm::NarrowBandSweeping)
+        {
+            eastl::vector<float3> triangles(m_allocator);
+            GatherTriangles(_indexBuffer, _vertexBuffer, _16BitsIndex, _vertexStride, _vertexPositionOffset, triangles);
+            GenerateNarrowBand(triangles, positionStart);
+            return;
+        }
+
         for (u32 z = 0; z < m_dimensions.z; z++)
         {
             for (u32 y = 0; y < m_dimensions.y; y++)
@@ -149,6 +245,388 @@ namespace KryneEngine::Modules::SdfTexture
         }
     }
 
+    Generator::TiledStats Generator::GenerateTiled(
+        eastl::span<const std::byte> _indexBuffer,
+        eastl::span<const std::byte> _vertexBuffer,
+        bool _16BitsIndex,
+        u64 _vertexStride,
+        u64 _vertexPositionOffset,
+        const BrickWriter& _writer)
+    {
+        eastl::vector<float3> triangles(m_allocator);
+        GatherTriangles(_indexBuffer, _vertexBuffer, _16BitsIndex, _vertexStride, _vertexPositionOffset, triangles);
+        const u32 triangleCount = triangles.size() / 3;
+
+        const float3 positionStart = GetPositionStart();
+        const uint3 brickCounts = (m_dimensions + (m_brickSize - 1)) / m_brickSize;
+        const float sparseDistance = m_sparseDistance * m_texelSize;
+
+        // Working memory is allocated once, and only depends on the brick size and the triangle count
+        eastl::vector<Math::Float16> brickTexels(m_allocator);
+        eastl::vector<float> centerDistances(m_allocator);
+        eastl::vector<u32> candidates(m_allocator);
+        brickTexels.resize(m_brickSize * m_brickSize * m_brickSize);
+        centerDistances.resize(triangleCount);
+        candidates.reserve(triangleCount);
+
+        TiledStats stats {};
+        stats.m_brickCount = u64(brickCounts.x) * brickCounts.y * brickCounts.z;
+        stats.m_denseBytes = u64(m_dimensions.x) * m_dimensions.y * m_dimensions.z * sizeof(Math::Float16);
+
+        for (u32 bz = 0; bz < brickCounts.z; bz++)
+        {
+            for (u32 by = 0; by < brickCounts.y; by++)
+            {
+                for (u32 bx = 0; bx < brickCounts.x; bx++)
+                {
+                    Brick brick {
+                        .m_coordinates = { bx, by, bz },
+                        .m_texelOffset = uint3 { bx, by, bz } * m_brickSize,
+                    };
+                    for (u32 i = 0; i < 3; i++)
+                    {
+                        brick.m_dimensions[i] = eastl::min(m_brickSize, m_dimensions[i] - brick.m_texelOffset[i]);
+                    }
+
+                    // Bounding sphere of the brick texel centers
+                    const float3 texelExtent = float3 { brick.m_dimensions - 1 } * m_texelSize;
+                    const float3 center = positionStart
+                        + (float3 { brick.m_texelOffset } + 0.5f) * m_texelSize
+                        + texelExtent * 0.5f;
+                    const float radius = texelExtent.Length() * 0.5f;
+
+                    float closestDistance = FLT_MAX;
+                    brick.m_centerDistance = FLT_MAX;
+                    for (u32 t = 0; t < triangleCount; t++)
+                    {
+                        const float sdf = TriangleSdf(
+                            center,
+                            triangles[t * 3],
+                            triangles[t * 3 + 1],
+                            triangles[t * 3 + 2]);
+                        centerDistances[t] = std::fabs(sdf);
+                        if (centerDistances[t] < closestDistance)
+                        {
+                            closestDistance = centerDistances[t];
+                            brick.m_centerDistance = sdf;
+                        }
+                    }
+
+                    // No texel of the brick is closer to the surface than the center distance minus the radius
+                    if (closestDistance - radius > sparseDistance)
+                    {
+                        stats.m_sparseBrickCount++;
+                        _writer(brick);
+                        continue;
+                    }
+
+                    // The closest triangle of any texel is at most twice the radius further from the center than
+                    // the closest triangle of the center, so the other ones can be skipped.
+                    const float candidateDistance = closestDistance + 2.f * radius;
+                    candidates.clear();
+                    for (u32 t = 0; t < triangleCount; t++)
+                    {
+                        if (centerDistances[t] <= candidateDistance)
+                        {
+                            candidates.push_back(t);
+                        }
+                    }
+
+                    for (u32 z = 0; z < brick.m_dimensions.z; z++)
+                    {
+                        for (u32 y = 0; y < brick.m_dimensions.y; y++)
+                        {
+                            for (u32 x = 0; x < brick.m_dimensions.x; x++)
+                            {
+                                const float3 offset = (float3 { brick.m_texelOffset + uint3 { x, y, z } } + 0.5f)
+                                    * m_texelSize;
+                                const float3 position = positionStart + offset;
+                                float dist = FLT_MAX;
+
+                                for (const u32 t: candidates)
+                                {
+                                    const float sdf = TriangleSdf(
+                                        position,
+                                        triangles[t * 3],
+                                        triangles[t * 3 + 1],
+                                        triangles[t * 3 + 2]);
+                                    if (std::fabs(sdf) < std::fabs(dist))
+                                    {
+                                        dist = sdf;
+                                    }
+                                }
+
+                                const u32 index = x + brick.m_dimensions.x * (y + brick.m_dimensions.y * z);
+                                brickTexels[index] = Math::Float16 { dist };
+                            }
+                        }
+                    }
+
+                    const size_t texelCount = brick.m_dimensions.x * brick.m_dimensions.y * brick.m_dimensions.z;
+                    brick.m_texels = { brickTexels.data(), texelCount };
+                    stats.m_storedBytes += texelCount * sizeof(Math::Float16);
+                    _writer(brick);
+                }
+            }
+        }
+
+        stats.m_peakWorkingBytes = brickTexels.capacity() * sizeof(Math::Float16)
+            + centerDistances.capacity() * sizeof(float)
+            + candidates.capacity() * sizeof(u32)
+            + triangles.capacity() * sizeof(float3);
+        return stats;
+    }
+
+    float3 Generator::GetPositionStart() const
+    {
+        return m_boundingBox.GetCenter() - float3 { m_dimensions } * m_texelSize * 0.5f;
+    }
+
+    void Generator::GatherTriangles(
+        eastl::span<const std::byte> _indexBuffer,
+        eastl::span<const std::byte> _vertexBuffer,
+        bool _16BitsIndex,
+        u64 _vertexStride,
+        u64 _vertexPositionOffset,
+        eastl::vector<float3>& _triangles)
+    {
+        const size_t indexCount = _indexBuffer.size_bytes() / (_16BitsIndex ? sizeof(u16) : sizeof(u32));
+
+        const auto loadIndex = [&](const size_t _index) -> size_t
+        {
+            return _16BitsIndex
+                ? *(reinterpret_cast<const u16*>(_indexBuffer.data() + _index * sizeof(u16)))
+                : *(reinterpret_cast<const u32*>(_indexBuffer.data() + _index * sizeof(u32)));
+        };
+
+        const auto loadPosition = [&](const size_t _index)
+        {
+            const size_t vertexOffset = _index * _vertexStride + _vertexPositionOffset;
+            return *reinterpret_cast<const float3*>(_vertexBuffer.data() + vertexOffset);
+        };
+
+        _triangles.clear();
+        _triangles.reserve(indexCount - indexCount % 3);
+        for (size_t i = 0; i + 2 < indexCount; i += 3)
+        {
+            _triangles.push_back(loadPosition(loadIndex(i)));
+            _triangles.push_back(loadPosition(loadIndex(i + 1)));
+            _triangles.push_back(loadPosition(loadIndex(i + 2)));
+        }
+    }
+
+    void Generator::GenerateNarrowBand(const eastl::span<const float3> _triangles, const float3& _positionStart)
+    {
+        const s32 dimX = static_cast<s32>(m_dimensions.x);
+        const s32 dimY = static_cast<s32>(m_dimensions.y);
+        const s32 dimZ = static_cast<s32>(m_dimensions.z);
+        const size_t texelCount = size_t(dimX) * dimY * dimZ;
+        const s32 band = static_cast<s32>(m_narrowBandWidth);
+
+        const auto texelIndex = [&](const s32 _x, const s32 _y, const s32 _z)
+        {
+            return size_t(_x) + size_t(dimX) * (size_t(_y) + size_t(dimY) * _z);
+        };
+
+        const auto texelPosition = [&](const s32 _x, const s32 _y, const s32 _z)
+        {
+            return _positionStart + (float3 { _x, _y, _z } + 0.5f) * m_texelSize;
+        };
+
+        // Texel space, where texel centers lie on integer coordinates
+        const float inverseTexelSize = 1.f / m_texelSize;
+        const auto toTexelSpace = [&](const float3& _position)
+        {
+            return (_position - _positionStart) * inverseTexelSize - 0.5f;
+        };
+
+        const auto triangleDistance = [&](const float3& _position, const u32 _triangle)
+        {
+            return std::fabs(TriangleSdf(
+                _position,
+                _triangles[_triangle * 3],
+                _triangles[_triangle * 3 + 1],
+                _triangles[_triangle * 3 + 2]));
+        };
+
+        auto* distances = m_allocator.Allocate<float>(texelCount);
+        auto* closestTriangles = m_allocator.Allocate<u32>(texelCount);
+        auto* crossingParities = m_allocator.Allocate<u8>(texelCount);
+        eastl::fill_n(distances, texelCount, FLT_MAX);
+        eastl::fill_n(closestTriangles, texelCount, kNoTriangle);
+        eastl::fill_n(crossingParities, texelCount, u8(0));
+
+        // The brute force sign follows the triangle winding, so use the mesh orientation to match it.
+        double signedVolume = 0.0;
+
+        const u32 triangleCount = _triangles.size() / 3;
+        for (u32 t = 0; t < triangleCount; t++)
+        {
+            const float3& a = _triangles[t * 3];
+            const float3& b = _triangles[t * 3 + 1];
+            const float3& c = _triangles[t * 3 + 2];
+
+            signedVolume += float3::Dot(a, float3::CrossProduct(b, c));
+
+            const float3 texelA = toTexelSpace(a);
+            const float3 texelB = toTexelSpace(b);
+            const float3 texelC = toTexelSpace(c);
+
+            float3 texelMin = texelA;
+            texelMin.MinComponents(texelB);
+            texelMin.MinComponents(texelC);
+            float3 texelMax = texelA;
+            texelMax.MaxComponents(texelB);
+            texelMax.MaxComponents(texelC);
+
+            // Exact distances in the narrow band around the triangle
+            {
+                const s32 x0 = eastl::max(static_cast<s32>(std::floor(texelMin.x)) - band, 0);
+                const s32 y0 = eastl::max(static_cast<s32>(std::floor(texelMin.y)) - band, 0);
+                const s32 z0 = eastl::max(static_cast<s32>(std::floor(texelMin.z)) - band, 0);
+                const s32 x1 = eastl::min(static_cast<s32>(std::ceil(texelMax.x)) + band, dimX - 1);
+                const s32 y1 = eastl::min(static_cast<s32>(std::ceil(texelMax.y)) + band, dimY - 1);
+                const s32 z1 = eastl::min(static_cast<s32>(std::ceil(texelMax.z)) + band, dimZ - 1);
+
+                for (s32 z = z0; z <= z1; z++)
+                {
+                    for (s32 y = y0; y <= y1; y++)
+                    {
+                        for (s32 x = x0; x <= x1; x++)
+                        {
+                            const size_t index = texelIndex(x, y, z);
+                            const float distance = std::fabs(TriangleSdf(texelPosition(x, y, z), a, b, c));
+                            if (distance < distances[index])
+                            {
+                                distances[index] = distance;
+                                closestTriangles[index] = t;
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Crossings of the rays cast along +X from each texel row. Each crossing flips the parity of the first
+            // texel past it.
+            {
+                const s32 y0 = eastl::max(static_cast<s32>(std::ceil(texelMin.y)), 0);
+                const s32 z0 = eastl::max(static_cast<s32>(std::ceil(texelMin.z)), 0);
+                const s32 y1 = eastl::min(static_cast<s32>(std::floor(texelMax.y)), dimY - 1);
+                const s32 z1 = eastl::min(static_cast<s32>(std::floor(texelMax.z)), dimZ - 1);
+
+                for (s32 z = z0; z <= z1; z++)
+                {
+                    for (s32 y = y0; y <= y1; y++)
+                    {
+                        double barycentrics[3];
+                        if (!PointInTriangle2d(
+                            y, z,
+                            texelA.y, texelA.z,
+                            texelB.y, texelB.z,
+                            texelC.y, texelC.z,
+                            barycentrics))
+                        {
+                            continue;
+                        }
+
+                        const double crossing = barycentrics[0] * texelA.x
+                            + barycentrics[1] * texelB.x
+                            + barycentrics[2] * texelC.x;
+                        const s32 x = eastl::max(static_cast<s32>(std::ceil(crossing)), 0);
+                        if (x < dimX)
+                        {
+                            crossingParities[texelIndex(x, y, z)] ^= 1;
+                        }
+                    }
+                }
+            }
+        }
+
+        // Fast sweeping: propagate the closest triangles across the volume, along each of the 8 diagonal directions.
+        // Distances stay exact with respect to the propagated triangle, so error only comes from missed triangles.
+        const auto sweep = [&](const s32 _dx, const s32 _dy, const s32 _dz)
+        {
+            const s32 xStart = _dx > 0 ? 1 : dimX - 2;
+            const s32 yStart = _dy > 0 ? 1 : dimY - 2;
+            const s32 zStart = _dz > 0 ? 1 : dimZ - 2;
+            const s32 xEnd = _dx > 0 ? dimX : -1;
+            const s32 yEnd = _dy > 0 ? dimY : -1;
+            const s32 zEnd = _dz > 0 ? dimZ : -1;
+
+            for (s32 z = zStart; z != zEnd; z += _dz)
+            {
+                for (s32 y = yStart; y != yEnd; y += _dy)
+                {
+                    for (s32 x = xStart; x != xEnd; x += _dx)
+                    {
+                        const size_t index = texelIndex(x, y, z);
+                        const float3 position = texelPosition(x, y, z);
+
+                        const size_t neighbors[] = {
+                            texelIndex(x - _dx, y, z),
+                            texelIndex(x, y - _dy, z),
+                            texelIndex(x - _dx, y - _dy, z),
+                            texelIndex(x, y, z - _dz),
+                            texelIndex(x - _dx, y, z - _dz),
+                            texelIndex(x, y - _dy, z - _dz),
+                            texelIndex(x - _dx, y - _dy, z - _dz),
+                        };
+                        for (const size_t neighbor: neighbors)
+                        {
+                            const u32 triangle = closestTriangles[neighbor];
+                            if (triangle == kNoTriangle || triangle == closestTriangles[index])
+                            {
+                                continue;
+                            }
+
+                            const float distance = triangleDistance(position, triangle);
+                            if (distance < distances[index])
+                            {
+                                distances[index] = distance;
+                                closestTriangles[index] = triangle;
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        for (u32 pass = 0; pass < kSweepPassCount; pass++)
+        {
+            for (const s32 dz: { 1, -1 })
+            {
+                for (const s32 dy: { 1, -1 })
+                {
+                    for (const s32 dx: { 1, -1 })
+                    {
+                        sweep(dx, dy, dz);
+                    }
+                }
+            }
+        }
+
+        // Texels with an odd crossing count along their row are inside the mesh
+        const float insideSign = signedVolume > 0.0 ? 1.f : -1.f;
+        for (s32 z = 0; z < dimZ; z++)
+        {
+            for (s32 y = 0; y < dimY; y++)
+            {
+                u8 parity = 0;
+                for (s32 x = 0; x < dimX; x++)
+                {
+                    const size_t index = texelIndex(x, y, z);
+                    parity ^= crossingParities[index];
+                    const float sign = parity != 0 ? insideSign : -insideSign;
+                    m_outputBuffer[index] = Math::Float16 { sign * distances[index] };
+                }
+            }
+        }
+
+        m_allocator.deallocate(crossingParities);
+        m_allocator.deallocate(closestTriangles);
+        m_allocator.deallocate(distances);
+    }
+
     float
     Generator::TriangleSdf(const float3& _p, const float3& _a, const float3& _b, const float3& _c)
     {
@@ -174,7 +652,8 @@ namespace KryneEngine::Modules::SdfTexture
             return std::fmin(std::fmax(_value, 0.f), 1.f);
         };
 
-        if (signs < 2)
+        // Closest point is on an edge when the projection lies outside any of the edges
+        if (signs > 0)
         {
             const float abEdgeSdf = (ba * saturate(float3::Dot(ba, pa) / ba.LengthSquared()) - pa).LengthSquared();
             const float bcEdgeSdf = (cb * saturate(float3::Dot(cb, pb) / cb.LengthSquared()) - pb).LengthSquared();
@@ -19,8 +19,9 @@ namespace KryneEngine::Modules::ShaderReflection
      * The blob is formatted as such:
      *      - header
      *      - entry point indirection table
-     *      - entry point blobs
-     *      - descriptor set blobs
+     *      - entry point name table
+     *      - entry point blobs (header, descriptor set indirection table, descriptor set name table)
+     *      - descriptor set blobs (header, descriptors, descriptor name table)
      *      - strings table
      *
      * Entry points are kept in contiguous memory, as they are expected to be accessed in sequence often, mostly by
@@ -33,13 +34,19 @@ namespace KryneEngine::Modules::ShaderReflection
      *
      * Strings are kept in a separate table, as most of them may not be accessed at all, and could thus take up some
      * cache space for nothing.
+     *
+     * Name tables are open-addressing hash tables, with linear probing and a load factor of at most 1/2. Their capacity
+     * only depends on the number of elements they index, so they need no extra offset. They allow finding an entry
+     * point, descriptor set or descriptor by name in constant time, directly from the mapped blob and with no
+     * allocation. Only the matching candidate names are read from the strings table.
      */
     struct alignas(sizeof(u64)) Blob
     {
         static constexpr size_t kAlignment = sizeof(u64);
         static constexpr u32 kMagicNumber = 0x91eb21ad; // 'keshrf' in base64
-        static constexpr u32 kVersion = 0;
+        static constexpr u32 kVersion = 1;
         static constexpr u32 kMaxStringLength = 255;
+        static constexpr u32 kInvalidIndex = ~0u;
 
         struct Header
         {
@@ -78,6 +85,12 @@ namespace KryneEngine::Modules::ShaderReflection
             TextureTypes m_textureType;
         };
 
+        struct NameTableSlot
+        {
+            u32 m_hashTag;  // High bits of the name hash
+            u32 m_index;    // Element index + 1, 0 for empty slots
+        };
+
         [[nodiscard]] const std::byte* GetByteBuffer() const { return reinterpret_cast<const std::byte*>(this); }
         [[nodiscard]] std::byte* GetByteBuffer() { return reinterpret_cast<std::byte*>(this); }
 
@@ -85,6 +98,28 @@ namespace KryneEngine::Modules::ShaderReflection
         [[nodiscard]] u32 GetEntryPointOffset(u32 _index) const;
         [[nodiscard]] const EntryPointHeader* GetEntryPointHeader(u32 _index) const;
 
+        [[nodiscard]] const DescriptorSetHeader* GetDescriptorSetHeader(const EntryPointHeader* _entryPoint, u32 _index) const;
+        [[nodiscard]] eastl::span<const DescriptorData> GetDescriptors(const DescriptorSetHeader* _descriptorSet) const;
+
+        /**
+         * @brief Returns a string of the strings table, from one of the name offsets.
+         */
+        [[nodiscard]] eastl::string_view GetString(u32 _offset) const;
+
+        /**
+         * @return The entry point index, or `kInvalidIndex` if there is no entry point with this name.
+         */
+        [[nodiscard]] u32 FindEntryPointIndex(eastl::string_view _name) const;
+        [[nodiscard]] const EntryPointHeader* FindEntryPoint(eastl::string_view _name) const;
+        [[nodiscard]] const DescriptorSetHeader* FindDescriptorSet(
+            const EntryPointHeader* _entryPoint,
+            eastl::string_view _name) const;
+        [[nodiscard]] const DescriptorData* FindDescriptor(
+            const DescriptorSetHeader* _descriptorSet,
+            eastl::string_view _name) const;
+
+        [[nodiscard]] static u32 GetNameTableCapacity(u32 _elementCount);
+
         [[nodiscard]] static bool IsShaderReflectionBlob(const std::byte* _data);
         [[nodiscard]] static Blob* CreateBlob(
             AllocatorInstance _allocator,
@@ -0,0 +1,159 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <EASTL/hash_map.h>
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
+#include <KryneEngine/Core/Graphics/Handles.hpp>
+#include <KryneEngine/Core/Graphics/ShaderPipeline.hpp>
+#include <KryneEngine/Core/Memory/Allocators/Allocator.hpp>
+
+#include "KryneEngine/Modules/ShaderReflection/Blob.hpp"
+
+namespace KryneEngine
+{
+    class GraphicsContext;
+}
+
+namespace KryneEngine::Modules::ShaderReflection
+{
+    /**
+     * @brief Derives descriptor set and pipeline layouts from reflection blobs, and shares identical ones.
+     *
+     * @details
+     * A pipeline layout is built from the entry points of all its stages, which may come from different blobs.
+     * Descriptor sets are matched by their index in the entry point set list, and descriptors within a set by their
+     * type and binding index. The visibility of a binding is the union of the stages using it.
+     * Push constants with the same signature are merged the same way, other ones get their own range.
+     *
+     * Layouts are keyed by a hash of their content, so identical layouts derived by different renderers map to the same
+     * graphics objects. Layouts are reference counted, and destroyed once their last user released them.
+     *
+     * Graphics objects are created and destroyed through a `Backend`, so the cache can run without a GPU.
+     * The cache is not thread safe.
+     */
+    class LayoutCache
+    {
+    public:
+        struct Backend
+        {
+            void* m_userData = nullptr;
+            DescriptorSetLayoutHandle (*m_createDescriptorSetLayout)(void* _userData, const DescriptorSetDesc& _desc, u32* _bindingIndices) = nullptr;
+            void (*m_destroyDescriptorSetLayout)(void* _userData, DescriptorSetLayoutHandle _layout) = nullptr;
+            PipelineLayoutHandle (*m_createPipelineLayout)(void* _userData, const PipelineLayoutDesc& _desc) = nullptr;
+            void (*m_destroyPipelineLayout)(void* _userData, PipelineLayoutHandle _layout) = nullptr;
+
+            [[nodiscard]] static Backend FromGraphicsContext(GraphicsContext* _graphicsContext);
+        };
+
+        struct EntryPointReference
+        {
+            const Blob* m_blob;
+            const Blob::EntryPointHeader* m_entryPoint;
+        };
+
+        struct DescriptorSetLayout
+        {
+            DescriptorSetLayoutHandle m_handle;
+
+            /// Merged bindings, sorted by binding index.
+            eastl::span<const DescriptorBindingDesc> m_bindings;
+
+            /// Backend indices of the bindings, to use in `DescriptorSetWriteInfo::m_index`.
+            eastl::span<const u32> m_bindingIndices;
+
+            /**
+             * @return The index to write the descriptor at, or `Blob::kInvalidIndex` if the set has no such binding.
+             */
+            [[nodiscard]] u32 FindWriteIndex(DescriptorBindingDesc::Type _type, u16 _bindingIndex) const;
+        };
+
+        struct PipelineLayout
+        {
+            PipelineLayoutHandle m_handle;
+            eastl::span<const DescriptorSetLayout* const> m_descriptorSets;
+            eastl::span<const PushConstantDesc> m_pushConstants;
+        };
+
+        struct Statistics
+        {
+            u32 m_descriptorSetLayoutRequests;
+            u32 m_reusedDescriptorSetLayouts;
+            u32 m_pipelineLayoutRequests;
+            u32 m_reusedPipelineLayouts;
+            u32 m_liveDescriptorSetLayouts;
+            u32 m_livePipelineLayouts;
+        };
+
+        LayoutCache(AllocatorInstance _allocator, const Backend& _backend);
+        ~LayoutCache();
+
+        LayoutCache(const LayoutCache&) = delete;
+        LayoutCache& operator=(const LayoutCache&) = delete;
+
+        /**
+         * @brief Returns the pipeline layout for a set of entry points, creating it if no identical layout exists.
+         *
+         * @details
+         * The returned layout stays valid until a matching `ReleasePipelineLayout()` call.
+         */
+        [[nodiscard]] const PipelineLayout* AcquirePipelineLayout(
+            eastl::span<const EntryPointReference> _entryPoints,
+            bool _useVertexLayout = true);
+
+        void ReleasePipelineLayout(const PipelineLayout* _layout);
+
+        [[nodiscard]] const Statistics& GetStatistics() const { return m_statistics; }
+
+        [[nodiscard]] static ShaderVisibility GetStageVisibility(ShaderStage::Stage _stage);
+
+        /**
+         * @brief Merges the bindings of a descriptor set over all the entry points using it.
+         */
+        static void MergeDescriptorSetBindings(
+            eastl::span<const EntryPointReference> _entryPoints,
+            u32 _setIndex,
+            eastl::vector<DescriptorBindingDesc>& _bindings);
+
+        static void MergePushConstants(
+            eastl::span<const EntryPointReference> _entryPoints,
+            eastl::vector<PushConstantDesc>& _pushConstants);
+
+    private:
+        struct DescriptorSetLayoutEntry: DescriptorSetLayout
+        {
+            u64 m_hash;
+            u32 m_refCount;
+            eastl::vector<DescriptorBindingDesc> m_bindingsStorage;
+            eastl::vector<u32> m_bindingIndicesStorage;
+        };
+
+        struct PipelineLayoutEntry: PipelineLayout
+        {
+            u64 m_hash;
+            u32 m_refCount;
+            bool m_useVertexLayout;
+            eastl::vector<const DescriptorSetLayout*> m_descriptorSetsStorage;
+            eastl::vector<PushConstantDesc> m_pushConstantsStorage;
+        };
+
+        AllocatorInstance m_allocator;
+        Backend m_backend;
+        eastl::hash_multimap<u64, DescriptorSetLayoutEntry*> m_descriptorSetLayouts;
+        eastl::hash_multimap<u64, PipelineLayoutEntry*> m_pipelineLayouts;
+        Statistics m_statistics {};
+
+        // Scratch storage, kept to avoid reallocating on each request
+        eastl::vector<DescriptorBindingDesc> m_bindings;
+        eastl::vector<PushConstantDesc> m_pushConstants;
+        eastl::vector<const DescriptorSetLayout*> m_descriptorSets;
+
+        const DescriptorSetLayout* AcquireDescriptorSetLayout(eastl::span<const DescriptorBindingDesc> _bindings);
+        void ReleaseDescriptorSetLayout(const DescriptorSetLayout* _layout);
+    };
+}
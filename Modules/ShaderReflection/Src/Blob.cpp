@@ -10,6 +10,54 @@
 
 namespace KryneEngine::Modules::ShaderReflection
 {
+    namespace
+    {
+        eastl::string_view TruncateName(const eastl::string_view _name)
+        {
+            return _name.substr(0, Blob::kMaxStringLength);
+        }
+
+        u64 HashName(const eastl::string_view _name)
+        {
+            return StringHash::Hash64(TruncateName(_name));
+        }
+
+        void InsertName(Blob::NameTableSlot* _table, const u32 _capacity, const u64 _hash, const u32 _index)
+        {
+            const u32 mask = _capacity - 1;
+            u32 slot = static_cast<u32>(_hash) & mask;
+            while (_table[slot].m_index != 0)
+                slot = (slot + 1) & mask;
+
+            _table[slot] = { static_cast<u32>(_hash >> 32), _index + 1 };
+        }
+
+        template <class Matches>
+        u32 FindName(const Blob::NameTableSlot* _table, const u32 _capacity, const u64 _hash, Matches&& _matches)
+        {
+            if (_capacity == 0)
+                return Blob::kInvalidIndex;
+
+            const u32 mask = _capacity - 1;
+            const u32 hashTag = static_cast<u32>(_hash >> 32);
+            for (u32 slot = static_cast<u32>(_hash) & mask;; slot = (slot + 1) & mask)
+            {
+                const Blob::NameTableSlot& entry = _table[slot];
+                if (entry.m_index == 0)
+                    return Blob::kInvalidIndex;
+
+                // Names are only compared on tag match, which should almost always be the actual match.
+                if (entry.m_hashTag == hashTag && _matches(entry.m_index - 1))
+                    return entry.m_index - 1;
+            }
+        }
+
+        size_t GetNameTableSize(const u32 _elementCount)
+        {
+            return Blob::GetNameTableCapacity(_elementCount) * sizeof(Blob::NameTableSlot);
+        }
+    }
+
     u32 Blob::GetEntryPointOffset(u32 _index) const
     {
         const u32* entryPointIndirectionTable = reinterpret_cast<const u32*>(this + 1);
@@ -21,9 +69,90 @@ namespace KryneEngine::Modules::ShaderReflection
         return reinterpret_cast<const EntryPointHeader*>(GetByteBuffer() + GetEntryPointOffset(_index));
     }
 
+    const Blob::DescriptorSetHeader* Blob::GetDescriptorSetHeader(const EntryPointHeader* _entryPoint, const u32 _index) const
+    {
+        const u32* descriptorSetIndirectionTable = reinterpret_cast<const u32*>(_entryPoint + 1);
+        return reinterpret_cast<const DescriptorSetHeader*>(GetByteBuffer() + descriptorSetIndirectionTable[_index]);
+    }
+
+    eastl::span<const Blob::DescriptorData> Blob::GetDescriptors(const DescriptorSetHeader* _descriptorSet) const
+    {
+        return { reinterpret_cast<const DescriptorData*>(_descriptorSet + 1), _descriptorSet->m_descriptorCount };
+    }
+
+    eastl::string_view Blob::GetString(const u32 _offset) const
+    {
+        const u8* string = reinterpret_cast<const u8*>(GetByteBuffer() + _offset);
+        return { reinterpret_cast<const char*>(string + 1), *string };
+    }
+
+    u32 Blob::FindEntryPointIndex(eastl::string_view _name) const
+    {
+        _name = TruncateName(_name);
+
+        const auto* table = reinterpret_cast<const NameTableSlot*>(
+            GetByteBuffer() + sizeof(Blob) + Alignment::AlignUp(GetEntryPointCount() * sizeof(u32), alignof(Blob)));
+
+        return FindName(
+            table,
+            GetNameTableCapacity(GetEntryPointCount()),
+            HashName(_name),
+            [&](const u32 _index) { return GetString(GetEntryPointHeader(_index)->m_nameOffset) == _name; });
+    }
+
+    const Blob::EntryPointHeader* Blob::FindEntryPoint(const eastl::string_view _name) const
+    {
+        const u32 index = FindEntryPointIndex(_name);
+        return index != kInvalidIndex ? GetEntryPointHeader(index) : nullptr;
+    }
+
+    const Blob::DescriptorSetHeader* Blob::FindDescriptorSet(
+        const EntryPointHeader* _entryPoint,
+        eastl::string_view _name) const
+    {
+        _name = TruncateName(_name);
+
+        const auto* table = reinterpret_cast<const NameTableSlot*>(
+            reinterpret_cast<const std::byte*>(_entryPoint + 1)
+            + Alignment::AlignUp(_entryPoint->m_descriptorSetCount * sizeof(u32), alignof(Blob)));
+
+        const u32 index = FindName(
+            table,
+            GetNameTableCapacity(_entryPoint->m_descriptorSetCount),
+            HashName(_name),
+            [&](const u32 _index) { return GetString(GetDescriptorSetHeader(_entryPoint, _index)->m_nameOffset) == _name; });
+        return index != kInvalidIndex ? GetDescriptorSetHeader(_entryPoint, index) : nullptr;
+    }
+
+    const Blob::DescriptorData* Blob::FindDescriptor(
+        const DescriptorSetHeader* _descriptorSet,
+        eastl::string_view _name) const
+    {
+        _name = TruncateName(_name);
+
+        const eastl::span<const DescriptorData> descriptors = GetDescriptors(_descriptorSet);
+        const auto* table = reinterpret_cast<const NameTableSlot*>(
+            reinterpret_cast<const std::byte*>(descriptors.data())
+            + Alignment::AlignUp(descriptors.size_bytes(), alignof(Blob)));
+
+        const u32 index = FindName(
+            table,
+            GetNameTableCapacity(descriptors.size()),
+            HashName(_name),
+            [&](const u32 _index) { return GetString(descriptors[_index].m_nameOffset) == _name; });
+        return index != kInvalidIndex ? &descriptors[index] : nullptr;
+    }
+
+    u32 Blob::GetNameTableCapacity(const u32 _elementCount)
+    {
+        // Keep the load factor at 1/2 at most, so probe sequences stay short.
+        return _elementCount > 0 ? static_cast<u32>(Alignment::NextPowerOfTwo(_elementCount * 2)) : 0;
+    }
+
     bool Blob::IsShaderReflectionBlob(const std::byte* _data)
     {
-        return *reinterpret_cast<const u32*>(_data) == kMagicNumber;
+        const auto* header = reinterpret_cast<const Header*>(_data);
+        return header->m_magic == kMagicNumber && header->m_version == kVersion;
     }
 
     Blob* Blob::CreateBlob(
@@ -42,8 +171,9 @@ namespace KryneEngine::Modules::ShaderReflection
             return eastl::min<u32>(_string.size(), kMaxStringLength) + 1u;
         };
 
-        // Count entry point indirection table
+        // Count entry point indirection table and name table
         estimatedPreStringTotal += Alignment::AlignUp(_entryPoints.size() * sizeof(u32), alignof(Blob));
+        estimatedPreStringTotal += GetNameTableSize(_entryPoints.size());
 
         for (const auto& entryPoint : _entryPoints)
         {
@@ -56,8 +186,9 @@ namespace KryneEngine::Modules::ShaderReflection
             // If applicable, save space for push constant name
             stringTotal += entryPoint.m_pushConstants.has_value() ? getStringSize(entryPoint.m_pushConstants->m_name) : 0;
 
-            // Count descriptor set indirection table
+            // Count descriptor set indirection table and name table
             estimatedPreStringTotal += Alignment::AlignUp(entryPoint.m_descriptorSets.size() * sizeof(u32), alignof(Blob));
+            estimatedPreStringTotal += GetNameTableSize(entryPoint.m_descriptorSets.size());
 
             for (const auto& descriptorSet : entryPoint.m_descriptorSets)
             {
@@ -65,6 +196,7 @@ namespace KryneEngine::Modules::ShaderReflection
                 stringTotal += getStringSize(descriptorSet.m_name);
 
                 estimatedPreStringTotal += Alignment::AlignUp(sizeof(DescriptorData) * descriptorSet.m_descriptors.size(), alignof(Blob));
+                estimatedPreStringTotal += GetNameTableSize(descriptorSet.m_descriptors.size());
 
                 for (const auto& descriptor : descriptorSet.m_descriptors)
                 {
@@ -105,15 +237,28 @@ namespace KryneEngine::Modules::ShaderReflection
         {
             u32* entryPointIndirectionIt = reinterpret_cast<u32*>(blob + 1);
 
-            dataIt = reinterpret_cast<std::byte*>(entryPointIndirectionIt) + Alignment::AlignUp(sizeof(u32) * _entryPoints.size(), alignof(Blob));
+            auto* entryPointNameTable = reinterpret_cast<NameTableSlot*>(
+                reinterpret_cast<std::byte*>(entryPointIndirectionIt) + Alignment::AlignUp(sizeof(u32) * _entryPoints.size(), alignof(Blob)));
+            const u32 entryPointNameTableCapacity = GetNameTableCapacity(_entryPoints.size());
+            memset(entryPointNameTable, 0, GetNameTableSize(_entryPoints.size()));
+
+            dataIt = reinterpret_cast<std::byte*>(entryPointNameTable) + GetNameTableSize(_entryPoints.size());
 
             for (const auto& entryPoint: _entryPoints)
             {
+                InsertName(
+                    entryPointNameTable,
+                    entryPointNameTableCapacity,
+                    HashName(entryPoint.m_name),
+                    static_cast<u32>(entryPointIndirectionIt - reinterpret_cast<u32*>(blob + 1)));
+
                 *entryPointIndirectionIt = dataIt - blob->GetByteBuffer();
                 entryPointIndirectionIt++;
 
                 auto* entryPointHeader = reinterpret_cast<EntryPointHeader*>(dataIt);
-                dataIt += sizeof(EntryPointHeader) + Alignment::AlignUp(sizeof(u32) * entryPoint.m_descriptorSets.size(), alignof(Blob));
+                dataIt += sizeof(EntryPointHeader)
+                    + Alignment::AlignUp(sizeof(u32) * entryPoint.m_descriptorSets.size(), alignof(Blob))
+                    + GetNameTableSize(entryPoint.m_descriptorSets.size());
 
                 entryPointHeader->m_nameHash = StringHash::Hash64(entryPoint.m_name);
                 entryPointHeader->m_nameOffset = registerName(entryPoint.m_name);
@@ -141,10 +286,23 @@ namespace KryneEngine::Modules::ShaderReflection
         for (auto entryPointIdx = 0u; entryPointIdx < blob->GetEntryPointCount(); entryPointIdx++)
         {
             const u32 entryPointOffset = blob->GetEntryPointOffset(entryPointIdx);
+            const eastl::span<const DescriptorSetInput> descriptorSets = _entryPoints[entryPointIdx].m_descriptorSets;
             auto* descriptorSetIndirectionIt = reinterpret_cast<u32*>(blob->GetByteBuffer() + entryPointOffset + sizeof(EntryPointHeader));
 
-            for (const auto& descriptorSet : _entryPoints[entryPointIdx].m_descriptorSets)
+            auto* descriptorSetNameTable = reinterpret_cast<NameTableSlot*>(
+                reinterpret_cast<std::byte*>(descriptorSetIndirectionIt) + Alignment::AlignUp(sizeof(u32) * descriptorSets.size(), alignof(Blob)));
+            memset(descriptorSetNameTable, 0, GetNameTableSize(descriptorSets.size()));
+
+            for (u32 descriptorSetIdx = 0; descriptorSetIdx < descriptorSets.size(); descriptorSetIdx++)
             {
+                const DescriptorSetInput& descriptorSet = descriptorSets[descriptorSetIdx];
+
+                InsertName(
+                    descriptorSetNameTable,
+                    GetNameTableCapacity(descriptorSets.size()),
+                    HashName(descriptorSet.m_name),
+                    descriptorSetIdx);
+
                 *descriptorSetIndirectionIt = dataIt - blob->GetByteBuffer();
                 descriptorSetIndirectionIt++;
 
@@ -158,8 +316,18 @@ namespace KryneEngine::Modules::ShaderReflection
                 auto* descriptorIt = reinterpret_cast<DescriptorData*>(dataIt);
                 dataIt += Alignment::AlignUp(sizeof(DescriptorData) * descriptorSet.m_descriptors.size(), alignof(Blob));
 
+                auto* descriptorNameTable = reinterpret_cast<NameTableSlot*>(dataIt);
+                dataIt += GetNameTableSize(descriptorSet.m_descriptors.size());
+                memset(descriptorNameTable, 0, GetNameTableSize(descriptorSet.m_descriptors.size()));
+
                 for (const auto& descriptor : descriptorSet.m_descriptors)
                 {
+                    InsertName(
+                        descriptorNameTable,
+                        GetNameTableCapacity(descriptorSet.m_descriptors.size()),
+                        HashName(descriptor.m_name),
+                        static_cast<u32>(descriptorIt - reinterpret_cast<DescriptorData*>(descriptorSetHeader + 1)));
+
                     descriptorIt->m_nameOffset = registerName(descriptor.m_name);
 
                     descriptorSetHeader->m_signatureHash = Hashing::Hash64Append(
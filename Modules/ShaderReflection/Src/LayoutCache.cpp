@@ -0,0 +1,401 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Modules/ShaderReflection/LayoutCache.hpp"
+
+#include <EASTL/algorithm.h>
+#include <EASTL/fixed_vector.h>
+#include <EASTL/sort.h>
+#include <KryneEngine/Core/Common/Assert.hpp>
+#include <KryneEngine/Core/Graphics/GraphicsContext.hpp>
+#include <KryneEngine/Core/Math/Hashing.hpp>
+#include <KryneEngine/Core/Profiling/TracyHeader.hpp>
+
+namespace KryneEngine::Modules::ShaderReflection
+{
+    namespace
+    {
+        // Hashed field by field, as the descriptions contain padding.
+        u64 HashBinding(const DescriptorBindingDesc& _binding, u64 _hash)
+        {
+            _hash = Hashing::Hash64Append(_binding.m_type, _hash);
+            _hash = Hashing::Hash64Append(_binding.m_visibility, _hash);
+            _hash = Hashing::Hash64Append(_binding.m_count, _hash);
+            _hash = Hashing::Hash64Append(_binding.m_bindingIndex, _hash);
+            return Hashing::Hash64Append(_binding.m_textureType, _hash);
+        }
+
+        u64 HashPushConstant(const PushConstantDesc& _pushConstant, u64 _hash)
+        {
+            _hash = Hashing::Hash64Append(_pushConstant.m_sizeInBytes, _hash);
+            _hash = Hashing::Hash64Append(_pushConstant.m_offset, _hash);
+            _hash = Hashing::Hash64Append(_pushConstant.m_index, _hash);
+            return Hashing::Hash64Append(_pushConstant.m_visibility, _hash);
+        }
+
+        bool AreSame(const eastl::span<const DescriptorBindingDesc> _a, const eastl::span<const DescriptorBindingDesc> _b)
+        {
+            return _a.size() == _b.size() && eastl::equal(
+                _a.begin(), _a.end(), _b.begin(),
+                [](const DescriptorBindingDesc& _x, const DescriptorBindingDesc& _y)
+                {
+                    return _x.m_type == _y.m_type
+                        && _x.m_visibility == _y.m_visibility
+                        && _x.m_count == _y.m_count
+                        && _x.m_bindingIndex == _y.m_bindingIndex
+                        && _x.m_textureType == _y.m_textureType;
+                });
+        }
+
+        bool AreSame(const eastl::span<const PushConstantDesc> _a, const eastl::span<const PushConstantDesc> _b)
+        {
+            return _a.size() == _b.size() && eastl::equal(
+                _a.begin(), _a.end(), _b.begin(),
+                [](const PushConstantDesc& _x, const PushConstantDesc& _y)
+                {
+                    return _x.m_sizeInBytes == _y.m_sizeInBytes
+                        && _x.m_offset == _y.m_offset
+                        && _x.m_index == _y.m_index
+                        && _x.m_visibility == _y.m_visibility;
+                });
+        }
+    }
+
+    LayoutCache::Backend LayoutCache::Backend::FromGraphicsContext(GraphicsContext* _graphicsContext)
+    {
+        return {
+            .m_userData = _graphicsContext,
+            .m_createDescriptorSetLayout = [](void* _userData, const DescriptorSetDesc& _desc, u32* _bindingIndices)
+            {
+                return static_cast<GraphicsContext*>(_userData)->CreateDescriptorSetLayout(_desc, _bindingIndices);
+            },
+            .m_destroyDescriptorSetLayout = [](void* _userData, const DescriptorSetLayoutHandle _layout)
+            {
+                static_cast<GraphicsContext*>(_userData)->DestroyDescriptorSetLayout(_layout);
+            },
+            .m_createPipelineLayout = [](void* _userData, const PipelineLayoutDesc& _desc)
+            {
+                return static_cast<GraphicsContext*>(_userData)->CreatePipelineLayout(_desc);
+            },
+            .m_destroyPipelineLayout = [](void* _userData, const PipelineLayoutHandle _layout)
+            {
+                static_cast<GraphicsContext*>(_userData)->DestroyPipelineLayout(_layout);
+            },
+        };
+    }
+
+    u32 LayoutCache::DescriptorSetLayout::FindWriteIndex(const DescriptorBindingDesc::Type _type, const u16 _bindingIndex) const
+    {
+        for (u32 i = 0; i < m_bindings.size(); i++)
+        {
+            if (m_bindings[i].m_type == _type && m_bindings[i].m_bindingIndex == _bindingIndex)
+                return m_bindingIndices[i];
+        }
+        return Blob::kInvalidIndex;
+    }
+
+    LayoutCache::LayoutCache(const AllocatorInstance _allocator, const Backend& _backend)
+        : m_allocator(_allocator)
+        , m_backend(_backend)
+        , m_descriptorSetLayouts(_allocator)
+        , m_pipelineLayouts(_allocator)
+        , m_bindings(_allocator)
+        , m_pushConstants(_allocator)
+        , m_descriptorSets(_allocator)
+    {}
+
+    LayoutCache::~LayoutCache()
+    {
+        KE_ASSERT_MSG(m_pipelineLayouts.empty(), "Some pipeline layouts were not released");
+
+        for (const auto& [hash, entry]: m_pipelineLayouts)
+        {
+            m_backend.m_destroyPipelineLayout(m_backend.m_userData, entry->m_handle);
+            m_allocator.Delete(entry);
+        }
+        for (const auto& [hash, entry]: m_descriptorSetLayouts)
+        {
+            m_backend.m_destroyDescriptorSetLayout(m_backend.m_userData, entry->m_handle);
+            m_allocator.Delete(entry);
+        }
+    }
+
+    const LayoutCache::PipelineLayout* LayoutCache::AcquirePipelineLayout(
+        const eastl::span<const EntryPointReference> _entryPoints,
+        const bool _useVertexLayout)
+    {
+        KE_ZoneScopedFunction("LayoutCache::AcquirePipelineLayout");
+
+        m_statistics.m_pipelineLayoutRequests++;
+
+        u32 setCount = 0;
+        for (const EntryPointReference& reference: _entryPoints)
+            setCount = eastl::max<u32>(setCount, reference.m_entryPoint->m_descriptorSetCount);
+
+        // Descriptor set layouts are shared, so the pipeline layout can be keyed on their addresses.
+        m_descriptorSets.clear();
+        u64 hash = Hashing::Hash64Append(_useVertexLayout, Hashing::Hash64(setCount));
+        for (u32 setIndex = 0; setIndex < setCount; setIndex++)
+        {
+            MergeDescriptorSetBindings(_entryPoints, setIndex, m_bindings);
+            const DescriptorSetLayout* setLayout = AcquireDescriptorSetLayout(m_bindings);
+            m_descriptorSets.push_back(setLayout);
+            hash = Hashing::Hash64Append(reinterpret_cast<uintptr_t>(setLayout), hash);
+        }
+
+        MergePushConstants(_entryPoints, m_pushConstants);
+        for (const PushConstantDesc& pushConstant: m_pushConstants)
+            hash = HashPushConstant(pushConstant, hash);
+
+        const auto range = m_pipelineLayouts.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            PipelineLayoutEntry* entry = it->second;
+            if (entry->m_useVertexLayout == _useVertexLayout
+                && m_descriptorSets == entry->m_descriptorSetsStorage
+                && AreSame(m_pushConstants, entry->m_pushConstantsStorage))
+            {
+                // The entry already holds a reference to each of its descriptor set layouts.
+                for (const DescriptorSetLayout* setLayout: m_descriptorSets)
+                    ReleaseDescriptorSetLayout(setLayout);
+
+                entry->m_refCount++;
+                m_statistics.m_reusedPipelineLayouts++;
+                return entry;
+            }
+        }
+
+        auto* entry = m_allocator.New<PipelineLayoutEntry>();
+        entry->m_hash = hash;
+        entry->m_refCount = 1;
+        entry->m_useVertexLayout = _useVertexLayout;
+        entry->m_descriptorSetsStorage.set_allocator(m_allocator);
+        entry->m_descriptorSetsStorage.assign(m_descriptorSets.begin(), m_descriptorSets.end());
+        entry->m_pushConstantsStorage.set_allocator(m_allocator);
+        entry->m_pushConstantsStorage.assign(m_pushConstants.begin(), m_pushConstants.end());
+        entry->m_descriptorSets = entry->m_descriptorSetsStorage;
+        entry->m_pushConstants = entry->m_pushConstantsStorage;
+
+        eastl::fixed_vector<DescriptorSetLayoutHandle, 8> handles;
+        for (const DescriptorSetLayout* setLayout: m_descriptorSets)
+            handles.push_back(setLayout->m_handle);
+
+        entry->m_handle = m_backend.m_createPipelineLayout(
+            m_backend.m_userData,
+            {
+                .m_descriptorSets = handles,
+                .m_pushConstants = entry->m_pushConstantsStorage,
+                .m_useVertexLayout = _useVertexLayout,
+            });
+
+        m_pipelineLayouts.emplace(hash, entry);
+        m_statistics.m_livePipelineLayouts++;
+        return entry;
+    }
+
+    void LayoutCache::ReleasePipelineLayout(const PipelineLayout* _layout)
+    {
+        VERIFY_OR_RETURN_VOID(_layout != nullptr);
+
+        auto* entry = const_cast<PipelineLayoutEntry*>(static_cast<const PipelineLayoutEntry*>(_layout));
+        KE_ASSERT(entry->m_refCount > 0);
+        if (--entry->m_refCount > 0)
+            return;
+
+        const auto range = m_pipelineLayouts.equal_range(entry->m_hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second == entry)
+            {
+                m_pipelineLayouts.erase(it);
+                break;
+            }
+        }
+        m_statistics.m_livePipelineLayouts--;
+
+        m_backend.m_destroyPipelineLayout(m_backend.m_userData, entry->m_handle);
+        for (const DescriptorSetLayout* setLayout: entry->m_descriptorSetsStorage)
+            ReleaseDescriptorSetLayout(setLayout);
+        m_allocator.Delete(entry);
+    }
+
+    ShaderVisibility LayoutCache::GetStageVisibility(const ShaderStage::Stage _stage)
+    {
+        switch (_stage)
+        {
+        case ShaderStage::Stage::Vertex:
+            return ShaderVisibility::Vertex;
+        case ShaderStage::Stage::TesselationControl:
+            return ShaderVisibility::TesselationControl;
+        case ShaderStage::Stage::TesselationEvaluation:
+            return ShaderVisibility::TesselationEvaluation;
+        case ShaderStage::Stage::Geometry:
+            return ShaderVisibility::Geometry;
+        case ShaderStage::Stage::Fragment:
+            return ShaderVisibility::Fragment;
+        case ShaderStage::Stage::Compute:
+            return ShaderVisibility::Compute;
+        case ShaderStage::Stage::Mesh:
+            return ShaderVisibility::Mesh;
+        case ShaderStage::Stage::Task:
+            return ShaderVisibility::Task;
+        }
+        return ShaderVisibility::None;
+    }
+
+    void LayoutCache::MergeDescriptorSetBindings(
+        const eastl::span<const EntryPointReference> _entryPoints,
+        const u32 _setIndex,
+        eastl::vector<DescriptorBindingDesc>& _bindings)
+    {
+        _bindings.clear();
+
+        for (const EntryPointReference& reference: _entryPoints)
+        {
+            if (_setIndex >= reference.m_entryPoint->m_descriptorSetCount)
+                continue;
+
+            const ShaderVisibility visibility = GetStageVisibility(static_cast<ShaderStage::Stage>(reference.m_entryPoint->m_stage));
+            const Blob::DescriptorSetHeader* descriptorSet = reference.m_blob->GetDescriptorSetHeader(reference.m_entryPoint, _setIndex);
+
+            for (const Blob::DescriptorData& descriptor: reference.m_blob->GetDescriptors(descriptorSet))
+            {
+                auto it = eastl::find_if(
+                    _bindings.begin(),
+                    _bindings.end(),
+                    [&descriptor](const DescriptorBindingDesc& _binding)
+                    {
+                        return _binding.m_type == descriptor.m_type && _binding.m_bindingIndex == descriptor.m_bindingIndex;
+                    });
+
+                if (it == _bindings.end())
+                {
+                    _bindings.push_back({
+                        .m_type = descriptor.m_type,
+                        .m_visibility = visibility,
+                        .m_count = descriptor.m_count,
+                        .m_bindingIndex = descriptor.m_bindingIndex,
+                        .m_textureType = descriptor.m_textureType,
+                    });
+                    continue;
+                }
+
+                KE_ASSERT_MSG(
+                    it->m_count == descriptor.m_count && it->m_textureType == descriptor.m_textureType,
+                    "Binding %u of set %u is declared differently between stages",
+                    descriptor.m_bindingIndex,
+                    _setIndex);
+                it->m_visibility |= visibility;
+            }
+        }
+
+        // Keep a deterministic order, whatever the stage order is, so identical layouts hash the same.
+        eastl::sort(
+            _bindings.begin(),
+            _bindings.end(),
+            [](const DescriptorBindingDesc& _a, const DescriptorBindingDesc& _b)
+            {
+                return _a.m_bindingIndex != _b.m_bindingIndex
+                    ? _a.m_bindingIndex < _b.m_bindingIndex
+                    : _a.m_type < _b.m_type;
+            });
+    }
+
+    void LayoutCache::MergePushConstants(
+        const eastl::span<const EntryPointReference> _entryPoints,
+        eastl::vector<PushConstantDesc>& _pushConstants)
+    {
+        _pushConstants.clear();
+
+        eastl::fixed_vector<u64, 4> signatures;
+        for (const EntryPointReference& reference: _entryPoints)
+        {
+            const Blob::EntryPointHeader* entryPoint = reference.m_entryPoint;
+            if (entryPoint->m_pushConstantsByteSize == 0)
+                continue;
+
+            const ShaderVisibility visibility = GetStageVisibility(static_cast<ShaderStage::Stage>(entryPoint->m_stage));
+
+            const auto it = eastl::find(signatures.begin(), signatures.end(), entryPoint->m_pushConstantsSignatureHash);
+            if (it != signatures.end())
+            {
+                _pushConstants[it - signatures.begin()].m_visibility |= visibility;
+                continue;
+            }
+
+            KE_ASSERT_MSG(entryPoint->m_pushConstantsByteSize <= 0xFF, "Push constants are limited to 255 bytes");
+            signatures.push_back(entryPoint->m_pushConstantsSignatureHash);
+            _pushConstants.push_back({
+                .m_sizeInBytes = static_cast<u8>(entryPoint->m_pushConstantsByteSize),
+                .m_index = static_cast<u8>(_pushConstants.size()),
+                .m_visibility = visibility,
+            });
+        }
+    }
+
+    const LayoutCache::DescriptorSetLayout* LayoutCache::AcquireDescriptorSetLayout(
+        const eastl::span<const DescriptorBindingDesc> _bindings)
+    {
+        m_statistics.m_descriptorSetLayoutRequests++;
+
+        u64 hash = Hashing::Hash64(_bindings.size());
+        for (const DescriptorBindingDesc& binding: _bindings)
+            hash = HashBinding(binding, hash);
+
+        const auto range = m_descriptorSetLayouts.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            DescriptorSetLayoutEntry* entry = it->second;
+            if (AreSame(_bindings, entry->m_bindingsStorage))
+            {
+                entry->m_refCount++;
+                m_statistics.m_reusedDescriptorSetLayouts++;
+                return entry;
+            }
+        }
+
+        auto* entry = m_allocator.New<DescriptorSetLayoutEntry>();
+        entry->m_hash = hash;
+        entry->m_refCount = 1;
+        entry->m_bindingsStorage.set_allocator(m_allocator);
+        entry->m_bindingsStorage.assign(_bindings.begin(), _bindings.end());
+        entry->m_bindingIndicesStorage.set_allocator(m_allocator);
+        entry->m_bindingIndicesStorage.resize(_bindings.size());
+        entry->m_bindings = entry->m_bindingsStorage;
+        entry->m_bindingIndices = entry->m_bindingIndicesStorage;
+
+        entry->m_handle = m_backend.m_createDescriptorSetLayout(
+            m_backend.m_userData,
+            { .m_bindings = entry->m_bindingsStorage },
+            entry->m_bindingIndicesStorage.data());
+
+        m_descriptorSetLayouts.emplace(hash, entry);
+        m_statistics.m_liveDescriptorSetLayouts++;
+        return entry;
+    }
+
+    void LayoutCache::ReleaseDescriptorSetLayout(const DescriptorSetLayout* _layout)
+    {
+        auto* entry = const_cast<DescriptorSetLayoutEntry*>(static_cast<const DescriptorSetLayoutEntry*>(_layout));
+        KE_ASSERT(entry->m_refCount > 0);
+        if (--entry->m_refCount > 0)
+            return;
+
+        const auto range = m_descriptorSetLayouts.equal_range(entry->m_hash);
+        for (auto it = range.first; it != range.second; ++it)
+        {
+            if (it->second == entry)
+            {
+                m_descriptorSetLayouts.erase(it);
+                break;
+            }
+        }
+        m_statistics.m_liveDescriptorSetLayouts--;
+
+        m_backend.m_destroyDescriptorSetLayout(m_backend.m_userData, entry->m_handle);
+        m_allocator.Delete(entry);
+    }
+}
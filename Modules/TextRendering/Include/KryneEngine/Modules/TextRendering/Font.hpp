@@ -23,6 +23,7 @@ namespace KryneEngine::Modules::TextRendering
     class Font final: public Resources::ResourceBase<FontManager>
     {
         friend FontManager;
+        friend class FontBaker;
 
     public:
         ~Font() override;
@@ -36,6 +37,16 @@ namespace KryneEngine::Modules::TextRendering
         float GetHorizontalAdvance(u32 _unicodeCodepoint, float _fontSize);
         GlyphLayoutMetrics GetGlyphLayoutMetrics(u32 _unicodeCodepoint, float _fontSize);
 
+        /**
+         * @brief Returns the horizontal kerning adjustment to apply between two consecutive codepoints.
+         *
+         * @details
+         * Kerning is only looked up in this font file, as pairs spanning different fallback fonts have no meaningful
+         * kerning value. Returns 0 when the font doesn't provide any kerning for the pair.
+         */
+        float GetKerning(u32 _leftCodepoint, u32 _rightCodepoint, float _fontSize);
+        [[nodiscard]] bool HasKerning() const;
+
         GlyphMsdfBitmap GetMsdf(u32 _unicodeCodepoint, u16 _fontSize, AllocatorInstance _allocator);
 
         void SetFallbackFont(const Font* _fallbackFont) { m_fallbackFontId = _fallbackFont->GetId(); }
@@ -48,6 +59,11 @@ namespace KryneEngine::Modules::TextRendering
 
         [[nodiscard]] u16 GetId() const { return m_fontId; }
 
+        /**
+         * @brief A hash of the font file content, stable across runs.
+         */
+        [[nodiscard]] u64 GetContentHash() const { return m_contentHash; }
+
     private:
         explicit Font(AllocatorInstance _allocator, FontManager* _fontManager, size_t _version);
 
@@ -61,6 +77,7 @@ namespace KryneEngine::Modules::TextRendering
         static constexpr u32 kNoFallback = 0x20000;
 
         u16 m_fontId = 0;
+        u64 m_contentHash = 0;
         FontFileType m_fileType = FontFileType::Freetype;
         union
         {
@@ -0,0 +1,74 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <EASTL/span.h>
+#include <KryneEngine/Core/Common/Types.hpp>
+#include <KryneEngine/Core/Memory/Allocators/Allocator.hpp>
+
+#include "KryneEngine/Modules/TextRendering/FontFiles/PreBakedFontFile.hpp"
+
+namespace KryneEngine::Modules::TextRendering
+{
+    class Font;
+
+    /**
+     * @brief Converts a loaded Freetype font into the pre-baked font format.
+     *
+     * @details
+     * All baking is performed on the CPU, so it can run headlessly (e.g. in an offline asset pipeline).
+     */
+    class FontBaker
+    {
+    public:
+        struct CodepointRange
+        {
+            u32 m_first;
+            u32 m_last; // Inclusive
+        };
+
+        struct Settings
+        {
+            eastl::span<const CodepointRange> m_ranges {};
+            PreBakedFontFile::BakedRenderInfo m_renderInfo =
+                PreBakedFontFile::BakedRenderInfo::Msdf | PreBakedFontFile::BakedRenderInfo::Outlines;
+            u16 m_msdfFontSize = 32;
+            bool m_kerning = true;
+            bool m_compressed = true;
+            s32 m_compressionLevel = PreBakedFontFile::kDefaultCompressionLevel;
+            size_t m_dictionaryCapacity = PreBakedFontFile::kDefaultDictionaryCapacity;
+        };
+
+        struct Statistics
+        {
+            u32 m_requestedCodepoints = 0;
+            u32 m_bakedGlyphs = 0;
+            u32 m_kerningPairs = 0;
+            u64 m_msdfBytes = 0;
+            u64 m_outlineBytes = 0;
+            u64 m_uncompressedSize = 0;
+            u64 m_bakedSize = 0;
+            u64 m_glyphGatherDuration = 0; // In nanoseconds
+            u64 m_kerningDuration = 0; // In nanoseconds
+            u64 m_msdfDuration = 0; // In nanoseconds
+            u64 m_bakeDuration = 0; // In nanoseconds
+        };
+
+        /**
+         * @brief Bakes the codepoints of the settings ranges that are present in the font.
+         *
+         * @param _font A font loaded from a Freetype compatible file (TTF, OTF...).
+         * @param _statistics Optional output statistics.
+         * @return The baked file data, allocated with `_allocator`. Empty on failure.
+         */
+        static eastl::span<std::byte> Bake(
+            Font* _font,
+            const Settings& _settings,
+            AllocatorInstance _allocator,
+            Statistics* _statistics = nullptr);
+    };
+}
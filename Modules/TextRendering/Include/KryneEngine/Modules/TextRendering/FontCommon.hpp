@@ -29,6 +29,16 @@ namespace KryneEngine::Modules::TextRendering
         float m_height;
     };
 
+    /**
+     * @brief A horizontal kerning adjustment between two codepoints, normalized to the em size.
+     */
+    struct KerningPair
+    {
+        u32 m_left;
+        u32 m_right;
+        float m_offsetX;
+    };
+
     struct GlyphShape
     {
         float2* m_points = nullptr;
@@ -45,4 +55,15 @@ namespace KryneEngine::Modules::TextRendering
         u16 m_baseLine = 0;
         bool m_allocated = true;
     };
+
+    /**
+     * @brief A single channel, 8-bit coverage bitmap, rasterized for a given pixel size.
+     */
+    struct GlyphCoverageBitmap
+    {
+        eastl::span<std::byte> m_bitmap {};
+        u16 m_width = 0;
+        u16 m_height = 0;
+        u16 m_baseLine = 0;
+    };
 }
\ No newline at end of file
@@ -33,6 +33,21 @@ namespace KryneEngine::Modules::TextRendering
 
         eastl::optional<GlyphLayoutMetrics> GetGlyphLayoutMetrics(u32 _unicodeCodepoint, float _fontSize);
 
+        [[nodiscard]] bool HasKerning() const;
+        float GetKerning(u32 _leftCodepoint, u32 _rightCodepoint, float _fontSize);
+
+        /**
+         * @brief Appends the non-zero kerning pairs between the given codepoints, normalized to the em size.
+         *
+         * @details
+         * Reads the font `kern` table, the one `FT_Get_Kerning` looks pairs up in, in a single pass over its entries.
+         * This avoids querying FreeType for every codepoint pair.
+         */
+        void GatherKerningPairs(
+            eastl::span<const u32> _codepoints,
+            eastl::vector<KerningPair>& _outPairs,
+            AllocatorInstance _allocator);
+
         bool HasOutline(u32 _unicodeCodepoint) const;
 
         GlyphShape AcquireGlyphShape(u32 _unicodeCodepoint);
@@ -42,6 +42,7 @@ namespace KryneEngine::Modules::TextRendering
      * The layout looks like this:
      * - header
      * - general glyph data table
+     * - kerning pairs table (if applicable), sorted by left then right codepoint
      * - indexing tables
      *   - MSDF entries table (if applicable)
      *   - outline entries table (if applicable)
@@ -84,6 +85,8 @@ namespace KryneEngine::Modules::TextRendering
             float m_height;
         };
 
+        using KerningPair = TextRendering::KerningPair;
+
         struct GlyphBakeInfo
         {
             GlyphEntry m_glyph;
@@ -110,6 +113,9 @@ namespace KryneEngine::Modules::TextRendering
 
         [[nodiscard]] eastl::optional<u32> GetGlyphIndex(u32 _unicodeCodepoint) const;
 
+        [[nodiscard]] bool HasKerning() const { return m_header.m_kerningPairCount > 0; }
+        [[nodiscard]] float GetKerning(u32 _leftCodepoint, u32 _rightCodepoint, float _fontSize) const;
+
         [[nodiscard]] bool HasMsdfBitmaps() const;
         [[nodiscard]] bool HasOutlines() const;
 
@@ -124,17 +130,31 @@ namespace KryneEngine::Modules::TextRendering
             BakedRenderInfo _renderInfo,
             FontMetrics _fontMetrics,
             eastl::span<const GlyphBakeInfo> _glyphs,
+            eastl::span<const KerningPair> _kerningPairs,
             eastl::span<float2> _outlinePoints,
             eastl::span<OutlineTag> _outlineTags,
             AllocatorInstance _allocator);
 
+        /**
+         * @brief Bakes the font with zstd compressed tables and data blobs.
+         *
+         * @details
+         * Data blobs are compressed using a zstd dictionary trained on the blobs themselves, with a capacity of
+         * `_dictionaryCapacity` bytes.
+         */
         static eastl::span<std::byte> BakeCompressed(
             BakedRenderInfo _renderInfo,
             FontMetrics _fontMetrics,
             eastl::span<const GlyphBakeInfo> _glyphs,
+            eastl::span<const KerningPair> _kerningPairs,
             eastl::span<float2> _outlinePoints,
             eastl::span<OutlineTag> _outlineTags,
-            AllocatorInstance _allocator);
+            AllocatorInstance _allocator,
+            s32 _compressionLevel = kDefaultCompressionLevel,
+            size_t _dictionaryCapacity = kDefaultDictionaryCapacity);
+
+        static constexpr s32 kDefaultCompressionLevel = 0;
+        static constexpr size_t kDefaultDictionaryCapacity = 64 << 10;
 
     private:
         struct Header
@@ -147,6 +167,7 @@ namespace KryneEngine::Modules::TextRendering
                 BakedRenderInfo m_renderInfo : 31;
             } m_options;
             u32 m_glyphCount;
+            u32 m_kerningPairCount;
         };
 
         struct MsdfEntry
@@ -164,10 +185,12 @@ namespace KryneEngine::Modules::TextRendering
             u32 m_tagsCount;
         };
 
-        static constexpr u64 kMagicNumber = Hashing::Hash64Static("PreBakedFontFile");
+        // Bumped with the header layout, so files baked with an older layout are rejected instead of misread.
+        static constexpr u64 kMagicNumber = Hashing::Hash64Static("PreBakedFontFileV2");
 
         Header m_header {};
         GlyphEntry* m_glyphs = nullptr;
+        KerningPair* m_kerningPairs = nullptr;
         MsdfEntry* m_msdfEntries = nullptr;
         OutlineEntry* m_outlineEntries = nullptr;
         eastl::span<std::byte> m_data {};
@@ -176,6 +199,8 @@ namespace KryneEngine::Modules::TextRendering
         ZSTD_DDict_s* m_dict = nullptr;
 
         [[nodiscard]] GlyphEntry* FindGlyphEntry(u32 _codePoint) const;
+
+        static void SortKerningPairs(eastl::span<KerningPair> _kerningPairs);
     };
 
     KE_ENUM_IMPLEMENT_BITWISE_OPERATORS(PreBakedFontFile::BakedRenderInfo);
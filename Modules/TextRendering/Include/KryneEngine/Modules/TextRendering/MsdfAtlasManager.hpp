@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <EASTL/span.h>
+#include <EASTL/vector.h>
 #include <EASTL/vector_map.h>
 #include <KryneEngine/Core/Graphics/GraphicsContext.hpp>
 #include <KryneEngine/Core/Graphics/Handles.hpp>
@@ -15,10 +17,13 @@
 #include <KryneEngine/Modules/GraphicsUtils/Allocators/AtlasShelfAllocator.hpp>
 #include <moodycamel/concurrentqueue.h>
 
+#include "KryneEngine/Modules/TextRendering/FontCommon.hpp"
+
 namespace KryneEngine::Modules::TextRendering
 {
     class Font;
     class FontManager;
+    class MsdfGlyphDiskCache;
 
     class MsdfAtlasManager
     {
@@ -46,8 +51,67 @@ namespace KryneEngine::Modules::TextRendering
 
         GlyphRegion GetGlyphRegion(Font* _font, u32 _unicodeCodepoint, u32 _fontSize = 0);
 
+        /**
+         * @brief Returns the region of a coverage bitmap, pre-rasterized for the given pixel size.
+         *
+         * @details
+         * The coverage is stored in the alpha channel of the atlas, and is meant to be sampled 1:1 in screen space, with
+         * no distance field evaluation. It is rasterized once from the glyph MSDF at `_sourceFontSize`, then cached for
+         * each pixel size. Valid coverage regions report a pixel range of 1, the width of their anti-aliased edge.
+         */
+        GlyphRegion GetCoverageGlyphRegion(Font* _font, u32 _unicodeCodepoint, u32 _pixelSize, u32 _sourceFontSize);
+
+        /**
+         * @brief Rasterizes the coverage of a glyph from its MSDF bitmap, scaled by `_scale`.
+         *
+         * @details
+         * Each output pixel evaluates the MSDF at its center, the same way the MSDF text shader would at that scale.
+         */
+        [[nodiscard]] static GlyphCoverageBitmap RasterizeCoverage(
+            const GlyphMsdfBitmap& _msdf,
+            float _scale,
+            AllocatorInstance _allocator);
+
+        /**
+         * @brief Uploads the pending glyph bitmaps to the atlas.
+         *
+         * @details
+         * All the glyphs of the flush are packed in a single staging allocation and uploaded with a single multi-region
+         * copy. If an upload budget is set, glyphs past the budget are deferred to the next flush.
+         *
+         * With an upload budget, glyph regions are only returned as valid once their upload was recorded, so glyphs
+         * are never drawn from texels that weren't uploaded yet. Without one, every queued glyph is uploaded by the next
+         * flush, and their regions are valid right away.
+         */
         void FlushLoads(GraphicsContext& _graphicsContext, CommandListHandle _transfer);
 
+        struct UploadStatistics
+        {
+            u64 m_uploadedBytes = 0;
+            u32 m_uploadedGlyphs = 0;
+            u32 m_copyCount = 0;
+            u32 m_deferredGlyphs = 0;
+        };
+
+        /**
+         * @brief Sets the maximum staging bytes uploaded per flush. 0 means unlimited.
+         */
+        void SetUploadBudget(u64 _bytesPerFlush) { m_uploadBudget = _bytesPerFlush; }
+        [[nodiscard]] u64 GetUploadBudget() const { return m_uploadBudget; }
+
+        [[nodiscard]] const UploadStatistics& GetLastUploadStatistics() const { return m_lastUploadStatistics; }
+
+        /**
+         * @brief Returns how many of the queued uploads fit in the budget, in order. At least one is always selected.
+         */
+        [[nodiscard]] static size_t SelectUploadBatch(eastl::span<const u64> _uploadSizes, u64 _uploadBudget);
+
+        /**
+         * @brief Sets an optional persistent cache, consulted before generating glyph MSDF bitmaps.
+         */
+        void SetDiskCache(MsdfGlyphDiskCache* _diskCache) { m_diskCache = _diskCache; }
+        [[nodiscard]] MsdfGlyphDiskCache* GetDiskCache() const { return m_diskCache; }
+
         FontManager* GetFontManager() const { return m_fontManager; }
 
         TextureViewHandle GetAtlasView() const { return m_atlasView; }
@@ -67,15 +131,22 @@ namespace KryneEngine::Modules::TextRendering
         {
             Font* m_font;
             u32 m_unicodeCodepoint;
+            u32 m_coverageSize = 0; // 0 for MSDF glyphs
 
             bool operator==(const GlyphKey& _other) const noexcept
             {
-                return m_font == _other.m_font && m_unicodeCodepoint == _other.m_unicodeCodepoint;
+                return m_font == _other.m_font
+                    && m_unicodeCodepoint == _other.m_unicodeCodepoint
+                    && m_coverageSize == _other.m_coverageSize;
             }
 
             bool operator<(const GlyphKey& _other) const noexcept
             {
-                return m_font < _other.m_font || (m_font == _other.m_font && m_unicodeCodepoint < _other.m_unicodeCodepoint);
+                if (m_font != _other.m_font)
+                    return m_font < _other.m_font;
+                if (m_unicodeCodepoint != _other.m_unicodeCodepoint)
+                    return m_unicodeCodepoint < _other.m_unicodeCodepoint;
+                return m_coverageSize < _other.m_coverageSize;
             }
         };
 
@@ -88,18 +159,22 @@ namespace KryneEngine::Modules::TextRendering
             u16 m_baseline = 0;
             u16 m_fontSize = 0;
             u32 m_allocatorSlot = 0;
+            bool m_uploaded = false;
         };
 
         struct GlyphLoadRequest
         {
+            GlyphKey m_key {};
             GlyphSlot m_slot {};
             Rect m_dstRegion {};
             std::byte* m_buffer = nullptr;
             bool m_shouldDeallocate = true;
+            bool m_coverage = false;
         };
 
         AllocatorInstance m_allocator;
         FontManager* m_fontManager;
+        MsdfGlyphDiskCache* m_diskCache = nullptr;
         GraphicsUtils::AtlasShelfAllocator m_atlasAllocator;
         DynamicArray<StagingBuffer> m_stagingBuffers;
         TextureHandle m_atlasTexture {};
@@ -109,6 +184,21 @@ namespace KryneEngine::Modules::TextRendering
         SpinLock m_lock {};
         eastl::vector_map<GlyphKey, GlyphSlot> m_glyphSlotMap;
         moodycamel::ConcurrentQueue<GlyphLoadRequest> m_loadQueue;
+        eastl::vector<GlyphLoadRequest> m_pendingRequests;
+        u64 m_uploadBudget = 0;
+        UploadStatistics m_lastUploadStatistics {};
         TextureViewHandle m_atlasView {};
+
+        [[nodiscard]] GlyphMsdfBitmap AcquireMsdf(Font* _font, u32 _unicodeCodepoint, u32 _fontSize, u16 _pxRange);
+
+        GlyphSlot AllocateSlot(
+            const GlyphKey& _key,
+            u16 _width,
+            u16 _height,
+            u16 _baseline,
+            u16 _fontSize,
+            std::byte* _buffer,
+            bool _shouldDeallocate,
+            bool _coverage);
     };
 }
@@ -0,0 +1,113 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <EASTL/string.h>
+#include <EASTL/vector_map.h>
+#include <KryneEngine/Core/Common/Types.hpp>
+#include <KryneEngine/Core/Memory/Allocators/Allocator.hpp>
+#include <KryneEngine/Core/Threads/LightweightMutex.hpp>
+
+#include "KryneEngine/Modules/TextRendering/FontCommon.hpp"
+
+namespace KryneEngine::Modules::TextRendering
+{
+    /**
+     * @brief A persistent on-disk cache of generated MSDF glyph bitmaps.
+     *
+     * @details
+     * MSDF generation is deterministic for a given font file, codepoint, font size and pixel range, so generated bitmaps
+     * can be reused across runs. Each glyph is stored as its own zstd compressed file inside the cache directory.
+     *
+     * The cache is bounded in size. When the bound is exceeded, the least recently used entries are removed. Recency is
+     * persisted through the file modification times, so it survives across runs.
+     */
+    class MsdfGlyphDiskCache
+    {
+    public:
+        struct Key
+        {
+            u64 m_fontContentHash;
+            u32 m_codepoint;
+            u16 m_fontSize;
+            u16 m_pxRange;
+        };
+
+        MsdfGlyphDiskCache(AllocatorInstance _allocator, eastl::string_view _directory, u64 _maxSize);
+
+        /**
+         * @brief Retrieves a cached bitmap.
+         *
+         * @return The bitmap allocated with `_allocator`, or an empty bitmap if the glyph is not in the cache.
+         */
+        [[nodiscard]] GlyphMsdfBitmap Load(const Key& _key, AllocatorInstance _allocator);
+
+        /**
+         * @param _generationDuration The time it took to generate the bitmap, in nanoseconds. Used to estimate the time
+         * saved by later cache hits.
+         */
+        void Store(const Key& _key, const GlyphMsdfBitmap& _bitmap, u64 _generationDuration);
+
+        /**
+         * @brief Removes the least recently used entries until the cache fits in `_maxSize` bytes.
+         */
+        void Trim(u64 _maxSize);
+
+        struct Statistics
+        {
+            u64 m_hits = 0;
+            u64 m_misses = 0;
+            u64 m_stores = 0;
+            u64 m_evictions = 0;
+            u64 m_loadDuration = 0; // In nanoseconds
+            u64 m_savedDuration = 0; // Estimated generation time avoided by hits, in nanoseconds
+        };
+
+        [[nodiscard]] Statistics GetStatistics();
+        [[nodiscard]] u64 GetTotalSize();
+        [[nodiscard]] size_t GetEntryCount();
+
+        [[nodiscard]] static u64 HashKey(const Key& _key);
+
+    private:
+        struct Entry
+        {
+            u64 m_size;
+            u64 m_lastAccess;
+        };
+
+        struct FileHeader
+        {
+            u32 m_magicNumber;
+            u32 m_version;
+            Key m_key;
+            u64 m_generationDuration;
+            u32 m_bitmapSize;
+            u32 m_compressedSize;
+            u16 m_width;
+            u16 m_height;
+            u16 m_baseLine;
+            u16 m_bakedFontSize;
+        };
+
+        static constexpr u32 kMagicNumber = 0x4644534d; // 'MSDF'
+        static constexpr u32 kVersion = 1;
+        static constexpr const char* kExtension = ".ke_msdf";
+
+        AllocatorInstance m_allocator;
+        eastl::string m_directory;
+        u64 m_maxSize;
+        u64 m_totalSize = 0;
+        u64 m_accessCounter = 0;
+        eastl::vector_map<u64, Entry> m_entries;
+        Statistics m_statistics {};
+        LightweightMutex m_mutex {};
+
+        [[nodiscard]] eastl::string GetEntryPath(u64 _hash) const;
+        void TrimLocked(u64 _maxSize);
+    };
+}
@@ -0,0 +1,108 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <EASTL/span.h>
+#include <EASTL/string_view.h>
+#include <KryneEngine/Core/Common/Types.hpp>
+#include <KryneEngine/Core/Math/Vector.hpp>
+#include <KryneEngine/Core/Memory/Allocators/Allocator.hpp>
+#include <KryneEngine/Core/Memory/Containers/LruCache.hpp>
+
+namespace KryneEngine::Modules::TextRendering
+{
+    class Font;
+
+    /**
+     * @brief A glyph placed by the text shaper.
+     *
+     * @details
+     * Glyphs are identified by their unicode codepoint, the same way the MSDF atlas keys them. The position is the pen
+     * position on the glyph baseline, relative to the top-left corner of the run. Bearings are not applied.
+     */
+    struct ShapedGlyph
+    {
+        u32 m_codepoint;
+        float2 m_position;
+    };
+
+    struct ShapedRun
+    {
+        eastl::span<ShapedGlyph> m_glyphs {};
+        float2 m_size {};
+        u64 m_contentHash = 0;
+    };
+
+    struct ShapingParameters
+    {
+        float m_fontSize = 16.f;
+        float m_letterSpacing = 0.f;
+        float m_lineSpacing = 0.f;
+        bool m_kerning = true;
+    };
+
+    /**
+     * @brief Converts UTF-8 text into positioned glyphs, applying font kerning, and caches the shaped runs.
+     *
+     * @details
+     * Runs are cached in an LRU cache keyed by a hash of the text content, the font and the shaping parameters.
+     * A run returned by `AcquireShapedRun()` stays valid until it is released with `ReleaseShapedRun()`.
+     *
+     * Line breaks follow the same rules as the GUI text measurement: '\n' starts a new line, '\r' only resets the pen.
+     */
+    class TextShaper
+    {
+    public:
+        explicit TextShaper(AllocatorInstance _allocator, u32 _cacheCapacity = kDefaultCacheCapacity);
+        ~TextShaper();
+
+        [[nodiscard]] const ShapedRun* AcquireShapedRun(
+            Font* _font,
+            eastl::string_view _text,
+            const ShapingParameters& _parameters);
+
+        void ReleaseShapedRun(const ShapedRun* _run);
+
+        /**
+         * @brief Shapes a run without going through the cache.
+         *
+         * @param _glyphBuffer The output buffer. Must be able to hold at least `_text.size()` glyphs.
+         * @return The shaped run, with glyphs pointing into the provided buffer.
+         */
+        static ShapedRun Shape(
+            Font* _font,
+            eastl::string_view _text,
+            const ShapingParameters& _parameters,
+            eastl::span<ShapedGlyph> _glyphBuffer);
+
+        [[nodiscard]] static u64 ComputeContentHash(
+            const Font* _font,
+            eastl::string_view _text,
+            const ShapingParameters& _parameters);
+
+        struct Statistics
+        {
+            u64 m_cacheHits;
+            u64 m_cacheMisses;
+            u64 m_shapedGlyphs;
+        };
+
+        [[nodiscard]] Statistics GetStatistics() const;
+        void ResetStatistics();
+
+        static constexpr u32 kDefaultCacheCapacity = 512;
+
+    private:
+        AllocatorInstance m_allocator;
+        LruCache<u64, ShapedRun> m_cache;
+
+        std::atomic<u64> m_cacheHits = 0;
+        std::atomic<u64> m_cacheMisses = 0;
+        std::atomic<u64> m_shapedGlyphs = 0;
+    };
+}
@@ -128,6 +128,34 @@ namespace KryneEngine::Modules::TextRendering
             : GlyphLayoutMetrics { 0, 0, 0, 0, 0 };
     }
 
+    float Font::GetKerning(const u32 _leftCodepoint, const u32 _rightCodepoint, const float _fontSize)
+    {
+        switch (m_fileType)
+        {
+        case FontFileType::Freetype:
+            return m_freetypeFile.GetKerning(_leftCodepoint, _rightCodepoint, _fontSize);
+        case FontFileType::PreBaked:
+            return m_preBakedFile.GetKerning(_leftCodepoint, _rightCodepoint, _fontSize);
+        default:
+            KE_ERROR("Unreachable code (unsupported font type: %d)", static_cast<int>(m_fileType));
+            return 0;
+        }
+    }
+
+    bool Font::HasKerning() const
+    {
+        switch (m_fileType)
+        {
+        case FontFileType::Freetype:
+            return m_freetypeFile.HasKerning();
+        case FontFileType::PreBaked:
+            return m_preBakedFile.HasKerning();
+        default:
+            KE_ERROR("Unreachable code (unsupported font type: %d)", static_cast<int>(m_fileType));
+            return false;
+        }
+    }
+
     GlyphMsdfBitmap Font::GetMsdf(
         const u32 _unicodeCodepoint,
         const u16 _fontSize,
@@ -0,0 +1,222 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Modules/TextRendering/FontBaker.hpp"
+
+#include <chrono>
+#include <EASTL/algorithm.h>
+#include <EASTL/sort.h>
+#include <EASTL/vector.h>
+#include <KryneEngine/Core/Common/Assert.hpp>
+#include <KryneEngine/Core/Profiling/TracyHeader.hpp>
+
+#include "KryneEngine/Modules/TextRendering/Font.hpp"
+
+namespace KryneEngine::Modules::TextRendering
+{
+    namespace
+    {
+        u64 ElapsedNanoseconds(const std::chrono::steady_clock::time_point _start)
+        {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count();
+        }
+    }
+
+    eastl::span<std::byte> FontBaker::Bake(
+        Font* _font,
+        const Settings& _settings,
+        const AllocatorInstance _allocator,
+        Statistics* _statistics)
+    {
+        KE_ZoneScopedFunction("FontBaker::Bake");
+
+        VERIFY_OR_RETURN(_font != nullptr, {});
+        IF_NOT_VERIFY_MSG(_font->m_fileType == Font::FontFileType::Freetype, "Only Freetype fonts can be baked")
+            return {};
+
+        Statistics statistics {};
+        FreetypeFontFile& fontFile = _font->m_freetypeFile;
+
+        const bool bakeMsdf = BitUtils::EnumHasAny(_settings.m_renderInfo, PreBakedFontFile::BakedRenderInfo::Msdf);
+        const bool bakeOutlines = BitUtils::EnumHasAny(_settings.m_renderInfo, PreBakedFontFile::BakedRenderInfo::Outlines);
+
+        eastl::vector<PreBakedFontFile::GlyphBakeInfo> glyphs(_allocator);
+        eastl::vector<float2> outlinePoints(_allocator);
+        eastl::vector<OutlineTag> outlineTags(_allocator);
+
+        // Gather glyph metrics and outlines, normalized to the em size.
+        {
+            KE_ZoneScoped("Gather glyphs");
+            const auto start = std::chrono::steady_clock::now();
+
+            for (const CodepointRange& range : _settings.m_ranges)
+            {
+                KE_ASSERT(range.m_first <= range.m_last);
+                for (u32 codepoint = range.m_first; codepoint <= range.m_last; ++codepoint)
+                {
+                    statistics.m_requestedCodepoints++;
+
+                    const eastl::optional<GlyphLayoutMetrics> metrics = fontFile.GetGlyphLayoutMetrics(codepoint, 1.f);
+                    if (!metrics.has_value())
+                        continue;
+
+                    PreBakedFontFile::GlyphBakeInfo& glyph = glyphs.push_back();
+                    glyph = {
+                        .m_glyph = {
+                            .m_codePoint = codepoint,
+                            .m_advanceX = metrics->m_advanceX,
+                            .m_bearingX = metrics->m_bearingX,
+                            .m_bearingY = metrics->m_bearingY,
+                            .m_width = metrics->m_width,
+                            .m_height = metrics->m_height,
+                        },
+                    };
+
+                    if (bakeOutlines && fontFile.HasOutline(codepoint))
+                    {
+                        const GlyphShape shape = fontFile.AcquireGlyphShape(codepoint);
+
+                        size_t pointCount = 0;
+                        for (const OutlineTag tag: shape.m_tags)
+                        {
+                            switch (tag)
+                            {
+                            case OutlineTag::NewContour:
+                            case OutlineTag::Line:
+                                pointCount += 1;
+                                break;
+                            case OutlineTag::Conic:
+                                pointCount += 2;
+                                break;
+                            case OutlineTag::Cubic:
+                                pointCount += 3;
+                                break;
+                            }
+                        }
+
+                        glyph.m_outlineStartPoint = outlinePoints.size();
+                        glyph.m_outlineFirstTag = outlineTags.size();
+                        glyph.m_outlineTagCount = shape.m_tags.size();
+                        outlinePoints.insert(outlinePoints.end(), shape.m_points, shape.m_points + pointCount);
+                        outlineTags.insert(outlineTags.end(), shape.m_tags.begin(), shape.m_tags.end());
+
+                        fontFile.ReleaseGlyphShape(codepoint, shape);
+                    }
+                }
+            }
+
+            // The pre-baked file looks glyphs up with a binary search, so they must be sorted by codepoint.
+            eastl::sort(glyphs.begin(), glyphs.end(), [](const auto& _a, const auto& _b)
+            {
+                return _a.m_glyph.m_codePoint < _b.m_glyph.m_codePoint;
+            });
+            const auto duplicates = eastl::unique(glyphs.begin(), glyphs.end(), [](const auto& _a, const auto& _b)
+            {
+                return _a.m_glyph.m_codePoint == _b.m_glyph.m_codePoint;
+            });
+            glyphs.erase(duplicates, glyphs.end());
+
+            statistics.m_bakedGlyphs = glyphs.size();
+            statistics.m_outlineBytes = outlinePoints.size() * sizeof(float2) + outlineTags.size() * sizeof(OutlineTag);
+            statistics.m_glyphGatherDuration = ElapsedNanoseconds(start);
+        }
+
+        eastl::vector<PreBakedFontFile::KerningPair> kerningPairs(_allocator);
+        if (_settings.m_kerning && fontFile.HasKerning())
+        {
+            KE_ZoneScoped("Gather kerning pairs");
+            const auto start = std::chrono::steady_clock::now();
+
+            eastl::vector<u32> codepoints(_allocator);
+            codepoints.reserve(glyphs.size());
+            for (const auto& glyph : glyphs)
+                codepoints.push_back(glyph.m_glyph.m_codePoint);
+
+            fontFile.GatherKerningPairs(codepoints, kerningPairs, _allocator);
+
+            statistics.m_kerningPairs = kerningPairs.size();
+            statistics.m_kerningDuration = ElapsedNanoseconds(start);
+        }
+
+        if (bakeMsdf)
+        {
+            KE_ZoneScoped("Generate MSDF bitmaps");
+            const auto start = std::chrono::steady_clock::now();
+
+            // Only bake this font's glyphs, never the fallback ones.
+            const u32 fallbackFont = _font->m_fallbackFontId;
+            _font->SetNoFallback();
+
+            for (auto& glyph : glyphs)
+            {
+                const GlyphMsdfBitmap bitmap = _font->GetMsdf(glyph.m_glyph.m_codePoint, _settings.m_msdfFontSize, _allocator);
+                glyph.m_msdfBitmap = bitmap.m_bitmap;
+                glyph.m_msdfWidth = bitmap.m_width;
+                glyph.m_msdfHeight = bitmap.m_height;
+                glyph.m_msdfBakedFontSize = _settings.m_msdfFontSize;
+                statistics.m_msdfBytes += bitmap.m_bitmap.size();
+            }
+
+            _font->m_fallbackFontId = fallbackFont;
+            statistics.m_msdfDuration = ElapsedNanoseconds(start);
+        }
+
+        const PreBakedFontFile::FontMetrics fontMetrics {
+            .m_ascender = _font->GetAscender(1.f),
+            .m_descender = _font->GetDescender(1.f),
+            .m_lineHeight = _font->GetLineHeight(1.f),
+        };
+
+        eastl::span<std::byte> baked;
+        {
+            const auto start = std::chrono::steady_clock::now();
+
+            if (_settings.m_compressed)
+            {
+                baked = PreBakedFontFile::BakeCompressed(
+                    _settings.m_renderInfo,
+                    fontMetrics,
+                    glyphs,
+                    kerningPairs,
+                    outlinePoints,
+                    outlineTags,
+                    _allocator,
+                    _settings.m_compressionLevel,
+                    _settings.m_dictionaryCapacity);
+            }
+            else
+            {
+                baked = PreBakedFontFile::Bake(
+                    _settings.m_renderInfo,
+                    fontMetrics,
+                    glyphs,
+                    kerningPairs,
+                    outlinePoints,
+                    outlineTags,
+                    _allocator);
+            }
+
+            statistics.m_bakeDuration = ElapsedNanoseconds(start);
+        }
+
+        statistics.m_uncompressedSize = sizeof(PreBakedFontFile::GlyphEntry) * glyphs.size()
+            + sizeof(PreBakedFontFile::KerningPair) * kerningPairs.size()
+            + statistics.m_msdfBytes
+            + statistics.m_outlineBytes;
+        statistics.m_bakedSize = baked.size();
+
+        for (const auto& glyph : glyphs)
+        {
+            if (glyph.m_msdfBitmap.data() != nullptr)
+                _allocator.deallocate(glyph.m_msdfBitmap.data());
+        }
+
+        if (_statistics != nullptr)
+            *_statistics = statistics;
+
+        return baked;
+    }
+}
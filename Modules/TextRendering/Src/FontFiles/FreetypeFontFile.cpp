@@ -6,8 +6,13 @@
 
 #include "KryneEngine/Modules/TextRendering/FontFiles/FreetypeFontFile.hpp"
 
+#include <EASTL/sort.h>
+
 #include "KryneEngine/Modules/TextRendering/Utils/FreetypeFunctionHelpers.hpp"
 
+#include FT_TRUETYPE_TABLES_H
+#include FT_TRUETYPE_TAGS_H
+
 namespace KryneEngine::Modules::TextRendering
 {
     FreetypeFontFile::FreetypeFontFile(
@@ -80,6 +85,173 @@ namespace KryneEngine::Modules::TextRendering
         return {};
     }
 
+    bool FreetypeFontFile::HasKerning() const
+    {
+        return FT_HAS_KERNING(m_face);
+    }
+
+    float FreetypeFontFile::GetKerning(const u32 _leftCodepoint, const u32 _rightCodepoint, const float _fontSize)
+    {
+        if (!HasKerning())
+            return 0.f;
+
+        const auto leftIt = m_glyphs.find(_leftCodepoint);
+        const auto rightIt = m_glyphs.find(_rightCodepoint);
+        if (leftIt == m_glyphs.end() || rightIt == m_glyphs.end())
+            return 0.f;
+
+        FT_Vector kerning {};
+        {
+            // The face is not safe to access concurrently, share the glyph load lock.
+            const auto lock = m_loadLock.AutoLock();
+            const FT_Error error = FT_Get_Kerning(
+                m_face,
+                leftIt->second.m_glyphIndex,
+                rightIt->second.m_glyphIndex,
+                FT_KERNING_UNSCALED,
+                &kerning);
+            VERIFY_OR_RETURN(error == FT_Err_Ok, 0.f);
+        }
+
+        return _fontSize * static_cast<float>(kerning.x) / static_cast<float>(m_face->units_per_EM);
+    }
+
+    void FreetypeFontFile::GatherKerningPairs(
+        const eastl::span<const u32> _codepoints,
+        eastl::vector<KerningPair>& _outPairs,
+        const AllocatorInstance _allocator)
+    {
+        if (!HasKerning())
+            return;
+
+        // Several codepoints can share a glyph, so map each glyph index to all its codepoints.
+        eastl::vector<eastl::pair<u32, u32>> glyphCodepoints(_allocator);
+        for (const u32 codepoint : _codepoints)
+        {
+            const auto it = m_glyphs.find(codepoint);
+            if (it != m_glyphs.end())
+                glyphCodepoints.push_back({ it->second.m_glyphIndex, codepoint });
+        }
+        eastl::sort(glyphCodepoints.begin(), glyphCodepoints.end());
+
+        eastl::vector<u8> table(_allocator);
+        {
+            // The face is not safe to access concurrently, share the glyph load lock.
+            const auto lock = m_loadLock.AutoLock();
+
+            FT_ULong tableSize = 0;
+            if (FT_Load_Sfnt_Table(m_face, TTAG_kern, 0, nullptr, &tableSize) != FT_Err_Ok)
+                return;
+            table.resize(tableSize);
+            if (FT_Load_Sfnt_Table(m_face, TTAG_kern, 0, table.data(), &tableSize) != FT_Err_Ok)
+                return;
+        }
+
+        const auto readU16 = [&table](const size_t _offset)
+        {
+            return static_cast<u16>(table[_offset] << 8 | table[_offset + 1]);
+        };
+
+        // Only the OpenType table layout is supported, as in FreeType.
+        if (table.size() < 4 || readU16(0) != 0)
+            return;
+
+        const auto findCodepoints = [&glyphCodepoints](const u32 _glyphIndex)
+        {
+            return eastl::equal_range(
+                glyphCodepoints.begin(),
+                glyphCodepoints.end(),
+                eastl::pair<u32, u32> { _glyphIndex, 0 },
+                [](const auto& _a, const auto& _b) { return _a.first < _b.first; });
+        };
+
+        struct RawPair
+        {
+            u32 m_left;
+            u32 m_right;
+            u32 m_subTable;
+            s16 m_value;
+            bool m_override;
+        };
+        eastl::vector<RawPair> rawPairs(_allocator);
+
+        const u16 subTableCount = readU16(2);
+        size_t subTableOffset = 4;
+        for (u32 subTable = 0; subTable < subTableCount && subTableOffset + 6 <= table.size(); subTable++)
+        {
+            const size_t length = readU16(subTableOffset + 2);
+            const u16 coverage = readU16(subTableOffset + 4);
+            const size_t subTableEnd = eastl::min<size_t>(subTableOffset + length, table.size());
+
+            // Like FreeType, only use horizontal format 0 sub-tables, optionally overriding the previous values.
+            constexpr u16 horizontalBit = 0x1;
+            constexpr u16 overrideBit = 0x8;
+            if ((coverage & ~overrideBit) == horizontalBit && subTableOffset + 14 <= subTableEnd)
+            {
+                const size_t pairsOffset = subTableOffset + 14;
+                const size_t pairCount = eastl::min<size_t>(readU16(subTableOffset + 6), (subTableEnd - pairsOffset) / 6);
+                for (size_t i = 0; i < pairCount; i++)
+                {
+                    const size_t pairOffset = pairsOffset + i * 6;
+                    const s16 value = static_cast<s16>(readU16(pairOffset + 4));
+
+                    const auto [leftBegin, leftEnd] = findCodepoints(readU16(pairOffset));
+                    if (leftBegin == leftEnd)
+                        continue;
+                    const auto [rightBegin, rightEnd] = findCodepoints(readU16(pairOffset + 2));
+
+                    for (auto left = leftBegin; left != leftEnd; ++left)
+                    {
+                        for (auto right = rightBegin; right != rightEnd; ++right)
+                        {
+                            rawPairs.push_back({
+                                left->second,
+                                right->second,
+                                subTable,
+                                value,
+                                (coverage & overrideBit) != 0,
+                            });
+                        }
+                    }
+                }
+            }
+
+            if (length == 0)
+                break;
+            subTableOffset += length;
+        }
+
+        // Fold the values of a pair over the sub-tables, in table order.
+        eastl::sort(rawPairs.begin(), rawPairs.end(), [](const RawPair& _a, const RawPair& _b)
+        {
+            if (_a.m_left != _b.m_left)
+                return _a.m_left < _b.m_left;
+            if (_a.m_right != _b.m_right)
+                return _a.m_right < _b.m_right;
+            return _a.m_subTable < _b.m_subTable;
+        });
+
+        s32 value = 0;
+        for (size_t i = 0; i < rawPairs.size(); i++)
+        {
+            const RawPair& pair = rawPairs[i];
+            value = pair.m_override ? pair.m_value : value + pair.m_value;
+
+            const bool last = i + 1 == rawPairs.size()
+                || rawPairs[i + 1].m_left != pair.m_left
+                || rawPairs[i + 1].m_right != pair.m_right;
+            if (last)
+            {
+                if (value != 0)
+                {
+                    const float offset = static_cast<float>(value) / static_cast<float>(m_face->units_per_EM);
+                    _outPairs.push_back({ pair.m_left, pair.m_right, offset });
+                }
+                value = 0;
+            }
+        }
+    }
+
     bool FreetypeFontFile::HasOutline(u32 _unicodeCodepoint) const
     {
         return m_glyphs.find(_unicodeCodepoint) != m_glyphs.end();
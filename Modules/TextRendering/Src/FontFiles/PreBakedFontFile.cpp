@@ -8,6 +8,7 @@
 
 #include <zdict.h>
 #include <zstd.h>
+#include <EASTL/sort.h>
 #include <KryneEngine/Core/Common/Utils/Alignment.hpp>
 #include <KryneEngine/Core/Memory/DynamicArray.hpp>
 #include <KryneEngine/Core/Profiling/TracyHeader.hpp>
@@ -29,6 +30,7 @@ namespace KryneEngine::Modules::TextRendering
             // Decompress and retrieve tables
             {
                 size_t dstSize = m_header.m_glyphCount * sizeof(GlyphEntry);
+                dstSize += m_header.m_kerningPairCount * sizeof(KerningPair);
                 if (BitUtils::EnumHasAny(m_header.m_options.m_renderInfo, BakedRenderInfo::Msdf))
                     dstSize += m_header.m_glyphCount * sizeof(MsdfEntry);
                 if (BitUtils::EnumHasAny(m_header.m_options.m_renderInfo, BakedRenderInfo::Outlines))
@@ -52,7 +54,8 @@ namespace KryneEngine::Modules::TextRendering
                 _allocator.deallocate(compressedTables, compressedTablesSize);
 
                 m_glyphs = reinterpret_cast<GlyphEntry*>(tablesBuffer);
-                auto currentPtr = reinterpret_cast<std::byte*>(m_glyphs + m_header.m_glyphCount);
+                m_kerningPairs = reinterpret_cast<KerningPair*>(m_glyphs + m_header.m_glyphCount);
+                auto currentPtr = reinterpret_cast<std::byte*>(m_kerningPairs + m_header.m_kerningPairCount);
                 if (BitUtils::EnumHasAny(m_header.m_options.m_renderInfo, BakedRenderInfo::Msdf))
                 {
                     m_msdfEntries = reinterpret_cast<MsdfEntry*>(currentPtr);
@@ -98,7 +101,8 @@ namespace KryneEngine::Modules::TextRendering
             _file.Read(offset, m_data);
 
             m_glyphs = reinterpret_cast<GlyphEntry*>(m_data.data());
-            auto ptr = reinterpret_cast<std::byte*>(m_glyphs + m_header.m_glyphCount);
+            m_kerningPairs = reinterpret_cast<KerningPair*>(m_glyphs + m_header.m_glyphCount);
+            auto ptr = reinterpret_cast<std::byte*>(m_kerningPairs + m_header.m_kerningPairCount);
             if (BitUtils::EnumHasAny(m_header.m_options.m_renderInfo, BakedRenderInfo::Msdf))
             {
                 m_msdfEntries = reinterpret_cast<MsdfEntry*>(ptr);
@@ -174,6 +178,19 @@ namespace KryneEngine::Modules::TextRendering
             : eastl::make_optional(static_cast<u32>(eastl::distance(m_glyphs, entry)));
     }
 
+    float PreBakedFontFile::GetKerning(const u32 _leftCodepoint, const u32 _rightCodepoint, const float _fontSize) const
+    {
+        const KerningPair* end = m_kerningPairs + m_header.m_kerningPairCount;
+        const KerningPair* it = eastl::lower_bound(m_kerningPairs, end, KerningPair { _leftCodepoint, _rightCodepoint, 0 },
+            [](const KerningPair& _a, const KerningPair& _b)
+            {
+                return _a.m_left < _b.m_left || (_a.m_left == _b.m_left && _a.m_right < _b.m_right);
+            });
+        if (it == end || it->m_left != _leftCodepoint || it->m_right != _rightCodepoint)
+            return 0.f;
+        return it->m_offsetX * _fontSize;
+    }
+
     bool PreBakedFontFile::HasMsdfBitmaps() const
     {
         return BitUtils::EnumHasAny(m_header.m_options.m_renderInfo, BakedRenderInfo::Msdf);
@@ -293,6 +310,7 @@ namespace KryneEngine::Modules::TextRendering
         const BakedRenderInfo _renderInfo,
         const FontMetrics _fontMetrics,
         const eastl::span<const GlyphBakeInfo> _glyphs,
+        const eastl::span<const KerningPair> _kerningPairs,
         const eastl::span<float2> _outlinePoints,
         const eastl::span<OutlineTag> _outlineTags,
         const AllocatorInstance _allocator)
@@ -302,6 +320,7 @@ namespace KryneEngine::Modules::TextRendering
         totalSize += sizeof(Header);
 
         totalSize += _glyphs.size() * sizeof(GlyphEntry);
+        totalSize += _kerningPairs.size() * sizeof(KerningPair);
 
         if (BitUtils::EnumHasAny(_renderInfo, BakedRenderInfo::Msdf))
         {
@@ -348,7 +367,8 @@ namespace KryneEngine::Modules::TextRendering
                 .m_compressed = false,
                 .m_renderInfo = _renderInfo,
             },
-            .m_glyphCount = static_cast<u32>(_glyphs.size())
+            .m_glyphCount = static_cast<u32>(_glyphs.size()),
+            .m_kerningPairCount = static_cast<u32>(_kerningPairs.size()),
         };
         bytes += sizeof(Header);
 
@@ -358,6 +378,14 @@ namespace KryneEngine::Modules::TextRendering
             bytes += sizeof(GlyphEntry);
         }
 
+        if (!_kerningPairs.empty())
+        {
+            auto* kerningPairs = reinterpret_cast<KerningPair*>(bytes);
+            memcpy(kerningPairs, _kerningPairs.data(), _kerningPairs.size_bytes());
+            SortKerningPairs({ kerningPairs, _kerningPairs.size() });
+            bytes += _kerningPairs.size_bytes();
+        }
+
         MsdfEntry* msdfEntries = nullptr;
         if (BitUtils::EnumHasAny(_renderInfo, BakedRenderInfo::Msdf))
         {
@@ -442,9 +470,12 @@ namespace KryneEngine::Modules::TextRendering
         const BakedRenderInfo _renderInfo,
         const FontMetrics _fontMetrics,
         const eastl::span<const GlyphBakeInfo> _glyphs,
+        const eastl::span<const KerningPair> _kerningPairs,
         const eastl::span<float2> _outlinePoints,
         const eastl::span<OutlineTag> _outlineTags,
-        const AllocatorInstance _allocator)
+        const AllocatorInstance _allocator,
+        const s32 _compressionLevel,
+        const size_t _dictionaryCapacity)
     {
         struct OutlineBlob
         {
@@ -511,12 +542,12 @@ namespace KryneEngine::Modules::TextRendering
             }
         }
 
-        constexpr size_t dictCapacity = 64 << 10;
+        const size_t dictCapacity = _dictionaryCapacity;
         void* dictBuffer = nullptr;
         size_t dictSize = 0;
         ZSTD_CDict* dict = nullptr;
-        constexpr s32 compressionLevel = 0;
-        if (!bigBlob.empty())
+        const s32 compressionLevel = _compressionLevel;
+        if (!bigBlob.empty() && dictCapacity > 0)
         {
             KE_ZoneScoped("Train dictionary");
 
@@ -541,7 +572,7 @@ namespace KryneEngine::Modules::TextRendering
         OutlineEntry* outlineEntries = nullptr;
         {
             KE_ZoneScoped("Prepare tables buffer");
-            size_t size = _glyphs.size() * sizeof(GlyphEntry);
+            size_t size = _glyphs.size() * sizeof(GlyphEntry) + _kerningPairs.size_bytes();
             if (BitUtils::EnumHasAny(_renderInfo, BakedRenderInfo::Msdf))
                 size += _glyphs.size() * sizeof(MsdfEntry);
             if (BitUtils::EnumHasAny(_renderInfo, BakedRenderInfo::Outlines))
@@ -550,6 +581,13 @@ namespace KryneEngine::Modules::TextRendering
 
             {
                 auto* currentPtr = tables.data() + sizeof(GlyphEntry) * _glyphs.size();
+                if (!_kerningPairs.empty())
+                {
+                    auto* kerningPairs = reinterpret_cast<KerningPair*>(currentPtr);
+                    memcpy(kerningPairs, _kerningPairs.data(), _kerningPairs.size_bytes());
+                    SortKerningPairs({ kerningPairs, _kerningPairs.size() });
+                    currentPtr += _kerningPairs.size_bytes();
+                }
                 if (BitUtils::EnumHasAny(_renderInfo, BakedRenderInfo::Msdf))
                 {
                     msdfEntries = reinterpret_cast<MsdfEntry*>(currentPtr);
@@ -571,7 +609,7 @@ namespace KryneEngine::Modules::TextRendering
         }
 
         ZSTD_CCtx* ctx = ZSTD_createCCtx();
-        const auto compressBlob = [ctx](const eastl::span<std::byte> _blob, eastl::vector<std::byte>& _vector, ZSTD_CDict* _dict)
+        const auto compressBlob = [ctx, compressionLevel](const eastl::span<std::byte> _blob, eastl::vector<std::byte>& _vector, ZSTD_CDict* _dict)
         {
             const size_t sizeOffset = _vector.size();
             _vector.resize(_vector.size() + sizeof(u32)); // Preinsert size
@@ -649,7 +687,8 @@ namespace KryneEngine::Modules::TextRendering
                     .m_compressed = true,
                     .m_renderInfo = _renderInfo,
                 },
-                .m_glyphCount = static_cast<u32>(_glyphs.size())
+                .m_glyphCount = static_cast<u32>(_glyphs.size()),
+                .m_kerningPairCount = static_cast<u32>(_kerningPairs.size()),
             };
         }
 
@@ -685,6 +724,15 @@ namespace KryneEngine::Modules::TextRendering
         }
     }
 
+    void PreBakedFontFile::SortKerningPairs(const eastl::span<KerningPair> _kerningPairs)
+    {
+        eastl::sort(_kerningPairs.begin(), _kerningPairs.end(),
+            [](const KerningPair& _a, const KerningPair& _b)
+            {
+                return _a.m_left < _b.m_left || (_a.m_left == _b.m_left && _a.m_right < _b.m_right);
+            });
+    }
+
     PreBakedFontFile::GlyphEntry* PreBakedFontFile::FindGlyphEntry(u32 _codePoint) const
     {
         GlyphEntry* end = m_glyphs + m_header.m_glyphCount;
@@ -13,6 +13,7 @@
 #include "KryneEngine/Core/Profiling/TracyHeader.hpp"
 
 #include <KryneEngine/Core/Common/Assert.hpp>
+#include <KryneEngine/Core/Math/Hashing.hpp>
 
 #include "KryneEngine/Modules/FileSystem/ReadOnlyFile.hpp"
 #include "KryneEngine/Modules/TextRendering/Font.hpp"
@@ -154,6 +155,7 @@ namespace KryneEngine::Modules::TextRendering
                 [](const auto& a, const auto& b) { return a.first < b.first; });
 
             newFont->m_fileType = Font::FontFileType::Freetype;
+            newFont->m_contentHash = Hashing::Hash64(_loadedResourceData.data(), _loadedResourceData.size());
         }
         else
         {
@@ -164,6 +166,9 @@ namespace KryneEngine::Modules::TextRendering
             new (&newFont->m_preBakedFile) PreBakedFontFile(*fontFile);
 
             newFont->m_fileType = Font::FontFileType::PreBaked;
+
+            // Hash the whole file, so fonts only differing by their glyph payloads don't share cache entries.
+            newFont->m_contentHash = Hashing::Hash64(_loadedResourceData.data(), _loadedResourceData.size());
         }
 
         newFont->m_fontId = m_fonts.size();
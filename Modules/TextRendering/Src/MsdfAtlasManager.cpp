@@ -6,14 +6,19 @@
 
 #include "KryneEngine/Modules/TextRendering/MsdfAtlasManager.hpp"
 
+#include <chrono>
 #include <cmath>
+#include <KryneEngine/Core/Common/Utils/Alignment.hpp>
 #include <KryneEngine/Core/Graphics/Buffer.hpp>
 #include <KryneEngine/Core/Graphics/MemoryBarriers.hpp>
 #include <KryneEngine/Core/Math/Color.hpp>
 #include <KryneEngine/Core/Math/Hashing.hpp>
+#include <KryneEngine/Core/Profiling/FrameStatistics.hpp>
+#include <KryneEngine/Core/Profiling/TracyHeader.hpp>
 
 #include "KryneEngine/Modules/TextRendering/Font.hpp"
 #include "KryneEngine/Modules/TextRendering/FontManager.hpp"
+#include "KryneEngine/Modules/TextRendering/MsdfGlyphDiskCache.hpp"
 
 namespace KryneEngine::Modules::TextRendering
 {
@@ -29,6 +34,7 @@ namespace KryneEngine::Modules::TextRendering
             , m_stagingBuffers(_allocator, _graphicsContext->GetFrameContextCount(), {})
             , m_atlasSize(_atlasSize)
             , m_glyphSlotMap(_allocator)
+            , m_pendingRequests(_allocator)
     {
         const TextureDesc atlasTextureDesc {
             .m_dimensions = { m_atlasSize, m_atlasSize, 1 },
@@ -73,7 +79,7 @@ namespace KryneEngine::Modules::TextRendering
                     .m_width = it->second.m_width,
                     .m_height = it->second.m_height,
                     .m_baseline = it->second.m_baseline,
-                    .m_pxRange = it->second.m_fontSize == 0 ? static_cast<u16>(0u) : pxRange,
+                    .m_pxRange = it->second.m_fontSize == 0 || !it->second.m_uploaded ? static_cast<u16>(0u) : pxRange,
                 };
             }
         }
@@ -90,38 +96,83 @@ namespace KryneEngine::Modules::TextRendering
             return {};
         }
 
-        const GlyphMsdfBitmap bitmap = eastl::move(_font->GetMsdf(_unicodeCodepoint, _fontSize, m_allocator));
+        const GlyphMsdfBitmap bitmap = AcquireMsdf(_font, _unicodeCodepoint, _fontSize, pxRange);
         KE_ASSERT(!bitmap.m_bitmap.empty());
 
-        Rect slotRect {};
-        GlyphSlot glyphSlot {};
-        {
-            // At least 2 px of padding
-            constexpr u16 padding = 2;
+        const GlyphSlot glyphSlot = AllocateSlot(
+            { _font, _unicodeCodepoint },
+            bitmap.m_width,
+            bitmap.m_height,
+            bitmap.m_baseLine,
+            bitmap.m_fontSize,
+            bitmap.m_bitmap.data(),
+            bitmap.m_allocated,
+            false);
 
-            const auto lock = m_lock.AutoLock();
+        return {
+            .m_x = glyphSlot.m_offsetX,
+            .m_y = glyphSlot.m_offsetY,
+            .m_width = glyphSlot.m_width,
+            .m_height = glyphSlot.m_height,
+            .m_baseline = glyphSlot.m_baseline,
+            .m_pxRange = glyphSlot.m_fontSize == 0 || !glyphSlot.m_uploaded ? static_cast<u16>(0u) : pxRange,
+        };
+    }
 
-            const uint2 glyphSize {
-                bitmap.m_width + padding,
-                bitmap.m_height + padding,
-            };
+    MsdfAtlasManager::GlyphRegion MsdfAtlasManager::GetCoverageGlyphRegion(
+        Font* _font,
+        const u32 _unicodeCodepoint,
+        const u32 _pixelSize,
+        const u32 _sourceFontSize)
+    {
+        VERIFY_OR_RETURN(_pixelSize > 0, {});
 
-            const u32 slot = m_atlasAllocator.Allocate(glyphSize);
-            slotRect = m_atlasAllocator.GetSlotRect(slot);
-            glyphSlot = {
-                .m_offsetX = static_cast<u16>(slotRect.m_left + padding / 2),
-                .m_offsetY = static_cast<u16>(slotRect.m_top + padding / 2),
-                .m_width = bitmap.m_width,
-                .m_height = bitmap.m_height,
-                .m_baseline = bitmap.m_baseLine,
-                .m_fontSize = bitmap.m_fontSize,
-                .m_allocatorSlot = slot,
-            };
+        const GlyphKey key { _font, _unicodeCodepoint, _pixelSize };
+        {
+            const auto lock = m_lock.AutoLock();
+            const auto it = m_glyphSlotMap.find(key);
+            if (it != m_glyphSlotMap.end())
+            {
+                return {
+                    .m_x = it->second.m_offsetX,
+                    .m_y = it->second.m_offsetY,
+                    .m_width = it->second.m_width,
+                    .m_height = it->second.m_height,
+                    .m_baseline = it->second.m_baseline,
+                    .m_pxRange = it->second.m_fontSize == 0 || !it->second.m_uploaded
+                        ? static_cast<u16>(0u)
+                        : static_cast<u16>(1u),
+                };
+            }
+        }
 
-            m_glyphSlotMap.emplace(GlyphKey { _font, _unicodeCodepoint }, glyphSlot);
+        const GlyphLayoutMetrics glyphMetrics = _font->GetGlyphLayoutMetrics(_unicodeCodepoint, static_cast<float>(_pixelSize));
+        if (glyphMetrics.m_height == 0 || glyphMetrics.m_width == 0)
+        {
+            const auto lock = m_lock.AutoLock();
+            m_glyphSlotMap.emplace(key, GlyphSlot {});
+            return {};
         }
 
-        m_loadQueue.enqueue({ glyphSlot, slotRect, bitmap.m_bitmap.data(), bitmap.m_allocated });
+        GlyphMsdfBitmap msdf = AcquireMsdf(_font, _unicodeCodepoint, _sourceFontSize, GetPxRange(_sourceFontSize));
+        VERIFY_OR_RETURN(!msdf.m_bitmap.empty() && msdf.m_fontSize > 0, {});
+        if (msdf.m_pxRange == 0)
+            msdf.m_pxRange = GetPxRange(msdf.m_fontSize);
+
+        const float scale = static_cast<float>(_pixelSize) / static_cast<float>(msdf.m_fontSize);
+        const GlyphCoverageBitmap coverage = RasterizeCoverage(msdf, scale, m_allocator);
+        if (msdf.m_allocated)
+            m_allocator.deallocate(msdf.m_bitmap.data());
+
+        const GlyphSlot glyphSlot = AllocateSlot(
+            key,
+            coverage.m_width,
+            coverage.m_height,
+            coverage.m_baseLine,
+            static_cast<u16>(_pixelSize),
+            coverage.m_bitmap.data(),
+            true,
+            true);
 
         return {
             .m_x = glyphSlot.m_offsetX,
@@ -129,68 +180,129 @@ namespace KryneEngine::Modules::TextRendering
             .m_width = glyphSlot.m_width,
             .m_height = glyphSlot.m_height,
             .m_baseline = glyphSlot.m_baseline,
-            .m_pxRange = glyphSlot.m_fontSize == 0 ? static_cast<u16>(0u) : pxRange,
+            .m_pxRange = glyphSlot.m_uploaded ? static_cast<u16>(1u) : static_cast<u16>(0u),
         };
     }
 
-    void MsdfAtlasManager::FlushLoads(GraphicsContext& _graphicsContext, CommandListHandle _transfer)
+    GlyphCoverageBitmap MsdfAtlasManager::RasterizeCoverage(
+        const GlyphMsdfBitmap& _msdf,
+        const float _scale,
+        const AllocatorInstance _allocator)
     {
-        eastl::vector<GlyphLoadRequest> requests { m_allocator };
-        constexpr size_t kMaxRequestsPerFlush = 32;
-        requests.resize(kMaxRequestsPerFlush);
+        KE_ZoneScopedFunction("MsdfAtlasManager::RasterizeCoverage");
 
-        size_t flushCount = m_loadQueue.try_dequeue_bulk(requests.begin(), kMaxRequestsPerFlush);
-        if (flushCount == 0)
-            return;
+        VERIFY_OR_RETURN(_scale > 0.f && _msdf.m_width > 0 && _msdf.m_height > 0, {});
 
-        if (GraphicsContext::SupportsNonGlobalBarriers())
+        GlyphCoverageBitmap result {
+            .m_width = static_cast<u16>(std::ceil(static_cast<float>(_msdf.m_width) * _scale)),
+            .m_height = static_cast<u16>(std::ceil(static_cast<float>(_msdf.m_height) * _scale)),
+            .m_baseLine = static_cast<u16>(std::round(static_cast<float>(_msdf.m_baseLine) * _scale)),
+        };
+        result.m_bitmap = {
+            static_cast<std::byte*>(_allocator.allocate(static_cast<size_t>(result.m_width) * result.m_height)),
+            static_cast<size_t>(result.m_width) * result.m_height,
+        };
+
+        const auto fetchMedian = [&](const s32 _x, const s32 _y) -> float
         {
-            const TextureMemoryBarrier barrier {
-                .m_stagesSrc = BarrierSyncStageFlags::All,
-                .m_stagesDst = BarrierSyncStageFlags::AllShading,
-                .m_accessSrc = BarrierAccessFlags::ShaderResource,
-                .m_accessDst = BarrierAccessFlags::TransferDst,
-                .m_texture = m_atlasTexture,
-                .m_layoutSrc = TextureLayout::ShaderResource,
-                .m_layoutDst = TextureLayout::TransferDst,
-            };
-            _graphicsContext.PlaceMemoryBarriers(_transfer, {}, {}, { &barrier, 1 });
-        }
+            const s32 x = eastl::clamp<s32>(_x, 0, _msdf.m_width - 1);
+            const s32 y = eastl::clamp<s32>(_y, 0, _msdf.m_height - 1);
+            const std::byte* texel = _msdf.m_bitmap.data() + (static_cast<size_t>(y) * _msdf.m_width + x) * 3;
+            const float r = static_cast<float>(texel[0]);
+            const float g = static_cast<float>(texel[1]);
+            const float b = static_cast<float>(texel[2]);
+            return eastl::max(eastl::min(r, g), eastl::min(eastl::max(r, g), b)) / 255.f;
+        };
+
+        // Distance in output pixels per unit of MSDF value, like the shader's screen pixel range at this scale.
+        const float screenPxRange = eastl::max(static_cast<float>(_msdf.m_pxRange) * _scale, 1.f);
 
-        // Flush all requests into a single vector
-        do
+        for (u32 y = 0; y < result.m_height; y++)
         {
-            if (flushCount == kMaxRequestsPerFlush)
+            for (u32 x = 0; x < result.m_width; x++)
             {
-                const size_t offset = requests.size();
-                requests.resize(requests.size() + kMaxRequestsPerFlush);
-                flushCount = m_loadQueue.try_dequeue_bulk(requests.begin() + offset, kMaxRequestsPerFlush);
-
-                if (flushCount == 0)
-                    requests.resize(offset);
+                // Pixel center in MSDF texel space, relative to the texel centers for bilinear filtering
+                const float u = (static_cast<float>(x) + 0.5f) / _scale - 0.5f;
+                const float v = (static_cast<float>(y) + 0.5f) / _scale - 0.5f;
+                const s32 x0 = static_cast<s32>(std::floor(u));
+                const s32 y0 = static_cast<s32>(std::floor(v));
+                const float fx = u - static_cast<float>(x0);
+                const float fy = v - static_cast<float>(y0);
+
+                // Filtering the medians is close enough to taking the median of the filtered channels at these scales.
+                const float median =
+                    (fetchMedian(x0, y0) * (1.f - fx) + fetchMedian(x0 + 1, y0) * fx) * (1.f - fy)
+                    + (fetchMedian(x0, y0 + 1) * (1.f - fx) + fetchMedian(x0 + 1, y0 + 1) * fx) * fy;
+
+                const float coverage = eastl::clamp(screenPxRange * (median - 0.5f) + 0.5f, 0.f, 1.f);
+                result.m_bitmap[y * result.m_width + x] = static_cast<std::byte>(std::lround(coverage * 255.f));
             }
-            else
+        }
+
+        return result;
+    }
+
+    void MsdfAtlasManager::FlushLoads(GraphicsContext& _graphicsContext, CommandListHandle _transfer)
+    {
+        KE_ZoneScopedFunction("MsdfAtlasManager::FlushLoads");
+
+        m_lastUploadStatistics = {};
+
+        // Requests deferred by the upload budget are kept in front, so they are uploaded first.
+        {
+            constexpr size_t kMaxRequestsPerDequeue = 32;
+            GlyphLoadRequest dequeuedRequests[kMaxRequestsPerDequeue];
+            size_t dequeuedCount;
+            while ((dequeuedCount = m_loadQueue.try_dequeue_bulk(dequeuedRequests, kMaxRequestsPerDequeue)) > 0)
             {
-                requests.resize(requests.size() + flushCount - kMaxRequestsPerFlush);
-                flushCount = 0;
+                m_pendingRequests.insert(m_pendingRequests.end(), dequeuedRequests, dequeuedRequests + dequeuedCount);
             }
         }
-        while (flushCount > 0);
 
-        eastl::vector<TextureMemoryFootprint> slotFootprints { m_allocator };
-        u64 cumulatedSize = 0;
-        for (const auto& request : requests)
+        if (m_pendingRequests.empty())
+            return;
+
+        // Compute the packed layout of all the regions inside a single staging allocation
+        eastl::vector<TextureRegionCopy> regions { m_allocator };
+        eastl::vector<u64> regionSizes { m_allocator };
+        regions.reserve(m_pendingRequests.size());
+        regionSizes.reserve(m_pendingRequests.size());
+        for (const GlyphLoadRequest& request : m_pendingRequests)
         {
-            TextureMemoryFootprint& footprint = slotFootprints.emplace_back();
-            footprint = _graphicsContext.FetchTextureSubResourcesMemoryFootprints({
-                .m_dimensions = {
-                    request.m_dstRegion.m_right - request.m_dstRegion.m_left,
-                    request.m_dstRegion.m_bottom - request.m_dstRegion.m_top,
-                    1
-                },
+            const uint3 regionSize {
+                request.m_dstRegion.m_right - request.m_dstRegion.m_left,
+                request.m_dstRegion.m_bottom - request.m_dstRegion.m_top,
+                1
+            };
+
+            // The backend provides the row pitch, as it depends on the format and its copy alignment rules.
+            const TextureMemoryFootprint footprint = _graphicsContext.FetchTextureSubResourcesMemoryFootprints({
+                .m_dimensions = regionSize,
                 .m_format = m_atlasFootprint.m_format,
             }).front();
-            cumulatedSize += footprint.m_lineByteAlignedSize * footprint.m_height;
+            KE_ASSERT(footprint.m_lineByteAlignedSize >= regionSize.x * sizeof(u32));
+
+            regions.push_back({
+                .m_bufferOffset = 0,
+                .m_footprint = footprint,
+                .m_regionOffset = { request.m_dstRegion.m_left, request.m_dstRegion.m_top, 0 },
+                .m_regionSize = regionSize,
+            });
+            regionSizes.push_back(static_cast<u64>(footprint.m_lineByteAlignedSize) * footprint.m_height);
+        }
+
+        const size_t batchSize = SelectUploadBatch(regionSizes, m_uploadBudget);
+        regions.resize(batchSize);
+
+        // Keep every region start aligned like its rows, as backends may require it for buffer to texture copies.
+        u64 cumulatedSize = 0;
+        for (size_t i = 0; i < batchSize; ++i)
+        {
+            cumulatedSize = Alignment::AlignUp<u64>(
+                cumulatedSize,
+                eastl::max<u64>(regions[i].m_footprint.m_rowPitchAlignment, 1u));
+            regions[i].m_bufferOffset = cumulatedSize;
+            cumulatedSize += regionSizes[i];
         }
 
         StagingBuffer& stagingBuffer = m_stagingBuffers[_graphicsContext.GetCurrentFrameContextIndex()];
@@ -229,18 +341,15 @@ namespace KryneEngine::Modules::TextRendering
 
         BufferMapping mapping { stagingBuffer.m_buffer, cumulatedSize };
         _graphicsContext.MapBuffer(mapping);
-        size_t progress = 0;
-        for (u32 i = 0; i < requests.size(); ++i)
+        for (size_t i = 0; i < batchSize; ++i)
         {
-            const GlyphLoadRequest& request = requests[i];
+            const GlyphLoadRequest& request = m_pendingRequests[i];
             const GlyphSlot& slot = request.m_slot;
-
-            const TextureMemoryFootprint& footprint = slotFootprints[i];
-            const u64 size = footprint.m_lineByteAlignedSize * footprint.m_height;
+            const TextureMemoryFootprint& footprint = regions[i].m_footprint;
 
             KE_ASSERT(request.m_buffer != nullptr);
 
-            u32 localProgress = progress;
+            u64 localProgress = regions[i].m_bufferOffset;
             for (u32 y = request.m_dstRegion.m_top; y < request.m_dstRegion.m_bottom; ++y)
             {
                 s32 ry = static_cast<s32>(y) - static_cast<s32>(slot.m_offsetY);
@@ -263,6 +372,12 @@ namespace KryneEngine::Modules::TextRendering
                     {
                         *pixels = 0;
                     }
+                    else if (request.m_coverage)
+                    {
+                        // Coverage glyphs only use the alpha channel
+                        const u8 coverage = static_cast<u8>(request.m_buffer[ry * slot.m_width + rx]);
+                        *pixels = Color(255u, 255u, 255u, coverage).ToRgba8();
+                    }
                     else
                     {
                         const Color pixelColor {
@@ -284,24 +399,31 @@ namespace KryneEngine::Modules::TextRendering
             }
             if (request.m_shouldDeallocate)
                 m_allocator.deallocate(request.m_buffer);
-
-            const uint3 offset ;
-            _graphicsContext.SetTextureRegionData(
-                _transfer,
-                { .m_size = size, .m_offset = progress, .m_buffer = stagingBuffer.m_buffer },
-                m_atlasTexture,
-                footprint,
-                m_atlasTextureSubresourceIndex,
-                { request.m_dstRegion.m_left, request.m_dstRegion.m_top, 0 },
-                {
-                    request.m_dstRegion.m_right - request.m_dstRegion.m_left,
-                    request.m_dstRegion.m_bottom - request.m_dstRegion.m_top,
-                    1
-                });
-            progress += size;
         }
         _graphicsContext.UnmapBuffer(mapping);
 
+        if (GraphicsContext::SupportsNonGlobalBarriers())
+        {
+            const TextureMemoryBarrier barrier {
+                .m_stagesSrc = BarrierSyncStageFlags::All,
+                .m_stagesDst = BarrierSyncStageFlags::AllShading,
+                .m_accessSrc = BarrierAccessFlags::ShaderResource,
+                .m_accessDst = BarrierAccessFlags::TransferDst,
+                .m_texture = m_atlasTexture,
+                .m_layoutSrc = TextureLayout::ShaderResource,
+                .m_layoutDst = TextureLayout::TransferDst,
+            };
+            _graphicsContext.PlaceMemoryBarriers(_transfer, {}, {}, { &barrier, 1 });
+        }
+
+        // The atlas is a single texture page, so all the glyphs of the batch go through a single copy.
+        _graphicsContext.SetTextureRegionsData(
+            _transfer,
+            stagingBuffer.m_buffer,
+            m_atlasTexture,
+            m_atlasTextureSubresourceIndex,
+            regions);
+
         if (GraphicsContext::SupportsNonGlobalBarriers())
         {
             const TextureMemoryBarrier barrier {
@@ -315,6 +437,127 @@ namespace KryneEngine::Modules::TextRendering
             };
             _graphicsContext.PlaceMemoryBarriers(_transfer, {}, {}, { &barrier, 1 });
         }
+
+        // Uploaded glyphs can be drawn from now on, deferred ones must wait for their upload.
+        {
+            const auto lock = m_lock.AutoLock();
+            for (size_t i = 0; i < m_pendingRequests.size(); ++i)
+            {
+                const auto it = m_glyphSlotMap.find(m_pendingRequests[i].m_key);
+                if (it != m_glyphSlotMap.end())
+                    it->second.m_uploaded = i < batchSize;
+            }
+        }
+
+        m_pendingRequests.erase(m_pendingRequests.begin(), m_pendingRequests.begin() + batchSize);
+
+        m_lastUploadStatistics = {
+            .m_uploadedBytes = cumulatedSize,
+            .m_uploadedGlyphs = static_cast<u32>(batchSize),
+            .m_copyCount = 1,
+            .m_deferredGlyphs = static_cast<u32>(m_pendingRequests.size()),
+        };
+    }
+
+    size_t MsdfAtlasManager::SelectUploadBatch(const eastl::span<const u64> _uploadSizes, const u64 _uploadBudget)
+    {
+        if (_uploadBudget == 0)
+            return _uploadSizes.size();
+
+        size_t count = 0;
+        u64 cumulatedSize = 0;
+        for (const u64 size : _uploadSizes)
+        {
+            // Always upload at least one glyph, so that a glyph bigger than the budget can't stall the queue.
+            if (count > 0 && cumulatedSize + size > _uploadBudget)
+                break;
+            cumulatedSize += size;
+            ++count;
+        }
+        return count;
+    }
+
+    GlyphMsdfBitmap MsdfAtlasManager::AcquireMsdf(
+        Font* _font,
+        const u32 _unicodeCodepoint,
+        const u32 _fontSize,
+        const u16 _pxRange)
+    {
+        const MsdfGlyphDiskCache::Key diskCacheKey {
+            .m_fontContentHash = _font->GetContentHash(),
+            .m_codepoint = _unicodeCodepoint,
+            .m_fontSize = static_cast<u16>(_fontSize),
+            .m_pxRange = _pxRange,
+        };
+
+        GlyphMsdfBitmap bitmap {};
+        if (m_diskCache != nullptr)
+            bitmap = m_diskCache->Load(diskCacheKey, m_allocator);
+
+        if (bitmap.m_bitmap.empty())
+        {
+            KE_FrameZoneScoped("Glyph MSDF generation");
+
+            const auto start = std::chrono::steady_clock::now();
+            bitmap = _font->GetMsdf(_unicodeCodepoint, _fontSize, m_allocator);
+            const u64 duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+
+            if (m_diskCache != nullptr && !bitmap.m_bitmap.empty())
+                m_diskCache->Store(diskCacheKey, bitmap, duration);
+        }
+        return bitmap;
+    }
+
+    MsdfAtlasManager::GlyphSlot MsdfAtlasManager::AllocateSlot(
+        const GlyphKey& _key,
+        const u16 _width,
+        const u16 _height,
+        const u16 _baseline,
+        const u16 _fontSize,
+        std::byte* _buffer,
+        const bool _shouldDeallocate,
+        const bool _coverage)
+    {
+        Rect slotRect {};
+        GlyphSlot glyphSlot {};
+        {
+            // At least 2 px of padding
+            constexpr u16 padding = 2;
+
+            const auto lock = m_lock.AutoLock();
+
+            const uint2 glyphSize {
+                _width + padding,
+                _height + padding,
+            };
+
+            const u32 slot = m_atlasAllocator.Allocate(glyphSize);
+            slotRect = m_atlasAllocator.GetSlotRect(slot);
+            glyphSlot = {
+                .m_offsetX = static_cast<u16>(slotRect.m_left + padding / 2),
+                .m_offsetY = static_cast<u16>(slotRect.m_top + padding / 2),
+                .m_width = _width,
+                .m_height = _height,
+                .m_baseline = _baseline,
+                .m_fontSize = _fontSize,
+                .m_allocatorSlot = slot,
+                // Without a budget, the next flush uploads it before the GPU consumes this frame's draws.
+                .m_uploaded = m_uploadBudget == 0,
+            };
+
+            m_glyphSlotMap.emplace(_key, glyphSlot);
+        }
+
+        m_loadQueue.enqueue({
+            .m_key = _key,
+            .m_slot = glyphSlot,
+            .m_dstRegion = slotRect,
+            .m_buffer = _buffer,
+            .m_shouldDeallocate = _shouldDeallocate,
+            .m_coverage = _coverage,
+        });
+        return glyphSlot;
     }
 
     u16 MsdfAtlasManager::GetPxRange(const u32 _fontSize)
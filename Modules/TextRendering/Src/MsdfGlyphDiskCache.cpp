@@ -0,0 +1,320 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Modules/TextRendering/MsdfGlyphDiskCache.hpp"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <zstd.h>
+#include <EASTL/sort.h>
+#include <EASTL/vector.h>
+#include <KryneEngine/Core/Common/Assert.hpp>
+#include <KryneEngine/Core/Math/Hashing.hpp>
+#include <KryneEngine/Core/Profiling/TracyHeader.hpp>
+
+namespace KryneEngine::Modules::TextRendering
+{
+    MsdfGlyphDiskCache::MsdfGlyphDiskCache(
+        const AllocatorInstance _allocator,
+        const eastl::string_view _directory,
+        const u64 _maxSize)
+            : m_allocator(_allocator)
+            , m_directory(_directory.data(), _directory.size(), _allocator)
+            , m_maxSize(_maxSize)
+            , m_entries(_allocator)
+    {
+        KE_ZoneScopedFunction("MsdfGlyphDiskCache::MsdfGlyphDiskCache");
+
+        std::error_code error;
+        const std::filesystem::path directory(m_directory.c_str());
+        std::filesystem::create_directories(directory, error);
+        IF_NOT_VERIFY_MSG(!error, "Unable to create MSDF glyph cache directory '%s'", m_directory.c_str())
+            return;
+
+        // Rebuild the index from the directory content, using the modification times as the access order.
+        struct ScannedEntry
+        {
+            u64 m_hash;
+            u64 m_size;
+            std::filesystem::file_time_type m_lastWrite;
+        };
+        eastl::vector<ScannedEntry> scannedEntries(m_allocator);
+
+        for (const std::filesystem::directory_entry& file : std::filesystem::directory_iterator(directory, error))
+        {
+            if (!file.is_regular_file() || file.path().extension() != kExtension)
+                continue;
+
+            const std::string stem = file.path().stem().string();
+            char* end;
+            const u64 hash = strtoull(stem.c_str(), &end, 16);
+            if (stem.empty() || *end != '\0')
+                continue;
+
+            const u64 size = file.file_size(error);
+            const std::filesystem::file_time_type lastWrite = file.last_write_time(error);
+            if (!error)
+                scannedEntries.push_back({ hash, size, lastWrite });
+        }
+
+        eastl::sort(scannedEntries.begin(), scannedEntries.end(), [](const ScannedEntry& _a, const ScannedEntry& _b)
+        {
+            return _a.m_lastWrite < _b.m_lastWrite;
+        });
+
+        m_entries.reserve(scannedEntries.size());
+        for (const ScannedEntry& entry : scannedEntries)
+        {
+            m_entries.emplace(entry.m_hash, Entry { entry.m_size, ++m_accessCounter });
+            m_totalSize += entry.m_size;
+        }
+
+        TrimLocked(m_maxSize);
+    }
+
+    GlyphMsdfBitmap MsdfGlyphDiskCache::Load(const Key& _key, const AllocatorInstance _allocator)
+    {
+        KE_ZoneScopedFunction("MsdfGlyphDiskCache::Load");
+
+        const auto start = std::chrono::steady_clock::now();
+        const u64 hash = HashKey(_key);
+
+        {
+            const auto lock = m_mutex.AutoLock();
+            if (m_entries.find(hash) == m_entries.end())
+            {
+                m_statistics.m_misses++;
+                return {};
+            }
+        }
+
+        const eastl::string path = GetEntryPath(hash);
+        std::ifstream file(path.c_str(), std::ios::binary | std::ios::in);
+
+        FileHeader header {};
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+        const bool validHeader = file.good()
+            && header.m_magicNumber == kMagicNumber
+            && header.m_version == kVersion
+            && header.m_key.m_fontContentHash == _key.m_fontContentHash
+            && header.m_key.m_codepoint == _key.m_codepoint
+            && header.m_key.m_fontSize == _key.m_fontSize
+            && header.m_key.m_pxRange == _key.m_pxRange
+            && header.m_bitmapSize == 3u * header.m_width * header.m_height;
+
+        GlyphMsdfBitmap bitmap {};
+        if (validHeader)
+        {
+            eastl::vector<std::byte> compressed(header.m_compressedSize, m_allocator);
+            file.read(reinterpret_cast<char*>(compressed.data()), header.m_compressedSize);
+
+            if (file.good())
+            {
+                auto* pixels = _allocator.Allocate<std::byte>(header.m_bitmapSize);
+                const size_t decompressedSize = ZSTD_decompress(
+                    pixels,
+                    header.m_bitmapSize,
+                    compressed.data(),
+                    compressed.size());
+
+                if (decompressedSize == header.m_bitmapSize)
+                {
+                    bitmap = {
+                        .m_bitmap = { pixels, header.m_bitmapSize },
+                        .m_pxRange = _key.m_pxRange,
+                        .m_width = header.m_width,
+                        .m_height = header.m_height,
+                        .m_fontSize = header.m_bakedFontSize,
+                        .m_baseLine = header.m_baseLine,
+                    };
+                }
+                else
+                {
+                    _allocator.deallocate(pixels, header.m_bitmapSize);
+                }
+            }
+        }
+        file.close();
+
+        const u64 duration = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+        const auto lock = m_mutex.AutoLock();
+        const auto it = m_entries.find(hash);
+
+        if (bitmap.m_bitmap.empty())
+        {
+            // Corrupted or stale entry, drop it.
+            m_statistics.m_misses++;
+            if (it != m_entries.end())
+            {
+                m_totalSize -= it->second.m_size;
+                m_entries.erase(it);
+            }
+            std::error_code error;
+            std::filesystem::remove(path.c_str(), error);
+            return {};
+        }
+
+        m_statistics.m_hits++;
+        m_statistics.m_loadDuration += duration;
+        if (header.m_generationDuration > duration)
+            m_statistics.m_savedDuration += header.m_generationDuration - duration;
+
+        if (it != m_entries.end())
+            it->second.m_lastAccess = ++m_accessCounter;
+
+        // Persist the access recency for the next runs.
+        std::error_code error;
+        std::filesystem::last_write_time(path.c_str(), std::filesystem::file_time_type::clock::now(), error);
+
+        return bitmap;
+    }
+
+    void MsdfGlyphDiskCache::Store(const Key& _key, const GlyphMsdfBitmap& _bitmap, const u64 _generationDuration)
+    {
+        KE_ZoneScopedFunction("MsdfGlyphDiskCache::Store");
+
+        VERIFY_OR_RETURN_VOID(!_bitmap.m_bitmap.empty());
+        KE_ASSERT(_bitmap.m_bitmap.size() == 3u * _bitmap.m_width * _bitmap.m_height);
+
+        const u64 hash = HashKey(_key);
+
+        eastl::vector<std::byte> compressed(ZSTD_compressBound(_bitmap.m_bitmap.size()), m_allocator);
+        const size_t compressedSize = ZSTD_compress(
+            compressed.data(),
+            compressed.size(),
+            _bitmap.m_bitmap.data(),
+            _bitmap.m_bitmap.size(),
+            ZSTD_CLEVEL_DEFAULT);
+        IF_NOT_VERIFY_MSG(!ZSTD_isError(compressedSize), "MSDF glyph compression failed: %s", ZSTD_getErrorName(compressedSize))
+            return;
+
+        const FileHeader header {
+            .m_magicNumber = kMagicNumber,
+            .m_version = kVersion,
+            .m_key = _key,
+            .m_generationDuration = _generationDuration,
+            .m_bitmapSize = static_cast<u32>(_bitmap.m_bitmap.size()),
+            .m_compressedSize = static_cast<u32>(compressedSize),
+            .m_width = _bitmap.m_width,
+            .m_height = _bitmap.m_height,
+            .m_baseLine = _bitmap.m_baseLine,
+            .m_bakedFontSize = _bitmap.m_fontSize,
+        };
+
+        // Write to a temporary file first, so that a concurrent or interrupted write never leaves a partial entry.
+        const eastl::string path = GetEntryPath(hash);
+        eastl::string temporaryPath = path;
+        temporaryPath.append_sprintf(".%zx.tmp", std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        {
+            std::ofstream file(temporaryPath.c_str(), std::ios::binary | std::ios::out | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(compressed.data()), static_cast<std::streamsize>(compressedSize));
+            if (!file.good())
+            {
+                file.close();
+                std::error_code error;
+                std::filesystem::remove(temporaryPath.c_str(), error);
+                return;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporaryPath.c_str(), path.c_str(), error);
+        if (error)
+        {
+            std::filesystem::remove(temporaryPath.c_str(), error);
+            return;
+        }
+
+        const u64 entrySize = sizeof(header) + compressedSize;
+
+        const auto lock = m_mutex.AutoLock();
+        const auto [it, inserted] = m_entries.emplace(hash, Entry { entrySize, ++m_accessCounter });
+        if (!inserted)
+        {
+            m_totalSize -= it->second.m_size;
+            it->second = { entrySize, m_accessCounter };
+        }
+        m_totalSize += entrySize;
+        m_statistics.m_stores++;
+
+        TrimLocked(m_maxSize);
+    }
+
+    void MsdfGlyphDiskCache::Trim(const u64 _maxSize)
+    {
+        const auto lock = m_mutex.AutoLock();
+        TrimLocked(_maxSize);
+    }
+
+    MsdfGlyphDiskCache::Statistics MsdfGlyphDiskCache::GetStatistics()
+    {
+        const auto lock = m_mutex.AutoLock();
+        return m_statistics;
+    }
+
+    u64 MsdfGlyphDiskCache::GetTotalSize()
+    {
+        const auto lock = m_mutex.AutoLock();
+        return m_totalSize;
+    }
+
+    size_t MsdfGlyphDiskCache::GetEntryCount()
+    {
+        const auto lock = m_mutex.AutoLock();
+        return m_entries.size();
+    }
+
+    u64 MsdfGlyphDiskCache::HashKey(const Key& _key)
+    {
+        u64 hash = Hashing::Hash64(_key.m_fontContentHash);
+        hash = Hashing::Hash64Append(_key.m_codepoint, hash);
+        hash = Hashing::Hash64Append(_key.m_fontSize, hash);
+        hash = Hashing::Hash64Append(_key.m_pxRange, hash);
+        return hash;
+    }
+
+    eastl::string MsdfGlyphDiskCache::GetEntryPath(const u64 _hash) const
+    {
+        eastl::string path(m_allocator);
+        path.sprintf("%s/%016llx%s", m_directory.c_str(), static_cast<unsigned long long>(_hash), kExtension);
+        return path;
+    }
+
+    void MsdfGlyphDiskCache::TrimLocked(const u64 _maxSize)
+    {
+        if (m_totalSize <= _maxSize)
+            return;
+
+        KE_ZoneScopedFunction("MsdfGlyphDiskCache::Trim");
+
+        // Evict in LRU order. Trimming is rare, so a sort of the index is cheaper than maintaining an ordered list.
+        eastl::vector<eastl::pair<u64, u64>> accessOrder(m_allocator);
+        accessOrder.reserve(m_entries.size());
+        for (const auto& [hash, entry] : m_entries)
+            accessOrder.emplace_back(entry.m_lastAccess, hash);
+        eastl::sort(accessOrder.begin(), accessOrder.end());
+
+        for (const auto& [lastAccess, hash] : accessOrder)
+        {
+            if (m_totalSize <= _maxSize)
+                break;
+
+            const auto it = m_entries.find(hash);
+            m_totalSize -= it->second.m_size;
+            m_entries.erase(it);
+            m_statistics.m_evictions++;
+
+            std::error_code error;
+            std::filesystem::remove(GetEntryPath(hash).c_str(), error);
+        }
+    }
+}
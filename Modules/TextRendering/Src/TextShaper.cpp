@@ -0,0 +1,163 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include "KryneEngine/Modules/TextRendering/TextShaper.hpp"
+
+#include <KryneEngine/Core/Common/StringHelpers.hpp>
+#include <KryneEngine/Core/Memory/Containers/LruCache.inl>
+#include <KryneEngine/Core/Profiling/TracyHeader.hpp>
+
+#include "KryneEngine/Modules/TextRendering/Font.hpp"
+
+namespace KryneEngine::Modules::TextRendering
+{
+    TextShaper::TextShaper(const AllocatorInstance _allocator, const u32 _cacheCapacity)
+        : m_allocator(_allocator)
+        , m_cache(_allocator, _cacheCapacity)
+    {}
+
+    TextShaper::~TextShaper()
+    {
+        m_cache.Destroy([this](u64&, ShapedRun& _run)
+        {
+            if (_run.m_glyphs.data() != nullptr)
+                m_allocator.deallocate(_run.m_glyphs.data());
+        });
+    }
+
+    const ShapedRun* TextShaper::AcquireShapedRun(
+        Font* _font,
+        const eastl::string_view _text,
+        const ShapingParameters& _parameters)
+    {
+        KE_ZoneScopedFunction("TextShaper::AcquireShapedRun");
+
+        const u64 hash = ComputeContentHash(_font, _text, _parameters);
+
+        bool shaped = false;
+        ShapedRun* run = m_cache.Acquire(hash, [&](const bool _mustReclaim, ShapedRun* _run)
+        {
+            if (_mustReclaim && _run->m_glyphs.data() != nullptr)
+                m_allocator.deallocate(_run->m_glyphs.data());
+
+            // The UTF-8 byte count is an upper bound of the glyph count, use it to shape in place.
+            auto* glyphs = _text.empty() ? nullptr : m_allocator.Allocate<ShapedGlyph>(_text.size());
+            new (_run) ShapedRun(Shape(_font, _text, _parameters, { glyphs, _text.size() }));
+            shaped = true;
+        });
+
+        IF_NOT_VERIFY_MSG(run != nullptr, "Text shaper cache is too small, all runs are in use")
+            return nullptr;
+
+        if (shaped)
+        {
+            m_cacheMisses.fetch_add(1, std::memory_order_relaxed);
+            m_shapedGlyphs.fetch_add(run->m_glyphs.size(), std::memory_order_relaxed);
+        }
+        else
+        {
+            m_cacheHits.fetch_add(1, std::memory_order_relaxed);
+        }
+        return run;
+    }
+
+    void TextShaper::ReleaseShapedRun(const ShapedRun* _run)
+    {
+        m_cache.Release(const_cast<ShapedRun*>(_run));
+    }
+
+    ShapedRun TextShaper::Shape(
+        Font* _font,
+        const eastl::string_view _text,
+        const ShapingParameters& _parameters,
+        const eastl::span<ShapedGlyph> _glyphBuffer)
+    {
+        KE_ASSERT(_font != nullptr);
+        KE_ASSERT(_glyphBuffer.size() >= _text.size());
+
+        const float fontSize = _parameters.m_fontSize;
+        const float ascender = _font->GetAscender(fontSize);
+        const float descender = _font->GetDescender(fontSize);
+        const float lineAdvance = _font->GetLineHeight(fontSize) + _parameters.m_lineSpacing;
+        const bool applyKerning = _parameters.m_kerning && _font->HasKerning();
+
+        ShapedRun run {
+            .m_contentHash = ComputeContentHash(_font, _text, _parameters),
+        };
+
+        size_t glyphCount = 0;
+        float2 pen { 0.f, ascender };
+        u32 previousCodepoint = 0;
+        bool lineStart = true;
+
+        for (auto it = Utf8Iterator(_text); it != _text.end(); ++it)
+        {
+            const u32 codepoint = *it;
+
+            switch (codepoint)
+            {
+            case '\n':
+                pen.y += lineAdvance;
+            case '\r':
+                run.m_size.x = eastl::max(run.m_size.x, pen.x);
+                pen.x = 0.f;
+                lineStart = true;
+                break;
+            default:
+                if (!lineStart)
+                {
+                    pen.x += _parameters.m_letterSpacing;
+                    if (applyKerning)
+                        pen.x += _font->GetKerning(previousCodepoint, codepoint, fontSize);
+                }
+
+                _glyphBuffer[glyphCount++] = { codepoint, pen };
+
+                pen.x += _font->GetHorizontalAdvance(codepoint, fontSize);
+                previousCodepoint = codepoint;
+                lineStart = false;
+                break;
+            }
+        }
+
+        // Same extent computation as the GUI text measurement, no vertical spacing for the last line.
+        run.m_size.x = eastl::max(run.m_size.x, pen.x);
+        run.m_size.y = pen.y + std::abs(descender);
+        run.m_glyphs = _glyphBuffer.first(glyphCount);
+
+        return run;
+    }
+
+    u64 TextShaper::ComputeContentHash(
+        const Font* _font,
+        const eastl::string_view _text,
+        const ShapingParameters& _parameters)
+    {
+        u64 hash = Hashing::Hash64(_text.data(), _text.size());
+        hash = Hashing::Hash64Append(_font->GetId(), hash);
+        hash = Hashing::Hash64Append(_parameters.m_fontSize, hash);
+        hash = Hashing::Hash64Append(_parameters.m_letterSpacing, hash);
+        hash = Hashing::Hash64Append(_parameters.m_lineSpacing, hash);
+        hash = Hashing::Hash64Append(_parameters.m_kerning, hash);
+        return hash;
+    }
+
+    TextShaper::Statistics TextShaper::GetStatistics() const
+    {
+        return {
+            .m_cacheHits = m_cacheHits.load(std::memory_order_relaxed),
+            .m_cacheMisses = m_cacheMisses.load(std::memory_order_relaxed),
+            .m_shapedGlyphs = m_shapedGlyphs.load(std::memory_order_relaxed),
+        };
+    }
+
+    void TextShaper::ResetStatistics()
+    {
+        m_cacheHits.store(0, std::memory_order_relaxed);
+        m_cacheMisses.store(0, std::memory_order_relaxed);
+        m_shapedGlyphs.store(0, std::memory_order_relaxed);
+    }
+}
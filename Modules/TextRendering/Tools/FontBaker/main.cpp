@@ -0,0 +1,197 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <EASTL/vector.h>
+#include <KryneEngine/Modules/FileSystem/VirtualFileSystem.hpp>
+#include <KryneEngine/Modules/Resources/Loaders/SerialResourceLoader.hpp>
+#include <KryneEngine/Modules/Resources/RuntimeResourceSystem.hpp>
+#include <KryneEngine/Modules/TextRendering/Font.hpp>
+#include <KryneEngine/Modules/TextRendering/FontBaker.hpp>
+#include <KryneEngine/Modules/TextRendering/FontManager.hpp>
+
+using namespace KryneEngine;
+using namespace KryneEngine::Modules;
+using namespace KryneEngine::Modules::TextRendering;
+
+namespace
+{
+    void PrintUsage()
+    {
+        printf(
+            "Usage: KryneFontBaker <input font (.ttf, .otf)> <output file (.ke_pbf)> [options]\n"
+            "\n"
+            "Options:\n"
+            "  --ranges <ranges>        Comma separated codepoint ranges, e.g. '0x20-0x7e,0xa0-0xff,0x20ac'\n"
+            "                           Defaults to printable ASCII (0x20-0x7e)\n"
+            "  --msdf-size <px>         Font size the MSDF bitmaps are generated at (default: 32)\n"
+            "  --no-msdf                Don't bake MSDF bitmaps\n"
+            "  --no-outlines            Don't bake glyph outlines\n"
+            "  --no-kerning             Don't bake kerning pairs\n"
+            "  --uncompressed           Don't use zstd compression\n"
+            "  --level <level>          zstd compression level (default: %d)\n"
+            "  --dict-size <bytes>      zstd dictionary capacity, 0 to disable the dictionary (default: %zu)\n",
+            PreBakedFontFile::kDefaultCompressionLevel,
+            PreBakedFontFile::kDefaultDictionaryCapacity);
+    }
+
+    bool ParseRanges(const char* _string, eastl::vector<FontBaker::CodepointRange>& _ranges)
+    {
+        const char* current = _string;
+        while (*current != '\0')
+        {
+            char* end;
+            const u32 first = strtoul(current, &end, 0);
+            if (end == current)
+                return false;
+            u32 last = first;
+            current = end;
+
+            if (*current == '-')
+            {
+                ++current;
+                last = strtoul(current, &end, 0);
+                if (end == current || last < first)
+                    return false;
+                current = end;
+            }
+
+            _ranges.push_back({ first, last });
+
+            if (*current == ',')
+                ++current;
+            else if (*current != '\0')
+                return false;
+        }
+        return !_ranges.empty();
+    }
+
+    double ToMilliseconds(const u64 _nanoseconds)
+    {
+        return static_cast<double>(_nanoseconds) * 1e-6;
+    }
+}
+
+s32 main(const s32 _argc, const char** _argv)
+{
+    if (_argc < 3)
+    {
+        PrintUsage();
+        return EXIT_FAILURE;
+    }
+
+    const char* inputPath = _argv[1];
+    const char* outputPath = _argv[2];
+
+    const AllocatorInstance allocator {};
+    eastl::vector<FontBaker::CodepointRange> ranges(allocator);
+    FontBaker::Settings settings {};
+
+    for (s32 i = 3; i < _argc; ++i)
+    {
+        const char* argument = _argv[i];
+        const bool hasValue = i + 1 < _argc;
+
+        if (strcmp(argument, "--ranges") == 0 && hasValue)
+        {
+            if (!ParseRanges(_argv[++i], ranges))
+            {
+                fprintf(stderr, "Invalid codepoint ranges '%s'\n", _argv[i]);
+                return EXIT_FAILURE;
+            }
+        }
+        else if (strcmp(argument, "--msdf-size") == 0 && hasValue)
+            settings.m_msdfFontSize = static_cast<u16>(strtoul(_argv[++i], nullptr, 0));
+        else if (strcmp(argument, "--no-msdf") == 0)
+            settings.m_renderInfo &= ~PreBakedFontFile::BakedRenderInfo::Msdf;
+        else if (strcmp(argument, "--no-outlines") == 0)
+            settings.m_renderInfo &= ~PreBakedFontFile::BakedRenderInfo::Outlines;
+        else if (strcmp(argument, "--no-kerning") == 0)
+            settings.m_kerning = false;
+        else if (strcmp(argument, "--uncompressed") == 0)
+            settings.m_compressed = false;
+        else if (strcmp(argument, "--level") == 0 && hasValue)
+            settings.m_compressionLevel = static_cast<s32>(strtol(_argv[++i], nullptr, 0));
+        else if (strcmp(argument, "--dict-size") == 0 && hasValue)
+            settings.m_dictionaryCapacity = strtoull(_argv[++i], nullptr, 0);
+        else
+        {
+            fprintf(stderr, "Unknown or incomplete option '%s'\n", argument);
+            PrintUsage();
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (ranges.empty())
+        ranges.push_back({ 0x20, 0x7e });
+    settings.m_ranges = ranges;
+
+    if (settings.m_msdfFontSize == 0)
+    {
+        fprintf(stderr, "MSDF font size must be non-zero\n");
+        return EXIT_FAILURE;
+    }
+
+    FileSystem::VirtualFileSystem fileSystem(allocator);
+    Resources::SerialResourceLoader resourceLoader(allocator, &fileSystem);
+    Resources::RuntimeResourceSystem resourceSystem(allocator, &resourceLoader);
+    FontManager fontManager(allocator);
+    resourceSystem.RegisterResourceManager<Font>(&fontManager);
+
+    const StringHash path { inputPath };
+    Resources::ResourceEntry* entry = resourceSystem.GetResourceEntry<Font>(path);
+    resourceSystem.LoadResource(path, entry);
+    Font* font = entry->UseResource<Font>();
+    if (font == nullptr)
+    {
+        fprintf(stderr, "Failed to load font '%s'\n", inputPath);
+        return EXIT_FAILURE;
+    }
+
+    FontBaker::Statistics statistics {};
+    const eastl::span<std::byte> baked = FontBaker::Bake(font, settings, allocator, &statistics);
+    if (baked.empty())
+    {
+        fprintf(stderr, "Failed to bake font '%s'\n", inputPath);
+        return EXIT_FAILURE;
+    }
+
+    {
+        std::ofstream file(outputPath, std::ios::binary | std::ios::out);
+        file.write(reinterpret_cast<const char*>(baked.data()), static_cast<std::streamsize>(baked.size()));
+        if (!file.good())
+        {
+            fprintf(stderr, "Failed to write '%s'\n", outputPath);
+            allocator.deallocate(baked.data(), baked.size());
+            return EXIT_FAILURE;
+        }
+    }
+    allocator.deallocate(baked.data(), baked.size());
+
+    printf("Baked '%s' into '%s'\n", inputPath, outputPath);
+    printf("  Glyphs:          %u / %u requested codepoints\n", statistics.m_bakedGlyphs, statistics.m_requestedCodepoints);
+    printf("  Kerning pairs:   %u\n", statistics.m_kerningPairs);
+    printf("  MSDF data:       %llu bytes\n", static_cast<unsigned long long>(statistics.m_msdfBytes));
+    printf("  Outline data:    %llu bytes\n", static_cast<unsigned long long>(statistics.m_outlineBytes));
+    printf("  Uncompressed:    %llu bytes\n", static_cast<unsigned long long>(statistics.m_uncompressedSize));
+    printf(
+        "  Output:          %llu bytes (ratio %.2f)\n",
+        static_cast<unsigned long long>(statistics.m_bakedSize),
+        statistics.m_bakedSize > 0
+            ? static_cast<double>(statistics.m_uncompressedSize) / static_cast<double>(statistics.m_bakedSize)
+            : 0.0);
+    printf(
+        "  Timings:         glyphs %.2f ms, kerning %.2f ms, MSDF %.2f ms, bake %.2f ms\n",
+        ToMilliseconds(statistics.m_glyphGatherDuration),
+        ToMilliseconds(statistics.m_kerningDuration),
+        ToMilliseconds(statistics.m_msdfDuration),
+        ToMilliseconds(statistics.m_bakeDuration));
+
+    return EXIT_SUCCESS;
+}
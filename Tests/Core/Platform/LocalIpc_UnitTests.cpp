@@ -0,0 +1,308 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#if defined(__linux__)
+
+#include <chrono>
+#include <cstdio>
+#include <EASTL/algorithm.h>
+#include <EASTL/vector.h>
+#include <KryneEngine/Core/Platform/Platform.hpp>
+#include <gtest/gtest.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Tests
+{
+    namespace
+    {
+        // Runs the function in a child process, and returns its pid. The child exits with 0 on success.
+        template <class Function>
+        pid_t RunChildProcess(Function&& _function)
+        {
+            const pid_t pid = fork();
+            if (pid == 0)
+            {
+                const bool success = _function();
+                fflush(stdout);
+                _exit(success ? 0 : 1);
+            }
+            return pid;
+        }
+
+        bool WaitChildProcess(const pid_t _pid)
+        {
+            s32 status = 0;
+            return waitpid(_pid, &status, 0) == _pid && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        }
+
+        void MakeConnectionName(char (&_name)[64], const char* _suffix)
+        {
+            snprintf(_name, sizeof(_name), "test_%d_%s", getpid(), _suffix);
+        }
+
+        // Socket and channel transports, behind the same calls
+        template <class Connection>
+        bool ReceiveAll(Connection _connection, char* _data, const size_t _size)
+        {
+            size_t received = 0;
+            while (received < _size)
+            {
+                const size_t count = Platform::ReceiveLocalIpc(_connection, { _data + received, _size - received });
+                if (count == 0 || count == static_cast<size_t>(-1))
+                    return false;
+                received += count;
+            }
+            return true;
+        }
+
+        template <class Connection>
+        bool SendAll(Connection _connection, char* _data, const size_t _size)
+        {
+            size_t sent = 0;
+            while (sent < _size)
+            {
+                const size_t count = Platform::SendLocalIpc(_connection, { _data + sent, _size - sent });
+                if (count == 0)
+                    return false;
+                sent += count;
+            }
+            return true;
+        }
+
+        struct BenchmarkResult
+        {
+            double m_throughputMiBps;
+            double m_roundTripMicroseconds;
+        };
+
+        constexpr size_t kThroughputBytes = 256 * 1024 * 1024;
+        constexpr size_t kThroughputChunkSize = 64 * 1024;
+        constexpr u32 kRoundTrips = 10'000;
+        constexpr size_t kRoundTripSize = 64;
+
+        // Host side of the benchmark: streams the payload, then measures ping-pong round trips.
+        template <class Connection>
+        BenchmarkResult RunBenchmarkHost(Connection _connection)
+        {
+            eastl::vector<char> buffer(kThroughputChunkSize, 0x5a);
+            BenchmarkResult result {};
+
+            const auto streamStart = std::chrono::steady_clock::now();
+            for (size_t sent = 0; sent < kThroughputBytes; sent += kThroughputChunkSize)
+                EXPECT_TRUE(SendAll(_connection, buffer.data(), kThroughputChunkSize));
+
+            // Wait for the client to have received everything
+            char ack = 0;
+            EXPECT_TRUE(ReceiveAll(_connection, &ack, 1));
+            const std::chrono::duration<double> streamTime = std::chrono::steady_clock::now() - streamStart;
+            result.m_throughputMiBps = static_cast<double>(kThroughputBytes) / (1024.0 * 1024.0) / streamTime.count();
+
+            const auto pingStart = std::chrono::steady_clock::now();
+            for (u32 i = 0; i < kRoundTrips; i++)
+            {
+                EXPECT_TRUE(SendAll(_connection, buffer.data(), kRoundTripSize));
+                EXPECT_TRUE(ReceiveAll(_connection, buffer.data(), kRoundTripSize));
+            }
+            const std::chrono::duration<double, std::micro> pingTime = std::chrono::steady_clock::now() - pingStart;
+            result.m_roundTripMicroseconds = pingTime.count() / kRoundTrips;
+
+            return result;
+        }
+
+        template <class Connection>
+        bool RunBenchmarkClient(Connection _connection)
+        {
+            eastl::vector<char> buffer(kThroughputChunkSize);
+
+            size_t received = 0;
+            while (received < kThroughputBytes)
+            {
+                const size_t count = Platform::ReceiveLocalIpc(_connection, { buffer.data(), buffer.size() });
+                if (count == 0 || count == static_cast<size_t>(-1))
+                    return false;
+                received += count;
+            }
+
+            char ack = 1;
+            if (!SendAll(_connection, &ack, 1))
+                return false;
+
+            for (u32 i = 0; i < kRoundTrips; i++)
+            {
+                if (!ReceiveAll(_connection, buffer.data(), kRoundTripSize)
+                    || !SendAll(_connection, buffer.data(), kRoundTripSize))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+    }
+
+    TEST(LocalIpc, ChannelRoundTrip)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        char name[64];
+        MakeConnectionName(name, "channel");
+        const Platform::LocalIpcHost host = Platform::HostLocalIpc(name, AllocatorInstance());
+        ASSERT_TRUE(host.IsValid());
+
+        constexpr u32 capacity = 64 * 1024;
+        constexpr size_t totalSize = 4 * 1024 * 1024;
+
+        // Echoes everything back, in the chunks it was received in
+        const pid_t child = RunChildProcess([&name]
+        {
+            const Platform::LocalIpcClient client = Platform::ConnectToLocalIpc(name, AllocatorInstance());
+            if (!client.IsValid())
+                return false;
+            const Platform::LocalIpcChannel channel = Platform::OpenLocalIpcChannel(client, AllocatorInstance());
+            if (!channel.IsValid())
+                return false;
+
+            eastl::vector<char> buffer(capacity);
+            size_t count;
+            while ((count = Platform::ReceiveLocalIpc(channel, { buffer.data(), buffer.size() })) > 0)
+            {
+                if (!SendAll(channel, buffer.data(), count))
+                    return false;
+            }
+
+            Platform::CloseLocalIpcChannel(channel, AllocatorInstance());
+            Platform::CloseLocalIpcClient(client, AllocatorInstance());
+            return true;
+        });
+
+        Platform::AcceptConnectionLocalIpc(host);
+        const Platform::LocalIpcChannel channel = Platform::CreateLocalIpcChannel(host, AllocatorInstance(), capacity);
+        ASSERT_TRUE(channel.IsValid());
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        eastl::vector<char> sent(totalSize);
+        for (size_t i = 0; i < totalSize; i++)
+            sent[i] = static_cast<char>((i * 31) ^ (i >> 11));
+
+        // Odd chunk sizes, so the ring wraps around at various positions. Each chunk fits in the ring, so the echo
+        // never blocks both sides at once.
+        eastl::vector<char> received(totalSize);
+        bool success = true;
+        size_t offset = 0;
+        for (u32 i = 0; offset < totalSize && success; i++)
+        {
+            const size_t chunkSize = eastl::min<size_t>(1 + (i * 7919) % (capacity - 1), totalSize - offset);
+            success = SendAll(channel, sent.data() + offset, chunkSize)
+                && ReceiveAll(channel, received.data() + offset, chunkSize);
+            offset += chunkSize;
+        }
+
+        Platform::CloseLocalIpcChannel(channel, AllocatorInstance());
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_TRUE(success);
+        EXPECT_TRUE(sent == received);
+        EXPECT_TRUE(WaitChildProcess(child));
+
+        Platform::CloseLocalIpcHost(host, AllocatorInstance());
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(LocalIpc, DISABLED_TransportBenchmark)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        char socketName[64];
+        MakeConnectionName(socketName, "socket");
+        char channelName[64];
+        MakeConnectionName(channelName, "shm");
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        BenchmarkResult socketResult;
+        {
+            const Platform::LocalIpcHost host = Platform::HostLocalIpc(socketName, AllocatorInstance());
+            ASSERT_TRUE(host.IsValid());
+
+            const pid_t child = RunChildProcess([&socketName]
+            {
+                const Platform::LocalIpcClient client = Platform::ConnectToLocalIpc(socketName, AllocatorInstance());
+                const bool success = client.IsValid() && RunBenchmarkClient(client);
+                if (client.IsValid())
+                    Platform::CloseLocalIpcClient(client, AllocatorInstance());
+                return success;
+            });
+
+            Platform::AcceptConnectionLocalIpc(host);
+            socketResult = RunBenchmarkHost(host);
+            EXPECT_TRUE(WaitChildProcess(child));
+            Platform::CloseLocalIpcHost(host, AllocatorInstance());
+        }
+
+        BenchmarkResult channelResult;
+        {
+            const Platform::LocalIpcHost host = Platform::HostLocalIpc(channelName, AllocatorInstance());
+            ASSERT_TRUE(host.IsValid());
+
+            const pid_t child = RunChildProcess([&channelName]
+            {
+                const Platform::LocalIpcClient client = Platform::ConnectToLocalIpc(channelName, AllocatorInstance());
+                if (!client.IsValid())
+                    return false;
+                const Platform::LocalIpcChannel channel = Platform::OpenLocalIpcChannel(client, AllocatorInstance());
+                const bool success = channel.IsValid() && RunBenchmarkClient(channel);
+                if (channel.IsValid())
+                    Platform::CloseLocalIpcChannel(channel, AllocatorInstance());
+                Platform::CloseLocalIpcClient(client, AllocatorInstance());
+                return success;
+            });
+
+            Platform::AcceptConnectionLocalIpc(host);
+            const Platform::LocalIpcChannel channel = Platform::CreateLocalIpcChannel(host, AllocatorInstance());
+            ASSERT_TRUE(channel.IsValid());
+            channelResult = RunBenchmarkHost(channel);
+            Platform::CloseLocalIpcChannel(channel, AllocatorInstance());
+            EXPECT_TRUE(WaitChildProcess(child));
+            Platform::CloseLocalIpcHost(host, AllocatorInstance());
+        }
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        printf(
+            "Socket: %.0f MiB/s, %.2f us round trip\n",
+            socketResult.m_throughputMiBps,
+            socketResult.m_roundTripMicroseconds);
+        printf(
+            "Shared memory channel: %.0f MiB/s, %.2f us round trip\n",
+            channelResult.m_throughputMiBps,
+            channelResult.m_roundTripMicroseconds);
+
+        catcher.ExpectNoMessage();
+    }
+}
+
+#endif
@@ -0,0 +1,225 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <gtest/gtest.h>
+#include <KryneEngine/Core/Profiling/FrameStatistics.hpp>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Tests
+{
+    namespace
+    {
+        constexpr u64 kMs = 1'000'000;
+
+        // Synthetic clock, only advanced explicitly by the frame loop
+        struct FakeClock
+        {
+            u64 m_time = 0;
+
+            static u64 GetTime(void* _userData)
+            {
+                return static_cast<FakeClock*>(_userData)->m_time;
+            }
+        };
+
+        // Mimics the graphics context frame end: a submit phase, with a nested wait on the previous frames.
+        void RunFrame(FrameStatistics& _statistics, FakeClock& _clock, u64 _frameId, u64 _cpu, u64 _submit, u64 _wait)
+        {
+            _clock.m_time += _cpu;
+            {
+                const FrameStatistics::ScopedPhase submitPhase(&_statistics, FrameStatistics::Timing::Submit);
+                _clock.m_time += _submit;
+                {
+                    const FrameStatistics::ScopedPhase waitPhase(&_statistics, FrameStatistics::Timing::PresentWait);
+                    _clock.m_time += _wait;
+                }
+            }
+            _statistics.EndFrame(_frameId);
+        }
+    }
+
+    TEST(FrameStatistics, TimingsAndRollingStatistics)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        FakeClock clock;
+        FrameStatistics statistics(AllocatorInstance(), {
+            .m_historySize = 64,
+            .m_rollingWindow = 100,
+            .m_clock = FakeClock::GetTime,
+            .m_clockUserData = &clock,
+        });
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        // CPU time goes from 1 to 100ms, only the last 64 frames are kept
+        for (u64 i = 1; i <= 100; i++)
+        {
+            RunFrame(statistics, clock, i, i * kMs, 2 * kMs, 3 * kMs);
+        }
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(statistics.GetFrameCount(), 64);
+
+        const FrameStatistics::FrameRecord& last = statistics.GetFrame(0);
+        EXPECT_EQ(last.m_frameId, 100);
+        EXPECT_EQ(last.GetTiming(FrameStatistics::Timing::Cpu), 100 * kMs);
+        EXPECT_EQ(last.GetTiming(FrameStatistics::Timing::Submit), 2 * kMs);
+        EXPECT_EQ(last.GetTiming(FrameStatistics::Timing::PresentWait), 3 * kMs);
+        EXPECT_EQ(last.GetTiming(FrameStatistics::Timing::Frame), 105 * kMs);
+        EXPECT_EQ(statistics.GetFrame(63).m_frameId, 37);
+
+        // Rolling window is clamped to the history size
+        const FrameStatistics::RollingStatistics cpu = statistics.GetRollingStatistics(FrameStatistics::Timing::Cpu);
+        EXPECT_EQ(cpu.m_frameCount, 64);
+        EXPECT_EQ(cpu.m_p50, 68 * kMs);
+        EXPECT_EQ(cpu.m_p95, 97 * kMs);
+        EXPECT_EQ(cpu.m_p99, 100 * kMs);
+        EXPECT_EQ(cpu.m_max, 100 * kMs);
+
+        const FrameStatistics::RollingStatistics wait =
+            statistics.GetRollingStatistics(FrameStatistics::Timing::PresentWait);
+        EXPECT_EQ(wait.m_p50, 3 * kMs);
+        EXPECT_EQ(wait.m_max, 3 * kMs);
+
+        // A steady ramp never spikes
+        EXPECT_EQ(statistics.GetSpikeCount(), 0);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(FrameStatistics, SpikeAttribution)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        FakeClock clock;
+        MetricsRegistry metrics(AllocatorInstance(), 1);
+        FrameStatistics statistics(AllocatorInstance(), {
+            .m_metrics = &metrics,
+            .m_clock = FakeClock::GetTime,
+            .m_clockUserData = &clock,
+        });
+        FrameStatistics::SetInstance(&statistics);
+
+        static constexpr const char* kShaderZone = "Shader compilation";
+        static constexpr const char* kGlyphZone = "Glyph generation";
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        u64 frameId = 0;
+        for (; frameId < 30; frameId++)
+        {
+            // Small zones in steady frames are not reported
+            {
+                const FrameStatistics::ScopedZone zone(kGlyphZone);
+                clock.m_time += kMs;
+            }
+            RunFrame(statistics, clock, frameId, 13 * kMs, kMs, kMs);
+        }
+
+        // Stutter: a long zone on the frame thread, and a shorter one on another thread
+        const u64 spikeStart = clock.m_time;
+        {
+            const FrameStatistics::ScopedZone zone(kShaderZone);
+            clock.m_time += 40 * kMs;
+        }
+        statistics.RecordZone(kGlyphZone, spikeStart + 5 * kMs, spikeStart + 15 * kMs);
+        statistics.RecordZone(kGlyphZone, spikeStart + 20 * kMs, spikeStart + 22 * kMs);
+        RunFrame(statistics, clock, frameId++, 0, kMs, kMs);
+
+        // Back to normal
+        RunFrame(statistics, clock, frameId++, 14 * kMs, kMs, kMs);
+
+        eastl::string json;
+        statistics.WriteHistoryJson(json);
+
+        FrameStatistics::SetInstance(nullptr);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(statistics.GetSpikeCount(), 1);
+        EXPECT_FALSE(statistics.GetFrame(0).m_spike);
+        EXPECT_FALSE(statistics.GetFrame(2).m_spike);
+
+        const FrameStatistics::FrameRecord& spike = statistics.GetFrame(1);
+        EXPECT_TRUE(spike.m_spike);
+        EXPECT_EQ(spike.GetTiming(FrameStatistics::Timing::Frame), 42 * kMs);
+        ASSERT_EQ(spike.m_attributedZoneCount, 2);
+        EXPECT_EQ(spike.m_attributedZones[0].m_name, kShaderZone);
+        EXPECT_EQ(spike.m_attributedZones[0].m_count, 1);
+        EXPECT_EQ(spike.m_attributedZones[0].m_duration, 40 * kMs);
+        EXPECT_EQ(spike.m_attributedZones[1].m_name, kGlyphZone);
+        EXPECT_EQ(spike.m_attributedZones[1].m_count, 2);
+        EXPECT_EQ(spike.m_attributedZones[1].m_duration, 12 * kMs);
+
+        // Timings are mirrored in the metrics
+        const MetricsSnapshot& snapshot = metrics.CaptureFrame(0);
+        ASSERT_EQ(snapshot.m_counters.size(), 1);
+        EXPECT_EQ(snapshot.m_counters[0].m_name, "frame/spikes");
+        EXPECT_EQ(snapshot.m_counters[0].m_total, 1);
+        ASSERT_EQ(snapshot.m_histograms.size(), FrameStatistics::kTimingCount);
+        EXPECT_EQ(snapshot.m_histograms[0].m_name, "frame/total");
+        EXPECT_EQ(snapshot.m_histograms[0].m_count, 32);
+
+        EXPECT_NE(
+            json.find("\"spike\":true,\"zones\":[{\"name\":\"Shader compilation\",\"count\":1,\"duration\":40000000}"),
+            eastl::string::npos);
+        EXPECT_NE(json.find("\"spikes\":1,\"rolling\":{\"frame\":{"), eastl::string::npos);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(FrameStatistics, MismatchingPhases)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        FakeClock clock;
+        FrameStatistics statistics(AllocatorInstance(), {
+            .m_clock = FakeClock::GetTime,
+            .m_clockUserData = &clock,
+        });
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        statistics.BeginPhase(FrameStatistics::Timing::Frame);
+        statistics.EndPhase(FrameStatistics::Timing::Submit);
+        statistics.BeginPhase(FrameStatistics::Timing::Submit);
+        clock.m_time += kMs;
+        statistics.EndFrame(0);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        catcher.ExpectMessageCount(3);
+        EXPECT_EQ(statistics.GetFrame(0).GetTiming(FrameStatistics::Timing::Submit), kMs);
+        EXPECT_EQ(statistics.GetFrame(0).GetTiming(FrameStatistics::Timing::Frame), kMs);
+    }
+}
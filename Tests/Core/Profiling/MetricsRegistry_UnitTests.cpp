@@ -0,0 +1,305 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <EASTL/vector.h>
+#include <gtest/gtest.h>
+#include <KryneEngine/Core/Profiling/MetricsRegistry.hpp>
+#include <thread>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Tests
+{
+    TEST(MetricsRegistry, HistogramBuckets)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        // -----------------------------------------------------------------------
+        // Execute & Verify
+        // -----------------------------------------------------------------------
+
+        // Small values are exact
+        for (u64 value = 0; value < MetricsRegistry::kHistogramSubBucketCount; value++)
+        {
+            EXPECT_EQ(MetricsRegistry::GetHistogramBucket(value), value);
+        }
+
+        // Every value falls within the bounds of its bucket
+        for (u64 value = 1; value < MetricsRegistry::kHistogramMaxValue; value = value * 3 / 2 + 1)
+        {
+            const u32 bucket = MetricsRegistry::GetHistogramBucket(value);
+            EXPECT_LE(MetricsRegistry::GetHistogramBucketLowerBound(bucket), value);
+            EXPECT_GT(MetricsRegistry::GetHistogramBucketLowerBound(bucket + 1), value);
+        }
+
+        // Values past the maximum are clamped to the last bucket
+        EXPECT_EQ(
+            MetricsRegistry::GetHistogramBucket(~0ull),
+            MetricsRegistry::kHistogramBucketCount - 1);
+        EXPECT_EQ(
+            MetricsRegistry::GetHistogramBucket(MetricsRegistry::kHistogramMaxValue),
+            MetricsRegistry::kHistogramBucketCount - 1);
+
+        // Percentiles, with a relative error bound by the bucket width
+        eastl::vector<u64> buckets(MetricsRegistry::kHistogramBucketCount, 0);
+        for (u64 value = 1; value <= 1000; value++)
+        {
+            buckets[MetricsRegistry::GetHistogramBucket(value * 1000)]++;
+        }
+        EXPECT_NEAR(MetricsRegistry::EstimatePercentile(buckets, 0.5), 500'000, 500'000 / 8);
+        EXPECT_NEAR(MetricsRegistry::EstimatePercentile(buckets, 0.99), 990'000, 990'000 / 8);
+        EXPECT_EQ(MetricsRegistry::EstimatePercentile(eastl::vector<u64>(4, 0), 0.5), 0);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(MetricsRegistry, ConcurrentUpdatesAndFrames)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        MetricsRegistry registry(AllocatorInstance(), 4);
+        const MetricsCounterId jobs = registry.RegisterCounter("jobs");
+        const MetricsHistogramId latency = registry.RegisterHistogram("latency");
+        const MetricsGaugeId memory = registry.RegisterGauge("memory");
+
+        constexpr u32 threadCount = 8;
+        constexpr u32 updatesPerThread = 100'000;
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        const auto runThreads = [&]
+        {
+            eastl::vector<std::thread> threads;
+            for (u32 i = 0; i < threadCount; i++)
+            {
+                threads.emplace_back([&registry, jobs, latency, i]
+                {
+                    for (u32 j = 0; j < updatesPerThread; j++)
+                    {
+                        registry.Increment(jobs);
+                        registry.Record(latency, i);
+                    }
+                });
+            }
+            for (std::thread& thread: threads)
+            {
+                thread.join();
+            }
+        };
+
+        runThreads();
+        registry.SetGauge(memory, 1024);
+        registry.AddGauge(memory, -24);
+        const MetricsSnapshot firstFrame = registry.CaptureFrame(0);
+
+        registry.Increment(jobs, 5);
+        const MetricsSnapshot& secondFrame = registry.CaptureFrame(1);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        // Registering again returns the same metric
+        EXPECT_EQ(registry.RegisterCounter("jobs").m_slot, jobs.m_slot);
+
+        ASSERT_EQ(firstFrame.m_counters.size(), 1);
+        EXPECT_EQ(firstFrame.m_counters[0].m_name, "jobs");
+        EXPECT_EQ(firstFrame.m_counters[0].m_total, threadCount * updatesPerThread);
+        EXPECT_EQ(firstFrame.m_counters[0].m_frameDelta, threadCount * updatesPerThread);
+
+        ASSERT_EQ(firstFrame.m_gauges.size(), 1);
+        EXPECT_EQ(firstFrame.m_gauges[0].m_value, 1000);
+
+        ASSERT_EQ(firstFrame.m_histograms.size(), 1);
+        const MetricsSnapshot::Histogram& histogram = firstFrame.m_histograms[0];
+        EXPECT_EQ(histogram.m_count, threadCount * updatesPerThread);
+        EXPECT_EQ(histogram.m_sum, updatesPerThread * (threadCount * (threadCount - 1) / 2));
+        for (u32 i = 0; i < threadCount; i++)
+        {
+            EXPECT_EQ(histogram.m_buckets[i], updatesPerThread);
+        }
+
+        EXPECT_EQ(secondFrame.m_frameIndex, 1);
+        EXPECT_EQ(secondFrame.m_counters[0].m_total, threadCount * updatesPerThread + 5);
+        EXPECT_EQ(secondFrame.m_counters[0].m_frameDelta, 5);
+        EXPECT_EQ(secondFrame.m_histograms[0].m_count, threadCount * updatesPerThread);
+        EXPECT_EQ(secondFrame.m_histograms[0].m_frameCount, 0);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(MetricsRegistry, RegistrationErrors)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        // Room for a single histogram
+        MetricsRegistry registry(
+            AllocatorInstance(),
+            1,
+            2 * (MetricsRegistry::kHistogramBucketCount + 1));
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        const MetricsHistogramId histogram = registry.RegisterHistogram("histogram");
+        const MetricsCounterId mismatchingType = registry.RegisterCounter("histogram");
+        const MetricsHistogramId overflow = registry.RegisterHistogram("overflow");
+
+        // Updates through invalid ids are discarded
+        registry.Increment(mismatchingType);
+        registry.Record(overflow, 42);
+        registry.Record(histogram, 12);
+
+        const MetricsSnapshot& snapshot = registry.CaptureFrame(0);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        catcher.ExpectMessageCount(2);
+        EXPECT_NE(histogram.m_slot, 0);
+        EXPECT_EQ(mismatchingType.m_slot, 0);
+        EXPECT_EQ(overflow.m_slot, 0);
+
+        EXPECT_TRUE(snapshot.m_counters.empty());
+        ASSERT_EQ(snapshot.m_histograms.size(), 1);
+        EXPECT_EQ(snapshot.m_histograms[0].m_count, 1);
+        EXPECT_EQ(snapshot.m_histograms[0].m_sum, 12);
+    }
+
+    TEST(MetricsRegistry, JsonExport)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        MetricsRegistry registry(AllocatorInstance(), 1);
+        registry.Increment(registry.RegisterCounter("io/bytes\"read\""), 4096);
+        registry.SetGauge(registry.RegisterGauge("memory"), -3);
+        const MetricsHistogramId frameTime = registry.RegisterHistogram("frameTime");
+        registry.Record(frameTime, 3);
+        registry.Record(frameTime, 3);
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        eastl::string json;
+        MetricsRegistry::WriteJson(registry.CaptureFrame(7), json);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(
+            json,
+            "{\"frame\":7,"
+            "\"counters\":{\"io/bytes\\\"read\\\"\":{\"total\":4096,\"frame\":4096}},"
+            "\"gauges\":{\"memory\":-3},"
+            "\"histograms\":{\"frameTime\":{"
+            "\"count\":2,\"sum\":6,\"p50\":3,\"p90\":3,\"p99\":3,"
+            "\"frameCount\":2,\"frameSum\":6,\"framep50\":3,\"framep90\":3,\"framep99\":3,"
+            "\"buckets\":[[3,2]]}}}");
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(MetricsRegistry, DISABLED_UpdateBenchmark)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        MetricsRegistry registry(AllocatorInstance());
+        const MetricsCounterId counter = registry.RegisterCounter("counter");
+        const MetricsHistogramId histogram = registry.RegisterHistogram("histogram");
+
+        const u32 threadCount = eastl::max(std::thread::hardware_concurrency(), 1u);
+        constexpr u32 updatesPerThread = 4'000'000;
+
+        // Baseline: a single counter shared by all threads
+        std::atomic<u64> sharedCounter = 0;
+
+        const auto runThreads = [threadCount](const auto& _function)
+        {
+            const auto start = std::chrono::steady_clock::now();
+            eastl::vector<std::thread> threads;
+            for (u32 i = 0; i < threadCount; i++)
+            {
+                threads.emplace_back([&_function, i]
+                {
+                    for (u32 j = 0; j < updatesPerThread; j++)
+                    {
+                        _function(i, j);
+                    }
+                });
+            }
+            for (std::thread& thread: threads)
+            {
+                thread.join();
+            }
+            const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+            return duration.count() / updatesPerThread;
+        };
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        const double sharedTime = runThreads([&sharedCounter](u32, u32)
+        {
+            sharedCounter.fetch_add(1, std::memory_order_relaxed);
+        });
+        const double counterTime = runThreads([&registry, counter](u32, u32)
+        {
+            registry.Increment(counter);
+        });
+        const double histogramTime = runThreads([&registry, histogram](u32, u32 _j)
+        {
+            registry.Record(histogram, _j);
+        });
+
+        const auto captureStart = std::chrono::steady_clock::now();
+        const MetricsSnapshot& snapshot = registry.CaptureFrame(0);
+        const std::chrono::duration<double, std::micro> captureTime = std::chrono::steady_clock::now() - captureStart;
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(snapshot.m_counters[0].m_total, static_cast<u64>(threadCount) * updatesPerThread);
+        EXPECT_EQ(snapshot.m_histograms[0].m_count, static_cast<u64>(threadCount) * updatesPerThread);
+
+        printf("%u threads, %u shards\n", threadCount, registry.GetShardCount());
+        printf("Shared atomic counter: %.2f ns/update per thread\n", sharedTime);
+        printf("Sharded counter: %.2f ns/update per thread\n", counterTime);
+        printf("Sharded histogram: %.2f ns/update per thread\n", histogramTime);
+        printf("Frame capture: %.1f us\n", captureTime.count());
+
+        catcher.ExpectNoMessage();
+    }
+}
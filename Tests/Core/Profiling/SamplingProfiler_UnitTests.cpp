@@ -0,0 +1,142 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <gtest/gtest.h>
+#include <KryneEngine/Core/Profiling/SamplingProfiler.hpp>
+#include <KryneEngine/Core/Threads/FibersManager.hpp>
+#include <thread>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Tests
+{
+    namespace
+    {
+        struct BusyJobData
+        {
+            std::chrono::milliseconds m_duration;
+            std::atomic<u32> m_finishedCount = 0;
+            std::atomic<u64> m_sink = 0;
+        };
+
+        void BusyJob(void* _userData)
+        {
+            auto* data = static_cast<BusyJobData*>(_userData);
+
+            const auto end = std::chrono::steady_clock::now() + data->m_duration;
+            u64 value = 1;
+            while (std::chrono::steady_clock::now() < end)
+            {
+                for (u32 i = 0; i < 1000; i++)
+                {
+                    value = value * 6364136223846793005ull + 1442695040888963407ull;
+                }
+            }
+            data->m_sink.fetch_add(value, std::memory_order_relaxed);
+            data->m_finishedCount.fetch_add(1, std::memory_order_release);
+        }
+    }
+
+    TEST(SamplingProfiler, JobAttribution)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        constexpr u16 fiberThreadCount = 2;
+        constexpr u32 jobCount = 4;
+
+        FibersManager fibersManager(fiberThreadCount, AllocatorInstance());
+        FibersManager::SetInstance(&fibersManager);
+
+        SamplingProfiler profiler(AllocatorInstance(), &fibersManager, { .m_samplingIntervalUs = 500 });
+
+        BusyJobData data { std::chrono::milliseconds(100) };
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        ASSERT_TRUE(profiler.Start());
+
+        fibersManager.InitAndBatchNoCounterJobs(BusyJob, &data, jobCount);
+        while (data.m_finishedCount.load(std::memory_order_acquire) < jobCount)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        profiler.Stop();
+        EXPECT_FALSE(profiler.IsRunning());
+
+        eastl::vector<SamplingProfiler::Sample> samples;
+        eastl::vector<uintptr_t> frames;
+        profiler.CopySamples(samples, frames);
+
+        eastl::string foldedStacks;
+        profiler.WriteFoldedStacks(foldedStacks);
+        eastl::string perThreadFoldedStacks;
+        profiler.WriteFoldedStacks(perThreadFoldedStacks, true);
+
+        FibersManager::SetInstance(nullptr);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        ASSERT_FALSE(samples.empty());
+
+        u64 jobSampleCount = 0;
+        u64 jobFiberSampleCount = 0;
+        for (const SamplingProfiler::Sample& sample: samples)
+        {
+            EXPECT_LT(sample.m_fiberThreadIndex, fiberThreadCount);
+            EXPECT_GT(sample.m_frameCount, 0);
+            EXPECT_LE(sample.m_firstFrame + sample.m_frameCount, frames.size());
+            EXPECT_TRUE(sample.m_jobFunction == nullptr || sample.m_jobFunction == BusyJob);
+
+            if (sample.m_jobFunction == BusyJob)
+            {
+                jobSampleCount++;
+
+                // Jobs run on their own fiber context. Samples taken mid-switch may not match, so don't expect all.
+                if (sample.m_fiberId >= 0)
+                {
+                    jobFiberSampleCount++;
+                }
+            }
+        }
+        EXPECT_GT(jobSampleCount, 0);
+        EXPECT_GT(jobFiberSampleCount, 0);
+
+        // Every sample ends up in a folded stack line
+        const auto countFoldedSamples = [](const eastl::string& _foldedStacks, const char* _rootPrefix)
+        {
+            u64 total = 0;
+            size_t lineStart = 0;
+            while (lineStart < _foldedStacks.size())
+            {
+                const size_t lineEnd = _foldedStacks.find('\n', lineStart);
+                const eastl::string line = _foldedStacks.substr(lineStart, lineEnd - lineStart);
+                EXPECT_EQ(line.find(_rootPrefix), 0);
+
+                const size_t countStart = line.rfind(' ');
+                EXPECT_NE(countStart, eastl::string::npos);
+                total += strtoull(line.c_str() + countStart + 1, nullptr, 10);
+
+                lineStart = lineEnd + 1;
+            }
+            return total;
+        };
+        EXPECT_EQ(countFoldedSamples(perThreadFoldedStacks, "Fiber thread "), samples.size());
+        EXPECT_EQ(countFoldedSamples(foldedStacks, ""), samples.size());
+
+        catcher.ExpectNoMessage();
+    }
+}
@@ -0,0 +1,196 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <chrono>
+#include <gtest/gtest.h>
+#include <KryneEngine/Core/Threads/FibersManager.hpp>
+#include <thread>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Tests
+{
+    namespace
+    {
+        constexpr u32 kParentJobCount = 8;
+        constexpr u32 kChildJobCount = 4;
+
+        struct WorkloadData
+        {
+            std::atomic<u32> m_finishedParents = 0;
+            std::atomic<u32> m_finishedChildren = 0;
+        };
+
+        void ChildJob(void* _userData)
+        {
+            const auto end = std::chrono::steady_clock::now() + std::chrono::microseconds(200);
+            while (std::chrono::steady_clock::now() < end) {}
+
+            static_cast<WorkloadData*>(_userData)->m_finishedChildren.fetch_add(1, std::memory_order_release);
+        }
+
+        // Spawns children and waits on them, so the job is paused and resumed.
+        void ParentJob(void* _userData)
+        {
+            FibersManager* fibersManager = FibersManager::GetInstance();
+            const SyncCounterId counter = fibersManager->InitAndBatchJobs(ChildJob, _userData, kChildJobCount);
+            fibersManager->WaitForCounterAndReset(counter);
+
+            static_cast<WorkloadData*>(_userData)->m_finishedParents.fetch_add(1, std::memory_order_release);
+        }
+
+        // Job bodies end before the worker switches out of them, so poll until it was recorded.
+        SchedulerTelemetry::Snapshot WaitForFinishedJobs(const FibersManager& _fibersManager, const u64 _jobCount)
+        {
+            SchedulerTelemetry::Snapshot snapshot;
+            const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            do
+            {
+                _fibersManager.CaptureTelemetry(snapshot);
+                if (snapshot.GetTotalCounters().m_finishedJobs >= _jobCount)
+                {
+                    break;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            while (std::chrono::steady_clock::now() < timeout);
+            return snapshot;
+        }
+
+        u64 CountOccurrences(const eastl::string& _string, const char* _pattern)
+        {
+            u64 count = 0;
+            for (size_t position = _string.find(_pattern);
+                 position != eastl::string::npos;
+                 position = _string.find(_pattern, position + 1))
+            {
+                count++;
+            }
+            return count;
+        }
+    }
+
+    TEST(SchedulerTelemetry, SyntheticWorkload)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        constexpr u16 fiberThreadCount = 2;
+        constexpr u64 jobCount = kParentJobCount * (1 + kChildJobCount);
+
+        FibersManager fibersManager(fiberThreadCount, AllocatorInstance());
+        FibersManager::SetInstance(&fibersManager);
+        SchedulerTelemetry& telemetry = fibersManager.GetTelemetry();
+
+        WorkloadData data {};
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        telemetry.SetEnabled(true);
+        telemetry.SetTracingEnabled(true);
+
+        fibersManager.InitAndBatchNoCounterJobs(ParentJob, &data, kParentJobCount);
+        const SchedulerTelemetry::Snapshot snapshot = WaitForFinishedJobs(fibersManager, jobCount);
+
+        telemetry.SetTracingEnabled(false);
+        telemetry.SetEnabled(false);
+
+        eastl::string trace;
+        telemetry.WriteChromeTrace(trace);
+
+        // Nothing is recorded while disabled
+        WorkloadData untrackedData {};
+        fibersManager.InitAndBatchNoCounterJobs(ParentJob, &untrackedData, kParentJobCount);
+        while (untrackedData.m_finishedParents.load(std::memory_order_acquire) < kParentJobCount)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        SchedulerTelemetry::Snapshot disabledSnapshot;
+        fibersManager.CaptureTelemetry(disabledSnapshot);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(data.m_finishedParents.load(), kParentJobCount);
+        EXPECT_EQ(data.m_finishedChildren.load(), kParentJobCount * kChildJobCount);
+
+        ASSERT_EQ(snapshot.m_workers.size(), fiberThreadCount);
+        const SchedulerTelemetry::WorkerCounters total = snapshot.GetTotalCounters();
+
+        EXPECT_EQ(snapshot.m_queuedJobs, jobCount);
+        EXPECT_EQ(total.m_startedJobs, jobCount);
+        EXPECT_EQ(total.m_finishedJobs, jobCount);
+        EXPECT_EQ(total.m_counterWaits, kParentJobCount);
+        EXPECT_LE(total.m_blockingCounterWaits, kParentJobCount);
+
+        // Parents only yield when blocked, and every paused job is resumed
+        EXPECT_EQ(total.m_yields, total.m_blockingCounterWaits);
+        EXPECT_EQ(total.m_resumedJobs, total.m_yields);
+
+        // Each job slice is switched into at least once. A worker may switch from a job straight to the next one,
+        // without going back to its base fiber, so switches out aren't always counted separately.
+        EXPECT_GE(total.m_fiberSwitches, total.m_startedJobs + total.m_resumedJobs);
+        EXPECT_GE(total.m_busyTime, kParentJobCount * kChildJobCount * 200'000ull);
+        EXPECT_EQ(snapshot.m_externalCounterWaits, 0);
+
+        eastl::vector<u64> durationBuckets(MetricsRegistry::kHistogramBucketCount, 0);
+        u64 latencyCount = 0;
+        u64 durationCount = 0;
+        for (const SchedulerTelemetry::WorkerSnapshot& worker: snapshot.m_workers)
+        {
+            for (u32 i = 0; i < MetricsRegistry::kHistogramBucketCount; i++)
+            {
+                durationBuckets[i] += worker.m_durationBuckets[i];
+                latencyCount += worker.m_latencyBuckets[i];
+                durationCount += worker.m_durationBuckets[i];
+            }
+        }
+        EXPECT_EQ(latencyCount, jobCount);
+        EXPECT_EQ(durationCount, jobCount);
+
+        // Most jobs are children, which run for at least 200us. Allow for the bucket resolution.
+        EXPECT_GE(MetricsRegistry::EstimatePercentile(durationBuckets, 0.5), 200'000 * 7 / 8);
+
+        // One slice per start or resume, all closed as every job finished
+        EXPECT_EQ(telemetry.GetDroppedTraceEventCount(), 0);
+        EXPECT_EQ(trace.find("{\"traceEvents\":["), 0);
+        EXPECT_EQ(CountOccurrences(trace, "\"ph\":\"M\""), fiberThreadCount);
+        EXPECT_EQ(CountOccurrences(trace, "\"ph\":\"B\""), total.m_startedJobs + total.m_resumedJobs);
+        EXPECT_EQ(CountOccurrences(trace, "\"ph\":\"E\""), total.m_startedJobs + total.m_resumedJobs);
+        EXPECT_EQ(CountOccurrences(trace, "\"finished\":true"), jobCount);
+        EXPECT_EQ(CountOccurrences(trace, "\"resumed\":true"), total.m_resumedJobs);
+
+        const SchedulerTelemetry::WorkerCounters disabledTotal = disabledSnapshot.GetTotalCounters();
+        EXPECT_EQ(disabledSnapshot.m_queuedJobs, jobCount);
+        EXPECT_EQ(disabledTotal.m_startedJobs, jobCount);
+        EXPECT_EQ(disabledTotal.m_finishedJobs, jobCount);
+        EXPECT_EQ(disabledTotal.m_counterWaits, kParentJobCount);
+
+        // Queues are drained
+        for (const u64 depth: disabledSnapshot.m_queueDepths)
+        {
+            EXPECT_EQ(depth, 0);
+        }
+
+        // Reset clears everything
+        telemetry.Reset();
+        SchedulerTelemetry::Snapshot resetSnapshot;
+        fibersManager.CaptureTelemetry(resetSnapshot);
+        EXPECT_EQ(resetSnapshot.m_queuedJobs, 0);
+        EXPECT_EQ(resetSnapshot.GetTotalCounters().m_startedJobs, 0);
+
+        FibersManager::SetInstance(nullptr);
+
+        catcher.ExpectNoMessage();
+    }
+}
@@ -0,0 +1,248 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <EASTL/sort.h>
+#include <EASTL/vector.h>
+#include <gtest/gtest.h>
+#include <KryneEngine/Core/Window/Input/InputManager.hpp>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Tests
+{
+    static InputEvent MakeKeyEvent(s32 _customCode)
+    {
+        InputEvent event { .m_type = InputEvent::Type::Key };
+        event.m_key = {
+            .m_physicalKey = InputKeys::Unknown,
+            .m_customCode = _customCode,
+            .m_action = InputActionType::StartPress,
+            .m_modifiers = KeyInputModifiers::None,
+        };
+        return event;
+    }
+
+    static InputEvent MakeCursorPosEvent(float _x, float _y)
+    {
+        InputEvent event { .m_type = InputEvent::Type::CursorPos };
+        event.m_cursorPos = { _x, _y };
+        return event;
+    }
+
+    TEST(InputManager, BufferedDispatch)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        InputManager inputManager { nullptr, AllocatorInstance() };
+
+        eastl::vector<s32> received;
+        const u32 keyId = inputManager.RegisterKeyInputEventCallback(
+            [&](const KeyInputEvent& _event) { received.push_back(_event.m_customCode); });
+        (void)inputManager.RegisterCursorPosEventCallback(
+            [&](float _x, float) { received.push_back(-static_cast<s32>(_x)); });
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_TRUE(inputManager.PushEvent(MakeKeyEvent(1)));
+        EXPECT_TRUE(inputManager.PushEvent(MakeCursorPosEvent(2, 3)));
+        EXPECT_TRUE(inputManager.PushEvent(MakeKeyEvent(3)));
+
+        // Nothing is dispatched until the consumer drains the queue, cursor position included.
+        EXPECT_TRUE(received.empty());
+        EXPECT_EQ(inputManager.GetCursorPos().x, 0);
+
+        EXPECT_EQ(inputManager.DispatchEvents(), 3);
+        EXPECT_EQ(received, (eastl::vector<s32> { 1, -2, 3 }));
+        EXPECT_EQ(inputManager.GetCursorPos().x, 2);
+        EXPECT_EQ(inputManager.GetCursorPos().y, 3);
+
+        // Callbacks may unregister themselves and register new ones while being dispatched.
+        received.clear();
+        inputManager.UnregisterKeyInputEventCallback(keyId);
+        u32 selfId = 0;
+        selfId = inputManager.RegisterKeyInputEventCallback(
+            [&](const KeyInputEvent& _event)
+            {
+                received.push_back(_event.m_customCode * 10);
+                inputManager.UnregisterKeyInputEventCallback(selfId);
+            });
+
+        EXPECT_TRUE(inputManager.PushEvent(MakeKeyEvent(4)));
+        EXPECT_TRUE(inputManager.PushEvent(MakeKeyEvent(5)));
+        EXPECT_EQ(inputManager.DispatchEvents(), 2);
+
+        // The second event still goes to the snapshot taken by the dispatch of the first one.
+        EXPECT_EQ(received.front(), 40);
+        received.clear();
+
+        EXPECT_TRUE(inputManager.PushEvent(MakeKeyEvent(6)));
+        EXPECT_EQ(inputManager.DispatchEvents(), 1);
+        EXPECT_TRUE(received.empty());
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(InputManager, QueueOverflow)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        InputManager inputManager { nullptr, AllocatorInstance(), 5 };
+
+        eastl::vector<s32> received;
+        (void)inputManager.RegisterKeyInputEventCallback(
+            [&](const KeyInputEvent& _event) { received.push_back(_event.m_customCode); });
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        // Capacity is rounded up to 8
+        for (s32 i = 0; i < 10; i++)
+            (void)inputManager.PushEvent(MakeKeyEvent(i));
+
+        const u32 firstDispatch = inputManager.DispatchEvents();
+
+        // Wrap around the end of the ring
+        for (s32 i = 10; i < 16; i++)
+            (void)inputManager.PushEvent(MakeKeyEvent(i));
+
+        const u32 secondDispatch = inputManager.DispatchEvents();
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(firstDispatch, 8);
+        EXPECT_EQ(secondDispatch, 6);
+        EXPECT_EQ(inputManager.GetDroppedEventCount(), 2);
+
+        eastl::vector<s32> expected;
+        for (s32 i = 0; i < 8; i++)
+            expected.push_back(i);
+        for (s32 i = 10; i < 16; i++)
+            expected.push_back(i);
+        EXPECT_EQ(received, expected);
+
+        // A full queue isn't a drop when the caller retries
+        for (s32 i = 0; i < 8; i++)
+            EXPECT_TRUE(inputManager.TryPushEvent(MakeKeyEvent(i)));
+        EXPECT_FALSE(inputManager.TryPushEvent(MakeKeyEvent(8)));
+        EXPECT_EQ(inputManager.GetDroppedEventCount(), 2);
+        EXPECT_EQ(inputManager.DispatchEvents(), 8);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(InputManager, DISABLED_EventStormBenchmark)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        InputManager inputManager { nullptr, AllocatorInstance() };
+
+        using Clock = std::chrono::steady_clock;
+        constexpr u32 eventCount = 1 << 20;
+        eastl::vector<Clock::time_point> pushTimes(eventCount);
+        eastl::vector<double> latencies(eventCount, 0.0);
+
+        u32 receivedCount = 0;
+        bool inOrder = true;
+        (void)inputManager.RegisterKeyInputEventCallback(
+            [&](const KeyInputEvent& _event)
+            {
+                const u32 index = static_cast<u32>(_event.m_customCode);
+                inOrder &= index == receivedCount;
+                latencies[index] = std::chrono::duration<double, std::micro>(Clock::now() - pushTimes[index]).count();
+                receivedCount++;
+            });
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        std::atomic<bool> producerDone = false;
+        std::atomic<bool> stopRegistering = false;
+
+        // Platform thread, pushing events as fast as the queue allows. Retries on a full queue aren't drops.
+        std::thread producer([&]
+        {
+            for (u32 i = 0; i < eventCount; i++)
+            {
+                pushTimes[i] = Clock::now();
+                while (!inputManager.TryPushEvent(MakeKeyEvent(static_cast<s32>(i))))
+                    std::this_thread::yield();
+            }
+            producerDone.store(true, std::memory_order_release);
+        });
+
+        // Registration churn from another thread, which used to contend with the dispatch
+        u32 registrations = 0;
+        std::thread registerer([&]
+        {
+            while (!stopRegistering.load(std::memory_order_acquire))
+            {
+                const u32 id = inputManager.RegisterCursorPosEventCallback([](float, float) {});
+                inputManager.UnregisterCursorPosEventCallback(id);
+                registrations++;
+            }
+        });
+
+        // Consumer, draining the queue once per "frame"
+        u32 frames = 0;
+        const auto start = Clock::now();
+        while (!producerDone.load(std::memory_order_acquire) || receivedCount < eventCount)
+        {
+            inputManager.DispatchEvents();
+            frames++;
+        }
+        const std::chrono::duration<double, std::milli> totalTime = Clock::now() - start;
+
+        producer.join();
+        stopRegistering.store(true, std::memory_order_release);
+        registerer.join();
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(receivedCount, eventCount);
+        EXPECT_TRUE(inOrder);
+        EXPECT_EQ(inputManager.GetDroppedEventCount(), 0);
+
+        eastl::sort(latencies.begin(), latencies.end());
+        double sum = 0;
+        for (const double latency: latencies)
+            sum += latency;
+
+        printf(
+            "Input event storm: %u events over %u dispatches in %.1f ms, %u concurrent registrations. "
+            "Per-event latency: mean %.2f us, p50 %.2f us, p99 %.2f us, max %.2f us\n",
+            eventCount,
+            frames,
+            totalTime.count(),
+            registrations,
+            sum / eventCount,
+            latencies[eventCount / 2],
+            latencies[eventCount * 99 / 100],
+            latencies.back());
+
+        catcher.ExpectNoMessage();
+    }
+}
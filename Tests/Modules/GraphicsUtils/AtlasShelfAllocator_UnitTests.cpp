@@ -4,6 +4,8 @@
  * @date 08/01/2026.
  */
 
+#include <chrono>
+#include <cstdio>
 #include <EASTL/span.h>
 #include <EASTL/vector_set.h>
 #include <KryneEngine/Core/Math/Color.hpp>
@@ -835,4 +837,340 @@ namespace KryneEngine::Modules::GraphicsUtils::Tests
 
         EXPECT_TRUE(catcher.GetCaughtMessages().empty());
     }
-}
\ No newline at end of file
+
+    TEST(AtlasShelfAllocatorTests, LargestFreeSummary)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        AllocatorInstance cpuAllocator;
+        AtlasShelfAllocator atlasShelfAllocator(cpuAllocator, commonConfig);
+        AtlasShelfAllocatorExplorator explorer(&atlasShelfAllocator);
+
+        constexpr u32 height = 128;
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        const u32 slots[] = {
+            atlasShelfAllocator.Allocate({ 64, height }),
+            atlasShelfAllocator.Allocate({ 128, height }),
+            atlasShelfAllocator.Allocate({ 64, height }),
+        };
+        const u32 shelfIndex = explorer.GetFirstShelf(height);
+        EXPECT_EQ(explorer.GetShelf(shelfIndex).m_largestFree, explorer.GetShelfWidth() - 256);
+
+        // Filling the shelf tail leaves no free run
+        const u32 tail = atlasShelfAllocator.Allocate({ explorer.GetShelfWidth() - 256, height });
+        EXPECT_EQ(explorer.GetSlot(tail).m_shelf, shelfIndex);
+        EXPECT_EQ(explorer.GetShelf(shelfIndex).m_largestFree, 0);
+
+        atlasShelfAllocator.Free(slots[1]);
+        EXPECT_EQ(explorer.GetShelf(shelfIndex).m_largestFree, 128);
+
+        // Coalescing grows the run
+        atlasShelfAllocator.Free(slots[2]);
+        EXPECT_EQ(explorer.GetShelf(shelfIndex).m_largestFree, 192);
+
+        // Best fit: a small slot goes in the existing shelf run, not in a new shelf
+        const u32 small = atlasShelfAllocator.Allocate({ 32, height });
+        EXPECT_EQ(explorer.GetSlot(small).m_shelf, shelfIndex);
+        EXPECT_EQ(explorer.GetShelf(shelfIndex).m_largestFree, 160);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(AtlasShelfAllocatorTests, AllocateMany)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        AllocatorInstance cpuAllocator;
+        AtlasShelfAllocator atlasShelfAllocator(cpuAllocator, commonConfig);
+        AtlasShelfAllocatorExplorator explorer(&atlasShelfAllocator);
+
+        eastl::vector<uint2> sizes;
+        for (u32 i = 0; i < 128; i++)
+            sizes.push_back({ (12 + 3 * i) % 60 + 4, (12 + 2 * i) % 128 + 4 });
+        sizes.push_back({ 2048, 16 }); // Too wide, must fail without affecting the others
+
+        eastl::vector<u32> slots(sizes.size(), 0u);
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        const u32 successCount = atlasShelfAllocator.AllocateMany(sizes, slots);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(successCount, sizes.size() - 1);
+        EXPECT_EQ(slots.back(), AtlasShelfAllocator::kInvalidSlot);
+
+        // Output slots follow the input order
+        for (u32 i = 0; i + 1 < sizes.size(); i++)
+        {
+            ASSERT_NE(slots[i], AtlasShelfAllocator::kInvalidSlot);
+            const Rect rect = atlasShelfAllocator.GetSlotRect(slots[i]);
+            EXPECT_GE(rect.m_right - rect.m_left, sizes[i].x);
+            EXPECT_GE(rect.m_bottom - rect.m_top, sizes[i].y);
+        }
+
+        const AtlasShelfAllocator::Metrics metrics = atlasShelfAllocator.ComputeMetrics();
+        EXPECT_EQ(metrics.m_slotCount, successCount);
+        EXPECT_GT(metrics.m_occupancy, 0.f);
+        EXPECT_LE(metrics.m_occupancy, metrics.m_shelfOccupancy);
+        EXPECT_LE(metrics.m_shelfOccupancy, 1.f);
+
+        // The failed allocation is reported through the assert catcher
+        EXPECT_FALSE(catcher.GetCaughtMessages().empty());
+
+        explorer.DumpGraph("AtlasShelfAllocator_AllocateMany.svg", "AtlasShelfAllocator Allocate Many");
+    }
+
+    TEST(AtlasShelfAllocatorTests, Metrics)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        AllocatorInstance cpuAllocator;
+        AtlasShelfAllocator atlasShelfAllocator(cpuAllocator, commonConfig);
+
+        constexpr u32 height = 128;
+        constexpr u32 width = 64;
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        AtlasShelfAllocator::Metrics metrics = atlasShelfAllocator.ComputeMetrics();
+        EXPECT_EQ(metrics.m_slotCount, 0);
+        EXPECT_EQ(metrics.m_shelfCount, 0);
+        EXPECT_EQ(metrics.m_atlasArea, 1024 * 1024);
+        EXPECT_EQ(metrics.m_occupancy, 0.f);
+
+        u32 slots[4];
+        for (u32& slot : slots)
+            slot = atlasShelfAllocator.Allocate({ width, height });
+
+        metrics = atlasShelfAllocator.ComputeMetrics();
+        EXPECT_EQ(metrics.m_slotCount, 4);
+        EXPECT_EQ(metrics.m_shelfCount, 1);
+        EXPECT_EQ(metrics.m_allocatedArea, 4 * width * height);
+        EXPECT_EQ(metrics.m_shelfArea, 512 * height);
+        EXPECT_FLOAT_EQ(metrics.m_shelfOccupancy, 0.5f);
+        EXPECT_FLOAT_EQ(metrics.m_fragmentation, 0.f);
+
+        // Free one inner slot: 64 of the 320 free pixels are not part of the largest run
+        atlasShelfAllocator.Free(slots[1]);
+        metrics = atlasShelfAllocator.ComputeMetrics();
+        EXPECT_EQ(metrics.m_slotCount, 3);
+        EXPECT_FLOAT_EQ(metrics.m_fragmentation, 64.f / 320.f);
+
+        catcher.ExpectNoMessage();
+    }
+
+    // Previous algorithm, kept as a benchmark reference: every shelf of the height category is walked, and each shelf
+    // free list is searched first fit and coalesced with a linear walk.
+    class ReferenceShelfAllocator
+    {
+    public:
+        ReferenceShelfAllocator(uint2 _atlasSize, u32 _shelfWidth)
+            : m_atlasSize(_atlasSize)
+            , m_shelfWidth(_shelfWidth)
+            , m_columnHeights(_atlasSize.x / _shelfWidth, 0u)
+        {}
+
+        u32 Allocate(uint2 _slotSize)
+        {
+            const u32 width = Alignment::AlignUp(_slotSize.x, 4u);
+            const u32 height = Alignment::AlignUp(_slotSize.y, 16u);
+
+            auto& category = m_categories[height];
+            for (const u32 shelfIndex : category)
+            {
+                const u32 slot = AllocateInShelf(width, shelfIndex);
+                if (slot != AtlasShelfAllocator::kInvalidSlot)
+                    return slot;
+            }
+
+            for (u32 column = 0; column < m_columnHeights.size(); column++)
+            {
+                if (m_columnHeights[column] + height > m_atlasSize.y)
+                    continue;
+
+                m_columnHeights[column] += height;
+                m_shelves.push_back().m_freeRuns.push_back(Run { 0, m_shelfWidth });
+                category.push_back(m_shelves.size() - 1);
+                return AllocateInShelf(width, m_shelves.size() - 1);
+            }
+            return AtlasShelfAllocator::kInvalidSlot;
+        }
+
+        void Free(u32 _slot)
+        {
+            const Slot slot = m_slots[_slot];
+            eastl::vector<Run>& runs = m_shelves[slot.m_shelf].m_freeRuns;
+
+            auto next = runs.begin();
+            while (next != runs.end() && next->m_start < slot.m_start)
+                ++next;
+
+            const bool backMerge = next != runs.end() && slot.m_start + slot.m_width == next->m_start;
+            const bool frontMerge = next != runs.begin() && (next - 1)->m_start + (next - 1)->m_width == slot.m_start;
+            if (frontMerge && backMerge)
+            {
+                (next - 1)->m_width += slot.m_width + next->m_width;
+                runs.erase(next);
+            }
+            else if (frontMerge)
+            {
+                (next - 1)->m_width += slot.m_width;
+            }
+            else if (backMerge)
+            {
+                next->m_start = slot.m_start;
+                next->m_width += slot.m_width;
+            }
+            else
+            {
+                runs.insert(next, Run { slot.m_start, slot.m_width });
+            }
+        }
+
+    private:
+        struct Run
+        {
+            u32 m_start;
+            u32 m_width;
+        };
+
+        struct Shelf
+        {
+            eastl::vector<Run> m_freeRuns;
+        };
+
+        struct Slot
+        {
+            u32 m_shelf;
+            u32 m_start;
+            u32 m_width;
+        };
+
+        uint2 m_atlasSize;
+        u32 m_shelfWidth;
+        eastl::vector<u32> m_columnHeights;
+        eastl::vector<Shelf> m_shelves;
+        eastl::vector_map<u32, eastl::vector<u32>> m_categories;
+        eastl::vector<Slot> m_slots;
+
+        u32 AllocateInShelf(u32 _width, u32 _shelfIndex)
+        {
+            eastl::vector<Run>& runs = m_shelves[_shelfIndex].m_freeRuns;
+            for (auto it = runs.begin(); it != runs.end(); ++it)
+            {
+                if (it->m_width < _width)
+                    continue;
+
+                m_slots.push_back({ _shelfIndex, it->m_start, _width });
+                it->m_start += _width;
+                it->m_width -= _width;
+                if (it->m_width == 0)
+                    runs.erase(it);
+                return m_slots.size() - 1;
+            }
+            return AtlasShelfAllocator::kInvalidSlot;
+        }
+    };
+
+    TEST(AtlasShelfAllocatorTests, DISABLED_Benchmark)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        AllocatorInstance cpuAllocator;
+        AtlasShelfAllocator atlasShelfAllocator(cpuAllocator, {
+            .m_atlasSize = { 4096, 4096 },
+            .m_shelfWidth = 512,
+            .m_minHeight = 16,
+            .m_slWidth = 2,
+        });
+
+        // Glyph-like sizes, mostly small with a few bigger images
+        constexpr u32 count = 8192;
+        eastl::vector<uint2> sizes;
+        for (u32 i = 0; i < count; i++)
+        {
+            const u64 hash = Hashing::Hash64(i);
+            const bool big = (hash & 0xf) == 0;
+            sizes.push_back({
+                static_cast<u32>(big ? 32 + (hash >> 8) % 96 : 8 + (hash >> 8) % 32),
+                static_cast<u32>(big ? 32 + (hash >> 16) % 96 : 12 + (hash >> 16) % 28),
+            });
+        }
+        eastl::vector<u32> slots(count, AtlasShelfAllocator::kInvalidSlot);
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        const auto RunWorkload = [&](auto& _allocator)
+        {
+            for (u32 i = 0; i < count; i++)
+                slots[i] = _allocator.Allocate(sizes[i]);
+
+            // Churn: free half, then allocate again
+            for (u32 i = 0; i < count; i += 2)
+            {
+                if (slots[i] != AtlasShelfAllocator::kInvalidSlot)
+                    _allocator.Free(slots[i]);
+            }
+            for (u32 i = 0; i < count; i += 2)
+                slots[i] = _allocator.Allocate(sizes[(i * 7) % count]);
+        };
+
+        ReferenceShelfAllocator referenceAllocator({ 4096, 4096 }, 512);
+        const auto referenceStart = std::chrono::steady_clock::now();
+        RunWorkload(referenceAllocator);
+        const auto referenceEnd = std::chrono::steady_clock::now();
+        RunWorkload(atlasShelfAllocator);
+        const auto indexedEnd = std::chrono::steady_clock::now();
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        u32 failedCount = 0;
+        for (const u32 slot : slots)
+            failedCount += slot == AtlasShelfAllocator::kInvalidSlot ? 1 : 0;
+
+        const AtlasShelfAllocator::Metrics metrics = atlasShelfAllocator.ComputeMetrics();
+        EXPECT_EQ(metrics.m_slotCount, count - failedCount);
+
+        const std::chrono::duration<double, std::micro> referenceTime = referenceEnd - referenceStart;
+        const std::chrono::duration<double, std::micro> indexedTime = indexedEnd - referenceEnd;
+        printf(
+            "AtlasShelfAllocator: %u allocations and churn. Linear walks: %.1f us, indexed runs: %.1f us. %u failed, "
+            "occupancy %.1f%%, shelf occupancy %.1f%%, fragmentation %.1f%%\n",
+            count,
+            referenceTime.count(),
+            indexedTime.count(),
+            failedCount,
+            metrics.m_occupancy * 100.f,
+            metrics.m_shelfOccupancy * 100.f,
+            metrics.m_fragmentation * 100.f);
+
+        catcher.ExpectNoMessage();
+    }
+}
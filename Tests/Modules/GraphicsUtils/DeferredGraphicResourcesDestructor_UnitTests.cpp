@@ -0,0 +1,275 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <EASTL/vector.h>
+#include <KryneEngine/Modules/GraphicsUtils/DeferredGraphicResourcesDestructor.hpp>
+#include <gtest/gtest.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::GraphicsUtils::Tests
+{
+    using namespace KryneEngine::Tests;
+    using Type = DeferredGraphicResourcesDestructor::Type;
+
+    struct DestroyedBatch
+    {
+        Type m_type;
+        eastl::vector<u32> m_handles;
+    };
+
+    static void RecordBatch(void* _userData, const Type _type, const eastl::span<const GenPool::Handle> _handles)
+    {
+        auto* batches = static_cast<eastl::vector<DestroyedBatch>*>(_userData);
+        DestroyedBatch& batch = batches->push_back();
+        batch.m_type = _type;
+        for (const GenPool::Handle handle: _handles)
+            batch.m_handles.push_back(static_cast<u32>(handle));
+    }
+
+    static void CountBatch(void* _userData, Type, const eastl::span<const GenPool::Handle> _handles)
+    {
+        *static_cast<u64*>(_userData) += _handles.size();
+    }
+
+    static GenPool::Handle MakeHandle(u32 _index)
+    {
+        return GenPool::Handle::FromU32(_index + 1);
+    }
+
+    TEST(DeferredGraphicResourcesDestructor, FrameBuckets)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        DeferredGraphicResourcesDestructor destructor { AllocatorInstance(), 4 };
+        eastl::vector<DestroyedBatch> batches;
+
+        destructor.DeferDestruction(BufferHandle { MakeHandle(0) }, 2, 1024);
+        destructor.DeferDestruction(SamplerHandle { MakeHandle(1) }, 2);
+        destructor.DeferDestruction(BufferHandle { MakeHandle(2) }, 2, 512);
+        destructor.DeferDestruction(TextureHandle { MakeHandle(3) }, 3, 4096);
+        destructor.DeferDestruction(DescriptorSetHandle { MakeHandle(4) }, 1);
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(destructor.GetPendingCount(), 5);
+        EXPECT_EQ(destructor.GetPendingBytes(), 1024 + 512 + 4096);
+
+        destructor.Flush(0, RecordBatch, &batches);
+        EXPECT_TRUE(batches.empty());
+
+        destructor.Flush(1, RecordBatch, &batches);
+        ASSERT_EQ(batches.size(), 1);
+        EXPECT_EQ(batches[0].m_type, Type::DescriptorSet);
+        EXPECT_EQ(destructor.GetPendingCount(), 4);
+        batches.clear();
+
+        // Both buffers are destroyed in the same batch
+        destructor.Flush(2, RecordBatch, &batches);
+        ASSERT_EQ(batches.size(), 2);
+        EXPECT_EQ(batches[0].m_type, Type::Buffer);
+        EXPECT_EQ(batches[0].m_handles.size(), 2);
+        EXPECT_EQ(batches[1].m_type, Type::Sampler);
+        EXPECT_EQ(destructor.GetPendingBytes(), 4096);
+        batches.clear();
+
+        // Skipped frames are caught up
+        destructor.Flush(10, RecordBatch, &batches);
+        ASSERT_EQ(batches.size(), 1);
+        EXPECT_EQ(batches[0].m_type, Type::Texture);
+        EXPECT_EQ(destructor.GetPendingCount(), 0);
+        EXPECT_EQ(destructor.GetPendingBytes(), 0);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(DeferredGraphicResourcesDestructor, OutOfRangeFrames)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        DeferredGraphicResourcesDestructor destructor { AllocatorInstance(), 2 };
+        eastl::vector<DestroyedBatch> batches;
+
+        destructor.Flush(4, RecordBatch, &batches);
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        // Already elapsed, destroyed on next flush
+        destructor.DeferDestruction(BufferHandle { MakeHandle(0) }, 1);
+        // Beyond the bucket count, shares its bucket with frame 5
+        destructor.DeferDestruction(BufferHandle { MakeHandle(1) }, 9);
+
+        destructor.Flush(5, RecordBatch, &batches);
+        ASSERT_EQ(batches.size(), 1);
+        ASSERT_EQ(batches[0].m_handles.size(), 1);
+        EXPECT_EQ(batches[0].m_handles[0], static_cast<u32>(MakeHandle(0)));
+        batches.clear();
+
+        for (u64 frameId = 6; frameId < 9; frameId++)
+        {
+            destructor.Flush(frameId, RecordBatch, &batches);
+            EXPECT_TRUE(batches.empty());
+        }
+
+        destructor.Flush(9, RecordBatch, &batches);
+        ASSERT_EQ(batches.size(), 1);
+        EXPECT_EQ(batches[0].m_handles[0], static_cast<u32>(MakeHandle(1)));
+        EXPECT_EQ(destructor.GetPendingCount(), 0);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(DeferredGraphicResourcesDestructor, ConcurrentDeferral)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        DeferredGraphicResourcesDestructor destructor { AllocatorInstance() };
+
+        constexpr u32 threadCount = 4;
+        constexpr u32 perThreadCount = 10'000;
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        eastl::vector<std::thread> threads;
+        for (u32 t = 0; t < threadCount; t++)
+        {
+            threads.emplace_back([&destructor, t]
+            {
+                for (u32 i = 0; i < perThreadCount; i++)
+                    destructor.DeferDestruction(TextureViewHandle { MakeHandle(t * perThreadCount + i) }, i % 3, 16);
+            });
+        }
+        for (std::thread& thread: threads)
+        {
+            thread.join();
+        }
+
+        u64 destroyedCount = 0;
+        destructor.Flush(2, CountBatch, &destroyedCount);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(destroyedCount, threadCount * perThreadCount);
+        EXPECT_EQ(destructor.GetPendingCount(), 0);
+        EXPECT_EQ(destructor.GetPendingBytes(), 0);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(DeferredGraphicResourcesDestructor, DISABLED_ChurnBenchmark)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        constexpr u64 frameCount = 256;
+        constexpr u32 framesInFlight = 3;
+        constexpr u32 destructionsPerFrame = 4096;
+
+        // Previous implementation: a single list, scanned whole on every flush
+        struct ReferenceEntry
+        {
+            Type m_type;
+            GenPool::Handle m_handle;
+            u64 m_frameId;
+        };
+        eastl::vector<ReferenceEntry> referenceEntries;
+        u64 referenceDestroyed = 0;
+
+        DeferredGraphicResourcesDestructor destructor { AllocatorInstance() };
+        u64 destroyed = 0;
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        const auto referenceStart = std::chrono::steady_clock::now();
+        for (u64 frameId = 0; frameId < frameCount; frameId++)
+        {
+            for (u32 i = 0; i < destructionsPerFrame; i++)
+            {
+                referenceEntries.push_back({
+                    static_cast<Type>(i % static_cast<u32>(Type::COUNT)),
+                    MakeHandle(i),
+                    frameId + framesInFlight,
+                });
+            }
+
+            for (auto it = referenceEntries.begin(); it != referenceEntries.end();)
+            {
+                if (it->m_frameId <= frameId)
+                {
+                    referenceDestroyed++;
+                    referenceEntries.erase_unsorted(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+        const auto referenceEnd = std::chrono::steady_clock::now();
+
+        for (u64 frameId = 0; frameId < frameCount; frameId++)
+        {
+            for (u32 i = 0; i < destructionsPerFrame; i++)
+            {
+                const GenPool::Handle handle = MakeHandle(i);
+                switch (i % 4)
+                {
+                case 0: destructor.DeferDestruction(BufferHandle { handle }, frameId + framesInFlight, 256); break;
+                case 1: destructor.DeferDestruction(TextureHandle { handle }, frameId + framesInFlight, 1024); break;
+                case 2: destructor.DeferDestruction(TextureViewHandle { handle }, frameId + framesInFlight); break;
+                default: destructor.DeferDestruction(DescriptorSetHandle { handle }, frameId + framesInFlight); break;
+                }
+            }
+            destructor.Flush(frameId, CountBatch, &destroyed);
+        }
+        const auto bucketedEnd = std::chrono::steady_clock::now();
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(destroyed, referenceDestroyed);
+        EXPECT_EQ(destructor.GetPendingCount(), referenceEntries.size());
+        EXPECT_EQ(destructor.GetPendingBytes(), framesInFlight * destructionsPerFrame / 4 * (256 + 1024));
+
+        const std::chrono::duration<double, std::milli> referenceTime = referenceEnd - referenceStart;
+        const std::chrono::duration<double, std::milli> bucketedTime = bucketedEnd - referenceEnd;
+        printf(
+            "Deferred destruction churn: %llu frames, %u destructions per frame. Linear scan: %.2f ms, "
+            "frame buckets: %.2f ms\n",
+            static_cast<unsigned long long>(frameCount),
+            destructionsPerFrame,
+            referenceTime.count(),
+            bucketedTime.count());
+
+        catcher.ExpectNoMessage();
+    }
+}
@@ -0,0 +1,131 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <KryneEngine/Core/Graphics/GraphicsContext.hpp>
+#include <KryneEngine/Modules/GraphicsUtils/DynamicBuffer.hpp>
+#include <gtest/gtest.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::GraphicsUtils::Tests
+{
+    using namespace KryneEngine::Tests;
+
+    static GraphicsCommon::ApplicationInfo MakeAppInfo()
+    {
+        return GraphicsCommon::ApplicationInfo {
+            .m_applicationName = "Unit test app",
+            .m_api =
+#if defined(KE_GRAPHICS_API_DX12)
+                GraphicsCommon::Api::DirectX12_1,
+#elif defined(KE_GRAPHICS_API_VK)
+                GraphicsCommon::Api::Vulkan_1_0,
+#elif defined(KE_GRAPHICS_API_MTL)
+                GraphicsCommon::Api::Metal_3,
+#endif
+            .m_features = {
+                .m_present = false,
+                .m_transferQueue = false,
+            },
+        };
+    }
+
+    static void UploadFrame(
+        GraphicsContext* _graphicsContext,
+        DynamicBuffer& _dynamicBuffer,
+        u64 _size,
+        const BufferRange& _range)
+    {
+        const u8 frameIndex = _graphicsContext->GetCurrentFrameContextIndex();
+        CommandListHandle commandList = _graphicsContext->BeginGraphicsCommandList();
+
+        auto* mapped = static_cast<u8*>(_dynamicBuffer.Map(_graphicsContext, frameIndex));
+        const u64 writeOffset = _dynamicBuffer.IsGpuContentRetained() ? _range.m_offset : 0;
+        const u64 writeSize = _dynamicBuffer.IsGpuContentRetained() ? _range.m_size : _size;
+        for (u64 i = writeOffset; i < writeOffset + writeSize; i++)
+        {
+            mapped[i] = static_cast<u8>(i * 7);
+        }
+        _dynamicBuffer.Unmap(_graphicsContext);
+
+        _dynamicBuffer.PrepareBufferRanges(
+            _graphicsContext,
+            commandList,
+            BarrierAccessFlags::VertexBuffer,
+            frameIndex,
+            { &_range, 1 });
+
+        _graphicsContext->EndGraphicsCommandList(commandList);
+        _graphicsContext->EndFrame();
+    }
+
+    TEST(DynamicBuffer, RangesAfterRecreation)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        GraphicsContext* graphicsContext = GraphicsContext::Create(MakeAppInfo(), nullptr, AllocatorInstance());
+
+        constexpr u64 initialSize = 256;
+        constexpr u64 resizedSize = 1024;
+        constexpr BufferRange dirtyRange { 64, 32 };
+
+        DynamicBuffer dynamicBuffer { AllocatorInstance() };
+        dynamicBuffer.Init(
+            graphicsContext,
+            {
+                .m_desc = {
+                    .m_size = initialSize,
+#if !defined(KE_FINAL)
+                    .m_debugName = "DynamicBuffer",
+#endif
+                },
+                .m_usage = MemoryUsage::StageEveryFrame_UsageType | MemoryUsage::VertexBuffer,
+            },
+            graphicsContext->GetFrameContextCount());
+
+        const bool staged = !dynamicBuffer.IsDirectMapping();
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        // The GPU buffer was never filled, the first upload covers it all
+        EXPECT_FALSE(dynamicBuffer.IsGpuContentRetained());
+        UploadFrame(graphicsContext, dynamicBuffer, initialSize, dirtyRange);
+        EXPECT_EQ(dynamicBuffer.IsGpuContentRetained(), staged);
+
+        // Only the dirty range is uploaded while the content is retained
+        UploadFrame(graphicsContext, dynamicBuffer, initialSize, dirtyRange);
+        EXPECT_EQ(dynamicBuffer.IsGpuContentRetained(), staged);
+
+        // Growing recreates the GPU buffer, the ranges upload falls back to a whole buffer copy
+        dynamicBuffer.RequestResize(resizedSize);
+        for (u8 i = 0; i < graphicsContext->GetFrameContextCount(); i++)
+        {
+            UploadFrame(graphicsContext, dynamicBuffer, resizedSize, dirtyRange);
+            EXPECT_EQ(dynamicBuffer.IsGpuContentRetained(), staged);
+        }
+        for (u8 i = 0; i < graphicsContext->GetFrameContextCount(); i++)
+        {
+            EXPECT_EQ(dynamicBuffer.GetSize(i), resizedSize);
+        }
+
+        catcher.ExpectNoMessage();
+
+        // -----------------------------------------------------------------------
+        // Teardown
+        // -----------------------------------------------------------------------
+
+        graphicsContext->WaitForLastFrame();
+        dynamicBuffer.Destroy(graphicsContext);
+        GraphicsContext::Destroy(graphicsContext);
+
+        catcher.ExpectNoMessage();
+    }
+}
@@ -0,0 +1,83 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <KryneEngine/Modules/GraphicsUtils/Allocators/LinearSuballocator.hpp>
+#include <gtest/gtest.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::GraphicsUtils::Tests
+{
+    using namespace KryneEngine::Tests;
+
+    TEST(LinearSuballocator, Allocate)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        LinearSuballocator suballocator { 256 };
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(suballocator.Allocate(10), 0);
+        EXPECT_EQ(suballocator.GetUsed(), 10);
+
+        // Aligned allocations skip the padding
+        EXPECT_EQ(suballocator.Allocate(20, 16), 16);
+        EXPECT_EQ(suballocator.Allocate(4, 4), 36);
+        EXPECT_EQ(suballocator.Allocate(64, 64), 64);
+        EXPECT_EQ(suballocator.GetUsed(), 128);
+
+        // Up to the exact capacity
+        EXPECT_EQ(suballocator.Allocate(128), 128);
+        EXPECT_EQ(suballocator.GetUsed(), 256);
+
+        // Failed allocations don't consume anything
+        EXPECT_EQ(suballocator.Allocate(1), LinearSuballocator::kInvalidOffset);
+        EXPECT_EQ(suballocator.GetUsed(), 256);
+
+        // Zero-sized allocations still fit at the end
+        EXPECT_EQ(suballocator.Allocate(0), 256);
+
+        suballocator.Reset();
+        EXPECT_EQ(suballocator.GetUsed(), 0);
+        EXPECT_EQ(suballocator.Allocate(200, 8), 0);
+        EXPECT_EQ(suballocator.Allocate(64, 8), LinearSuballocator::kInvalidOffset);
+
+        suballocator.Reset(512);
+        EXPECT_EQ(suballocator.GetCapacity(), 512);
+        EXPECT_EQ(suballocator.Allocate(200, 8), 0);
+        EXPECT_EQ(suballocator.Allocate(64, 8), 200);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(LinearSuballocator, InvalidAlignment)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        LinearSuballocator suballocator { 256 };
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        (void)suballocator.Allocate(16, 12);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        catcher.ExpectMessageCount(1);
+    }
+}
@@ -0,0 +1,146 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <KryneEngine/Modules/GraphicsUtils/RetainedBufferDiff.hpp>
+#include <gtest/gtest.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::GraphicsUtils::Tests
+{
+    using namespace KryneEngine::Tests;
+
+    static constexpr u32 kBlockSize = 32;
+
+    static eastl::vector<std::byte> MakeStream(u32 _blockCount)
+    {
+        eastl::vector<std::byte> stream(_blockCount * kBlockSize);
+        for (u32 i = 0; i < stream.size(); i++)
+        {
+            stream[i] = static_cast<std::byte>(i * 7);
+        }
+        return stream;
+    }
+
+    TEST(RetainedBufferDiff, Diff)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        RetainedBufferDiff diff { AllocatorInstance(), kBlockSize };
+
+        eastl::vector<std::byte> stream = MakeStream(64);
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        // First update uploads everything
+        {
+            const auto ranges = diff.Update(stream.data(), stream.size());
+            ASSERT_EQ(ranges.size(), 1);
+            EXPECT_EQ(ranges[0].m_offset, 0);
+            EXPECT_EQ(ranges[0].m_size, stream.size());
+            EXPECT_EQ(diff.GetStatistics().GetSavedBytes(), 0);
+        }
+
+        // Static content, nothing to upload
+        {
+            const auto ranges = diff.Update(stream.data(), stream.size());
+            EXPECT_TRUE(ranges.empty());
+            EXPECT_EQ(diff.GetStatistics().m_totalBytes, stream.size());
+            EXPECT_EQ(diff.GetStatistics().GetSavedBytes(), stream.size());
+        }
+
+        // A single byte change uploads its whole block
+        {
+            stream[10 * kBlockSize + 5] ^= std::byte { 0xff };
+            const auto ranges = diff.Update(stream.data(), stream.size());
+            ASSERT_EQ(ranges.size(), 1);
+            EXPECT_EQ(ranges[0].m_offset, 10 * kBlockSize);
+            EXPECT_EQ(ranges[0].m_size, kBlockSize);
+            EXPECT_EQ(diff.GetStatistics().m_uploadedBytes, kBlockSize);
+            EXPECT_EQ(diff.GetStatistics().GetSavedBytes(), stream.size() - kBlockSize);
+        }
+
+        // Adjacent blocks are joined, distant ones are not
+        {
+            stream[2 * kBlockSize] ^= std::byte { 0xff };
+            stream[3 * kBlockSize] ^= std::byte { 0xff };
+            stream[40 * kBlockSize] ^= std::byte { 0xff };
+            const auto ranges = diff.Update(stream.data(), stream.size());
+            ASSERT_EQ(ranges.size(), 2);
+            EXPECT_EQ(ranges[0].m_offset, 2 * kBlockSize);
+            EXPECT_EQ(ranges[0].m_size, 2 * kBlockSize);
+            EXPECT_EQ(ranges[1].m_offset, 40 * kBlockSize);
+            EXPECT_EQ(ranges[1].m_size, kBlockSize);
+            EXPECT_EQ(diff.GetStatistics().m_rangeCount, 2);
+        }
+
+        // Growth uploads the new tail, shrinking uploads nothing
+        {
+            stream.resize(stream.size() + kBlockSize + 8, std::byte { 1 });
+            const auto ranges = diff.Update(stream.data(), stream.size());
+            ASSERT_EQ(ranges.size(), 1);
+            EXPECT_EQ(ranges[0].m_offset, 64 * kBlockSize);
+            EXPECT_EQ(ranges[0].m_size, kBlockSize + 8);
+
+            stream.resize(32 * kBlockSize);
+            EXPECT_TRUE(diff.Update(stream.data(), stream.size()).empty());
+        }
+
+        // Invalidation forces a full upload
+        {
+            diff.Invalidate();
+            const auto ranges = diff.Update(stream.data(), stream.size());
+            ASSERT_EQ(ranges.size(), 1);
+            EXPECT_EQ(ranges[0].m_size, stream.size());
+        }
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(RetainedBufferDiff, MergeDistance)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        RetainedBufferDiff diff { AllocatorInstance(), kBlockSize, 2 * kBlockSize };
+
+        eastl::vector<std::byte> stream = MakeStream(64);
+        (void)diff.Update(stream.data(), stream.size());
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        // Blocks 0, 3 (2 clean blocks apart) and 7 (3 clean blocks apart)
+        stream[0] ^= std::byte { 0xff };
+        stream[3 * kBlockSize] ^= std::byte { 0xff };
+        stream[7 * kBlockSize] ^= std::byte { 0xff };
+        const auto ranges = diff.Update(stream.data(), stream.size());
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        ASSERT_EQ(ranges.size(), 2);
+        EXPECT_EQ(ranges[0].m_offset, 0);
+        EXPECT_EQ(ranges[0].m_size, 4 * kBlockSize);
+        EXPECT_EQ(ranges[1].m_offset, 7 * kBlockSize);
+        EXPECT_EQ(ranges[1].m_size, kBlockSize);
+        EXPECT_EQ(diff.GetStatistics().m_uploadedBytes, 5 * kBlockSize);
+
+        // Retained content was updated, including the merged clean blocks
+        EXPECT_TRUE(diff.Update(stream.data(), stream.size()).empty());
+
+        catcher.ExpectNoMessage();
+    }
+}
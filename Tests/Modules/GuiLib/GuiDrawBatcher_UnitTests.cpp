@@ -0,0 +1,187 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <KryneEngine/Modules/GuiLib/GuiRenderers/GuiDrawBatcher.hpp>
+#include <gtest/gtest.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::GuiLib::Tests
+{
+    using namespace KryneEngine::Tests;
+
+    static GraphicsPipelineHandle MakePipeline(u32 _index)
+    {
+        return GraphicsPipelineHandle { GenPool::Handle::FromU32(_index) };
+    }
+
+    TEST(GuiDrawBatcher, MergeConsecutiveInstances)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        GuiDrawBatcher batcher { AllocatorInstance() };
+
+        const GraphicsPipelineHandle rectanglePipeline = MakePipeline(1);
+        const GraphicsPipelineHandle imagePipeline = MakePipeline(2);
+        const GraphicsPipelineHandle textPipeline = MakePipeline(3);
+        constexpr u32 textDescriptorSet = 2;
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        batcher.Reset(true);
+        u32 instance = 0;
+
+        // 3 rectangles
+        for (u32 i = 0; i < 3; i++)
+            batcher.PushInstance({ .m_pipeline = rectanglePipeline }, instance++);
+
+        // 2 images in set 0, 1 image in set 1
+        batcher.PushInstance({ .m_pipeline = imagePipeline, .m_descriptorSetIndex = 0 }, instance++);
+        batcher.PushInstance({ .m_pipeline = imagePipeline, .m_descriptorSetIndex = 0 }, instance++);
+        batcher.PushInstance({ .m_pipeline = imagePipeline, .m_descriptorSetIndex = 1 }, instance++);
+
+        // 2 text elements of 4 glyphs each
+        for (u32 i = 0; i < 8; i++)
+            batcher.PushInstance({ .m_pipeline = textPipeline, .m_descriptorSetIndex = textDescriptorSet }, instance++);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        const eastl::span<const GuiDrawBatcher::Batch> batches = batcher.GetBatches();
+        ASSERT_EQ(batches.size(), 4);
+
+        EXPECT_EQ(batches[0].m_state.m_pipeline, rectanglePipeline);
+        EXPECT_EQ(batches[0].m_state.m_descriptorSetIndex, GuiDrawBatcher::kAnyDescriptorSet);
+        EXPECT_EQ(batches[0].m_firstInstance, 0);
+        EXPECT_EQ(batches[0].m_instanceCount, 3);
+
+        EXPECT_EQ(batches[1].m_state.m_pipeline, imagePipeline);
+        EXPECT_EQ(batches[1].m_state.m_descriptorSetIndex, 0);
+        EXPECT_EQ(batches[1].m_firstInstance, 3);
+        EXPECT_EQ(batches[1].m_instanceCount, 2);
+
+        EXPECT_EQ(batches[2].m_state.m_descriptorSetIndex, 1);
+        EXPECT_EQ(batches[2].m_firstInstance, 5);
+        EXPECT_EQ(batches[2].m_instanceCount, 1);
+
+        EXPECT_EQ(batches[3].m_state.m_pipeline, textPipeline);
+        EXPECT_EQ(batches[3].m_firstInstance, 6);
+        EXPECT_EQ(batches[3].m_instanceCount, 8);
+
+        EXPECT_EQ(batcher.GetStatistics().m_instances, 14);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(GuiDrawBatcher, BatchBreaks)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        GuiDrawBatcher batcher { AllocatorInstance() };
+
+        const GraphicsPipelineHandle rectanglePipeline = MakePipeline(1);
+        const GraphicsPipelineHandle borderPipeline = MakePipeline(2);
+
+        constexpr Rect root { 0, 0, 1920, 1080 };
+        constexpr Rect clip { 10, 10, 100, 100 };
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        batcher.Reset(true);
+        batcher.SetScissor(root);
+
+        batcher.PushInstance({ .m_pipeline = rectanglePipeline }, 0);
+
+        // Same rect doesn't break the batch
+        batcher.SetScissor(root);
+        batcher.PushInstance({ .m_pipeline = rectanglePipeline }, 1);
+
+        // A different rect does
+        batcher.SetScissor(clip);
+        batcher.PushInstance({ .m_pipeline = rectanglePipeline }, 2);
+        batcher.SetScissor(root);
+        batcher.PushInstance({ .m_pipeline = rectanglePipeline }, 3);
+
+        // Painter's order is kept: interleaved pipelines are not merged
+        batcher.PushInstance({ .m_pipeline = borderPipeline }, 4);
+        batcher.PushInstance({ .m_pipeline = rectanglePipeline }, 5);
+
+        // Non-contiguous instances are not merged either
+        batcher.PushInstance({ .m_pipeline = rectanglePipeline }, 7);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        const eastl::span<const GuiDrawBatcher::Batch> batches = batcher.GetBatches();
+        ASSERT_EQ(batches.size(), 6);
+        EXPECT_EQ(batches[0].m_instanceCount, 2);
+        EXPECT_EQ(batches[1].m_firstInstance, 2);
+        EXPECT_NE(batches[1].m_scissorIndex, batches[0].m_scissorIndex);
+        EXPECT_EQ(batches[2].m_firstInstance, 3);
+        EXPECT_EQ(batches[3].m_state.m_pipeline, borderPipeline);
+        EXPECT_EQ(batches[4].m_firstInstance, 5);
+        EXPECT_EQ(batches[5].m_firstInstance, 7);
+
+        const eastl::span<const Rect> scissors = batcher.GetScissors();
+        ASSERT_EQ(scissors.size(), 3);
+        EXPECT_EQ(scissors[batches[1].m_scissorIndex].m_left, clip.m_left);
+        EXPECT_EQ(scissors[batches[2].m_scissorIndex].m_right, root.m_right);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(GuiDrawBatcher, BatchingDisabled)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        GuiDrawBatcher batcher { AllocatorInstance() };
+
+        const GraphicsPipelineHandle pipeline = MakePipeline(1);
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        batcher.Reset(false);
+        for (u32 i = 0; i < 16; i++)
+        {
+            batcher.CountRenderCommand();
+            batcher.PushInstance({ .m_pipeline = pipeline }, i);
+        }
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(batcher.GetBatches().size(), 16);
+        EXPECT_EQ(batcher.GetStatistics().m_renderCommands, 16);
+
+        // Re-enabling batching on reset clears previous state
+        batcher.Reset(true);
+        for (u32 i = 0; i < 16; i++)
+            batcher.PushInstance({ .m_pipeline = pipeline }, i);
+        ASSERT_EQ(batcher.GetBatches().size(), 1);
+        EXPECT_EQ(batcher.GetBatches()[0].m_instanceCount, 16);
+        EXPECT_EQ(batcher.GetStatistics().m_renderCommands, 0);
+
+        catcher.ExpectNoMessage();
+    }
+}
@@ -0,0 +1,377 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include <KryneEngine/Core/Math/Hashing.hpp>
+#include <KryneEngine/Modules/GuiLib/ClayHelper.hpp>
+#include <KryneEngine/Modules/GuiLib/GuiLayoutCache.hpp>
+#include <gtest/gtest.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::GuiLib::Tests
+{
+    using namespace KryneEngine::Tests;
+
+    namespace
+    {
+        u32 g_measureTextCalls = 0;
+
+        Clay_Dimensions MeasureText(Clay_StringSlice _slice, Clay_TextElementConfig* _config, void*)
+        {
+            g_measureTextCalls++;
+            return { static_cast<float>(_slice.length) * _config->fontSize * 0.5f, _config->fontSize };
+        }
+
+        struct ClayScope
+        {
+            AllocatorInstance m_allocator {};
+            char* m_memory = nullptr;
+            Clay_Context* m_context = nullptr;
+            float2 m_viewportSize;
+
+            explicit ClayScope(const float2& _viewportSize)
+                : m_viewportSize(_viewportSize)
+            {
+                const u32 capacity = Clay_MinMemorySize();
+                m_memory = m_allocator.Allocate<char>(capacity);
+
+                const Clay_ErrorHandler errorHandler {
+                    .errorHandlerFunction = [](Clay_ErrorData _errorData) { KE_ERROR(_errorData.errorText.chars); },
+                };
+                m_context = Clay_Initialize(
+                    { .capacity = capacity, .memory = m_memory },
+                    { _viewportSize.x, _viewportSize.y },
+                    errorHandler);
+                Clay_SetMeasureTextFunction(MeasureText, nullptr);
+                Clay_SetCurrentContext(nullptr);
+            }
+
+            ~ClayScope()
+            {
+                Clay_SetCurrentContext(nullptr);
+                m_allocator.deallocate(m_memory);
+            }
+        };
+
+        // A grid of static panels, a few of which are updated every frame.
+        struct Dashboard
+        {
+            static constexpr u32 kColumns = 10;
+            static constexpr u32 kRows = 8;
+            static constexpr u32 kPanelCount = kColumns * kRows;
+            static constexpr u32 kLinesPerPanel = 6;
+            static constexpr u32 kAnimatedPanelStride = kPanelCount / 4;
+
+            // Per frame strings of the animated panels, must outlive the layout
+            eastl::vector<eastl::string> m_values;
+
+            static bool IsAnimated(const u32 _panel) { return _panel % kAnimatedPanelStride == 0; }
+
+            void Declare(const u64 _frame, GuiLayoutCache* _cache)
+            {
+                m_values.clear();
+                m_values.reserve(kPanelCount * kLinesPerPanel);
+
+                CLAY({
+                    .id = CLAY_ID("Dashboard"),
+                    .layout = { .padding = CLAY_PADDING_ALL(16), .childGap = 16, .layoutDirection = CLAY_TOP_TO_BOTTOM },
+                })
+                {
+                    for (u32 row = 0; row < kRows; row++)
+                    {
+                        CLAY({ .layout = { .childGap = 16 } })
+                        {
+                            for (u32 column = 0; column < kColumns; column++)
+                                DeclarePanel(row * kColumns + column, _frame, _cache);
+                        }
+                    }
+                }
+            }
+
+            void DeclarePanel(const u32 _panel, const u64 _frame, GuiLayoutCache* _cache)
+            {
+                const bool animated = IsAnimated(_panel);
+                const Clay_ElementId id = CLAY_IDI("Panel", _panel);
+                const Clay_ElementDeclaration declaration {
+                    .layout = { .padding = CLAY_PADDING_ALL(8), .childGap = 4, .layoutDirection = CLAY_TOP_TO_BOTTOM },
+                    .backgroundColor = { 40, 40, 48, 255 },
+                };
+
+                bool declareChildren = true;
+                if (_cache != nullptr)
+                {
+                    const u64 contentHash = Hashing::Hash64(static_cast<u64>(_panel) << 32 | (animated ? _frame : 0));
+                    declareChildren = _cache->BeginSubtree(id, contentHash, declaration);
+                }
+                else
+                {
+                    Clay_ElementDeclaration plainDeclaration = declaration;
+                    plainDeclaration.id = id;
+                    Clay__OpenElement();
+                    Clay__ConfigureOpenElement(plainDeclaration);
+                }
+
+                if (declareChildren)
+                {
+                    CLAY({ .layout = { .sizing = { .width = CLAY_SIZING_GROW(0) } }, .backgroundColor = { 70, 70, 90, 255 } })
+                    {
+                        CLAY_TEXT(CLAY_STRING("Panel title"), CLAY_TEXT_CONFIG({ .fontSize = 16 }));
+                    }
+
+                    for (u32 line = 0; line < kLinesPerPanel; line++)
+                    {
+                        CLAY({ .layout = { .childGap = 8 } })
+                        {
+                            CLAY_TEXT(CLAY_STRING("Throughput"), CLAY_TEXT_CONFIG({ .fontSize = 14 }));
+                            if (animated)
+                            {
+                                m_values.emplace_back().sprintf(
+                                    "%llu MB/s",
+                                    static_cast<unsigned long long>(_frame * (line + 1)));
+                                CLAY_TEXT(ToClayString(m_values.back()), CLAY_TEXT_CONFIG({ .fontSize = 14 }));
+                            }
+                            else
+                            {
+                                CLAY_TEXT(CLAY_STRING("1024 MB/s"), CLAY_TEXT_CONFIG({ .fontSize = 14 }));
+                            }
+                        }
+                    }
+                }
+
+                if (_cache != nullptr)
+                    _cache->EndSubtree();
+                else
+                    Clay__CloseElement();
+            }
+        };
+
+        void RunFrame(
+            const ClayScope& _scope,
+            Dashboard& _dashboard,
+            const u64 _frame,
+            GuiLayoutCache* _cache,
+            eastl::vector<Clay_RenderCommand>* _output = nullptr)
+        {
+            Clay_SetCurrentContext(_scope.m_context);
+            Clay_BeginLayout();
+            if (_cache != nullptr)
+                _cache->BeginFrame(_scope.m_viewportSize);
+            else
+                Clay_SetCullingEnabled(true);
+
+            _dashboard.Declare(_frame, _cache);
+
+            const Clay_RenderCommandArray renderCommands = Clay_EndLayout();
+            const eastl::span<const Clay_RenderCommand> commands = _cache != nullptr
+                ? _cache->EndFrame(renderCommands)
+                : eastl::span<const Clay_RenderCommand>(renderCommands.internalArray, renderCommands.length);
+
+            if (_output != nullptr)
+                _output->assign(commands.begin(), commands.end());
+            Clay_SetCurrentContext(nullptr);
+        }
+    }
+
+    TEST(GuiLayoutCache, MatchesFullLayout)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        const float2 viewportSize(4096.f, 4096.f);
+        const ClayScope plainScope { viewportSize };
+        const ClayScope cachedScope { viewportSize };
+        GuiLayoutCache cache { AllocatorInstance() };
+
+        Dashboard plainDashboard;
+        Dashboard cachedDashboard;
+        eastl::vector<Clay_RenderCommand> plainCommands;
+        eastl::vector<Clay_RenderCommand> cachedCommands;
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        for (u64 frame = 1; frame <= 4; frame++)
+        {
+            RunFrame(plainScope, plainDashboard, frame, nullptr, &plainCommands);
+            RunFrame(cachedScope, cachedDashboard, frame, &cache, &cachedCommands);
+
+            ASSERT_EQ(plainCommands.size(), cachedCommands.size());
+            for (u32 i = 0; i < plainCommands.size(); i++)
+            {
+                const Clay_RenderCommand& expected = plainCommands[i];
+                const Clay_RenderCommand& actual = cachedCommands[i];
+                ASSERT_EQ(expected.commandType, actual.commandType);
+                EXPECT_EQ(expected.id, actual.id);
+                EXPECT_NEAR(expected.boundingBox.x, actual.boundingBox.x, 0.01f);
+                EXPECT_NEAR(expected.boundingBox.y, actual.boundingBox.y, 0.01f);
+                EXPECT_EQ(expected.boundingBox.width, actual.boundingBox.width);
+                EXPECT_EQ(expected.boundingBox.height, actual.boundingBox.height);
+
+                if (expected.commandType == CLAY_RENDER_COMMAND_TYPE_TEXT)
+                {
+                    const Clay_StringSlice& expectedText = expected.renderData.text.stringContents;
+                    const Clay_StringSlice& actualText = actual.renderData.text.stringContents;
+                    ASSERT_EQ(expectedText.length, actualText.length);
+                    EXPECT_EQ(memcmp(expectedText.chars, actualText.chars, expectedText.length), 0);
+                }
+            }
+
+            const GuiLayoutCache::Statistics& statistics = cache.GetStatistics();
+            EXPECT_EQ(statistics.m_subtrees, Dashboard::kPanelCount);
+            if (frame == 1)
+            {
+                EXPECT_EQ(statistics.m_reusedSubtrees, 0);
+            }
+            else
+            {
+                EXPECT_EQ(statistics.m_reusedSubtrees, Dashboard::kPanelCount - Dashboard::kPanelCount / Dashboard::kAnimatedPanelStride);
+            }
+        }
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(GuiLayoutCache, Invalidation)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        ClayScope scope { float2(1920.f, 1080.f) };
+        GuiLayoutCache cache { AllocatorInstance() };
+        const Clay_ElementDeclaration declaration { .backgroundColor = { 255, 0, 0, 255 } };
+
+        u64 panelHash = 0;
+        bool declarePanel = true;
+        const auto runFrame = [&]()
+        {
+            Clay_SetCurrentContext(scope.m_context);
+            Clay_BeginLayout();
+            cache.BeginFrame(scope.m_viewportSize);
+
+            if (declarePanel)
+            {
+                if (cache.BeginSubtree(CLAY_ID("Panel"), panelHash, declaration))
+                {
+                    CLAY_TEXT(CLAY_STRING("Some text"), CLAY_TEXT_CONFIG({ .fontSize = 16 }));
+                }
+                cache.EndSubtree();
+            }
+
+            (void)cache.EndFrame(Clay_EndLayout());
+            Clay_SetCurrentContext(nullptr);
+        };
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        runFrame();
+        EXPECT_EQ(cache.GetStatistics().m_reusedSubtrees, 0);
+        // Root rectangle and text
+        EXPECT_EQ(cache.GetStatistics().m_elements, 2);
+        EXPECT_EQ(cache.GetStatistics().m_renderCommands, 2);
+
+        runFrame();
+        EXPECT_EQ(cache.GetStatistics().m_reusedSubtrees, 1);
+        EXPECT_EQ(cache.GetStatistics().m_reusedElements, 2);
+        EXPECT_EQ(cache.GetStatistics().m_reusedRenderCommands, 2);
+        EXPECT_FLOAT_EQ(cache.GetStatistics().GetReuseRatio(), 1.f);
+
+        // Content change
+        panelHash = 1;
+        runFrame();
+        EXPECT_EQ(cache.GetStatistics().m_reusedSubtrees, 0);
+        runFrame();
+        EXPECT_EQ(cache.GetStatistics().m_reusedSubtrees, 1);
+
+        // Viewport change
+        scope.m_viewportSize = float2(1280.f, 720.f);
+        runFrame();
+        EXPECT_EQ(cache.GetStatistics().m_reusedSubtrees, 0);
+
+        // Subtrees not declared for a frame are dropped
+        declarePanel = false;
+        runFrame();
+        declarePanel = true;
+        runFrame();
+        EXPECT_EQ(cache.GetStatistics().m_reusedSubtrees, 0);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(GuiLayoutCache, DISABLED_Benchmark)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        const float2 viewportSize(1920.f, 1080.f);
+        const ClayScope plainScope { viewportSize };
+        const ClayScope cachedScope { viewportSize };
+        GuiLayoutCache cache { AllocatorInstance() };
+        Dashboard dashboard;
+
+        constexpr u64 frameCount = 200;
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        g_measureTextCalls = 0;
+        const auto plainStart = std::chrono::steady_clock::now();
+        for (u64 frame = 1; frame <= frameCount; frame++)
+            RunFrame(plainScope, dashboard, frame, nullptr);
+        const auto plainEnd = std::chrono::steady_clock::now();
+        const u32 plainMeasureTextCalls = g_measureTextCalls;
+
+        g_measureTextCalls = 0;
+        float reuseRatio = 0.f;
+        for (u64 frame = 1; frame <= frameCount; frame++)
+        {
+            RunFrame(cachedScope, dashboard, frame, &cache);
+            if (frame > 1)
+                reuseRatio += cache.GetStatistics().GetReuseRatio();
+        }
+        const auto cachedEnd = std::chrono::steady_clock::now();
+        const u32 cachedMeasureTextCalls = g_measureTextCalls;
+        reuseRatio /= static_cast<float>(frameCount - 1);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_GT(reuseRatio, 0.9f);
+        EXPECT_LE(cachedMeasureTextCalls, plainMeasureTextCalls);
+
+        const std::chrono::duration<double, std::micro> plainTime = plainEnd - plainStart;
+        const std::chrono::duration<double, std::micro> cachedTime = cachedEnd - plainEnd;
+        printf(
+            "GuiLayoutCache: %u panels, %llu frames. Full layout: %.1f us/frame, %u text measures. "
+            "Incremental layout: %.1f us/frame, %u text measures, %.1f%% elements reused\n",
+            Dashboard::kPanelCount,
+            static_cast<unsigned long long>(frameCount),
+            plainTime.count() / frameCount,
+            plainMeasureTextCalls,
+            cachedTime.count() / frameCount,
+            cachedMeasureTextCalls,
+            reuseRatio * 100.f);
+
+        catcher.ExpectNoMessage();
+    }
+}
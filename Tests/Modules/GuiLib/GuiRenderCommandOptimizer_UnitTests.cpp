@@ -0,0 +1,245 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <EASTL/vector.h>
+#include <KryneEngine/Modules/GuiLib/GuiRenderCommandOptimizer.hpp>
+#include <gtest/gtest.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::GuiLib::Tests
+{
+    using namespace KryneEngine::Tests;
+
+    static constexpr Clay_Color kOpaque { 255, 255, 255, 255 };
+    static constexpr Clay_Color kTransparent { 255, 255, 255, 0 };
+
+    static Clay_RenderCommand MakeCommand(
+        const Clay_RenderCommandType _type,
+        const float _x,
+        const float _y,
+        const float _width,
+        const float _height,
+        const u32 _id = 0)
+    {
+        Clay_RenderCommand command {};
+        command.commandType = _type;
+        command.boundingBox = { _x, _y, _width, _height };
+        command.id = _id;
+        return command;
+    }
+
+    static Clay_RenderCommand MakeRectangle(float _x, float _y, float _width, float _height, u32 _id, Clay_Color _color = kOpaque)
+    {
+        Clay_RenderCommand command = MakeCommand(CLAY_RENDER_COMMAND_TYPE_RECTANGLE, _x, _y, _width, _height, _id);
+        command.renderData.rectangle.backgroundColor = _color;
+        return command;
+    }
+
+    static Clay_RenderCommand MakeText(float _x, float _y, float _width, float _height, u32 _id, const char* _text = "Text")
+    {
+        Clay_RenderCommand command = MakeCommand(CLAY_RENDER_COMMAND_TYPE_TEXT, _x, _y, _width, _height, _id);
+        command.renderData.text.textColor = kOpaque;
+        command.renderData.text.stringContents = {
+            .length = static_cast<int32_t>(strlen(_text)),
+            .chars = _text,
+            .baseChars = _text,
+        };
+        return command;
+    }
+
+    static Clay_RenderCommand MakeImage(float _x, float _y, float _width, float _height, u32 _id)
+    {
+        // Zero tint is displayed untinted
+        return MakeCommand(CLAY_RENDER_COMMAND_TYPE_IMAGE, _x, _y, _width, _height, _id);
+    }
+
+    static Clay_RenderCommand MakeBorder(float _x, float _y, float _width, float _height, u32 _id, u16 _borderWidth = 1)
+    {
+        Clay_RenderCommand command = MakeCommand(CLAY_RENDER_COMMAND_TYPE_BORDER, _x, _y, _width, _height, _id);
+        command.renderData.border.color = kOpaque;
+        command.renderData.border.width = { _borderWidth, _borderWidth, _borderWidth, _borderWidth, 0 };
+        return command;
+    }
+
+    static eastl::vector<u32> GetIds(const eastl::span<const Clay_RenderCommand> _commands)
+    {
+        eastl::vector<u32> ids;
+        for (const Clay_RenderCommand& command: _commands)
+            ids.push_back(command.id);
+        return ids;
+    }
+
+    TEST(GuiRenderCommandOptimizer, CullAndDrop)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        GuiRenderCommandOptimizer optimizer { AllocatorInstance() };
+
+        const Clay_RenderCommand commands[] = {
+            MakeRectangle(0, 0, 100, 100, 1),
+            // Off viewport
+            MakeRectangle(0, 1000, 100, 100, 2),
+            // Fully transparent
+            MakeRectangle(0, 0, 100, 100, 3, kTransparent),
+            // Scissor only containing clipped content
+            MakeCommand(CLAY_RENDER_COMMAND_TYPE_SCISSOR_START, 0, 0, 100, 100, 4),
+            MakeRectangle(200, 200, 50, 50, 5),
+            MakeText(0, 150, 50, 20, 6),
+            MakeCommand(CLAY_RENDER_COMMAND_TYPE_SCISSOR_END, 0, 0, 0, 0, 7),
+            MakeCommand(CLAY_RENDER_COMMAND_TYPE_NONE, 0, 0, 10, 10, 8),
+            // Border without width, empty text, zero-sized rectangle
+            MakeBorder(0, 0, 100, 100, 9, 0),
+            MakeText(10, 10, 50, 20, 10, ""),
+            MakeRectangle(10, 10, 0, 20, 11),
+            // Untinted image
+            MakeImage(300, 300, 50, 50, 12),
+            // Scissor with visible content is kept
+            MakeCommand(CLAY_RENDER_COMMAND_TYPE_SCISSOR_START, 400, 0, 100, 100, 13),
+            MakeText(410, 10, 50, 20, 14),
+            MakeCommand(CLAY_RENDER_COMMAND_TYPE_SCISSOR_END, 0, 0, 0, 0, 15),
+        };
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        const eastl::span<const Clay_RenderCommand> output = optimizer.Process(commands, float2(800, 600));
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        const eastl::vector<u32> expectedIds = { 1, 12, 13, 14, 15 };
+        EXPECT_EQ(GetIds(output), expectedIds);
+
+        const GuiRenderCommandOptimizer::Statistics& statistics = optimizer.GetStatistics();
+        EXPECT_EQ(statistics.m_inputCommands, 15);
+        EXPECT_EQ(statistics.m_outputCommands, 5);
+        EXPECT_EQ(statistics.m_culledCommands, 3);
+        EXPECT_EQ(statistics.m_invisibleCommands, 5);
+        EXPECT_EQ(statistics.m_removedScissors, 1);
+        EXPECT_EQ(statistics.m_reorderedCommands, 0);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(GuiRenderCommandOptimizer, Reordering)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        GuiRenderCommandOptimizer optimizer { AllocatorInstance() };
+
+        // Three list rows, each with a background, a label and an icon
+        eastl::vector<Clay_RenderCommand> commands;
+        for (u32 i = 0; i < 3; i++)
+        {
+            const float y = static_cast<float>(i) * 30.f;
+            commands.push_back(MakeRectangle(0, y, 200, 30, 10 * i + 1));
+            commands.push_back(MakeText(10, y + 5, 100, 20, 10 * i + 2));
+            commands.push_back(MakeImage(150, y + 5, 20, 20, 10 * i + 3));
+        }
+        // Overlaps the last label, must stay after it
+        commands.push_back(MakeRectangle(50, 65, 20, 20, 100));
+        // Scissor commands split the reordering segments
+        commands.push_back(MakeCommand(CLAY_RENDER_COMMAND_TYPE_SCISSOR_START, 0, 200, 200, 200, 101));
+        commands.push_back(MakeRectangle(0, 200, 10, 10, 102));
+        commands.push_back(MakeCommand(CLAY_RENDER_COMMAND_TYPE_SCISSOR_END, 0, 0, 0, 0, 103));
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        const eastl::span<const Clay_RenderCommand> output = optimizer.Process(commands, float2(800, 600));
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        const eastl::vector<u32> expectedIds = { 1, 11, 21, 2, 12, 22, 3, 13, 23, 100, 101, 102, 103 };
+        EXPECT_EQ(GetIds(output), expectedIds);
+        EXPECT_EQ(optimizer.GetStatistics().m_reorderedCommands, 4);
+        EXPECT_EQ(optimizer.GetStatistics().m_outputCommands, commands.size());
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(GuiRenderCommandOptimizer, DISABLED_Benchmark)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        GuiRenderCommandOptimizer optimizer { AllocatorInstance() };
+
+        // A scrolled list of 100k rows, in a scroll container covering the viewport
+        constexpr u32 itemCount = 100'000;
+        constexpr float rowHeight = 24.f;
+        const float2 viewportSize { 800, 600 };
+        const float scrollOffset = itemCount / 2 * rowHeight;
+
+        eastl::vector<Clay_RenderCommand> commands;
+        commands.push_back(MakeCommand(CLAY_RENDER_COMMAND_TYPE_SCISSOR_START, 0, 0, viewportSize.x, viewportSize.y));
+        for (u32 i = 0; i < itemCount; i++)
+        {
+            const float y = static_cast<float>(i) * rowHeight - scrollOffset;
+            // Alternating row backgrounds, odd ones being transparent
+            commands.push_back(MakeRectangle(0, y, viewportSize.x, rowHeight, i, i % 2 == 0 ? kOpaque : kTransparent));
+            commands.push_back(MakeImage(4, y + 4, 16, 16, i));
+            commands.push_back(MakeText(24, y + 2, 300, 20, i));
+            commands.push_back(MakeBorder(0, y, viewportSize.x, rowHeight, i));
+        }
+        commands.push_back(MakeCommand(CLAY_RENDER_COMMAND_TYPE_SCISSOR_END, 0, 0, 0, 0));
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        const auto start = std::chrono::steady_clock::now();
+        const eastl::span<const Clay_RenderCommand> output = optimizer.Process(commands, viewportSize);
+        const std::chrono::duration<double, std::milli> time = std::chrono::steady_clock::now() - start;
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        const GuiRenderCommandOptimizer::Statistics& statistics = optimizer.GetStatistics();
+        EXPECT_EQ(statistics.m_inputCommands, commands.size());
+        EXPECT_EQ(
+            statistics.m_outputCommands + statistics.m_culledCommands + statistics.m_invisibleCommands,
+            statistics.m_inputCommands);
+
+        for (const Clay_RenderCommand& command: output.subspan(1, output.size() - 2))
+        {
+            EXPECT_LT(command.boundingBox.y, viewportSize.y);
+            EXPECT_GT(command.boundingBox.y + command.boundingBox.height, 0.f);
+        }
+
+        // Only the ~26 visible rows are left
+        EXPECT_LT(statistics.m_outputCommands, 30 * 4);
+
+        printf(
+            "Render command post-pass: %u commands in %.2f ms. %u culled, %u invisible, %u reordered, %u output\n",
+            statistics.m_inputCommands,
+            time.count(),
+            statistics.m_culledCommands,
+            statistics.m_invisibleCommands,
+            statistics.m_reorderedCommands,
+            statistics.m_outputCommands);
+
+        catcher.ExpectNoMessage();
+    }
+}
@@ -0,0 +1,104 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <KryneEngine/Modules/GuiLib/GuiRenderers/GuiTextTierSelector.hpp>
+#include <gtest/gtest.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::GuiLib::Tests
+{
+    using namespace KryneEngine::Tests;
+    using Tier = GuiTextTierSelector::Tier;
+
+    TEST(GuiTextTierSelector, TierSelection)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        GuiTextTierSelector selector;
+        selector.SetSettings({ .m_coverageMaxFontSize = 16.f });
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        selector.BeginFrame(true);
+        EXPECT_EQ(selector.SelectTier(10.f), Tier::Coverage);
+        EXPECT_EQ(selector.SelectTier(16.f), Tier::Coverage);
+        EXPECT_EQ(selector.SelectTier(16.5f), Tier::Msdf);
+        EXPECT_EQ(selector.SelectTier(48.f), Tier::Msdf);
+
+        // Sizes rounding to 0 px have no coverage bitmap
+        EXPECT_EQ(selector.SelectTier(0.2f), Tier::Msdf);
+
+        EXPECT_EQ(GuiTextTierSelector::GetCoveragePixelSize(12.4f), 12);
+        EXPECT_EQ(GuiTextTierSelector::GetCoveragePixelSize(12.5f), 13);
+
+        // Coverage bitmaps are only valid 1:1, text drawn with a custom transform keeps the MSDF path
+        selector.BeginFrame(false);
+        EXPECT_EQ(selector.SelectTier(10.f), Tier::Msdf);
+
+        // Coverage tier can be disabled altogether
+        selector.SetSettings({ .m_coverageMaxFontSize = 0.f });
+        selector.BeginFrame(true);
+        EXPECT_EQ(selector.SelectTier(10.f), Tier::Msdf);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(GuiTextTierSelector, InstanceBudget)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        GuiTextTierSelector selector;
+        selector.SetSettings({ .m_coverageMaxFontSize = 16.f, .m_instanceBudget = 10 });
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        selector.BeginFrame(true);
+        u32 accepted = 0;
+        for (u32 i = 0; i < 6; i++)
+            accepted += selector.AcquireInstance(selector.SelectTier(12.f)) ? 1 : 0;
+        for (u32 i = 0; i < 8; i++)
+            accepted += selector.AcquireInstance(selector.SelectTier(32.f)) ? 1 : 0;
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(accepted, 10);
+        {
+            const GuiTextTierSelector::Statistics& statistics = selector.GetStatistics();
+            EXPECT_EQ(statistics.m_coverageInstances, 6);
+            EXPECT_EQ(statistics.m_msdfInstances, 4);
+            EXPECT_EQ(statistics.m_overBudgetInstances, 4);
+            EXPECT_EQ(statistics.GetInstanceCount(), 10);
+        }
+
+        // The budget is per frame
+        selector.BeginFrame(true);
+        EXPECT_TRUE(selector.AcquireInstance(Tier::Msdf));
+        EXPECT_EQ(selector.GetStatistics().m_msdfInstances, 1);
+        EXPECT_EQ(selector.GetStatistics().m_overBudgetInstances, 0);
+
+        // No budget
+        selector.SetSettings({});
+        selector.BeginFrame(true);
+        for (u32 i = 0; i < 1000; i++)
+            EXPECT_TRUE(selector.AcquireInstance(Tier::Coverage));
+        EXPECT_EQ(selector.GetStatistics().m_coverageInstances, 1000);
+
+        catcher.ExpectNoMessage();
+    }
+}
@@ -0,0 +1,229 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <KryneEngine/Modules/GuiLib/GuiRenderers/GuiTextureBindingCache.hpp>
+#include <gtest/gtest.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::GuiLib::Tests
+{
+    using namespace KryneEngine::Tests;
+
+    static TextureViewHandle MakeTextureView(u32 _index)
+    {
+        return TextureViewHandle { GenPool::Handle::FromU32(_index + 1) };
+    }
+
+    static SamplerHandle MakeSampler(u32 _index)
+    {
+        return SamplerHandle { GenPool::Handle::FromU32(_index + 1) };
+    }
+
+    TEST(GuiTextureBindingCache, PersistentBindings)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        GuiTextureBindingCache cache { AllocatorInstance(), 2 };
+
+        const TextureViewHandle textureA = MakeTextureView(0);
+        const TextureViewHandle textureB = MakeTextureView(1);
+        const SamplerHandle linear = MakeSampler(0);
+        const SamplerHandle point = MakeSampler(1);
+
+        const auto runFrame = [&](const u64 _frameId)
+        {
+            cache.BeginFrame(_frameId);
+            const GuiTextureBindingCache::Binding bindings[] = {
+                cache.Acquire(textureA, linear),
+                cache.Acquire(textureB, linear),
+                cache.Acquire(textureA, point),
+            };
+            cache.EndFrame();
+            return eastl::array<GuiTextureBindingCache::Binding, 3> { bindings[0], bindings[1], bindings[2] };
+        };
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        const auto first = runFrame(10);
+        {
+            const GuiTextureBindingCache::Statistics& statistics = cache.GetStatistics();
+            EXPECT_EQ(statistics.m_misses, 3);
+            EXPECT_EQ(statistics.m_setCreations, 1);
+            EXPECT_EQ(statistics.m_setWrites, 1);
+            EXPECT_EQ(statistics.m_descriptorWrites, 4);
+        }
+
+        EXPECT_EQ(first[0].m_descriptorSetIndex, 0);
+        EXPECT_EQ(first[0].m_textureSlot, 0);
+        EXPECT_EQ(first[0].m_samplerSlot, 0);
+        EXPECT_EQ(first[1].m_textureSlot, 1);
+        EXPECT_EQ(first[1].m_samplerSlot, 0);
+        // Same texture with another sampler shares the texture slot
+        EXPECT_EQ(first[2].m_textureSlot, 0);
+        EXPECT_EQ(first[2].m_samplerSlot, 1);
+        EXPECT_EQ(cache.GetFrameTextureViews().size(), 2);
+        EXPECT_EQ(cache.GetDescriptorSets().size(), 1);
+
+        // Second frame context copy still has to be written
+        const auto second = runFrame(11);
+        {
+            const GuiTextureBindingCache::Statistics& statistics = cache.GetStatistics();
+            EXPECT_EQ(statistics.m_hits, 3);
+            EXPECT_EQ(statistics.m_misses, 0);
+            EXPECT_EQ(statistics.m_setCreations, 0);
+            EXPECT_EQ(statistics.m_setWrites, 1);
+        }
+        for (u32 i = 0; i < second.size(); i++)
+        {
+            EXPECT_EQ(second[i].m_textureSlot, first[i].m_textureSlot);
+            EXPECT_EQ(second[i].m_samplerSlot, first[i].m_samplerSlot);
+        }
+
+        // Static UI, nothing to do anymore
+        runFrame(12);
+        {
+            const GuiTextureBindingCache::Statistics& statistics = cache.GetStatistics();
+            EXPECT_EQ(statistics.m_hits, 3);
+            EXPECT_EQ(statistics.m_setCreations, 0);
+            EXPECT_EQ(statistics.m_setWrites, 0);
+            EXPECT_EQ(statistics.m_descriptorWrites, 0);
+        }
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(GuiTextureBindingCache, SlotOverflow)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        GuiTextureBindingCache cache { AllocatorInstance(), 2 };
+
+        constexpr u32 textureCount = GuiTextureBindingCache::kTextureSlotCount + 8;
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        cache.BeginFrame(0);
+        eastl::vector<GuiTextureBindingCache::Binding> bindings;
+        for (u32 i = 0; i < textureCount; i++)
+            bindings.push_back(cache.Acquire(MakeTextureView(i), MakeSampler(0)));
+
+        // One more sampler than a set can hold, each with its own texture
+        for (u32 i = 0; i <= GuiTextureBindingCache::kSamplerSlotCount; i++)
+            bindings.push_back(cache.Acquire(MakeTextureView(100 + i), MakeSampler(10 + i)));
+
+        cache.EndFrame();
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        for (u32 i = 0; i < GuiTextureBindingCache::kTextureSlotCount; i++)
+            EXPECT_EQ(bindings[i].m_descriptorSetIndex, 0);
+        for (u32 i = GuiTextureBindingCache::kTextureSlotCount; i < textureCount; i++)
+            EXPECT_EQ(bindings[i].m_descriptorSetIndex, 1);
+
+        // Set 1 already holds sampler 0, so it can only take 7 of the new samplers
+        for (u32 i = 0; i < GuiTextureBindingCache::kSamplerSlotCount - 1; i++)
+            EXPECT_EQ(bindings[textureCount + i].m_descriptorSetIndex, 1);
+        EXPECT_EQ(bindings[textureCount + GuiTextureBindingCache::kSamplerSlotCount - 1].m_descriptorSetIndex, 2);
+        EXPECT_EQ(bindings.back().m_descriptorSetIndex, 2);
+
+        EXPECT_EQ(cache.GetStatistics().m_setCreations, 3);
+        EXPECT_EQ(cache.GetDescriptorSets().size(), 3);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(GuiTextureBindingCache, Eviction)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        constexpr u32 evictionFrameCount = 4;
+        GuiTextureBindingCache cache { AllocatorInstance(), 2, evictionFrameCount };
+
+        const TextureViewHandle textureA = MakeTextureView(0);
+        const TextureViewHandle textureB = MakeTextureView(1);
+        const TextureViewHandle textureC = MakeTextureView(2);
+        const SamplerHandle sampler = MakeSampler(0);
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        cache.BeginFrame(0);
+        (void)cache.Acquire(textureA, sampler);
+        (void)cache.Acquire(textureB, sampler);
+        cache.EndFrame();
+
+        u64 frameId = 1;
+        for (; frameId <= evictionFrameCount; frameId++)
+        {
+            cache.BeginFrame(frameId);
+            (void)cache.Acquire(textureA, sampler);
+            cache.EndFrame();
+            EXPECT_EQ(cache.GetStatistics().m_slotEvictions, 0);
+        }
+
+        // Texture B hasn't been used for more than the eviction frame count
+        cache.BeginFrame(frameId);
+        (void)cache.Acquire(textureA, sampler);
+        cache.EndFrame();
+        EXPECT_EQ(cache.GetStatistics().m_slotEvictions, 1);
+        frameId++;
+
+        // Its slot gets reused, no new descriptor set
+        cache.BeginFrame(frameId);
+        const GuiTextureBindingCache::Binding bindingC = cache.Acquire(textureC, sampler);
+        cache.EndFrame();
+        EXPECT_EQ(bindingC.m_descriptorSetIndex, 0);
+        EXPECT_EQ(bindingC.m_textureSlot, 1);
+        EXPECT_EQ(cache.GetStatistics().m_setCreations, 0);
+        EXPECT_EQ(cache.GetStatistics().m_setWrites, 1);
+        frameId++;
+
+        // Invalidated textures are re-bound on next use
+        cache.BeginFrame(frameId);
+        cache.Invalidate(textureA);
+        (void)cache.Acquire(textureA, sampler);
+        cache.EndFrame();
+        EXPECT_EQ(cache.GetStatistics().m_misses, 1);
+        EXPECT_EQ(cache.GetStatistics().m_slotEvictions, 1);
+        const u64 lastUseFrame = frameId;
+        frameId++;
+
+        // Once nothing is used anymore, the whole set goes away
+        u32 setEvictions = 0;
+        for (; frameId <= lastUseFrame + evictionFrameCount + 1; frameId++)
+        {
+            cache.BeginFrame(frameId);
+            cache.EndFrame();
+            setEvictions += cache.GetStatistics().m_setEvictions;
+        }
+        EXPECT_EQ(setEvictions, 1);
+
+        cache.BeginFrame(frameId);
+        (void)cache.Acquire(textureB, sampler);
+        cache.EndFrame();
+        EXPECT_EQ(cache.GetStatistics().m_setCreations, 1);
+        EXPECT_EQ(cache.GetDescriptorSets().size(), 1);
+
+        catcher.ExpectNoMessage();
+    }
+}
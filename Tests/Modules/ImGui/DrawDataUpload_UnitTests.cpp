@@ -0,0 +1,236 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <EASTL/unique_ptr.h>
+#include <EASTL/vector.h>
+#include <KryneEngine/Core/Math/Hashing.hpp>
+#include <KryneEngine/Core/Threads/FibersManager.hpp>
+#include <KryneEngine/Modules/ImGui/Context.hpp>
+#include <gtest/gtest.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::ImGui::Tests
+{
+    using namespace KryneEngine::Tests;
+
+    struct SyntheticDrawData
+    {
+        eastl::vector<eastl::unique_ptr<ImDrawList>> m_lists;
+        eastl::vector<ImDrawList*> m_listPointers;
+        ImDrawData m_drawData {};
+
+        SyntheticDrawData(u32 _listCount, u32 _verticesPerList)
+        {
+            const u32 indicesPerList = _verticesPerList / 4 * 6;
+            for (u32 i = 0; i < _listCount; i++)
+            {
+                auto& list = m_lists.emplace_back(new ImDrawList(nullptr));
+                list->VtxBuffer.resize(static_cast<s32>(_verticesPerList));
+                list->IdxBuffer.resize(static_cast<s32>(indicesPerList));
+
+                for (u32 j = 0; j < _verticesPerList; j++)
+                {
+                    const u64 hash = Hashing::Hash64(static_cast<u64>(i) << 32 | j);
+                    ImDrawVert& vertex = list->VtxBuffer[static_cast<s32>(j)];
+                    vertex.pos = { static_cast<float>(hash & 0xfff), static_cast<float>((hash >> 12) & 0xfff) };
+                    vertex.uv = {
+                        static_cast<float>((hash >> 24) & 0xff) / 255.f,
+                        static_cast<float>((hash >> 32) & 0xff) / 255.f,
+                    };
+                    vertex.col = static_cast<u32>(hash >> 32);
+                }
+
+                // Quads, as ImGui emits them
+                for (u32 j = 0; j < indicesPerList / 6; j++)
+                {
+                    constexpr u32 quadIndices[] = { 0, 1, 2, 0, 2, 3 };
+                    for (u32 k = 0; k < 6; k++)
+                        list->IdxBuffer[static_cast<s32>(j * 6 + k)] = static_cast<ImDrawIdx>(j * 4 + quadIndices[k]);
+                }
+
+                m_listPointers.push_back(list.get());
+            }
+
+            m_drawData.Valid = true;
+            m_drawData.CmdListsCount = static_cast<s32>(_listCount);
+            m_drawData.TotalVtxCount = static_cast<s32>(_listCount * _verticesPerList);
+            m_drawData.TotalIdxCount = static_cast<s32>(_listCount * indicesPerList);
+            m_drawData.CmdLists.Data = m_listPointers.data();
+            m_drawData.CmdLists.Size = static_cast<s32>(_listCount);
+            m_drawData.CmdLists.Capacity = static_cast<s32>(_listCount);
+        }
+
+        ~SyntheticDrawData()
+        {
+            // The list pointers are owned by this struct, don't let ImVector free them.
+            m_drawData.CmdLists.Data = nullptr;
+            m_drawData.CmdLists.Size = 0;
+            m_drawData.CmdLists.Capacity = 0;
+        }
+    };
+
+    static void ExpectMatchesSource(const ImDrawData& _drawData, const ImDrawVert* _vertices, const ImDrawIdx* _indices)
+    {
+        for (s32 i = 0; i < _drawData.CmdListsCount; i++)
+        {
+            const ImDrawList* list = _drawData.CmdLists[i];
+            EXPECT_EQ(memcmp(_vertices, list->VtxBuffer.Data, list->VtxBuffer.size_in_bytes()), 0);
+            EXPECT_EQ(memcmp(_indices, list->IdxBuffer.Data, list->IdxBuffer.size_in_bytes()), 0);
+            _vertices += list->VtxBuffer.Size;
+            _indices += list->IdxBuffer.Size;
+        }
+    }
+
+    TEST(DrawDataUpload, CopyDrawData)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        const SyntheticDrawData synthetic { 8, 1024 };
+        const ImDrawData& drawData = synthetic.m_drawData;
+
+        eastl::vector<ImDrawVert> serialVertices(drawData.TotalVtxCount);
+        eastl::vector<ImDrawIdx> serialIndices(drawData.TotalIdxCount);
+        eastl::vector<ImDrawVert> parallelVertices(drawData.TotalVtxCount);
+        eastl::vector<ImDrawIdx> parallelIndices(drawData.TotalIdxCount);
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        Context::CopyDrawData(&drawData, serialVertices.data(), serialIndices.data());
+
+        {
+            // Waiting from outside a fiber thread goes through the global instance
+            FibersManager fibersManager { 2, AllocatorInstance() };
+            FibersManager::SetInstance(&fibersManager);
+            Context::CopyDrawData(&drawData, parallelVertices.data(), parallelIndices.data(), &fibersManager);
+            FibersManager::SetInstance(nullptr);
+        }
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        ExpectMatchesSource(drawData, serialVertices.data(), serialIndices.data());
+        ExpectMatchesSource(drawData, parallelVertices.data(), parallelIndices.data());
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(DrawDataUpload, DISABLED_Benchmark)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        // 64 windows of 16k vertices, ~1M vertices in total
+        constexpr u32 listCount = 64;
+        constexpr u32 verticesPerList = 16 * 1024;
+        const SyntheticDrawData synthetic { listCount, verticesPerList };
+        const ImDrawData& drawData = synthetic.m_drawData;
+
+        eastl::vector<ImDrawVert> vertices(drawData.TotalVtxCount);
+        eastl::vector<ImDrawIdx> indices(drawData.TotalIdxCount);
+
+        // Previous upload path: per element vertex copy and 32-bit index widening
+        struct ReferenceVertex
+        {
+            float2 m_position;
+            float2 m_uv;
+            u32 m_color;
+        };
+        eastl::vector<ReferenceVertex> referenceVertices(drawData.TotalVtxCount);
+        eastl::vector<u32> referenceIndices(drawData.TotalIdxCount);
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        const auto start = std::chrono::steady_clock::now();
+        {
+            u64 vertexIndex = 0;
+            u64 indexIndex = 0;
+            for (s32 i = 0; i < drawData.CmdListsCount; i++)
+            {
+                const ImDrawList* list = drawData.CmdLists[i];
+                for (const ImDrawVert& vertex: list->VtxBuffer)
+                {
+                    referenceVertices[vertexIndex++] = {
+                        { vertex.pos.x, vertex.pos.y },
+                        { vertex.uv.x, vertex.uv.y },
+                        vertex.col,
+                    };
+                }
+                for (const ImDrawIdx index: list->IdxBuffer)
+                    referenceIndices[indexIndex++] = index;
+            }
+        }
+        const auto referenceEnd = std::chrono::steady_clock::now();
+
+        Context::CopyDrawData(&drawData, vertices.data(), indices.data());
+        const auto serialEnd = std::chrono::steady_clock::now();
+
+        ExpectMatchesSource(drawData, vertices.data(), indices.data());
+        eastl::fill(vertices.begin(), vertices.end(), ImDrawVert {});
+        eastl::fill(indices.begin(), indices.end(), 0);
+
+        std::chrono::duration<double, std::micro> parallelTime {};
+        u16 fiberThreadCount;
+        {
+            // Waiting from outside a fiber thread goes through the global instance
+            FibersManager fibersManager { 4, AllocatorInstance() };
+            FibersManager::SetInstance(&fibersManager);
+            fiberThreadCount = fibersManager.GetFiberThreadCount();
+
+            const auto parallelStart = std::chrono::steady_clock::now();
+            Context::CopyDrawData(&drawData, vertices.data(), indices.data(), &fibersManager);
+            parallelTime = std::chrono::steady_clock::now() - parallelStart;
+
+            FibersManager::SetInstance(nullptr);
+        }
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        ExpectMatchesSource(drawData, vertices.data(), indices.data());
+
+        // The bulk copies hold the same data as the previous upload path
+        static_assert(sizeof(ReferenceVertex) == sizeof(ImDrawVert));
+        EXPECT_EQ(memcmp(referenceVertices.data(), vertices.data(), vertices.size() * sizeof(ImDrawVert)), 0);
+        for (u32 i = 0; i < indices.size(); i++)
+        {
+            if (referenceIndices[i] != indices[i])
+            {
+                ADD_FAILURE() << "Index mismatch at " << i;
+                break;
+            }
+        }
+
+        const std::chrono::duration<double, std::micro> referenceTime = referenceEnd - start;
+        const std::chrono::duration<double, std::micro> serialTime = serialEnd - referenceEnd;
+        printf(
+            "ImGui draw data upload: %d vertices, %d indices. Per element: %.1f us, bulk: %.1f us, "
+            "bulk over %u fiber threads: %.1f us\n",
+            drawData.TotalVtxCount,
+            drawData.TotalIdxCount,
+            referenceTime.count(),
+            serialTime.count(),
+            fiberThreadCount,
+            parallelTime.count());
+
+        catcher.ExpectNoMessage();
+    }
+}
@@ -0,0 +1,374 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <EASTL/algorithm.h>
+#include <EASTL/hash_map.h>
+#include <EASTL/vector.h>
+#include <gtest/gtest.h>
+#include <KryneEngine/Modules/SdfTexture/Generator.hpp>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::SdfTexture::Tests
+{
+    using namespace KryneEngine::Tests;
+
+    namespace
+    {
+        constexpr float kSphereRadius = 0.8f;
+
+        struct Mesh
+        {
+            eastl::vector<float3> m_vertices;
+            eastl::vector<u32> m_indices;
+        };
+
+        // Closed sphere mesh, made of 20 * 4^_subdivisions triangles
+        Mesh BuildIcosphere(const u32 _subdivisions)
+        {
+            Mesh mesh;
+
+            const float t = (1.f + std::sqrt(5.f)) * 0.5f;
+            const float3 icosahedronVertices[] = {
+                { -1, t, 0 }, { 1, t, 0 }, { -1, -t, 0 }, { 1, -t, 0 },
+                { 0, -1, t }, { 0, 1, t }, { 0, -1, -t }, { 0, 1, -t },
+                { t, 0, -1 }, { t, 0, 1 }, { -t, 0, -1 }, { -t, 0, 1 },
+            };
+            for (const float3& vertex: icosahedronVertices)
+            {
+                mesh.m_vertices.push_back(vertex.Normalized());
+            }
+            mesh.m_indices = {
+                0, 11, 5, 0, 5, 1, 0, 1, 7, 0, 7, 10, 0, 10, 11,
+                1, 5, 9, 5, 11, 4, 11, 10, 2, 10, 7, 6, 7, 1, 8,
+                3, 9, 4, 3, 4, 2, 3, 2, 6, 3, 6, 8, 3, 8, 9,
+                4, 9, 5, 2, 4, 11, 6, 2, 10, 8, 6, 7, 9, 8, 1,
+            };
+
+            for (u32 subdivision = 0; subdivision < _subdivisions; subdivision++)
+            {
+                eastl::hash_map<u64, u32> midpoints;
+                const auto getMidpoint = [&](const u32 _a, const u32 _b)
+                {
+                    const u64 key = (u64(eastl::min(_a, _b)) << 32) | eastl::max(_a, _b);
+                    const auto it = midpoints.find(key);
+                    if (it != midpoints.end())
+                    {
+                        return it->second;
+                    }
+                    mesh.m_vertices.push_back(((mesh.m_vertices[_a] + mesh.m_vertices[_b]) * 0.5f).Normalized());
+                    const u32 index = mesh.m_vertices.size() - 1;
+                    midpoints.emplace(key, index);
+                    return index;
+                };
+
+                eastl::vector<u32> indices;
+                indices.reserve(mesh.m_indices.size() * 4);
+                for (size_t i = 0; i < mesh.m_indices.size(); i += 3)
+                {
+                    const u32 a = mesh.m_indices[i];
+                    const u32 b = mesh.m_indices[i + 1];
+                    const u32 c = mesh.m_indices[i + 2];
+                    const u32 ab = getMidpoint(a, b);
+                    const u32 bc = getMidpoint(b, c);
+                    const u32 ca = getMidpoint(c, a);
+                    for (const u32 index: { a, ab, ca, b, bc, ab, c, ca, bc, ab, bc, ca })
+                    {
+                        indices.push_back(index);
+                    }
+                }
+                mesh.m_indices = eastl::move(indices);
+            }
+
+            for (float3& vertex: mesh.m_vertices)
+            {
+                vertex = vertex * kSphereRadius;
+            }
+            return mesh;
+        }
+
+        eastl::vector<float> Generate(Generator& _generator, const Mesh& _mesh, const Generator::Algorithm _algorithm)
+        {
+            _generator.SetAlgorithm(_algorithm);
+            _generator.Generate(
+                { reinterpret_cast<const std::byte*>(_mesh.m_indices.data()), _mesh.m_indices.size() * sizeof(u32) },
+                { reinterpret_cast<const std::byte*>(_mesh.m_vertices.data()), _mesh.m_vertices.size() * sizeof(float3) },
+                false,
+                sizeof(float3),
+                0);
+
+            const uint3& dimensions = _generator.GetDimensions();
+            const auto* output = reinterpret_cast<const Math::Float16*>(_generator.GetOutputBuffer());
+
+            eastl::vector<float> distances(dimensions.x * dimensions.y * dimensions.z);
+            for (size_t i = 0; i < distances.size(); i++)
+            {
+                distances[i] = static_cast<float>(output[i]);
+            }
+            return distances;
+        }
+    }
+
+    TEST(SdfTextureGenerator, NarrowBandMatchesBruteForce)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        constexpr u32 dimension = 24;
+        const Mesh mesh = BuildIcosphere(2);
+
+        Generator generator(AllocatorInstance {});
+        generator.SetMeshBoundingBox({ float3(-1.f), float3(1.f) });
+        generator.ForceDimensions(dimension);
+
+        const float texelSize = 2.f / static_cast<float>(dimension - 1);
+        const float bandDistance = static_cast<float>(generator.GetNarrowBandWidth()) * texelSize;
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        const eastl::vector<float> exact = Generate(generator, mesh, Generator::Algorithm::BruteForce);
+        const eastl::vector<float> approximate = Generate(generator, mesh, Generator::Algorithm::NarrowBandSweeping);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        ASSERT_EQ(exact.size(), approximate.size());
+
+        u32 bandTexelCount = 0;
+        for (size_t i = 0; i < exact.size(); i++)
+        {
+            // Exact in the band, whose texels have the same closest triangle
+            if (std::fabs(exact[i]) <= bandDistance)
+            {
+                EXPECT_EQ(exact[i], approximate[i]);
+                bandTexelCount++;
+            }
+            // Outside, the propagated closest triangle might not be the actual closest one
+            else
+            {
+                EXPECT_NEAR(exact[i], approximate[i], 0.25f * texelSize);
+            }
+        }
+        EXPECT_GT(bandTexelCount, 0);
+
+        // Both agree on the sign at the center of the sphere
+        const size_t center = dimension / 2 * (1 + dimension + dimension * dimension);
+        EXPECT_NEAR(std::fabs(exact[center]), kSphereRadius, texelSize);
+        EXPECT_EQ(std::signbit(exact[center]), std::signbit(approximate[center]));
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(SdfTextureGenerator, DISABLED_Benchmark)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        constexpr u32 dimension = 32;
+        const float texelSize = 2.f / static_cast<float>(dimension - 1);
+
+        Generator generator(AllocatorInstance {});
+        generator.SetMeshBoundingBox({ float3(-1.f), float3(1.f) });
+        generator.ForceDimensions(dimension);
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        for (u32 subdivisions = 0; subdivisions <= 3; subdivisions++)
+        {
+            const Mesh mesh = BuildIcosphere(subdivisions);
+
+            const auto exactStart = std::chrono::steady_clock::now();
+            const eastl::vector<float> exact = Generate(generator, mesh, Generator::Algorithm::BruteForce);
+            const auto approximateStart = std::chrono::steady_clock::now();
+            const eastl::vector<float> approximate = Generate(generator, mesh, Generator::Algorithm::NarrowBandSweeping);
+            const auto approximateEnd = std::chrono::steady_clock::now();
+
+            float maxError = 0.f;
+            for (size_t i = 0; i < exact.size(); i++)
+            {
+                maxError = eastl::max(maxError, std::fabs(exact[i] - approximate[i]));
+            }
+            EXPECT_LE(maxError, 0.25f * texelSize);
+
+            const std::chrono::duration<double, std::milli> exactTime = approximateStart - exactStart;
+            const std::chrono::duration<double, std::milli> approximateTime = approximateEnd - approximateStart;
+            printf(
+                "SdfTexture %u^3, %zu triangles: brute force %.1f ms, narrow band %.1f ms (x%.1f), max error %.3f texel\n",
+                dimension,
+                mesh.m_indices.size() / 3,
+                exactTime.count(),
+                approximateTime.count(),
+                exactTime.count() / approximateTime.count(),
+                maxError / texelSize);
+        }
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(SdfTextureGenerator, TiledMatchesBruteForce)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        constexpr u32 dimension = 30;
+        const Mesh mesh = BuildIcosphere(2);
+        const eastl::span<const std::byte> indices {
+            reinterpret_cast<const std::byte*>(mesh.m_indices.data()),
+            mesh.m_indices.size() * sizeof(u32)
+        };
+        const eastl::span<const std::byte> vertices {
+            reinterpret_cast<const std::byte*>(mesh.m_vertices.data()),
+            mesh.m_vertices.size() * sizeof(float3)
+        };
+
+        Generator generator(AllocatorInstance {});
+        generator.SetMeshBoundingBox({ float3(-1.f), float3(1.f) });
+        generator.ForceDimensions(dimension);
+        generator.SetBrickSize(4);
+
+        const float texelSize = 2.f / static_cast<float>(dimension - 1);
+        const eastl::vector<float> exact = Generate(generator, mesh, Generator::Algorithm::BruteForce);
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        eastl::vector<u32> texelCoverage(exact.size(), 0);
+        u64 denseBrickCount = 0;
+        u32 mismatchCount = 0;
+
+        const Generator::TiledStats stats = generator.GenerateTiled(
+            indices,
+            vertices,
+            false,
+            sizeof(float3),
+            0,
+            [&](const Generator::Brick& _brick)
+            {
+                for (u32 z = 0; z < _brick.m_dimensions.z; z++)
+                {
+                    for (u32 y = 0; y < _brick.m_dimensions.y; y++)
+                    {
+                        for (u32 x = 0; x < _brick.m_dimensions.x; x++)
+                        {
+                            const uint3 texel = _brick.m_texelOffset + uint3 { x, y, z };
+                            const size_t index = texel.x + dimension * (texel.y + dimension * texel.z);
+                            texelCoverage[index]++;
+
+                            if (_brick.IsSparse())
+                            {
+                                // Far from the surface, on the side of the brick center
+                                mismatchCount += std::fabs(exact[index]) <= generator.GetSparseDistance() * texelSize;
+                                mismatchCount += std::signbit(exact[index]) != std::signbit(_brick.m_centerDistance);
+                            }
+                            else
+                            {
+                                const u32 brickIndex = x + _brick.m_dimensions.x * (y + _brick.m_dimensions.y * z);
+                                mismatchCount += static_cast<float>(_brick.m_texels[brickIndex]) != exact[index];
+                            }
+                        }
+                    }
+                }
+                denseBrickCount += !_brick.IsSparse();
+            });
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        // 30 texels is 7 full bricks and a partial one per axis
+        EXPECT_EQ(stats.m_brickCount, 8 * 8 * 8);
+        EXPECT_EQ(stats.m_brickCount, stats.m_sparseBrickCount + denseBrickCount);
+        EXPECT_EQ(mismatchCount, 0);
+
+        for (const u32 coverage: texelCoverage)
+        {
+            EXPECT_EQ(coverage, 1);
+        }
+
+        EXPECT_EQ(stats.m_denseBytes, exact.size() * sizeof(Math::Float16));
+        EXPECT_GT(stats.m_sparseBrickCount, 0);
+        EXPECT_LT(stats.m_storedBytes, stats.m_denseBytes);
+
+        // Working memory doesn't depend on the resolution
+        EXPECT_LT(stats.m_peakWorkingBytes, stats.m_denseBytes);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(SdfTextureGenerator, TiledSparsity)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        const Mesh mesh = BuildIcosphere(3);
+        const eastl::span<const std::byte> indices {
+            reinterpret_cast<const std::byte*>(mesh.m_indices.data()),
+            mesh.m_indices.size() * sizeof(u32)
+        };
+        const eastl::span<const std::byte> vertices {
+            reinterpret_cast<const std::byte*>(mesh.m_vertices.data()),
+            mesh.m_vertices.size() * sizeof(float3)
+        };
+
+        Generator generator(AllocatorInstance {});
+        generator.SetBrickSize(4);
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        u64 previousPeakWorkingBytes = 0;
+        for (const float boundsExtent: { 1.f, 2.f })
+        {
+            for (const u32 dimension: { 32u, 64u })
+            {
+                generator.SetMeshBoundingBox({ float3(-boundsExtent), float3(boundsExtent) });
+                generator.ForceDimensions(dimension);
+
+                const Generator::TiledStats stats = generator.GenerateTiled(
+                    indices,
+                    vertices,
+                    false,
+                    sizeof(float3),
+                    0,
+                    [](const Generator::Brick&) {});
+
+                EXPECT_GT(stats.m_sparseBrickCount, 0);
+                EXPECT_LT(stats.m_storedBytes, stats.m_denseBytes);
+
+                // Bounded by the brick size and the triangle count only
+                if (previousPeakWorkingBytes != 0)
+                {
+                    EXPECT_EQ(stats.m_peakWorkingBytes, previousPeakWorkingBytes);
+                }
+                previousPeakWorkingBytes = stats.m_peakWorkingBytes;
+            }
+        }
+
+        catcher.ExpectNoMessage();
+    }
+}
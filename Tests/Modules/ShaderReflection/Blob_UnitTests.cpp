@@ -0,0 +1,229 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <EASTL/string.h>
+#include <EASTL/vector.h>
+#include <KryneEngine/Modules/ShaderReflection/Blob.hpp>
+#include <gtest/gtest.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::ShaderReflection::Tests
+{
+    using namespace KryneEngine::Tests;
+
+    // Synthetic reflection data, with names generated from indices.
+    struct SyntheticShader
+    {
+        eastl::vector<eastl::string> m_names;
+        eastl::vector<DescriptorInput> m_descriptors;
+        eastl::vector<DescriptorSetInput> m_descriptorSets;
+        eastl::vector<EntryPointInput> m_entryPoints;
+
+        SyntheticShader(u32 _entryPointCount, u32 _setsPerEntryPoint, u32 _descriptorsPerSet)
+        {
+            const u32 setCount = _entryPointCount * _setsPerEntryPoint;
+            const u32 descriptorCount = setCount * _descriptorsPerSet;
+
+            // Reserve upfront, so string views and spans stay valid
+            m_names.reserve(_entryPointCount + setCount + descriptorCount);
+            m_descriptors.reserve(descriptorCount);
+            m_descriptorSets.reserve(setCount);
+
+            for (u32 i = 0; i < _entryPointCount; i++)
+            {
+                const DescriptorSetInput* firstSet = m_descriptorSets.end();
+                for (u32 j = 0; j < _setsPerEntryPoint; j++)
+                {
+                    const DescriptorInput* firstDescriptor = m_descriptors.end();
+                    for (u32 k = 0; k < _descriptorsPerSet; k++)
+                    {
+                        m_descriptors.push_back({
+                            .m_name = m_names.push_back().sprintf("descriptor_%u", k),
+                            .m_type = k % 2 == 0 ? DescriptorBindingDesc::Type::SampledTexture : DescriptorBindingDesc::Type::ConstantBuffer,
+                            .m_textureType = TextureTypes::Single2D,
+                            .m_count = static_cast<u16>(1 + k % 3),
+                            .m_bindingIndex = static_cast<u16>(k),
+                        });
+                    }
+                    m_descriptorSets.push_back({
+                        .m_name = m_names.push_back().sprintf("Set%u", j),
+                        .m_descriptors = { firstDescriptor, _descriptorsPerSet },
+                    });
+                }
+                m_entryPoints.push_back({
+                    .m_name = m_names.push_back().sprintf("EntryPoint_%u_%s", i, i % 2 == 0 ? "Vs" : "Fs"),
+                    .m_stage = i % 2 == 0 ? ShaderStage::Stage::Vertex : ShaderStage::Stage::Fragment,
+                    .m_pushConstants = {},
+                    .m_descriptorSets = { firstSet, _setsPerEntryPoint },
+                });
+            }
+        }
+    };
+
+    TEST(ShaderReflectionBlob, NameLookup)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        const SyntheticShader shader { 16, 3, 5 };
+
+        size_t blobSize = 0;
+        Blob* blob = Blob::CreateBlob(AllocatorInstance(), shader.m_entryPoints, blobSize);
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        ASSERT_NE(blob, nullptr);
+        EXPECT_TRUE(Blob::IsShaderReflectionBlob(blob->GetByteBuffer()));
+        EXPECT_EQ(blob->GetEntryPointCount(), 16);
+
+        for (u32 i = 0; i < shader.m_entryPoints.size(); i++)
+        {
+            const EntryPointInput& input = shader.m_entryPoints[i];
+            EXPECT_EQ(blob->FindEntryPointIndex(input.m_name), i);
+
+            const Blob::EntryPointHeader* entryPoint = blob->FindEntryPoint(input.m_name);
+            ASSERT_EQ(entryPoint, blob->GetEntryPointHeader(i));
+            EXPECT_EQ(blob->GetString(entryPoint->m_nameOffset), input.m_name);
+            EXPECT_EQ(entryPoint->m_stage, static_cast<u16>(input.m_stage));
+
+            for (u32 j = 0; j < input.m_descriptorSets.size(); j++)
+            {
+                const DescriptorSetInput& setInput = input.m_descriptorSets[j];
+                const Blob::DescriptorSetHeader* descriptorSet = blob->FindDescriptorSet(entryPoint, setInput.m_name);
+                ASSERT_EQ(descriptorSet, blob->GetDescriptorSetHeader(entryPoint, j));
+                EXPECT_EQ(blob->GetString(descriptorSet->m_nameOffset), setInput.m_name);
+
+                for (u32 k = 0; k < setInput.m_descriptors.size(); k++)
+                {
+                    const DescriptorInput& descriptorInput = setInput.m_descriptors[k];
+                    const Blob::DescriptorData* descriptor = blob->FindDescriptor(descriptorSet, descriptorInput.m_name);
+                    ASSERT_EQ(descriptor, &blob->GetDescriptors(descriptorSet)[k]);
+                    EXPECT_EQ(descriptor->m_bindingIndex, descriptorInput.m_bindingIndex);
+                    EXPECT_EQ(descriptor->m_count, descriptorInput.m_count);
+                    EXPECT_EQ(descriptor->m_type, descriptorInput.m_type);
+                }
+
+                EXPECT_EQ(blob->FindDescriptor(descriptorSet, "descriptor_99"), nullptr);
+            }
+
+            EXPECT_EQ(blob->FindDescriptorSet(entryPoint, "Set3"), nullptr);
+        }
+
+        EXPECT_EQ(blob->FindEntryPointIndex("EntryPoint_16_Vs"), Blob::kInvalidIndex);
+        EXPECT_EQ(blob->FindEntryPoint(""), nullptr);
+
+        AllocatorInstance().deallocate(blob, blobSize);
+
+        // Empty blob
+        blob = Blob::CreateBlob(AllocatorInstance(), {}, blobSize);
+        EXPECT_EQ(blob->FindEntryPoint("EntryPoint_0_Vs"), nullptr);
+        AllocatorInstance().deallocate(blob, blobSize);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(ShaderReflectionBlob, DISABLED_LookupBenchmark)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        constexpr u32 entryPointCount = 512;
+        const SyntheticShader shader { entryPointCount, 4, 8 };
+
+        size_t blobSize = 0;
+        Blob* blob = Blob::CreateBlob(AllocatorInstance(), shader.m_entryPoints, blobSize);
+
+        // Previous lookup path: scan the entry point headers, then the descriptor set and descriptor lists.
+        const auto linearFind = [blob](const eastl::string_view _entryPoint, const eastl::string_view _set, const eastl::string_view _descriptor)
+            -> const Blob::DescriptorData*
+        {
+            for (u32 i = 0; i < blob->GetEntryPointCount(); i++)
+            {
+                const Blob::EntryPointHeader* entryPoint = blob->GetEntryPointHeader(i);
+                if (blob->GetString(entryPoint->m_nameOffset) != _entryPoint)
+                    continue;
+
+                for (u32 j = 0; j < entryPoint->m_descriptorSetCount; j++)
+                {
+                    const Blob::DescriptorSetHeader* descriptorSet = blob->GetDescriptorSetHeader(entryPoint, j);
+                    if (blob->GetString(descriptorSet->m_nameOffset) != _set)
+                        continue;
+
+                    for (const Blob::DescriptorData& descriptor: blob->GetDescriptors(descriptorSet))
+                    {
+                        if (blob->GetString(descriptor.m_nameOffset) == _descriptor)
+                            return &descriptor;
+                    }
+                }
+            }
+            return nullptr;
+        };
+
+        const auto hashedFind = [blob](const eastl::string_view _entryPoint, const eastl::string_view _set, const eastl::string_view _descriptor)
+            -> const Blob::DescriptorData*
+        {
+            const Blob::EntryPointHeader* entryPoint = blob->FindEntryPoint(_entryPoint);
+            if (entryPoint == nullptr)
+                return nullptr;
+            const Blob::DescriptorSetHeader* descriptorSet = blob->FindDescriptorSet(entryPoint, _set);
+            return descriptorSet != nullptr ? blob->FindDescriptor(descriptorSet, _descriptor) : nullptr;
+        };
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        constexpr u32 iterations = 16;
+        u32 mismatches = 0;
+
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 iteration = 0; iteration < iterations; iteration++)
+        {
+            for (const EntryPointInput& entryPoint: shader.m_entryPoints)
+                mismatches += linearFind(entryPoint.m_name, "Set3", "descriptor_7") == nullptr ? 1 : 0;
+        }
+        const auto linearEnd = std::chrono::steady_clock::now();
+
+        for (u32 iteration = 0; iteration < iterations; iteration++)
+        {
+            for (const EntryPointInput& entryPoint: shader.m_entryPoints)
+                mismatches += hashedFind(entryPoint.m_name, "Set3", "descriptor_7") == nullptr ? 1 : 0;
+        }
+        const auto hashedEnd = std::chrono::steady_clock::now();
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(mismatches, 0);
+        for (const EntryPointInput& entryPoint: shader.m_entryPoints)
+            EXPECT_EQ(hashedFind(entryPoint.m_name, "Set2", "descriptor_5"), linearFind(entryPoint.m_name, "Set2", "descriptor_5"));
+
+        constexpr u32 lookupCount = iterations * entryPointCount;
+        const std::chrono::duration<double, std::nano> linearTime = linearEnd - start;
+        const std::chrono::duration<double, std::nano> hashedTime = hashedEnd - linearEnd;
+        printf(
+            "Shader reflection lookup, %u entry points, %zu bytes blob. Linear scan: %.1f ns/lookup, hashed: %.1f ns/lookup\n",
+            entryPointCount,
+            blobSize,
+            linearTime.count() / lookupCount,
+            hashedTime.count() / lookupCount);
+
+        AllocatorInstance().deallocate(blob, blobSize);
+
+        catcher.ExpectNoMessage();
+    }
+}
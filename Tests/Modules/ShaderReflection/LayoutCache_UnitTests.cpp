@@ -0,0 +1,238 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <EASTL/vector.h>
+#include <KryneEngine/Modules/ShaderReflection/LayoutCache.hpp>
+#include <gtest/gtest.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::ShaderReflection::Tests
+{
+    using namespace KryneEngine::Tests;
+
+    // Records layout creations and destructions instead of going through a graphics context.
+    struct RecordingBackend
+    {
+        eastl::vector<eastl::vector<DescriptorBindingDesc>> m_createdSetLayouts;
+        eastl::vector<eastl::vector<DescriptorSetLayoutHandle>> m_createdPipelineLayouts;
+        u32 m_destroyedSetLayouts = 0;
+        u32 m_destroyedPipelineLayouts = 0;
+
+        LayoutCache::Backend GetBackend()
+        {
+            return {
+                .m_userData = this,
+                .m_createDescriptorSetLayout = [](void* _userData, const DescriptorSetDesc& _desc, u32* _bindingIndices)
+                {
+                    auto* backend = static_cast<RecordingBackend*>(_userData);
+                    backend->m_createdSetLayouts.emplace_back(_desc.m_bindings.begin(), _desc.m_bindings.end());
+                    for (u32 i = 0; i < _desc.m_bindings.size(); i++)
+                        _bindingIndices[i] = i;
+
+                    DescriptorSetLayoutHandle handle;
+                    handle.m_handle.m_index = backend->m_createdSetLayouts.size();
+                    handle.m_handle.m_generation = 0;
+                    return handle;
+                },
+                .m_destroyDescriptorSetLayout = [](void* _userData, DescriptorSetLayoutHandle)
+                {
+                    static_cast<RecordingBackend*>(_userData)->m_destroyedSetLayouts++;
+                },
+                .m_createPipelineLayout = [](void* _userData, const PipelineLayoutDesc& _desc)
+                {
+                    auto* backend = static_cast<RecordingBackend*>(_userData);
+                    backend->m_createdPipelineLayouts.emplace_back(_desc.m_descriptorSets.begin(), _desc.m_descriptorSets.end());
+
+                    PipelineLayoutHandle handle;
+                    handle.m_handle.m_index = backend->m_createdPipelineLayouts.size();
+                    handle.m_handle.m_generation = 0;
+                    return handle;
+                },
+                .m_destroyPipelineLayout = [](void* _userData, PipelineLayoutHandle)
+                {
+                    static_cast<RecordingBackend*>(_userData)->m_destroyedPipelineLayouts++;
+                },
+            };
+        }
+    };
+
+    TEST(ShaderReflectionLayoutCache, DeriveAndShareLayouts)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        const DescriptorInput constantsDescriptors[] = {
+            { .m_name = "g_constants", .m_type = DescriptorBindingDesc::Type::ConstantBuffer, .m_count = 1, .m_bindingIndex = 0 },
+        };
+        const DescriptorInput materialDescriptors[] = {
+            {
+                .m_name = "g_textures",
+                .m_type = DescriptorBindingDesc::Type::SampledTexture,
+                .m_textureType = TextureTypes::Single2D,
+                .m_count = 4,
+                .m_bindingIndex = 0,
+            },
+            { .m_name = "g_sampler", .m_type = DescriptorBindingDesc::Type::Sampler, .m_count = 1, .m_bindingIndex = 0 },
+        };
+        const DescriptorSetInput vsSets[] = {
+            { .m_name = "Constants", .m_descriptors = constantsDescriptors },
+        };
+        const DescriptorSetInput fsSets[] = {
+            { .m_name = "Constants", .m_descriptors = constantsDescriptors },
+            { .m_name = "Material", .m_descriptors = materialDescriptors },
+        };
+        const PushConstantInput pushConstants { .m_name = "g_pushConstants", .m_size = 16 };
+
+        // Two blobs with different entry point names, but the same resources
+        const EntryPointInput entryPointsA[] = {
+            { .m_name = "MainVs", .m_stage = ShaderStage::Stage::Vertex, .m_pushConstants = pushConstants, .m_descriptorSets = vsSets },
+            { .m_name = "MainFs", .m_stage = ShaderStage::Stage::Fragment, .m_pushConstants = pushConstants, .m_descriptorSets = fsSets },
+        };
+        const EntryPointInput entryPointsB[] = {
+            { .m_name = "OtherVs", .m_stage = ShaderStage::Stage::Vertex, .m_pushConstants = pushConstants, .m_descriptorSets = vsSets },
+            { .m_name = "OtherFs", .m_stage = ShaderStage::Stage::Fragment, .m_pushConstants = pushConstants, .m_descriptorSets = fsSets },
+        };
+
+        size_t blobSizeA, blobSizeB;
+        Blob* blobA = Blob::CreateBlob(AllocatorInstance(), entryPointsA, blobSizeA);
+        Blob* blobB = Blob::CreateBlob(AllocatorInstance(), entryPointsB, blobSizeB);
+
+        RecordingBackend backend;
+        auto* cache = AllocatorInstance().New<LayoutCache>(AllocatorInstance(), backend.GetBackend());
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        const LayoutCache::EntryPointReference stagesA[] = {
+            { blobA, blobA->FindEntryPoint("MainVs") },
+            { blobA, blobA->FindEntryPoint("MainFs") },
+        };
+        const LayoutCache::EntryPointReference stagesB[] = {
+            { blobB, blobB->FindEntryPoint("OtherFs") },
+            { blobB, blobB->FindEntryPoint("OtherVs") },
+        };
+        const LayoutCache::EntryPointReference fragmentOnly[] = {
+            { blobA, blobA->FindEntryPoint("MainFs") },
+        };
+
+        const LayoutCache::PipelineLayout* layoutA = cache->AcquirePipelineLayout(stagesA);
+        const LayoutCache::PipelineLayout* layoutB = cache->AcquirePipelineLayout(stagesB);
+        const LayoutCache::PipelineLayout* layoutFragment = cache->AcquirePipelineLayout(fragmentOnly);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        // Stage order doesn't matter, both share the same layout
+        ASSERT_NE(layoutA, nullptr);
+        EXPECT_EQ(layoutA, layoutB);
+        EXPECT_NE(layoutA, layoutFragment);
+
+        ASSERT_EQ(layoutA->m_descriptorSets.size(), 2);
+        const LayoutCache::DescriptorSetLayout* constantsSet = layoutA->m_descriptorSets[0];
+        ASSERT_EQ(constantsSet->m_bindings.size(), 1);
+        EXPECT_EQ(constantsSet->m_bindings[0].m_type, DescriptorBindingDesc::Type::ConstantBuffer);
+        EXPECT_EQ(constantsSet->m_bindings[0].m_visibility, ShaderVisibility::Vertex | ShaderVisibility::Fragment);
+
+        const LayoutCache::DescriptorSetLayout* materialSet = layoutA->m_descriptorSets[1];
+        ASSERT_EQ(materialSet->m_bindings.size(), 2);
+        EXPECT_EQ(materialSet->m_bindings[0].m_type, DescriptorBindingDesc::Type::Sampler);
+        EXPECT_EQ(materialSet->m_bindings[1].m_type, DescriptorBindingDesc::Type::SampledTexture);
+        EXPECT_EQ(materialSet->m_bindings[1].m_count, 4);
+        EXPECT_EQ(materialSet->m_bindings[1].m_visibility, ShaderVisibility::Fragment);
+        EXPECT_EQ(materialSet->FindWriteIndex(DescriptorBindingDesc::Type::SampledTexture, 0), 1);
+        EXPECT_EQ(materialSet->FindWriteIndex(DescriptorBindingDesc::Type::ConstantBuffer, 0), Blob::kInvalidIndex);
+
+        ASSERT_EQ(layoutA->m_pushConstants.size(), 1);
+        EXPECT_EQ(layoutA->m_pushConstants[0].m_sizeInBytes, 16);
+        EXPECT_EQ(layoutA->m_pushConstants[0].m_visibility, ShaderVisibility::Vertex | ShaderVisibility::Fragment);
+
+        // Constants set differs by its visibility, material set is shared
+        ASSERT_EQ(layoutFragment->m_descriptorSets.size(), 2);
+        EXPECT_NE(layoutFragment->m_descriptorSets[0], constantsSet);
+        EXPECT_EQ(layoutFragment->m_descriptorSets[1], materialSet);
+
+        EXPECT_EQ(backend.m_createdSetLayouts.size(), 3);
+        EXPECT_EQ(backend.m_createdPipelineLayouts.size(), 2);
+
+        const LayoutCache::Statistics& statistics = cache->GetStatistics();
+        EXPECT_EQ(statistics.m_pipelineLayoutRequests, 3);
+        EXPECT_EQ(statistics.m_reusedPipelineLayouts, 1);
+        EXPECT_EQ(statistics.m_descriptorSetLayoutRequests, 6);
+        EXPECT_EQ(statistics.m_reusedDescriptorSetLayouts, 3);
+        EXPECT_EQ(statistics.m_livePipelineLayouts, 2);
+        EXPECT_EQ(statistics.m_liveDescriptorSetLayouts, 3);
+
+        // Layouts are only destroyed with their last user
+        cache->ReleasePipelineLayout(layoutA);
+        EXPECT_EQ(backend.m_destroyedPipelineLayouts, 0);
+        cache->ReleasePipelineLayout(layoutB);
+        EXPECT_EQ(backend.m_destroyedPipelineLayouts, 1);
+        EXPECT_EQ(backend.m_destroyedSetLayouts, 1);
+        cache->ReleasePipelineLayout(layoutFragment);
+        EXPECT_EQ(backend.m_destroyedPipelineLayouts, 2);
+        EXPECT_EQ(backend.m_destroyedSetLayouts, 3);
+        EXPECT_EQ(cache->GetStatistics().m_livePipelineLayouts, 0);
+        EXPECT_EQ(cache->GetStatistics().m_liveDescriptorSetLayouts, 0);
+
+        AllocatorInstance().Delete(cache);
+        AllocatorInstance().deallocate(blobA, blobSizeA);
+        AllocatorInstance().deallocate(blobB, blobSizeB);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(ShaderReflectionLayoutCache, MismatchingStages)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        const DescriptorInput vsDescriptors[] = {
+            { .m_name = "g_buffer", .m_type = DescriptorBindingDesc::Type::StorageReadOnlyBuffer, .m_count = 1, .m_bindingIndex = 2 },
+        };
+        const DescriptorInput fsDescriptors[] = {
+            { .m_name = "g_buffer", .m_type = DescriptorBindingDesc::Type::StorageReadOnlyBuffer, .m_count = 2, .m_bindingIndex = 2 },
+        };
+        const DescriptorSetInput vsSets[] = { { .m_name = "Set", .m_descriptors = vsDescriptors } };
+        const DescriptorSetInput fsSets[] = { { .m_name = "Set", .m_descriptors = fsDescriptors } };
+        const EntryPointInput entryPoints[] = {
+            { .m_name = "Vs", .m_stage = ShaderStage::Stage::Vertex, .m_descriptorSets = vsSets },
+            { .m_name = "Fs", .m_stage = ShaderStage::Stage::Fragment, .m_descriptorSets = fsSets },
+        };
+
+        size_t blobSize;
+        Blob* blob = Blob::CreateBlob(AllocatorInstance(), entryPoints, blobSize);
+        const LayoutCache::EntryPointReference stages[] = {
+            { blob, blob->GetEntryPointHeader(0) },
+            { blob, blob->GetEntryPointHeader(1) },
+        };
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        eastl::vector<DescriptorBindingDesc> bindings;
+        LayoutCache::MergeDescriptorSetBindings(stages, 0, bindings);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        catcher.ExpectMessageCount(1);
+        ASSERT_EQ(bindings.size(), 1);
+        EXPECT_EQ(bindings[0].m_visibility, ShaderVisibility::Vertex | ShaderVisibility::Fragment);
+
+        AllocatorInstance().deallocate(blob, blobSize);
+    }
+}
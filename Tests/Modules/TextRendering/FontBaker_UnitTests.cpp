@@ -0,0 +1,110 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <KryneEngine/Modules/FileSystem/VirtualFileSystem.hpp>
+#include <KryneEngine/Modules/Resources/Loaders/SerialResourceLoader.hpp>
+#include <KryneEngine/Modules/Resources/RuntimeResourceSystem.hpp>
+#include <KryneEngine/Modules/TextRendering/Font.hpp>
+#include <KryneEngine/Modules/TextRendering/FontBaker.hpp>
+#include <gtest/gtest.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::TextRendering::Tests
+{
+    using namespace KryneEngine::Tests;
+
+    TEST(FontBaker, BakeRoundTrip)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        FileSystem::VirtualFileSystem fileSystem(AllocatorInstance());
+        Resources::SerialResourceLoader resourceLoader(AllocatorInstance(), &fileSystem);
+        Resources::RuntimeResourceSystem resourceSystem(AllocatorInstance(), &resourceLoader);
+        FontManager fontManager(AllocatorInstance());
+        resourceSystem.RegisterResourceManager<Font>(&fontManager);
+
+        const auto loadFont = [&](const char* _path)
+        {
+            const StringHash path { _path };
+            Resources::ResourceEntry* entry = resourceSystem.GetResourceEntry<Font>(path);
+            resourceSystem.LoadResource(path, entry);
+            return entry->UseResource<Font>();
+        };
+
+        Font* sourceFont = loadFont("Resources/Modules/TextRendering/NotoSerif-Regular.ttf");
+        ASSERT_NE(sourceFont, nullptr);
+
+        const FontBaker::CodepointRange ranges[] { { 'A', 'Z' }, { 'a', 'z' }, { 0x10ffff, 0x10ffff } };
+
+        constexpr const char* bakedPath = "FontBakerTestFont.ke_pbf";
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        FontBaker::Statistics statistics {};
+        const eastl::span<std::byte> baked = FontBaker::Bake(
+            sourceFont,
+            { .m_ranges = ranges, .m_msdfFontSize = 24 },
+            AllocatorInstance(),
+            &statistics);
+        ASSERT_FALSE(baked.empty());
+        {
+            std::ofstream file(bakedPath, std::ios::binary | std::ios::out);
+            file.write(reinterpret_cast<const char*>(baked.data()), static_cast<std::streamsize>(baked.size()));
+        }
+        AllocatorInstance().deallocate(baked.data(), baked.size());
+
+        Font* bakedFont = loadFont(bakedPath);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(statistics.m_requestedCodepoints, 53);
+        EXPECT_EQ(statistics.m_bakedGlyphs, 52);
+        EXPECT_EQ(statistics.m_bakedSize, baked.size());
+        EXPECT_GT(statistics.m_msdfBytes, 0);
+        EXPECT_GT(statistics.m_outlineBytes, 0);
+
+        ASSERT_NE(bakedFont, nullptr);
+        bakedFont->SetNoFallback();
+
+        EXPECT_NEAR(bakedFont->GetAscender(32.f), sourceFont->GetAscender(32.f), 1e-4f);
+        EXPECT_NEAR(bakedFont->GetLineHeight(32.f), sourceFont->GetLineHeight(32.f), 1e-4f);
+        for (const u32 codepoint : { 'A', 'g', 'z' })
+        {
+            EXPECT_NEAR(
+                bakedFont->GetHorizontalAdvance(codepoint, 32.f),
+                sourceFont->GetHorizontalAdvance(codepoint, 32.f),
+                1e-4f);
+        }
+
+        EXPECT_EQ(bakedFont->HasKerning(), statistics.m_kerningPairs > 0);
+        EXPECT_NEAR(bakedFont->GetKerning('A', 'V', 32.f), sourceFont->GetKerning('A', 'V', 32.f), 1e-4f);
+
+        const GlyphMsdfBitmap bitmap = bakedFont->GetMsdf('A', 24, AllocatorInstance());
+        EXPECT_FALSE(bitmap.m_bitmap.empty());
+        EXPECT_EQ(bitmap.m_fontSize, 24);
+        if (bitmap.m_allocated)
+            AllocatorInstance().deallocate(bitmap.m_bitmap.data(), bitmap.m_bitmap.size());
+
+        catcher.ExpectNoMessage();
+
+        // -----------------------------------------------------------------------
+        // Teardown
+        // -----------------------------------------------------------------------
+
+        std::filesystem::remove(bakedPath);
+    }
+}
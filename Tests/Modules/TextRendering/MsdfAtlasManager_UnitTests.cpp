@@ -0,0 +1,121 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <cmath>
+#include <EASTL/vector.h>
+#include <KryneEngine/Modules/TextRendering/MsdfAtlasManager.hpp>
+#include <gtest/gtest.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::TextRendering::Tests
+{
+    using namespace KryneEngine::Tests;
+
+    TEST(MsdfAtlasManager, SelectUploadBatch)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        const u64 sizes[] = { 1024, 2048, 512, 4096 };
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        // No budget, everything is uploaded
+        EXPECT_EQ(MsdfAtlasManager::SelectUploadBatch(sizes, 0), 4);
+
+        // Stops at the first glyph that doesn't fit, to keep uploads in order
+        EXPECT_EQ(MsdfAtlasManager::SelectUploadBatch(sizes, 3072), 2);
+        EXPECT_EQ(MsdfAtlasManager::SelectUploadBatch(sizes, 3583), 2);
+        EXPECT_EQ(MsdfAtlasManager::SelectUploadBatch(sizes, 3584), 3);
+        EXPECT_EQ(MsdfAtlasManager::SelectUploadBatch(sizes, 1'000'000), 4);
+
+        // A glyph bigger than the budget is still uploaded alone
+        EXPECT_EQ(MsdfAtlasManager::SelectUploadBatch(sizes, 256), 1);
+        EXPECT_EQ(MsdfAtlasManager::SelectUploadBatch({ sizes + 3, 1 }, 256), 1);
+
+        EXPECT_EQ(MsdfAtlasManager::SelectUploadBatch({}, 256), 0);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(MsdfAtlasManager, RasterizeCoverage)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+
+        // A disc of radius 12 texels, centered in a 32x32 MSDF. All channels hold the same distance, as for a shape
+        // without corners.
+        constexpr u16 size = 32;
+        constexpr u16 pxRange = 8;
+        eastl::vector<std::byte> msdfData(size * size * 3);
+        for (u32 y = 0; y < size; y++)
+        {
+            for (u32 x = 0; x < size; x++)
+            {
+                const float dx = static_cast<float>(x) + 0.5f - 16.f;
+                const float dy = static_cast<float>(y) + 0.5f - 16.f;
+                const float distance = 12.f - std::sqrt(dx * dx + dy * dy);
+                const float value = eastl::clamp(distance / pxRange + 0.5f, 0.f, 1.f);
+                for (u32 c = 0; c < 3; c++)
+                    msdfData[(y * size + x) * 3 + c] = static_cast<std::byte>(std::lround(value * 255.f));
+            }
+        }
+
+        const GlyphMsdfBitmap msdf {
+            .m_bitmap = msdfData,
+            .m_pxRange = pxRange,
+            .m_width = size,
+            .m_height = size,
+            .m_fontSize = 32,
+            .m_baseLine = 24,
+            .m_allocated = false,
+        };
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        const GlyphCoverageBitmap coverage = MsdfAtlasManager::RasterizeCoverage(msdf, 0.375f, AllocatorInstance());
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(coverage.m_width, 12);
+        EXPECT_EQ(coverage.m_height, 12);
+        EXPECT_EQ(coverage.m_baseLine, 9);
+        ASSERT_EQ(coverage.m_bitmap.size(), 144);
+
+        const auto at = [&](const u32 _x, const u32 _y) { return static_cast<u8>(coverage.m_bitmap[_y * 12 + _x]); };
+
+        // Inside, outside, and an anti-aliased edge of the disc (radius 4.5 px)
+        EXPECT_EQ(at(6, 6), 255);
+        EXPECT_EQ(at(0, 0), 0);
+        EXPECT_EQ(at(11, 11), 0);
+        EXPECT_GT(at(10, 6), 0);
+        EXPECT_LT(at(10, 6), 255);
+
+        // Symmetric
+        for (u32 y = 0; y < 12; y++)
+        {
+            for (u32 x = 0; x < 12; x++)
+                EXPECT_NEAR(at(x, y), at(11 - x, y), 1);
+        }
+
+        AllocatorInstance().deallocate(coverage.m_bitmap.data());
+
+        catcher.ExpectNoMessage();
+    }
+}
@@ -0,0 +1,185 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <filesystem>
+#include <EASTL/vector.h>
+#include <KryneEngine/Modules/TextRendering/MsdfGlyphDiskCache.hpp>
+#include <gtest/gtest.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::TextRendering::Tests
+{
+    using namespace KryneEngine::Tests;
+
+    namespace
+    {
+        struct TemporaryDirectory
+        {
+            explicit TemporaryDirectory(const char* _name)
+                : m_path(std::filesystem::temp_directory_path() / _name)
+            {
+                std::filesystem::remove_all(m_path);
+            }
+
+            ~TemporaryDirectory()
+            {
+                std::filesystem::remove_all(m_path);
+            }
+
+            std::filesystem::path m_path;
+        };
+
+        struct TestBitmap
+        {
+            explicit TestBitmap(const u16 _size, const u8 _seed)
+                : m_pixels(3u * _size * _size)
+            {
+                for (size_t i = 0; i < m_pixels.size(); ++i)
+                    m_pixels[i] = static_cast<std::byte>((i * 7 + _seed) & 0xff);
+
+                m_bitmap = {
+                    .m_bitmap = { m_pixels.data(), m_pixels.size() },
+                    .m_pxRange = 4,
+                    .m_width = _size,
+                    .m_height = _size,
+                    .m_fontSize = 32,
+                    .m_baseLine = 20,
+                    .m_allocated = false,
+                };
+            }
+
+            eastl::vector<std::byte> m_pixels;
+            GlyphMsdfBitmap m_bitmap;
+        };
+
+        MsdfGlyphDiskCache::Key MakeKey(const u32 _codepoint)
+        {
+            return { .m_fontContentHash = 0x1234'5678'9abc'def0, .m_codepoint = _codepoint, .m_fontSize = 32, .m_pxRange = 4 };
+        }
+    }
+
+    TEST(MsdfGlyphDiskCache, StoreLoad)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        const TemporaryDirectory directory("KryneEngine_MsdfGlyphDiskCache_StoreLoad");
+
+        const TestBitmap glyph(24, 3);
+        constexpr u64 generationDuration = 5'000'000'000;
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        {
+            MsdfGlyphDiskCache cache(AllocatorInstance(), directory.m_path.string().c_str(), 1 << 20);
+            EXPECT_TRUE(cache.Load(MakeKey('A'), AllocatorInstance()).m_bitmap.empty());
+            cache.Store(MakeKey('A'), glyph.m_bitmap, generationDuration);
+            EXPECT_EQ(cache.GetEntryCount(), 1);
+
+            // Compressed entry is smaller than the raw bitmap
+            EXPECT_LT(cache.GetTotalSize(), glyph.m_pixels.size());
+        }
+
+        // Warm start: a new cache instance on the same directory.
+        MsdfGlyphDiskCache cache(AllocatorInstance(), directory.m_path.string().c_str(), 1 << 20);
+        const GlyphMsdfBitmap loaded = cache.Load(MakeKey('A'), AllocatorInstance());
+        const GlyphMsdfBitmap otherSize = cache.Load({ MakeKey('A').m_fontContentHash, 'A', 48, 6 }, AllocatorInstance());
+        const GlyphMsdfBitmap otherFont = cache.Load({ 42, 'A', 32, 4 }, AllocatorInstance());
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(cache.GetEntryCount(), 1);
+        ASSERT_EQ(loaded.m_bitmap.size(), glyph.m_pixels.size());
+        EXPECT_EQ(memcmp(loaded.m_bitmap.data(), glyph.m_pixels.data(), glyph.m_pixels.size()), 0);
+        EXPECT_EQ(loaded.m_width, glyph.m_bitmap.m_width);
+        EXPECT_EQ(loaded.m_height, glyph.m_bitmap.m_height);
+        EXPECT_EQ(loaded.m_baseLine, glyph.m_bitmap.m_baseLine);
+        EXPECT_EQ(loaded.m_fontSize, glyph.m_bitmap.m_fontSize);
+        EXPECT_EQ(loaded.m_pxRange, 4);
+        EXPECT_TRUE(loaded.m_allocated);
+
+        EXPECT_TRUE(otherSize.m_bitmap.empty());
+        EXPECT_TRUE(otherFont.m_bitmap.empty());
+
+        const MsdfGlyphDiskCache::Statistics statistics = cache.GetStatistics();
+        EXPECT_EQ(statistics.m_hits, 1);
+        EXPECT_EQ(statistics.m_misses, 2);
+        EXPECT_EQ(statistics.m_stores, 0);
+        EXPECT_EQ(statistics.m_evictions, 0);
+
+        // The warm hit saves the recorded generation time, minus the time spent loading
+        EXPECT_GT(statistics.m_savedDuration, 0);
+        EXPECT_EQ(statistics.m_savedDuration + statistics.m_loadDuration, generationDuration);
+
+        AllocatorInstance().deallocate(loaded.m_bitmap.data(), loaded.m_bitmap.size());
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(MsdfGlyphDiskCache, LruTrimming)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        const TemporaryDirectory directory("KryneEngine_MsdfGlyphDiskCache_LruTrimming");
+
+        const TestBitmap glyphs[] = { TestBitmap(16, 0), TestBitmap(16, 1), TestBitmap(16, 2), TestBitmap(16, 3) };
+
+        u64 entrySize;
+        {
+            MsdfGlyphDiskCache probe(AllocatorInstance(), directory.m_path.string().c_str(), 1 << 20);
+            probe.Store(MakeKey(0), glyphs[0].m_bitmap, 0);
+            entrySize = probe.GetTotalSize();
+            probe.Trim(0);
+            EXPECT_EQ(probe.GetEntryCount(), 0);
+        }
+
+        // Sized for 3 entries, with some slack for the compressed size variations
+        MsdfGlyphDiskCache cache(AllocatorInstance(), directory.m_path.string().c_str(), entrySize * 3 + entrySize / 2);
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        cache.Store(MakeKey(0), glyphs[0].m_bitmap, 0);
+        cache.Store(MakeKey(1), glyphs[1].m_bitmap, 0);
+        cache.Store(MakeKey(2), glyphs[2].m_bitmap, 0);
+
+        // Touch the oldest entry, so that the second one becomes the least recently used.
+        const GlyphMsdfBitmap touched = cache.Load(MakeKey(0), AllocatorInstance());
+        ASSERT_FALSE(touched.m_bitmap.empty());
+        AllocatorInstance().deallocate(touched.m_bitmap.data(), touched.m_bitmap.size());
+
+        cache.Store(MakeKey(3), glyphs[3].m_bitmap, 0);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(cache.GetEntryCount(), 3);
+        EXPECT_EQ(cache.GetStatistics().m_evictions, 1);
+        EXPECT_LE(cache.GetTotalSize(), entrySize * 3 + entrySize / 2);
+
+        const GlyphMsdfBitmap evicted = cache.Load(MakeKey(1), AllocatorInstance());
+        EXPECT_TRUE(evicted.m_bitmap.empty());
+
+        size_t fileCount = 0;
+        for ([[maybe_unused]] const auto& file : std::filesystem::directory_iterator(directory.m_path))
+            fileCount++;
+        EXPECT_EQ(fileCount, 3);
+
+        catcher.ExpectNoMessage();
+    }
+}
@@ -0,0 +1,249 @@
+/**
+ * @file
+ * @author Max Godefroy
+ * @date 18/10/2026.
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <EASTL/vector.h>
+#include <KryneEngine/Modules/FileSystem/VirtualFileSystem.hpp>
+#include <KryneEngine/Modules/Resources/Loaders/SerialResourceLoader.hpp>
+#include <KryneEngine/Modules/Resources/RuntimeResourceSystem.hpp>
+#include <KryneEngine/Modules/TextRendering/Font.hpp>
+#include <KryneEngine/Modules/TextRendering/TextShaper.hpp>
+#include <gtest/gtest.h>
+
+#include "Utils/AssertUtils.hpp"
+
+namespace KryneEngine::Modules::TextRendering::Tests
+{
+    using namespace KryneEngine::Tests;
+
+    /**
+     * @brief Bakes a synthetic pre-baked font and loads it through the resource system, so that shaping can be tested
+     * without any font file dependency nor GPU.
+     */
+    struct ShaperTestEnvironment
+    {
+        static constexpr const char* kFontPath = "TextShaperTestFont.ke_pbf";
+        static constexpr float kAdvance = 0.5f;
+        static constexpr float kAvKerning = -0.1f;
+
+        ShaperTestEnvironment()
+            : m_fileSystem(AllocatorInstance())
+            , m_resourceLoader(AllocatorInstance(), &m_fileSystem)
+            , m_resourceSystem(AllocatorInstance(), &m_resourceLoader)
+            , m_fontManager(AllocatorInstance())
+        {
+            eastl::vector<PreBakedFontFile::GlyphBakeInfo> glyphs;
+            for (u32 codepoint = 0x20; codepoint < 0x7f; ++codepoint)
+            {
+                glyphs.push_back({
+                    .m_glyph = {
+                        .m_codePoint = codepoint,
+                        .m_advanceX = kAdvance,
+                        .m_bearingX = 0.05f,
+                        .m_bearingY = 0.7f,
+                        .m_width = 0.4f,
+                        .m_height = 0.7f,
+                    },
+                });
+            }
+            const PreBakedFontFile::KerningPair kerningPairs[] {
+                { 'V', 'A', kAvKerning },
+                { 'A', 'V', kAvKerning },
+            };
+
+            const eastl::span<std::byte> baked = PreBakedFontFile::Bake(
+                static_cast<PreBakedFontFile::BakedRenderInfo>(0),
+                { .m_ascender = 0.8f, .m_descender = -0.2f, .m_lineHeight = 1.2f },
+                glyphs,
+                kerningPairs,
+                {},
+                {},
+                AllocatorInstance());
+            {
+                std::ofstream file(kFontPath, std::ios::binary | std::ios::out);
+                file.write(reinterpret_cast<const char*>(baked.data()), static_cast<std::streamsize>(baked.size()));
+            }
+            AllocatorInstance().deallocate(baked.data(), baked.size());
+
+            m_resourceSystem.RegisterResourceManager<Font>(&m_fontManager);
+
+            const StringHash path { kFontPath };
+            Resources::ResourceEntry* entry = m_resourceSystem.GetResourceEntry<Font>(path);
+            m_resourceSystem.LoadResource(path, entry);
+            m_font = entry->UseResource<Font>();
+            m_font->SetNoFallback();
+        }
+
+        ~ShaperTestEnvironment()
+        {
+            std::filesystem::remove(kFontPath);
+        }
+
+        FileSystem::VirtualFileSystem m_fileSystem;
+        Resources::SerialResourceLoader m_resourceLoader;
+        Resources::RuntimeResourceSystem m_resourceSystem;
+        FontManager m_fontManager;
+        Font* m_font = nullptr;
+    };
+
+    TEST(TextShaper, Positions)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        ShaperTestEnvironment environment;
+        ASSERT_NE(environment.m_font, nullptr);
+
+        constexpr eastl::string_view text = "AVB\nA";
+        ShapedGlyph glyphBuffer[text.size()];
+
+        constexpr float fontSize = 10.f;
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        const ShapedRun kerned = TextShaper::Shape(
+            environment.m_font,
+            text,
+            { .m_fontSize = fontSize },
+            glyphBuffer);
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_TRUE(environment.m_font->HasKerning());
+        EXPECT_FLOAT_EQ(environment.m_font->GetKerning('A', 'V', fontSize), -1.f);
+        EXPECT_FLOAT_EQ(environment.m_font->GetKerning('A', 'B', fontSize), 0.f);
+
+        ASSERT_EQ(kerned.m_glyphs.size(), 4);
+        EXPECT_EQ(kerned.m_glyphs[0].m_codepoint, 'A');
+        EXPECT_FLOAT_EQ(kerned.m_glyphs[0].m_position.x, 0.f);
+        EXPECT_FLOAT_EQ(kerned.m_glyphs[0].m_position.y, 8.f);
+        EXPECT_FLOAT_EQ(kerned.m_glyphs[1].m_position.x, 4.f);
+        EXPECT_FLOAT_EQ(kerned.m_glyphs[2].m_position.x, 9.f);
+        EXPECT_EQ(kerned.m_glyphs[3].m_codepoint, 'A');
+        EXPECT_FLOAT_EQ(kerned.m_glyphs[3].m_position.x, 0.f);
+        EXPECT_FLOAT_EQ(kerned.m_glyphs[3].m_position.y, 20.f);
+        EXPECT_FLOAT_EQ(kerned.m_size.x, 14.f);
+        EXPECT_FLOAT_EQ(kerned.m_size.y, 22.f);
+
+        // Disabling kerning only changes the pair adjustments
+        const ShapedRun unkerned = TextShaper::Shape(
+            environment.m_font,
+            text,
+            { .m_fontSize = fontSize, .m_letterSpacing = 1.f, .m_kerning = false },
+            glyphBuffer);
+        ASSERT_EQ(unkerned.m_glyphs.size(), 4);
+        EXPECT_FLOAT_EQ(unkerned.m_glyphs[1].m_position.x, 6.f);
+        EXPECT_FLOAT_EQ(unkerned.m_glyphs[2].m_position.x, 12.f);
+        EXPECT_NE(kerned.m_contentHash, unkerned.m_contentHash);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(TextShaper, RunCache)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        ShaperTestEnvironment environment;
+        ASSERT_NE(environment.m_font, nullptr);
+
+        TextShaper shaper(AllocatorInstance(), 2);
+
+        // -----------------------------------------------------------------------
+        // Execute & verify
+        // -----------------------------------------------------------------------
+
+        const ShapedRun* first = shaper.AcquireShapedRun(environment.m_font, "Hello", { .m_fontSize = 12.f });
+        const ShapedRun* second = shaper.AcquireShapedRun(environment.m_font, "Hello", { .m_fontSize = 12.f });
+        ASSERT_NE(first, nullptr);
+        EXPECT_EQ(first, second);
+        EXPECT_EQ(first->m_glyphs.size(), 5);
+        shaper.ReleaseShapedRun(first);
+        shaper.ReleaseShapedRun(second);
+
+        const ShapedRun* other = shaper.AcquireShapedRun(environment.m_font, "Hello", { .m_fontSize = 14.f });
+        ASSERT_NE(other, nullptr);
+        EXPECT_NE(other->m_contentHash, first->m_contentHash);
+        shaper.ReleaseShapedRun(other);
+
+        // Evicts the least recently used run
+        const ShapedRun* third = shaper.AcquireShapedRun(environment.m_font, "World!", { .m_fontSize = 12.f });
+        ASSERT_NE(third, nullptr);
+        EXPECT_EQ(third->m_glyphs.size(), 6);
+        shaper.ReleaseShapedRun(third);
+
+        const TextShaper::Statistics statistics = shaper.GetStatistics();
+        EXPECT_EQ(statistics.m_cacheHits, 1);
+        EXPECT_EQ(statistics.m_cacheMisses, 3);
+        EXPECT_EQ(statistics.m_shapedGlyphs, 16);
+
+        catcher.ExpectNoMessage();
+    }
+
+    TEST(TextShaper, DISABLED_Throughput)
+    {
+        // -----------------------------------------------------------------------
+        // Setup
+        // -----------------------------------------------------------------------
+
+        ScopedAssertCatcher catcher;
+        ShaperTestEnvironment environment;
+        ASSERT_NE(environment.m_font, nullptr);
+
+        constexpr eastl::string_view text =
+            "Lorem ipsum dolor sit amet, consectetur adipiscing elit. AVAVAV Vestibulum ac ipsum vel lorem viverra.";
+        eastl::vector<ShapedGlyph> glyphBuffer(text.size());
+
+        constexpr u32 iterations = 20'000;
+
+        // -----------------------------------------------------------------------
+        // Execute
+        // -----------------------------------------------------------------------
+
+        size_t glyphCount = 0;
+        const auto start = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < iterations; ++i)
+        {
+            const ShapedRun run = TextShaper::Shape(environment.m_font, text, { .m_fontSize = 16.f }, glyphBuffer);
+            glyphCount += run.m_glyphs.size();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        TextShaper shaper(AllocatorInstance());
+        const auto cachedStart = std::chrono::steady_clock::now();
+        for (u32 i = 0; i < iterations; ++i)
+        {
+            const ShapedRun* run = shaper.AcquireShapedRun(environment.m_font, text, { .m_fontSize = 16.f });
+            shaper.ReleaseShapedRun(run);
+        }
+        const std::chrono::duration<double> cachedElapsed = std::chrono::steady_clock::now() - cachedStart;
+
+        // -----------------------------------------------------------------------
+        // Verify
+        // -----------------------------------------------------------------------
+
+        EXPECT_EQ(glyphCount, text.size() * iterations);
+        EXPECT_EQ(shaper.GetStatistics().m_cacheMisses, 1);
+
+        printf(
+            "Shaping throughput: %.2f Mglyphs/s uncached, %.2f Mglyphs/s cached\n",
+            static_cast<double>(glyphCount) / elapsed.count() * 1e-6,
+            static_cast<double>(glyphCount) / cachedElapsed.count() * 1e-6);
+
+        catcher.ExpectNoMessage();
+    }
+}